@@ -1,7 +1,7 @@
 TARGET = DualDepthPeelingApp
 TEMPLATE = app
 
-QT = core gui widgets
+QT = core gui widgets concurrent
 
 CONFIG += debug_and_release c++17 qtquickcompiler
 
@@ -0,0 +1,28 @@
+TARGET = DualDepthPeelingHeadless
+TEMPLATE = app
+
+QT = core gui concurrent
+
+CONFIG += console debug_and_release c++17
+CONFIG -= app_bundle
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+INCLUDEPATH += \
+    ../../DataModel \
+    ../../Gui
+
+SOURCES += \
+    main.cpp
+
+build_pass:CONFIG(debug, debug|release):CONFIGURATION = debug
+else:build_pass:CONFIG(release, debug|release):CONFIGURATION = release
+
+LIBS += \
+    -L$$OUT_PWD/../../Gui -L$$OUT_PWD/../../Gui/$${CONFIGURATION} -lGui \
+    -L$$OUT_PWD/../../DataModel -L$$OUT_PWD/../../DataModel/$${CONFIGURATION} -lDataModel
+
+!win32-msvc {
+    RESOURCES += \
+        ../Resources/Resources.qrc
+}
@@ -0,0 +1,221 @@
+#include <Offscreen/OffscreenRenderer.h>
+#include <Renderers/Common/ImageComparison.h>
+#include <Renderers/Software/SoftwareDualDepthPeelingRenderer.h>
+#include <Renderers/UnorderedTransparency/DualDepthPeelingRenderer.h>
+#include <Renderers/UnorderedTransparency/TransparencyRenderer.h>
+
+#include <QtGui/QGuiApplication>
+#include <QtCore/QCommandLineParser>
+#include <QtCore/QDebug>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+// Render the model without window, write the frames and their timings.
+// Without display, run it under xvfb-run or with QT_QPA_PLATFORM=offscreen (if the Qt offscreen plugin provides OpenGL),
+// --software selects Mesa llvmpipe.
+// --reference renders the last frame again with the CPU engine (or --reference-engine) and compares the images, the exit code
+// is 3 when they differ.
+int main(int argc, char *argv[])
+{
+    // read before the OpenGL library is loaded
+    if (std::any_of(argv + 1, argv + argc, [](const char* p_arg) { return std::strcmp(p_arg, "--software") == 0; }))
+    {
+        qputenv("LIBGL_ALWAYS_SOFTWARE", "1");
+        QCoreApplication::setAttribute(Qt::AA_UseSoftwareOpenGL, true);
+    }
+    else
+    {
+        QCoreApplication::setAttribute(Qt::AA_UseDesktopOpenGL, true);
+    }
+
+    QGuiApplication a(argc, argv);
+    QCoreApplication::setApplicationName("DualDepthPeelingHeadless");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Render a model with a transparency engine without window");
+    parser.addHelpOption();
+    const QCommandLineOption modelOption("model", "Model .obj file (default the dragon of the application).", "file",
+#ifdef Q_CC_MSVC
+        "./dragon.obj");
+#else
+        ":/Model/dragon.obj");
+#endif
+    const QCommandLineOption engineOption("engine", QString("Transparency engine: %1.").arg(gui::OffscreenRenderer::transparencyEngineNames().join(", ")), "name", "DualDepthPeeling");
+    const QCommandLineOption sizeOption("size", "Image size in pixels.", "WxH", "1024x768");
+    const QCommandLineOption framesOption("frames", "Number of rendered frames.", "count", "10");
+    const QCommandLineOption opacityOption("opacity", "Opacity of the model.", "alpha", "0.5");
+    const QCommandLineOption zoomOption("zoom", "Camera zoom.", "zoom", "1");
+    const QCommandLineOption rotateOption("rotate", "Camera rotation before each frame, as a mouse move in pixels.", "dx,dy", "0,0");
+    const QCommandLineOption outputOption("output", "Directory of the images and of timing.json.", "directory", ".");
+    const QCommandLineOption saveAllOption("save-all", "Save every frame, else only the last one.");
+    const QCommandLineOption budgetOption("budget", "GPU time budget of the transparency passes of dual depth peeling, 0 to disable.", "ms", "0");
+    const QCommandLineOption softwareOption("software", "Mesa software rasterizer (llvmpipe).");
+    const QCommandLineOption noGpuOption("no-gpu", "No OpenGL context, only with the Software engine.");
+    const QCommandLineOption referenceOption("reference", "Compare the last frame with the reference engine, write reference.png and difference.png.");
+    const QCommandLineOption referenceEngineOption("reference-engine", "Engine of the reference image, ex. DualDepthPeeling for the error of an approximate engine on the GPU.", "name", "Software");
+    const QCommandLineOption toleranceOption("tolerance", "Accepted difference by 8 bits channel with the reference.", "value", "4");
+    const QCommandLineOption maxDifferentRatioOption("max-different-ratio", "Accepted ratio of pixels over the tolerance (triangle edges).", "ratio", "0.01");
+    parser.addOptions({ modelOption, engineOption, sizeOption, framesOption, opacityOption, zoomOption, rotateOption, outputOption, saveAllOption, budgetOption,
+        softwareOption, noGpuOption, referenceOption, referenceEngineOption, toleranceOption, maxDifferentRatioOption });
+    parser.process(a);
+
+    const QStringList size{ parser.value(sizeOption).split('x') };
+    const QStringList rotation{ parser.value(rotateOption).split(',') };
+    const int width{ size.value(0).toInt() };
+    const int height{ size.value(1).toInt() };
+    const int frameCount{ parser.value(framesOption).toInt() };
+    const double budget{ parser.value(budgetOption).toDouble() };
+    if (size.size() != 2 || width <= 0 || height <= 0 || frameCount <= 0 || rotation.size() != 2 || budget < 0.)
+    {
+        qCritical() << "Invalid arguments";
+        parser.showHelp(1);
+    }
+
+    const QDir outputDir(parser.value(outputOption));
+    if (!outputDir.mkpath("."))
+    {
+        qCritical() << "Cannot create the output directory" << outputDir.path();
+        return 1;
+    }
+
+    gui::OffscreenRenderer renderer;
+    renderer.setFrameTimeBudget(budget);
+    if (!renderer.initialize(width, height, !parser.isSet(noGpuOption))
+        || !renderer.setTransparencyEngine(parser.value(engineOption))
+        || !renderer.loadModel(parser.value(modelOption), parser.value(opacityOption).toFloat()))
+    {
+        return 1;
+    }
+    if (renderer.hasOpenGL())
+    {
+        qInfo().noquote() << "OpenGL:" << renderer.glRendererName();
+    }
+
+    renderer.camera().setZoom(parser.value(zoomOption).toDouble());
+    renderer.gpuProfiler().setEnable(true);
+
+    QJsonArray frames;
+    std::vector<double> frameTimes;
+    QImage lastImage;
+    for (int frameId = 0; frameId < frameCount; frameId++)
+    {
+        renderer.camera().rotate(rotation.at(0).toFloat(), rotation.at(1).toFloat());
+
+        const double frameTime{ renderer.renderFrame() };
+        if (frameTime < 0.)
+        {
+            return 1;
+        }
+        frameTimes.push_back(frameTime);
+        QJsonObject frame{ { "frame", frameId }, { "time_ms", frameTime } };
+        if (const auto* const dualRenderer{ dynamic_cast<gui::gl::DualDepthPeelingRenderer*>(renderer.transparencyRenderer()) })
+        {
+            // the pass cap of the frame and the layers left of a previous frame
+            frame.insert("passes", static_cast<qint64>(dualRenderer->lastPassCount()));
+            if (dualRenderer->frameTimeBudget() > 0.)
+            {
+                frame.insert("pass_budget", static_cast<qint64>(dualRenderer->passBudget()));
+            }
+            if (dualRenderer->isUnpeeledQueryUsed())
+            {
+                frame.insert("unpeeled_pixels", static_cast<qint64>(dualRenderer->unpeeledSampleCount()));
+            }
+        }
+        frames.append(frame);
+
+        if (parser.isSet(saveAllOption) || frameId == frameCount - 1)
+        {
+            lastImage = renderer.grabImage();
+            const QString filepath{ outputDir.filePath(QString("frame_%1.png").arg(frameId, 4, 10, QChar('0'))) };
+            if (!lastImage.save(filepath))
+            {
+                qCritical() << "Cannot write" << filepath;
+                return 1;
+            }
+        }
+    }
+    renderer.flushGpuProfiler();
+
+    // the first frame initializes the engine, its time is kept in the frames only
+    std::vector<double> sortedTimes(frameTimes.size() > 1 ? frameTimes.begin() + 1 : frameTimes.begin(), frameTimes.end());
+    std::sort(sortedTimes.begin(), sortedTimes.end());
+
+    QJsonArray gpuStages;
+    for (const gui::gl::GpuProfiler::StageTiming& stage : renderer.gpuProfiler().averageStages())
+    {
+        gpuStages.append(QJsonObject{ { "name", stage.name }, { "time_ms", stage.time } });
+    }
+
+    QJsonObject timing{
+        { "renderer", renderer.hasOpenGL() ? renderer.glRendererName() : QString("CPU") },
+        { "engine", renderer.transparencyEngineName() },
+        { "width", width },
+        { "height", height },
+        { "budget_ms", budget },
+        { "median_time_ms", sortedTimes.at(sortedTimes.size() / 2) },
+        { "gpu_time_ms", renderer.gpuProfiler().averageFrameTime() },
+        { "gpu_stages", gpuStages },
+        { "frames", frames }
+    };
+
+    // same camera as the last frame, the engine is replaced by the reference one (the CPU one by default)
+    bool isDifferentFromReference{ false };
+    if (parser.isSet(referenceOption))
+    {
+        const QString engineName{ renderer.transparencyEngineName() };
+        const QString referenceEngineName{ parser.value(referenceEngineOption) };
+        // the GL engines render the frame of their initialization again, the last one is compared
+        const double referenceTime{ renderer.setTransparencyEngine(referenceEngineName) && renderer.renderFrame() >= 0. ? renderer.renderFrame() : -1. };
+        if (referenceTime < 0.)
+        {
+            return 1;
+        }
+
+        const QImage referenceImage{ renderer.grabImage() };
+        const int tolerance{ parser.value(toleranceOption).toInt() };
+        const gui::ImageDifference difference{ gui::compareImages(lastImage, referenceImage, tolerance) };
+        if (!referenceImage.save(outputDir.filePath("reference.png")) || !difference.differenceImage.save(outputDir.filePath("difference.png")))
+        {
+            qCritical() << "Cannot write the reference images in" << outputDir.path();
+            return 1;
+        }
+
+        isDifferentFromReference = difference.differentPixelRatio > parser.value(maxDifferentRatioOption).toDouble();
+        QJsonObject reference{
+            { "engine", referenceEngineName },
+            { "time_ms", referenceTime },
+            { "tolerance", tolerance },
+            { "max_difference", difference.maxDifference },
+            { "mean_difference", difference.meanDifference },
+            { "different_pixels", difference.differentPixelCount },
+            { "different_pixel_ratio", difference.differentPixelRatio }
+        };
+        if (const auto* const softwareRenderer{ renderer.softwareRenderer() })
+        {
+            reference.insert("passes", static_cast<qint64>(softwareRenderer->lastPassCount()));
+            reference.insert("max_depth_complexity", softwareRenderer->maxDepthComplexity());
+        }
+        timing.insert("reference", reference);
+        qInfo().noquote() << QString("%1 against the %2 reference: max difference %3, mean difference %4, %5% of the pixels over %6")
+            .arg(engineName, referenceEngineName).arg(difference.maxDifference).arg(difference.meanDifference, 0, 'f', 3)
+            .arg(100. * difference.differentPixelRatio, 0, 'f', 3).arg(tolerance);
+    }
+
+    QFile file(outputDir.filePath("timing.json"));
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate) || file.write(QJsonDocument(timing).toJson()) < 0)
+    {
+        qCritical() << "Cannot write" << file.fileName();
+        return 1;
+    }
+    qInfo().noquote() << QString("%1 frames of %2x%3 with %4, median %5 ms").arg(frameCount).arg(width).arg(height)
+        .arg(timing.value("engine").toString()).arg(sortedTimes.at(sortedTimes.size() / 2), 0, 'f', 3);
+
+    return isDifferentFromReference ? 3 : 0;
+}
@@ -27,6 +27,8 @@ int main(int argc, char *argv[])
     QSurfaceFormat::setDefaultFormat(format);
 
     QApplication a(argc, argv);
+    QCoreApplication::setOrganizationName("DualDepthPeeling");
+    QCoreApplication::setApplicationName("DualDepthPeelingApp"); // QSettings of the transparency engine calibration
     MainWidget w;
 #ifdef Q_CC_MSVC
     w.setModelFilepath("./dragon.obj");
@@ -0,0 +1,7 @@
+TEMPLATE = subdirs
+
+SUBDIRS = \
+    CameraPathBenchmark \
+    GeomBenchmark \
+    ObjLoaderBenchmark \
+    SceneScalingBenchmark
@@ -0,0 +1,160 @@
+#include "BenchmarkReport.h"
+#include "RenderBenchmark.h"
+
+#include <GLWidgets/CameraSession.h>
+#include <Offscreen/OffscreenRenderer.h>
+
+#include <QtGui/QGuiApplication>
+#include <QtCore/QCommandLineParser>
+#include <QtCore/QDebug>
+#include <QtCore/QFileInfo>
+
+#include <utility>
+#include <vector>
+
+// Render the transparency engines along camera paths without window and report the frame times as JSON.
+// Scripted paths (orbit, zoom sweep, close-up) and sessions recorded with the R key of the application are replayed
+// from their start view, one camera move by frame. A baseline report makes the run fail on a regression.
+
+int main(int argc, char *argv[])
+{
+    bench::setOpenGLFromArguments(argc, argv); // before the OpenGL library is loaded
+
+    QGuiApplication a(argc, argv);
+    QCoreApplication::setApplicationName("CameraPathBenchmark");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Frame times of the transparency engines along camera paths");
+    parser.addHelpOption();
+    const QCommandLineOption modelOption("model", "Model .obj file (default the dragon of the application).", "file",
+#ifdef Q_CC_MSVC
+        "./dragon.obj");
+#else
+        ":/Model/dragon.obj");
+#endif
+    const QCommandLineOption enginesOption("engines", QString("Comma separated engines among %1, or all.").arg(gui::OffscreenRenderer::transparencyEngineNames().join(", ")), "names", "DualDepthPeeling");
+    const QCommandLineOption pathsOption("paths", "Comma separated scripted paths among orbit, zoom, closeup.", "names", "orbit,zoom,closeup");
+    const QCommandLineOption sessionOption("session", "Recorded camera session to replay, can be repeated.", "file");
+    const QCommandLineOption framesOption("frames", "Frames of each scripted path.", "count", "120");
+    const QCommandLineOption sizeOption("size", "Image size in pixels.", "WxH", "1024x768");
+    const QCommandLineOption outputOption("output", "JSON report.", "file", "camera_path_benchmark.json");
+    const QCommandLineOption baselineOption("baseline", "JSON report to compare with, the exit code is 2 on a regression.", "file");
+    const QCommandLineOption toleranceOption("tolerance", "Accepted relative increase of the p95 frame times.", "ratio", "0.1");
+    const QCommandLineOption budgetOption("budget", "GPU time budget of the transparency passes of dual depth peeling, 0 to disable.", "ms", "0");
+    const QCommandLineOption softwareOption("software", "Mesa software rasterizer (llvmpipe).");
+    parser.addOptions({ modelOption, enginesOption, pathsOption, sessionOption, framesOption, sizeOption, outputOption, baselineOption, toleranceOption,
+        budgetOption, softwareOption });
+    parser.process(a);
+
+    const QStringList size{ parser.value(sizeOption).split('x') };
+    const int width{ size.value(0).toInt() };
+    const int height{ size.value(1).toInt() };
+    const int frameCount{ parser.value(framesOption).toInt() };
+    const double budget{ parser.value(budgetOption).toDouble() };
+    if (size.size() != 2 || width <= 0 || height <= 0 || frameCount <= 0 || budget < 0.)
+    {
+        qCritical() << "Invalid arguments";
+        parser.showHelp(1);
+    }
+
+    QStringList engines{ parser.value(enginesOption).split(',', QString::SkipEmptyParts) };
+    if (engines == QStringList{ "all" })
+    {
+        engines = gui::OffscreenRenderer::transparencyEngineNames();
+    }
+
+    gui::OffscreenRenderer renderer;
+    if (!renderer.initialize(width, height) || !renderer.loadModel(parser.value(modelOption)))
+    {
+        return 1;
+    }
+    qInfo().noquote() << "OpenGL:" << renderer.glRendererName();
+    renderer.setFrameTimeBudget(budget);
+
+    // the scripted paths start from the fitted view, the recorded ones from their own start
+    std::vector<std::pair<QString, gui::CameraSession>> sessions;
+    for (const QString& path : parser.value(pathsOption).split(',', QString::SkipEmptyParts))
+    {
+        if (path == "orbit")
+        {
+            sessions.emplace_back(path, gui::CameraSession::orbit(renderer.camera(), frameCount));
+        }
+        else if (path == "zoom")
+        {
+            sessions.emplace_back(path, gui::CameraSession::zoomSweep(renderer.camera(), frameCount));
+        }
+        else if (path == "closeup")
+        {
+            sessions.emplace_back(path, gui::CameraSession::closeUp(renderer.camera(), frameCount));
+        }
+        else
+        {
+            qCritical() << "Unknown camera path" << path;
+            return 1;
+        }
+    }
+    for (const QString& filepath : parser.values(sessionOption))
+    {
+        gui::CameraSession session;
+        if (!session.load(filepath))
+        {
+            return 1;
+        }
+        sessions.emplace_back("session:" + QFileInfo(filepath).completeBaseName(), session);
+    }
+
+    QJsonObject benchmarks;
+    for (const QString& engine : engines)
+    {
+        if (!renderer.setTransparencyEngine(engine))
+        {
+            qWarning() << "Engine" << engine << "skipped";
+            continue;
+        }
+
+        if (!bench::warmUp(renderer))
+        {
+            return 1;
+        }
+
+        for (const auto& [pathName, session] : sessions)
+        {
+            const QJsonObject result{ bench::runCameraSession(renderer, session) };
+            if (result.isEmpty())
+            {
+                return 1;
+            }
+
+            const QString name{ QString("%1/%2").arg(engine, pathName) };
+            benchmarks.insert(name, result);
+            const QJsonObject cpu{ result.value("cpu_ms").toObject() };
+            const QJsonObject dualDepthPeeling{ result.value("dual_depth_peeling").toObject() };
+            qInfo().noquote() << QString("%1: p50 %2 ms, p95 %3 ms, p99 %4 ms, %5 passes, %6 geometry passes%7").arg(name, -40)
+                .arg(cpu.value("p50").toDouble(), 0, 'f', 3).arg(cpu.value("p95").toDouble(), 0, 'f', 3).arg(cpu.value("p99").toDouble(), 0, 'f', 3)
+                .arg(result.value("passes").toObject().value("mean").toDouble(), 0, 'f', 1)
+                .arg(result.value("geometry_passes").toObject().value("mean").toDouble(), 0, 'f', 1)
+                .arg(dualDepthPeeling.contains("avoided_stalls") ? QString(", %1 avoided stalls").arg(dualDepthPeeling.value("avoided_stalls").toInt()) : QString());
+        }
+    }
+
+    const QJsonObject report{
+        { "renderer", renderer.glRendererName() },
+        { "model", parser.value(modelOption) },
+        { "width", width },
+        { "height", height },
+        { "budget_ms", budget },
+        { "peak_rss_kb", bench::peakResidentMemory() },
+        { "benchmarks", benchmarks }
+    };
+    if (!bench::writeJson(parser.value(outputOption), report))
+    {
+        return 1;
+    }
+
+    if (parser.isSet(baselineOption))
+    {
+        return bench::checkBaseline(report, parser.value(baselineOption), { "cpu_ms/p95", "gpu_ms/p95" }, parser.value(toleranceOption).toDouble());
+    }
+
+    return 0;
+}
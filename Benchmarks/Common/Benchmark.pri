@@ -0,0 +1,11 @@
+# Shared by the benchmark applications: statistics, memory and JSON reports with baseline comparison
+
+INCLUDEPATH += $$PWD
+
+HEADERS += \
+    $$PWD/BenchmarkReport.h
+
+SOURCES += \
+    $$PWD/BenchmarkReport.cpp
+
+win32: LIBS += -lpsapi
@@ -0,0 +1,185 @@
+#include "BenchmarkReport.h"
+
+#include <QtCore/QDebug>
+#include <QtCore/QFile>
+#include <QtCore/QJsonDocument>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#if defined(Q_OS_WIN)
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#elif defined(Q_OS_UNIX)
+#include <sys/resource.h>
+#endif
+
+namespace bench
+{
+
+    //---------------------------------------------------------------------------------------
+    double percentile(std::vector<double> p_values, double p_ratio)
+    //---------------------------------------------------------------------------------------
+    {
+        if (p_values.empty())
+        {
+            return 0.;
+        }
+
+        const double rank{ std::ceil(std::clamp(p_ratio, 0., 1.) * static_cast<double>(p_values.size())) };
+        const size_t index{ static_cast<size_t>(std::max(rank, 1.)) - 1 };
+        std::nth_element(p_values.begin(), p_values.begin() + static_cast<std::ptrdiff_t>(index), p_values.end());
+        return p_values.at(index);
+    }
+
+    //---------------------------------------------------------------------------------------
+    QJsonObject summarize(const std::vector<double>& p_values)
+    //---------------------------------------------------------------------------------------
+    {
+        if (p_values.empty())
+        {
+            return QJsonObject{ { "count", 0 } };
+        }
+
+        const auto [minValue, maxValue] = std::minmax_element(p_values.cbegin(), p_values.cend());
+        return QJsonObject{
+            { "count", static_cast<qint64>(p_values.size()) },
+            { "mean", std::accumulate(p_values.cbegin(), p_values.cend(), 0.) / static_cast<double>(p_values.size()) },
+            { "min", *minValue },
+            { "max", *maxValue },
+            { "p50", percentile(p_values, 0.5) },
+            { "p95", percentile(p_values, 0.95) },
+            { "p99", percentile(p_values, 0.99) }
+        };
+    }
+
+    //---------------------------------------------------------------------------------------
+    qint64 peakResidentMemory(void)
+    //---------------------------------------------------------------------------------------
+    {
+#if defined(Q_OS_WIN)
+        PROCESS_MEMORY_COUNTERS counters;
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        {
+            return static_cast<qint64>(counters.PeakWorkingSetSize / 1024);
+        }
+        return -1;
+#elif defined(Q_OS_UNIX)
+        struct rusage usage;
+        if (getrusage(RUSAGE_SELF, &usage) != 0)
+        {
+            return -1;
+        }
+#if defined(Q_OS_MACOS)
+        return static_cast<qint64>(usage.ru_maxrss / 1024); // bytes on macOS
+#else
+        return static_cast<qint64>(usage.ru_maxrss);
+#endif
+#else
+        return -1;
+#endif
+    }
+
+    //---------------------------------------------------------------------------------------
+    bool writeJson(const QString& p_filepath, const QJsonObject& p_object)
+    //---------------------------------------------------------------------------------------
+    {
+        QFile file(p_filepath);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate) || file.write(QJsonDocument(p_object).toJson()) < 0)
+        {
+            qCritical() << "Cannot write" << p_filepath;
+            return false;
+        }
+        return true;
+    }
+
+    //---------------------------------------------------------------------------------------
+    bool readJson(const QString& p_filepath, QJsonObject& p_object)
+    //---------------------------------------------------------------------------------------
+    {
+        QFile file(p_filepath);
+        if (!file.open(QIODevice::ReadOnly))
+        {
+            qCritical() << "Cannot read" << p_filepath;
+            return false;
+        }
+
+        const QJsonDocument document{ QJsonDocument::fromJson(file.readAll()) };
+        if (!document.isObject())
+        {
+            qCritical() << "Invalid JSON report" << p_filepath;
+            return false;
+        }
+        p_object = document.object();
+        return true;
+    }
+
+    //---------------------------------------------------------------------------------------
+    QStringList compareWithBaseline(const QJsonObject& p_report, const QJsonObject& p_baseline, const QStringList& p_metrics, double p_tolerance)
+    //---------------------------------------------------------------------------------------
+    {
+        const auto metricValue = [](QJsonValue p_value, const QString& p_metric)
+        {
+            for (const QString& key : p_metric.split('/'))
+            {
+                p_value = p_value.toObject().value(key);
+            }
+            return p_value;
+        };
+
+        QStringList regressions;
+        const QJsonObject benchmarks{ p_report.value("benchmarks").toObject() };
+        const QJsonObject baselineBenchmarks{ p_baseline.value("benchmarks").toObject() };
+        for (auto it = benchmarks.constBegin(); it != benchmarks.constEnd(); ++it)
+        {
+            if (!baselineBenchmarks.contains(it.key()))
+            {
+                continue;
+            }
+
+            for (const QString& metric : p_metrics)
+            {
+                const QJsonValue value{ metricValue(it.value(), metric) };
+                const QJsonValue baselineValue{ metricValue(baselineBenchmarks.value(it.key()), metric) };
+                if (!value.isDouble() || !baselineValue.isDouble())
+                {
+                    continue;
+                }
+
+                if (value.toDouble() > baselineValue.toDouble() * (1. + p_tolerance))
+                {
+                    regressions << QString("%1 %2: %3 instead of %4 (+%5%)").arg(it.key(), metric)
+                        .arg(value.toDouble(), 0, 'f', 3).arg(baselineValue.toDouble(), 0, 'f', 3)
+                        .arg(100. * (value.toDouble() / std::max(baselineValue.toDouble(), 1e-9) - 1.), 0, 'f', 1);
+                }
+            }
+        }
+        return regressions;
+    }
+
+    //---------------------------------------------------------------------------------------
+    int checkBaseline(const QJsonObject& p_report, const QString& p_baselineFilepath, const QStringList& p_metrics, double p_tolerance)
+    //---------------------------------------------------------------------------------------
+    {
+        QJsonObject baseline;
+        if (!readJson(p_baselineFilepath, baseline))
+        {
+            return 1;
+        }
+
+        const QStringList regressions{ compareWithBaseline(p_report, baseline, p_metrics, p_tolerance) };
+        for (const QString& regression : regressions)
+        {
+            qCritical().noquote() << "Regression" << regression;
+        }
+        if (!regressions.isEmpty())
+        {
+            return 2;
+        }
+        qInfo() << "No regression against" << p_baselineFilepath;
+        return 0;
+    }
+
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <QtCore/QJsonObject>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+
+#include <vector>
+
+namespace bench
+{
+
+    //!< Nearest rank percentile of p_values, p_ratio in [0, 1] (ex. 0.95), 0 if empty
+    double percentile(std::vector<double> p_values, double p_ratio);
+    //!< count, mean, min, max, p50, p95 and p99 of p_values
+    QJsonObject summarize(const std::vector<double>& p_values);
+
+    //!< Peak resident memory of the process in kilobytes, -1 if unknown on the platform
+    qint64 peakResidentMemory(void);
+
+    bool writeJson(const QString& p_filepath, const QJsonObject& p_object);
+    bool readJson(const QString& p_filepath, QJsonObject& p_object);
+
+    /**
+     * \brief Compare a report with a baseline report, both of the form { "benchmarks": { name: { metrics } } }
+     * \param p_metrics paths of the compared values in a benchmark, ex. "cpu_ms/p95", a greater value is worse
+     * \param p_tolerance relative increase accepted, ex. 0.1 for 10%
+     * \return one line by regression, the benchmarks absent of one report are skipped
+     */
+    QStringList compareWithBaseline(const QJsonObject& p_report, const QJsonObject& p_baseline, const QStringList& p_metrics, double p_tolerance);
+
+    /**
+     * \brief Read the baseline report p_baselineFilepath, compare p_report with it and log the regressions
+     * \return exit code of the benchmark: 0 without regression, 1 if the baseline cannot be read, 2 on a regression
+     */
+    int checkBaseline(const QJsonObject& p_report, const QString& p_baselineFilepath, const QStringList& p_metrics, double p_tolerance);
+
+}
@@ -0,0 +1,247 @@
+#include "RenderBenchmark.h"
+#include "BenchmarkReport.h"
+
+#include <GLWidgets/CameraSession.h>
+#include <Offscreen/OffscreenRenderer.h>
+#include <Renderers/GlFunctions.h>
+#include <Renderers/Software/SoftwareDualDepthPeelingRenderer.h>
+#include <Renderers/UnorderedTransparency/DualDepthPeelingRenderer.h>
+#include <Renderers/UnorderedTransparency/MultiLayerPeelingRenderer.h>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QMap>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace bench
+{
+
+    //---------------------------------------------------------------------------------------
+    void setOpenGLFromArguments(int p_argc, char* p_argv[])
+    //---------------------------------------------------------------------------------------
+    {
+        if (std::any_of(p_argv + 1, p_argv + p_argc, [](const char* p_arg) { return std::strcmp(p_arg, "--software") == 0; }))
+        {
+            qputenv("LIBGL_ALWAYS_SOFTWARE", "1");
+            QCoreApplication::setAttribute(Qt::AA_UseSoftwareOpenGL, true);
+        }
+        else
+        {
+            QCoreApplication::setAttribute(Qt::AA_UseDesktopOpenGL, true);
+        }
+    }
+
+    //---------------------------------------------------------------------------------------
+    size_t lastPassCount(gui::OffscreenRenderer& p_renderer)
+    //---------------------------------------------------------------------------------------
+    {
+        if (const auto* const renderer{ p_renderer.softwareRenderer() })
+        {
+            return renderer->lastPassCount();
+        }
+        if (const auto* const renderer{ dynamic_cast<gui::gl::DualDepthPeelingRenderer*>(p_renderer.transparencyRenderer()) })
+        {
+            return renderer->lastPassCount();
+        }
+        if (const auto* const renderer{ dynamic_cast<gui::gl::MultiLayerPeelingRenderer*>(p_renderer.transparencyRenderer()) })
+        {
+            return renderer->lastPassCount();
+        }
+        return 0;
+    }
+
+    //---------------------------------------------------------------------------------------
+    size_t lastGeometryPassCount(gui::OffscreenRenderer& p_renderer)
+    //---------------------------------------------------------------------------------------
+    {
+        if (const auto* const renderer{ dynamic_cast<gui::gl::DualDepthPeelingRenderer*>(p_renderer.transparencyRenderer()) })
+        {
+            return renderer->lastGeometryPassCount();
+        }
+        if (const auto* const renderer{ dynamic_cast<gui::gl::MultiLayerPeelingRenderer*>(p_renderer.transparencyRenderer()) })
+        {
+            return renderer->lastGeometryPassCount();
+        }
+        return 0;
+    }
+
+    //---------------------------------------------------------------------------------------
+    bool warmUp(gui::OffscreenRenderer& p_renderer, int p_frameCount)
+    //---------------------------------------------------------------------------------------
+    {
+        for (int i = 0; i < p_frameCount; i++)
+        {
+            if (p_renderer.renderFrame() < 0.)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    //---------------------------------------------------------------------------------------
+    QJsonObject runCameraSession(gui::OffscreenRenderer& p_renderer, const gui::CameraSession& p_session)
+    //---------------------------------------------------------------------------------------
+    {
+        gui::gl::GpuProfiler& profiler{ p_renderer.gpuProfiler() };
+        profiler.setEnable(false); // clear the history of the previous session
+        profiler.setEnable(true);
+
+        std::vector<double> frameTimes;
+        std::vector<double> gpuFrameTimes;
+        std::vector<double> passCounts;
+        std::vector<double> geometryPassCounts;
+        QMap<QString, double> stageTimes;
+
+        // the pass cap and the layers left are read after the frame which has used them
+        const auto* const dualRenderer{ dynamic_cast<gui::gl::DualDepthPeelingRenderer*>(p_renderer.transparencyRenderer()) };
+        const bool isBudgeted{ dualRenderer != nullptr && dualRenderer->frameTimeBudget() > 0. };
+        const bool isUnpeeledCounted{ dualRenderer != nullptr && dualRenderer->isUnpeeledQueryUsed() };
+        const bool isNonStalling{ dualRenderer != nullptr && dualRenderer->isNonStallingQueryUsed() };
+        const size_t firstAvoidedStallCount{ dualRenderer != nullptr ? dualRenderer->avoidedStallCount() : 0 };
+        std::vector<double> passBudgets;
+        std::vector<double> unpeeledCounts;
+        std::vector<double> predictedPassCounts;
+        quint64 lastGpuFrameId{ std::numeric_limits<quint64>::max() };
+        const auto readGpuFrame = [&]()
+        {
+            const gui::gl::GpuProfiler::FrameTiming* const frame{ profiler.lastFrame() };
+            if (frame != nullptr && frame->frameId != lastGpuFrameId)
+            {
+                lastGpuFrameId = frame->frameId;
+                gpuFrameTimes.push_back(frame->time);
+                for (const gui::gl::GpuProfiler::StageTiming& stage : frame->stages)
+                {
+                    stageTimes[stage.name] += stage.time;
+                }
+            }
+        };
+
+#ifdef DEBUG_GL_CALL_COUNTERS
+        // the software engine issues no counted call
+        const bool isCounted{ p_renderer.softwareRenderer() == nullptr };
+        std::vector<std::pair<const char*, std::vector<double>>> glCallCounts{ { "draw_calls", {} }, { "vertices", {} },
+            { "program_binds", {} }, { "texture_binds", {} }, { "framebuffer_binds", {} }, { "uniform_updates", {} },
+            { "buffer_upload_bytes", {} }, { "queries", {} } };
+        QMap<QString, double> stageDrawCalls;
+        const auto readGlCallCounts = [&]()
+        {
+            const gui::gl::GlCallCounters::FrameCount& frame{ gui::gl::GlCallCounters::lastFrame() };
+            const gui::gl::GlCallCounters::Count& total{ frame.total };
+            const quint64 counts[]{ total.drawCalls, total.vertices, total.programBinds, total.textureBinds,
+                total.framebufferBinds, total.uniformUpdates, total.bufferUploadBytes, total.queries };
+            for (size_t i = 0; i < glCallCounts.size(); i++)
+            {
+                glCallCounts[i].second.push_back(static_cast<double>(counts[i]));
+            }
+            for (const gui::gl::GlCallCounters::StageCount& stage : frame.stages)
+            {
+                stageDrawCalls[stage.name] += static_cast<double>(stage.count.drawCalls);
+            }
+        };
+#endif
+
+        p_session.restoreStart(p_renderer.camera());
+        for (const gui::CameraSession::Step& step : p_session.steps())
+        {
+            gui::CameraSession::applyStep(p_renderer.camera(), step);
+            const double frameTime{ p_renderer.renderFrame() };
+            if (frameTime < 0.)
+            {
+                return QJsonObject();
+            }
+            frameTimes.push_back(frameTime);
+            passCounts.push_back(static_cast<double>(lastPassCount(p_renderer)));
+            geometryPassCounts.push_back(static_cast<double>(lastGeometryPassCount(p_renderer)));
+            if (isBudgeted)
+            {
+                passBudgets.push_back(static_cast<double>(dualRenderer->passBudget()));
+            }
+            if (isUnpeeledCounted)
+            {
+                unpeeledCounts.push_back(static_cast<double>(dualRenderer->unpeeledSampleCount()));
+            }
+            if (isNonStalling)
+            {
+                predictedPassCounts.push_back(static_cast<double>(dualRenderer->predictedPassCount()));
+            }
+            readGpuFrame();
+#ifdef DEBUG_GL_CALL_COUNTERS
+            if (isCounted)
+            {
+                readGlCallCounts();
+            }
+#endif
+        }
+        p_renderer.flushGpuProfiler();
+        readGpuFrame();
+
+        QJsonObject stages;
+        for (auto it = stageTimes.constBegin(); it != stageTimes.constEnd(); ++it)
+        {
+            stages.insert(it.key(), it.value() / static_cast<double>(std::max<size_t>(gpuFrameTimes.size(), 1)));
+        }
+
+        QJsonObject result{
+            { "frames", static_cast<qint64>(frameTimes.size()) },
+            { "cpu_ms", summarize(frameTimes) },
+            { "gpu_ms", summarize(gpuFrameTimes) },
+            { "gpu_stages_ms", stages },
+            { "passes", summarize(passCounts) },
+            { "geometry_passes", summarize(geometryPassCounts) },
+            { "dropped_gpu_frames", static_cast<qint64>(profiler.droppedFrameCount()) },
+            { "peak_rss_kb", peakResidentMemory() }
+        };
+
+        if (dualRenderer != nullptr)
+        {
+            QJsonObject dualDepthPeeling;
+            if (isBudgeted)
+            {
+                dualDepthPeeling.insert("budget_ms", dualRenderer->frameTimeBudget());
+                dualDepthPeeling.insert("pass_budget", summarize(passBudgets));
+            }
+            if (isUnpeeledCounted)
+            {
+                dualDepthPeeling.insert("unpeeled_pixels", summarize(unpeeledCounts));
+            }
+            if (isNonStalling)
+            {
+                // a stall of the synchronous readback is counted by pass
+                const size_t avoidedStallCount{ dualRenderer->avoidedStallCount() - firstAvoidedStallCount };
+                dualDepthPeeling.insert("avoided_stalls", static_cast<qint64>(avoidedStallCount));
+                dualDepthPeeling.insert("avoided_stalls_by_frame", static_cast<double>(avoidedStallCount) / static_cast<double>(std::max<size_t>(frameTimes.size(), 1)));
+                dualDepthPeeling.insert("predicted_passes", summarize(predictedPassCounts));
+            }
+            if (!dualDepthPeeling.isEmpty())
+            {
+                result.insert("dual_depth_peeling", dualDepthPeeling);
+            }
+        }
+
+#ifdef DEBUG_GL_CALL_COUNTERS
+        if (isCounted)
+        {
+            QJsonObject glCalls;
+            for (const auto& [name, counts] : glCallCounts)
+            {
+                glCalls.insert(name, summarize(counts));
+            }
+            QJsonObject stageDraws;
+            for (auto it = stageDrawCalls.constBegin(); it != stageDrawCalls.constEnd(); ++it)
+            {
+                stageDraws.insert(it.key(), it.value() / static_cast<double>(std::max<size_t>(frameTimes.size(), 1)));
+            }
+            glCalls.insert("stage_draw_calls", stageDraws);
+            result.insert("gl_calls", glCalls);
+        }
+#endif
+
+        return result;
+    }
+
+}
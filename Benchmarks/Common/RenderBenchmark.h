@@ -0,0 +1,40 @@
+#pragma once
+
+#include <QtCore/QJsonObject>
+
+#include <cstddef>
+
+namespace gui
+{
+    class CameraSession;
+    class OffscreenRenderer;
+}
+
+namespace bench
+{
+
+    //!< Read before the OpenGL library is loaded: --software selects Mesa llvmpipe, desktop OpenGL otherwise
+    void setOpenGLFromArguments(int p_argc, char* p_argv[]);
+
+    //!< Pass count of the engines which peel at the last frame, 0 for the others
+    size_t lastPassCount(gui::OffscreenRenderer& p_renderer);
+    //!< Geometry passes of the GL peeling engines at the last frame, initialization included, 0 for the others.
+    //!< The cost to compare between dual depth peeling (one by peel pass) and multi-layer peeling (two by peel pass)
+    size_t lastGeometryPassCount(gui::OffscreenRenderer& p_renderer);
+
+    //!< Shader compilation and first allocations of the current engine, not measured
+    bool warmUp(gui::OffscreenRenderer& p_renderer, int p_frameCount = 2);
+
+    /**
+     * \brief Replay p_session from its start view, one step by frame
+     * \return frames, cpu_ms and gpu_ms (summarize), gpu_stages_ms (mean by frame), passes, geometry_passes, dropped_gpu_frames and peak_rss_kb,
+     * empty on error. With the GL call counters (debug and GL_CALL_COUNTERS), gl_calls: the counts of GlCallCounters by
+     * frame (summarize) and the mean draw calls of each stage, absent for the software engine.
+     * For dual depth peeling, dual_depth_peeling: with a frame time budget its budget_ms and the pass cap by frame
+     * (pass_budget, to check against gpu_ms and passes), with the quality indicator the pixels with layers left by frame
+     * (unpeeled_pixels), with the non stalling queries the passes whose synchronous readback would have stalled the CPU
+     * (avoided_stalls, avoided_stalls_by_frame, to read with cpu_ms) and the predicted pass count by frame (predicted_passes)
+     */
+    QJsonObject runCameraSession(gui::OffscreenRenderer& p_renderer, const gui::CameraSession& p_session);
+
+}
@@ -0,0 +1,30 @@
+# Shared by the rendering benchmarks: offscreen renderer of the Gui library and camera path replay
+
+include(Benchmark.pri)
+
+QT += gui concurrent
+
+INCLUDEPATH += \
+    $$PWD/../../DataModel \
+    $$PWD/../../Gui
+
+HEADERS += \
+    $$PWD/RenderBenchmark.h
+
+SOURCES += \
+    $$PWD/RenderBenchmark.cpp
+
+# same renderer headers as the debug Gui library: runCameraSession() reports the GL call counts
+build_pass:CONFIG(debug, debug|release): DEFINES += GL_CALL_COUNTERS
+
+build_pass:CONFIG(debug, debug|release):CONFIGURATION = debug
+else:build_pass:CONFIG(release, debug|release):CONFIGURATION = release
+
+LIBS += \
+    -L$$OUT_PWD/../../Gui -L$$OUT_PWD/../../Gui/$${CONFIGURATION} -lGui \
+    -L$$OUT_PWD/../../DataModel -L$$OUT_PWD/../../DataModel/$${CONFIGURATION} -lDataModel
+
+!win32-msvc {
+    RESOURCES += \
+        $$PWD/../../App/Resources/Resources.qrc
+}
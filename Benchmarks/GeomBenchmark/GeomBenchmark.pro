@@ -0,0 +1,26 @@
+TARGET = GeomBenchmark
+TEMPLATE = app
+
+QT = core concurrent
+
+CONFIG += console debug_and_release c++17
+CONFIG -= app_bundle
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+include(../Common/Benchmark.pri)
+
+INCLUDEPATH += \
+    ../../DataModel
+
+HEADERS += \
+    GeomTypes.h
+
+SOURCES += \
+    main.cpp
+
+build_pass:CONFIG(debug, debug|release):CONFIGURATION = debug
+else:build_pass:CONFIG(release, debug|release):CONFIGURATION = release
+
+LIBS += \
+    -L$$OUT_PWD/../../DataModel -L$$OUT_PWD/../../DataModel/$${CONFIGURATION} -lDataModel
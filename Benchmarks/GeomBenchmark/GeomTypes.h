@@ -0,0 +1,122 @@
+#pragma once
+
+#include <Geom/Plane.h>
+#include <Geom/Point.h>
+#include <Geom/Vector.h>
+
+#include <cmath>
+
+namespace bench
+{
+
+    /**
+     * The operations of the benchmark on a family of geometry types: the geom library, and plain structs of three
+     * components used as references (same formulas, no homogeneous component, no checks).
+     * A family defines Point, Vector and Plane, and the static functions below.
+     */
+
+    //!< geom::Point, geom::Vector and geom::Plane backed by a double Vec4
+    struct GeomTypes
+    {
+        using Point = geom::Point;
+        using Vector = geom::Vector;
+        using Plane = geom::Plane;
+
+        static inline Point point(double p_x, double p_y, double p_z) { return Point(p_x, p_y, p_z); }
+        static inline Vector vector(double p_x, double p_y, double p_z) { return Vector(p_x, p_y, p_z); }
+        static inline Plane plane(const Vector& p_normal, const Point& p_point) { return Plane(p_normal, p_point); }
+
+        static inline Vector addScaled(const Vector& p_a, const Vector& p_b, double p_factor) { return p_a + p_b * p_factor; }
+        static inline double dot(const Vector& p_a, const Vector& p_b) { return p_a * p_b; }
+        static inline Vector cross(const Vector& p_a, const Vector& p_b) { return p_a ^ p_b; }
+        static inline Vector normalized(const Vector& p_vector) { return p_vector.normalized(); }
+        static inline double distance(const Point& p_a, const Point& p_b) { return p_a.distance(p_b); }
+        static inline Point project(const Plane& p_plane, const Point& p_point) { return p_plane.project(p_point); }
+        static inline void getBase(const Plane& p_plane, Vector& p_i, Vector& p_j) { p_plane.getBase(p_i, p_j); }
+        static inline double signedDistance(const Plane& p_plane, const Point& p_point)
+        {
+            return p_plane.a() * p_point.x() + p_plane.b() * p_point.y() + p_plane.c() * p_point.z() + p_plane.d();
+        }
+
+        template <typename T>
+        static inline double checksum(const T& p_value) { return p_value.x() + p_value.y() + p_value.z(); }
+    };
+
+    //!< Three components of type T, the plane is normalized at construction as geom::Plane
+    template <typename T>
+    struct PlainTypes
+    {
+        struct Point { T x, y, z; };
+        struct Vector { T x, y, z; };
+        struct Plane { T a, b, c, d; };
+
+        static inline Point point(double p_x, double p_y, double p_z) { return { static_cast<T>(p_x), static_cast<T>(p_y), static_cast<T>(p_z) }; }
+        static inline Vector vector(double p_x, double p_y, double p_z) { return { static_cast<T>(p_x), static_cast<T>(p_y), static_cast<T>(p_z) }; }
+        static inline Plane plane(const Vector& p_normal, const Point& p_point)
+        {
+            const T invLength{ T(1) / std::sqrt(dot(p_normal, p_normal)) };
+            const Vector normal{ p_normal.x * invLength, p_normal.y * invLength, p_normal.z * invLength };
+            return { normal.x, normal.y, normal.z, -(normal.x * p_point.x + normal.y * p_point.y + normal.z * p_point.z) };
+        }
+
+        static inline Vector addScaled(const Vector& p_a, const Vector& p_b, double p_factor)
+        {
+            const T factor{ static_cast<T>(p_factor) };
+            return { p_a.x + p_b.x * factor, p_a.y + p_b.y * factor, p_a.z + p_b.z * factor };
+        }
+        static inline T dot(const Vector& p_a, const Vector& p_b) { return p_a.x * p_b.x + p_a.y * p_b.y + p_a.z * p_b.z; }
+        static inline Vector cross(const Vector& p_a, const Vector& p_b)
+        {
+            return { p_a.y * p_b.z - p_a.z * p_b.y, p_a.z * p_b.x - p_a.x * p_b.z, p_a.x * p_b.y - p_a.y * p_b.x };
+        }
+        static inline Vector normalized(const Vector& p_vector)
+        {
+            const T length{ std::sqrt(dot(p_vector, p_vector)) };
+            if (length == T(0))
+            {
+                return p_vector;
+            }
+            const T invLength{ T(1) / length };
+            return { p_vector.x * invLength, p_vector.y * invLength, p_vector.z * invLength };
+        }
+        static inline T distance(const Point& p_a, const Point& p_b)
+        {
+            const Vector difference{ p_a.x - p_b.x, p_a.y - p_b.y, p_a.z - p_b.z };
+            return std::sqrt(dot(difference, difference));
+        }
+        static inline T signedDistance(const Plane& p_plane, const Point& p_point)
+        {
+            return p_plane.a * p_point.x + p_plane.b * p_point.y + p_plane.c * p_point.z + p_plane.d;
+        }
+        static inline Point project(const Plane& p_plane, const Point& p_point)
+        {
+            const T distance{ signedDistance(p_plane, p_point) };
+            return { p_point.x - distance * p_plane.a, p_point.y - distance * p_plane.b, p_point.z - distance * p_plane.c };
+        }
+        static inline void getBase(const Plane& p_plane, Vector& p_i, Vector& p_j)
+        {
+            // as geom::Plane::getBase: the longest projection of the axes, then normal ^ i
+            const Vector normal{ p_plane.a, p_plane.b, p_plane.c };
+            const Vector axes[3]{ { T(1), T(0), T(0) }, { T(0), T(1), T(0) }, { T(0), T(0), T(1) } };
+            Vector longest{};
+            T longestLength{ T(-1) };
+            for (const Vector& axis : axes)
+            {
+                const T projection{ dot(normal, axis) };
+                const Vector projected{ axis.x - projection * normal.x, axis.y - projection * normal.y, axis.z - projection * normal.z };
+                const T length{ dot(projected, projected) };
+                if (longestLength < length)
+                {
+                    longest = projected;
+                    longestLength = length;
+                }
+            }
+            p_i = normalized(longest);
+            p_j = cross(normal, p_i);
+        }
+
+        template <typename U>
+        static inline double checksum(const U& p_value) { return static_cast<double>(p_value.x) + p_value.y + p_value.z; }
+    };
+
+}
@@ -0,0 +1,437 @@
+#include "BenchmarkReport.h"
+#include "GeomTypes.h"
+
+#include <Geom/Batch.h>
+
+#include <QtCore/QCommandLineParser>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDebug>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QRegularExpression>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+// Microbenchmarks of the geom library over large arrays, reported as JSON in ns by operation and millions of
+// operations by second. Each operation is also run on plain structs of three doubles and three floats, the
+// references of what the layout of the types costs. The checksums of the outputs keep the compiler from
+// removing the loops and allow to check that the variants compute the same values.
+// The batch operations of geom::batch are compared with loops of the same operations on single objects.
+
+namespace
+{
+    //!< Random coordinates shared by the variants
+    struct Inputs
+    {
+        std::vector<double> x, y, z;        // points and first vectors
+        std::vector<double> u, v, w;        // second vectors and plane normals
+    };
+
+    static Inputs makeInputs(size_t p_count, unsigned int p_seed)
+    {
+        std::mt19937 generator(p_seed);
+        std::uniform_real_distribution<double> distribution(-100., 100.);
+        Inputs inputs;
+        for (std::vector<double>* values : { &inputs.x, &inputs.y, &inputs.z, &inputs.u, &inputs.v, &inputs.w })
+        {
+            values->resize(p_count);
+            for (double& value : *values)
+            {
+                value = distribution(generator);
+            }
+        }
+        return inputs;
+    }
+
+    class GeomBenchmark
+    {
+    public:
+        explicit GeomBenchmark(const Inputs& p_inputs, int p_repeatCount, const QRegularExpression& p_filter)
+            : m_inputs(p_inputs)
+            , m_repeatCount(p_repeatCount)
+            , m_filter(p_filter)
+            , m_sink(0.)
+        {
+        }
+
+        inline const QJsonObject& results(void) const { return m_results; }
+        inline double sink(void) const { return m_sink; }
+
+        template <typename Types>
+        void run(const QString& p_variant)
+        {
+            using Point = typename Types::Point;
+            using Vector = typename Types::Vector;
+            using Plane = typename Types::Plane;
+
+            const Inputs& in{ m_inputs };
+            const size_t count{ in.x.size() };
+            std::vector<Point> points(count), outPoints(count);
+            std::vector<Vector> vectors(count), others(count), outVectors(count), outOthers(count);
+            std::vector<Plane> planes(count);
+            for (size_t i = 0; i < count; i++)
+            {
+                points[i] = Types::point(in.x[i], in.y[i], in.z[i]);
+                vectors[i] = Types::vector(in.x[i], in.y[i], in.z[i]);
+                others[i] = Types::vector(in.u[i], in.v[i], in.w[i]);
+                planes[i] = Types::plane(others[i], points[i]);
+            }
+            const Point query{ Types::point(1., 2., 3.) };
+            const Plane plane{ Types::plane(Types::vector(1., 2., 3.), query) };
+            std::vector<double> values(count);
+
+            const auto sumOf = [count](const auto& p_array)
+            {
+                double sum{ 0. };
+                for (size_t i = 0; i < count; i++)
+                {
+                    sum += Types::checksum(p_array[i]);
+                }
+                return sum;
+            };
+            const auto sumOfValues = [&values]()
+            {
+                double sum{ 0. };
+                for (const double value : values)
+                {
+                    sum += value;
+                }
+                return sum;
+            };
+
+            measure(p_variant, "construct", [&]()
+            {
+                for (size_t i = 0; i < count; i++)
+                {
+                    outPoints[i] = Types::point(in.x[i], in.y[i], in.z[i]);
+                }
+            }, [&]() { return sumOf(outPoints); });
+            measure(p_variant, "copy", [&]()
+            {
+                for (size_t i = 0; i < count; i++)
+                {
+                    outPoints[i] = points[i];
+                }
+            }, [&]() { return sumOf(outPoints); });
+            measure(p_variant, "add_scaled", [&]()
+            {
+                for (size_t i = 0; i < count; i++)
+                {
+                    outVectors[i] = Types::addScaled(vectors[i], others[i], 0.5);
+                }
+            }, [&]() { return sumOf(outVectors); });
+            measure(p_variant, "dot", [&]()
+            {
+                for (size_t i = 0; i < count; i++)
+                {
+                    values[i] = static_cast<double>(Types::dot(vectors[i], others[i]));
+                }
+            }, sumOfValues);
+            measure(p_variant, "cross", [&]()
+            {
+                for (size_t i = 0; i < count; i++)
+                {
+                    outVectors[i] = Types::cross(vectors[i], others[i]);
+                }
+            }, [&]() { return sumOf(outVectors); });
+            measure(p_variant, "normalize", [&]()
+            {
+                for (size_t i = 0; i < count; i++)
+                {
+                    outVectors[i] = Types::normalized(vectors[i]);
+                }
+            }, [&]() { return sumOf(outVectors); });
+            measure(p_variant, "point_distance", [&]()
+            {
+                for (size_t i = 0; i < count; i++)
+                {
+                    values[i] = static_cast<double>(Types::distance(points[i], query));
+                }
+            }, sumOfValues);
+            measure(p_variant, "plane_distance", [&]()
+            {
+                for (size_t i = 0; i < count; i++)
+                {
+                    values[i] = static_cast<double>(Types::signedDistance(plane, points[i]));
+                }
+            }, sumOfValues);
+            measure(p_variant, "plane_project", [&]()
+            {
+                for (size_t i = 0; i < count; i++)
+                {
+                    outPoints[i] = Types::project(plane, points[i]);
+                }
+            }, [&]() { return sumOf(outPoints); });
+            measure(p_variant, "plane_get_base", [&]()
+            {
+                for (size_t i = 0; i < count; i++)
+                {
+                    Types::getBase(planes[i], outVectors[i], outOthers[i]);
+                }
+            }, [&]() { return sumOf(outVectors) + sumOf(outOthers); });
+        }
+
+        void runBatch(void)
+        {
+            const Inputs& in{ m_inputs };
+            const size_t count{ in.x.size() };
+            std::vector<geom::Point> points(count), outPoints(count);
+            for (size_t i = 0; i < count; i++)
+            {
+                points[i] = geom::Point(in.x[i], in.y[i], in.z[i]);
+            }
+            std::vector<int> indices(3 * count);
+            for (size_t i = 0; i < indices.size(); i++)
+            {
+                indices[i] = static_cast<int>((i * 7919) % count); // scattered vertices, as in a mesh
+            }
+            const size_t triangleCount{ count };
+            std::vector<geom::Vector> normals(triangleCount);
+            std::vector<double> values(count);
+            std::vector<quint32> masks(count);
+
+            // translation, rotation of 30 degrees around z and scaling, column-major
+            const double cosine{ std::sqrt(3.) / 2. }, sine{ 0.5 };
+            const double matrix[16]{ 2. * cosine, 2. * sine, 0., 0., -2. * sine, 2. * cosine, 0., 0., 0., 0., 2., 0., 1., 2., 3., 1. };
+            const geom::Plane plane(geom::Vector(1., 2., 3.), geom::Point(1., 2., 3.));
+            // a box of 6 planes oriented inwards
+            const geom::Plane planes[6]{ { 1., 0., 0., 50. }, { -1., 0., 0., 50. }, { 0., 1., 0., 50. }, { 0., -1., 0., 50. }, { 0., 0., 1., 50. }, { 0., 0., -1., 50. } };
+
+            const auto sumOfPoints = [&outPoints]()
+            {
+                double sum{ 0. };
+                for (const geom::Point& point : outPoints)
+                {
+                    sum += bench::GeomTypes::checksum(point);
+                }
+                return sum;
+            };
+            const auto sumOfNormals = [&normals]()
+            {
+                double sum{ 0. };
+                for (const geom::Vector& normal : normals)
+                {
+                    sum += bench::GeomTypes::checksum(normal);
+                }
+                return sum;
+            };
+            const auto sumOfValues = [&values]()
+            {
+                double sum{ 0. };
+                for (const double value : values)
+                {
+                    sum += value;
+                }
+                return sum;
+            };
+            const auto sumOfMasks = [&masks]()
+            {
+                double sum{ 0. };
+                for (const quint32 mask : masks)
+                {
+                    sum += mask;
+                }
+                return sum;
+            };
+            geom::Point boundsMin, boundsMax;
+            const auto sumOfBounds = [&boundsMin, &boundsMax]() { return bench::GeomTypes::checksum(boundsMin) + bench::GeomTypes::checksum(boundsMax); };
+
+            measure("geom_loop", "transform", [&]()
+            {
+                for (size_t i = 0; i < count; i++)
+                {
+                    const geom::Point& p{ points[i] };
+                    outPoints[i] = geom::Point(matrix[0] * p.x() + matrix[4] * p.y() + matrix[8] * p.z() + matrix[12],
+                        matrix[1] * p.x() + matrix[5] * p.y() + matrix[9] * p.z() + matrix[13],
+                        matrix[2] * p.x() + matrix[6] * p.y() + matrix[10] * p.z() + matrix[14]);
+                }
+            }, sumOfPoints);
+            measure("geom_batch", "transform", [&]() { geom::batch::transform(matrix, points.data(), count, outPoints.data()); }, sumOfPoints);
+
+            measure("geom_loop", "bounds", [&]()
+            {
+                boundsMin = points.front();
+                boundsMax = points.front();
+                for (const geom::Point& p : points)
+                {
+                    boundsMin = geom::Point(std::min(boundsMin.x(), p.x()), std::min(boundsMin.y(), p.y()), std::min(boundsMin.z(), p.z()));
+                    boundsMax = geom::Point(std::max(boundsMax.x(), p.x()), std::max(boundsMax.y(), p.y()), std::max(boundsMax.z(), p.z()));
+                }
+            }, sumOfBounds);
+            measure("geom_batch", "bounds", [&]() { geom::batch::bounds(points.data(), count, boundsMin, boundsMax); }, sumOfBounds);
+
+            measure("geom_loop", "plane_project", [&]()
+            {
+                for (size_t i = 0; i < count; i++)
+                {
+                    outPoints[i] = plane.project(points[i]);
+                }
+            }, sumOfPoints);
+            measure("geom_batch", "plane_project", [&]() { geom::batch::project(plane, points.data(), count, outPoints.data()); }, sumOfPoints);
+
+            measure("geom_batch", "plane_distance", [&]() { geom::batch::signedDistances(plane, points.data(), count, values.data()); }, sumOfValues);
+
+            measure("geom_loop", "classify_6_planes", [&]()
+            {
+                for (size_t i = 0; i < count; i++)
+                {
+                    quint32 mask{ 0 };
+                    for (quint32 k = 0; k < 6; k++)
+                    {
+                        if (bench::GeomTypes::signedDistance(planes[k], points[i]) < 0.)
+                        {
+                            mask |= 1u << k;
+                        }
+                    }
+                    masks[i] = mask;
+                }
+            }, sumOfMasks);
+            measure("geom_batch", "classify_6_planes", [&]() { geom::batch::classify(planes, 6, points.data(), count, masks.data()); }, sumOfMasks);
+
+            measure("geom_loop", "triangle_normals", [&]()
+            {
+                for (size_t i = 0; i < triangleCount; i++)
+                {
+                    const geom::Point& a{ points[static_cast<size_t>(indices[3 * i])] };
+                    const geom::Point& b{ points[static_cast<size_t>(indices[3 * i + 1])] };
+                    const geom::Point& c{ points[static_cast<size_t>(indices[3 * i + 2])] };
+                    normals[i] = (geom::Vector(b - a) ^ geom::Vector(c - a)).normalized();
+                }
+            }, sumOfNormals);
+            measure("geom_batch", "triangle_normals", [&]() { geom::batch::triangleNormals(points.data(), indices.data(), triangleCount, normals.data()); }, sumOfNormals);
+
+            // small objects culled by the frustum of an orthographic camera viewing the cube [-50, 50]^3
+            const double projection[16]{ 0.02, 0., 0., 0., 0., 0.02, 0., 0., 0., 0., 0.02, 0., 0., 0., 0., 1. };
+            const geom::Frustum frustum(projection);
+            std::vector<geom::AABB> boxes(count);
+            std::vector<geom::Sphere> spheres(count);
+            for (size_t i = 0; i < count; i++)
+            {
+                boxes[i] = geom::AABB(points[i], points[i].add(5., 5., 5.));
+                spheres[i] = boxes[i].boundingSphere();
+            }
+            std::vector<geom::Frustum::Intersection> intersections(count);
+            const auto sumOfIntersections = [&intersections]()
+            {
+                double sum{ 0. };
+                for (const geom::Frustum::Intersection intersection : intersections)
+                {
+                    sum += static_cast<double>(intersection);
+                }
+                return sum;
+            };
+
+            measure("geom_loop", "frustum_boxes", [&]()
+            {
+                for (size_t i = 0; i < count; i++)
+                {
+                    intersections[i] = frustum.intersects(boxes[i]);
+                }
+            }, sumOfIntersections);
+            measure("geom_batch", "frustum_boxes", [&]() { geom::batch::intersects(frustum, boxes.data(), count, intersections.data()); }, sumOfIntersections);
+
+            measure("geom_loop", "frustum_spheres", [&]()
+            {
+                for (size_t i = 0; i < count; i++)
+                {
+                    intersections[i] = frustum.intersects(spheres[i]);
+                }
+            }, sumOfIntersections);
+            measure("geom_batch", "frustum_spheres", [&]() { geom::batch::intersects(frustum, spheres.data(), count, intersections.data()); }, sumOfIntersections);
+        }
+
+    private:
+        template <typename Kernel, typename Checksum>
+        void measure(const QString& p_variant, const QString& p_operation, Kernel p_kernel, Checksum p_checksum)
+        {
+            const QString name{ QString("%1/%2").arg(p_variant, p_operation) };
+            if (!m_filter.match(name).hasMatch())
+            {
+                return;
+            }
+
+            p_kernel(); // warm up: caches and page faults of the outputs
+            std::vector<double> nsPerOperation;
+            const double count{ static_cast<double>(m_inputs.x.size()) };
+            for (int repeat = 0; repeat < m_repeatCount; repeat++)
+            {
+                QElapsedTimer timer;
+                timer.start();
+                p_kernel();
+                nsPerOperation.push_back(static_cast<double>(timer.nsecsElapsed()) / count);
+            }
+            const double checksum{ p_checksum() };
+            m_sink += checksum;
+
+            const double medianTime{ bench::percentile(nsPerOperation, 0.5) };
+            m_results.insert(name, QJsonObject{
+                { "ns_per_op", bench::summarize(nsPerOperation) },
+                { "mops_per_s", medianTime > 0. ? 1e3 / medianTime : 0. },
+                { "checksum", checksum }
+            });
+            qInfo().noquote() << QString("%1: %2 ns/op, %3 Mop/s").arg(name, -30).arg(medianTime, 0, 'f', 3).arg(medianTime > 0. ? 1e3 / medianTime : 0., 0, 'f', 1);
+        }
+
+        const Inputs& m_inputs;
+        const int m_repeatCount;
+        const QRegularExpression m_filter;
+        QJsonObject m_results;
+        double m_sink;
+    };
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication a(argc, argv);
+    QCoreApplication::setApplicationName("GeomBenchmark");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Microbenchmarks of the geom library over large arrays");
+    parser.addHelpOption();
+    const QCommandLineOption countOption("count", "Elements of the arrays.", "count", "1048576");
+    const QCommandLineOption repeatsOption("repeats", "Measured runs of each operation over the arrays.", "count", "15");
+    const QCommandLineOption filterOption("filter", "Regular expression of the run benchmarks, as variant/operation (ex. geom/).", "regexp", ".*");
+    const QCommandLineOption seedOption("seed", "Seed of the random inputs.", "seed", "1");
+    const QCommandLineOption outputOption("output", "JSON report.", "file", "geom_benchmark.json");
+    const QCommandLineOption baselineOption("baseline", "JSON report to compare with, the exit code is 2 on a regression.", "file");
+    const QCommandLineOption toleranceOption("tolerance", "Accepted relative increase of the median times.", "ratio", "0.1");
+    parser.addOptions({ countOption, repeatsOption, filterOption, seedOption, outputOption, baselineOption, toleranceOption });
+    parser.process(a);
+
+    const int count{ parser.value(countOption).toInt() };
+    const int repeatCount{ parser.value(repeatsOption).toInt() };
+    const QRegularExpression filter(parser.value(filterOption));
+    if (count <= 0 || repeatCount <= 0 || !filter.isValid())
+    {
+        qCritical() << "Invalid arguments";
+        parser.showHelp(1);
+    }
+
+    qInfo() << "geom SIMD path:" << geom::simd::instructionSet();
+    const Inputs inputs{ makeInputs(static_cast<size_t>(count), parser.value(seedOption).toUInt()) };
+    GeomBenchmark benchmark(inputs, repeatCount, filter);
+    benchmark.run<bench::GeomTypes>("geom");
+    benchmark.runBatch();
+    benchmark.run<bench::PlainTypes<double>>("double3");
+    benchmark.run<bench::PlainTypes<float>>("float3");
+
+    const QJsonObject report{
+        { "count", count },
+        { "repeats", repeatCount },
+        { "geom_simd", geom::simd::instructionSet() },
+        { "sink", benchmark.sink() },
+        { "benchmarks", benchmark.results() }
+    };
+    if (!bench::writeJson(parser.value(outputOption), report))
+    {
+        return 1;
+    }
+
+    if (parser.isSet(baselineOption))
+    {
+        return bench::checkBaseline(report, parser.value(baselineOption), { "ns_per_op/p50" }, parser.value(toleranceOption).toDouble());
+    }
+
+    return 0;
+}
@@ -0,0 +1,185 @@
+#include "AllocationCounter.h"
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+
+// the glibc allocator stays the one of the process, the replaced functions only count its calls:
+// memory allocated before main or by libraries is released by the same heap
+extern "C"
+{
+    void* __libc_malloc(size_t p_size);
+    void* __libc_calloc(size_t p_count, size_t p_size);
+    void* __libc_realloc(void* p_pointer, size_t p_size);
+    void* __libc_memalign(size_t p_alignment, size_t p_size);
+    void* __libc_valloc(size_t p_size);
+    void* __libc_pvalloc(size_t p_size);
+    void __libc_free(void* p_pointer);
+}
+#endif
+
+namespace
+{
+    static std::atomic<qint64> s_allocations{ 0 };
+    static std::atomic<qint64> s_frees{ 0 };
+    static std::atomic<qint64> s_allocatedBytes{ 0 };
+    static std::atomic<qint64> s_liveBytes{ 0 };
+    static std::atomic<qint64> s_peakLiveBytes{ 0 };
+    static std::atomic<qint64> s_resetLiveBytes{ 0 };
+
+#if defined(__GLIBC__)
+    static void countAllocation(void* p_pointer)
+    {
+        if (p_pointer == nullptr)
+        {
+            return;
+        }
+
+        const qint64 size{ static_cast<qint64>(malloc_usable_size(p_pointer)) };
+        s_allocations.fetch_add(1, std::memory_order_relaxed);
+        s_allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+        const qint64 liveBytes{ s_liveBytes.fetch_add(size, std::memory_order_relaxed) + size };
+        qint64 peakLiveBytes{ s_peakLiveBytes.load(std::memory_order_relaxed) };
+        while (liveBytes > peakLiveBytes && !s_peakLiveBytes.compare_exchange_weak(peakLiveBytes, liveBytes, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    static void countFree(void* p_pointer)
+    {
+        if (p_pointer == nullptr)
+        {
+            return;
+        }
+
+        s_frees.fetch_add(1, std::memory_order_relaxed);
+        s_liveBytes.fetch_sub(static_cast<qint64>(malloc_usable_size(p_pointer)), std::memory_order_relaxed);
+    }
+#endif
+}
+
+#if defined(__GLIBC__)
+extern "C"
+{
+    void* malloc(size_t p_size)
+    {
+        void* const pointer{ __libc_malloc(p_size) };
+        countAllocation(pointer);
+        return pointer;
+    }
+
+    void* calloc(size_t p_count, size_t p_size)
+    {
+        void* const pointer{ __libc_calloc(p_count, p_size) };
+        countAllocation(pointer);
+        return pointer;
+    }
+
+    void* realloc(void* p_pointer, size_t p_size)
+    {
+        const qint64 previousSize{ p_pointer != nullptr ? static_cast<qint64>(malloc_usable_size(p_pointer)) : 0 };
+        void* const pointer{ __libc_realloc(p_pointer, p_size) };
+        if (pointer != nullptr || p_size == 0)
+        {
+            // a realloc is counted as an allocation and a free, the moved bytes are part of the cost of growing containers
+            if (p_pointer != nullptr)
+            {
+                s_frees.fetch_add(1, std::memory_order_relaxed);
+                s_liveBytes.fetch_sub(previousSize, std::memory_order_relaxed);
+            }
+            countAllocation(pointer);
+        }
+        return pointer;
+    }
+
+    void* memalign(size_t p_alignment, size_t p_size)
+    {
+        void* const pointer{ __libc_memalign(p_alignment, p_size) };
+        countAllocation(pointer);
+        return pointer;
+    }
+
+    void* valloc(size_t p_size)
+    {
+        void* const pointer{ __libc_valloc(p_size) };
+        countAllocation(pointer);
+        return pointer;
+    }
+
+    void* pvalloc(size_t p_size)
+    {
+        void* const pointer{ __libc_pvalloc(p_size) };
+        countAllocation(pointer);
+        return pointer;
+    }
+
+    void* aligned_alloc(size_t p_alignment, size_t p_size)
+    {
+        return memalign(p_alignment, p_size);
+    }
+
+    int posix_memalign(void** p_pointer, size_t p_alignment, size_t p_size)
+    {
+        if (p_alignment < sizeof(void*) || (p_alignment & (p_alignment - 1)) != 0)
+        {
+            return EINVAL;
+        }
+        void* const pointer{ memalign(p_alignment, p_size) };
+        if (pointer == nullptr && p_size != 0)
+        {
+            return ENOMEM;
+        }
+        *p_pointer = pointer;
+        return 0;
+    }
+
+    void free(void* p_pointer)
+    {
+        countFree(p_pointer);
+        __libc_free(p_pointer);
+    }
+}
+#endif
+
+namespace bench
+{
+
+    //---------------------------------------------------------------------------------------
+    bool isAllocationCountAvailable(void)
+    //---------------------------------------------------------------------------------------
+    {
+#if defined(__GLIBC__)
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    //---------------------------------------------------------------------------------------
+    void resetAllocationCount(void)
+    //---------------------------------------------------------------------------------------
+    {
+        const qint64 liveBytes{ s_liveBytes.load() };
+        s_allocations = 0;
+        s_frees = 0;
+        s_allocatedBytes = 0;
+        s_resetLiveBytes = liveBytes;
+        s_peakLiveBytes = liveBytes;
+    }
+
+    //---------------------------------------------------------------------------------------
+    AllocationCount allocationCount(void)
+    //---------------------------------------------------------------------------------------
+    {
+        AllocationCount count;
+        count.allocations = s_allocations.load();
+        count.frees = s_frees.load();
+        count.allocatedBytes = s_allocatedBytes.load();
+        count.peakLiveBytes = s_peakLiveBytes.load() - s_resetLiveBytes.load();
+        return count;
+    }
+
+}
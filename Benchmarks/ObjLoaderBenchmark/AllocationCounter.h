@@ -0,0 +1,22 @@
+#pragma once
+
+#include <QtCore/QtGlobal>
+
+namespace bench
+{
+
+    //!< Heap activity of the process since resetAllocationCount()
+    struct AllocationCount
+    {
+        qint64 allocations = 0; //!< malloc, calloc, realloc, valloc and aligned allocations
+        qint64 frees = 0;
+        qint64 allocatedBytes = 0; //!< usable size of the allocations
+        qint64 peakLiveBytes = 0; //!< most bytes allocated and not freed at the same time, above the live bytes at reset
+    };
+
+    //!< The malloc family is replaced to count the allocations of Qt containers too, only with glibc
+    bool isAllocationCountAvailable(void);
+    void resetAllocationCount(void);
+    AllocationCount allocationCount(void);
+
+}
@@ -0,0 +1,237 @@
+#include "ObjCorpus.h"
+
+#include <QtCore/QByteArray>
+#include <QtCore/QDebug>
+#include <QtCore/QFile>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <initializer_list>
+
+namespace
+{
+    static constexpr int BUFFER_SIZE{ 1 << 20 };
+    static constexpr double WAVE_HEIGHT{ 2. };
+    static constexpr double WAVE_FREQUENCY{ 0.1 };
+
+    static const std::initializer_list<bench::ObjCorpus::Variant> VARIANTS{
+        bench::ObjCorpus::Variant::PLAIN, bench::ObjCorpus::Variant::NORMALS, bench::ObjCorpus::Variant::TEXTURED,
+        bench::ObjCorpus::Variant::QUADS, bench::ObjCorpus::Variant::NEGATIVE, bench::ObjCorpus::Variant::COMMENTED };
+
+    //!< Buffered writer of the .obj lines
+    class ObjWriter
+    {
+    public:
+        explicit ObjWriter(QFile& p_file) : m_file(p_file), m_isValid(true) { m_buffer.reserve(BUFFER_SIZE + 256); }
+
+        template <typename... Args>
+        void line(const char* p_format, Args... p_args)
+        {
+            char text[256];
+            const int length{ std::snprintf(text, sizeof(text), p_format, p_args...) };
+            m_buffer.append(text, std::min(length, static_cast<int>(sizeof(text)) - 1));
+            if (m_buffer.size() >= BUFFER_SIZE)
+            {
+                flush();
+            }
+        }
+
+        bool flush(void)
+        {
+            m_isValid = m_isValid && m_file.write(m_buffer) == m_buffer.size();
+            m_buffer.clear();
+            return m_isValid;
+        }
+
+    private:
+        QFile& m_file;
+        QByteArray m_buffer;
+        bool m_isValid;
+    };
+}
+
+namespace bench
+{
+
+    //---------------------------------------------------------------------------------------
+    QString ObjCorpus::variantName(Variant p_variant)
+    //---------------------------------------------------------------------------------------
+    {
+        switch (p_variant)
+        {
+        case Variant::PLAIN:
+            return "plain";
+        case Variant::NORMALS:
+            return "normals";
+        case Variant::TEXTURED:
+            return "textured";
+        case Variant::QUADS:
+            return "quads";
+        case Variant::NEGATIVE:
+            return "negative";
+        default:
+            return "commented";
+        }
+    }
+
+    //---------------------------------------------------------------------------------------
+    bool ObjCorpus::variantFromName(const QString& p_name, Variant& p_variant)
+    //---------------------------------------------------------------------------------------
+    {
+        for (const Variant variant : VARIANTS)
+        {
+            if (p_name == variantName(variant))
+            {
+                p_variant = variant;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    //---------------------------------------------------------------------------------------
+    QStringList ObjCorpus::variantNames(void)
+    //---------------------------------------------------------------------------------------
+    {
+        QStringList names;
+        for (const Variant variant : VARIANTS)
+        {
+            names << variantName(variant);
+        }
+        return names;
+    }
+
+    //---------------------------------------------------------------------------------------
+    bool ObjCorpus::write(const QString& p_filepath, Variant p_variant, qint64 p_triangleCount)
+    //---------------------------------------------------------------------------------------
+    {
+        QFile file(p_filepath);
+        if (p_triangleCount <= 0 || !file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        {
+            qCritical() << "Cannot write the corpus file" << p_filepath;
+            return false;
+        }
+
+        // grid of cells of two triangles (or one quad), the last cell may have one triangle
+        const bool isQuads{ p_variant == Variant::QUADS };
+        const bool hasNormals{ p_variant == Variant::NORMALS || p_variant == Variant::TEXTURED };
+        const bool hasTexCoords{ p_variant == Variant::TEXTURED || isQuads };
+        const qint64 cellCount{ (p_triangleCount + 1) / 2 };
+        const qint64 columns{ std::max<qint64>(1, static_cast<qint64>(std::ceil(std::sqrt(static_cast<double>(cellCount))))) };
+        const qint64 rows{ (cellCount + columns - 1) / columns };
+
+        ObjWriter writer(file);
+        writer.line("# ObjLoaderBenchmark corpus: %s, %lld triangles\n", variantName(p_variant).toLatin1().constData(), p_triangleCount);
+        writer.line("o grid\n");
+
+        qint64 vertexCount{ 0 };
+        const auto writeVertexRow = [&](qint64 p_row)
+        {
+            for (qint64 i = 0; i <= columns; i++)
+            {
+                const double x{ static_cast<double>(i) };
+                const double y{ static_cast<double>(p_row) };
+                const double z{ WAVE_HEIGHT * std::sin(WAVE_FREQUENCY * x) * std::cos(WAVE_FREQUENCY * y) };
+                writer.line("v %.6f %.6f %.6f\n", x, y, z);
+                if (hasTexCoords)
+                {
+                    writer.line("vt %.6f %.6f\n", x / static_cast<double>(columns), y / static_cast<double>(rows));
+                }
+                if (hasNormals)
+                {
+                    const double dzdx{ WAVE_HEIGHT * WAVE_FREQUENCY * std::cos(WAVE_FREQUENCY * x) * std::cos(WAVE_FREQUENCY * y) };
+                    const double dzdy{ -WAVE_HEIGHT * WAVE_FREQUENCY * std::sin(WAVE_FREQUENCY * x) * std::sin(WAVE_FREQUENCY * y) };
+                    const double length{ std::sqrt(dzdx * dzdx + dzdy * dzdy + 1.) };
+                    writer.line("vn %.6f %.6f %.6f\n", -dzdx / length, -dzdy / length, 1. / length);
+                }
+                vertexCount++;
+            }
+        };
+
+        // one based indices, or relative to the last written vertex
+        char references[4][64];
+        const auto formatReference = [&](char* p_text, qint64 p_index)
+        {
+            const qint64 index{ p_variant == Variant::NEGATIVE ? p_index - vertexCount - 1 : p_index };
+            if (p_variant == Variant::NORMALS)
+            {
+                std::snprintf(p_text, 64, "%lld//%lld", index, index);
+            }
+            else if (p_variant == Variant::TEXTURED)
+            {
+                std::snprintf(p_text, 64, "%lld/%lld/%lld", index, index, index);
+            }
+            else if (isQuads)
+            {
+                std::snprintf(p_text, 64, "%lld/%lld", index, index);
+            }
+            else
+            {
+                std::snprintf(p_text, 64, "%lld", index);
+            }
+        };
+
+        qint64 triangleCount{ 0 };
+        const auto writeFaceRow = [&](qint64 p_row)
+        {
+            if (p_variant == Variant::COMMENTED)
+            {
+                writer.line("\n# row %lld of %lld\ng row%lld\ns off\n", p_row, rows, p_row);
+            }
+            for (qint64 i = 0; i < columns && triangleCount < p_triangleCount; i++)
+            {
+                const qint64 a{ p_row * (columns + 1) + i + 1 };
+                const qint64 d{ a + columns + 1 };
+                formatReference(references[0], a);
+                formatReference(references[1], a + 1);
+                formatReference(references[2], d + 1);
+                formatReference(references[3], d);
+                if (isQuads)
+                {
+                    writer.line("f %s %s %s %s\n", references[0], references[1], references[2], references[3]);
+                    triangleCount += 2;
+                    continue;
+                }
+
+                writer.line("f %s %s %s\n", references[0], references[1], references[2]);
+                triangleCount++;
+                if (triangleCount < p_triangleCount)
+                {
+                    writer.line("f %s %s %s\n", references[0], references[2], references[3]);
+                    triangleCount++;
+                }
+            }
+        };
+
+        if (p_variant == Variant::NEGATIVE)
+        {
+            // the faces follow their vertices, as written by the streaming exporters
+            writeVertexRow(0);
+            for (qint64 row = 0; row < rows; row++)
+            {
+                writeVertexRow(row + 1);
+                writeFaceRow(row);
+            }
+        }
+        else
+        {
+            for (qint64 row = 0; row <= rows; row++)
+            {
+                writeVertexRow(row);
+            }
+            for (qint64 row = 0; row < rows; row++)
+            {
+                writeFaceRow(row);
+            }
+        }
+
+        if (!writer.flush())
+        {
+            qCritical() << "Cannot write the corpus file" << p_filepath;
+            return false;
+        }
+        return true;
+    }
+
+}
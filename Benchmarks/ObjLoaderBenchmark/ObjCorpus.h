@@ -0,0 +1,38 @@
+#pragma once
+
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+
+namespace bench
+{
+
+    /**
+     * \class ObjCorpus
+     * \brief Synthetic .obj files of a given triangle count, for the loader benchmarks
+     *
+     * The mesh is a wavy grid, written with one of the syntaxes met in the exported files: faces with vertex
+     * indices only, with normals (a//n), with texture coordinates and normals (a/t/n), quads with texture
+     * coordinates (a/t), negative (relative) indices, or comments and groups between the rows.
+     */
+    class ObjCorpus
+    {
+    public:
+        enum class Variant
+        {
+            PLAIN,      //!< v, f a b c
+            NORMALS,    //!< v and vn, f a//n b//n c//n
+            TEXTURED,   //!< v, vt and vn, f a/t/n b/t/n c/t/n
+            QUADS,      //!< v and vt, f a/t b/t c/t d/t, two triangles by face
+            NEGATIVE,   //!< v, f -a -b -c after each row of vertices
+            COMMENTED   //!< v, f a b c with comments, groups and smoothing lines
+        };
+
+        static QString variantName(Variant p_variant);
+        static bool variantFromName(const QString& p_name, Variant& p_variant);
+        static QStringList variantNames(void);
+
+        //!< Write p_triangleCount triangles in p_filepath (rounded up to an even count for QUADS), false on error
+        static bool write(const QString& p_filepath, Variant p_variant, qint64 p_triangleCount);
+    };
+
+}
@@ -0,0 +1,29 @@
+TARGET = ObjLoaderBenchmark
+TEMPLATE = app
+
+QT = core concurrent
+
+CONFIG += console debug_and_release c++17
+CONFIG -= app_bundle
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+include(../Common/Benchmark.pri)
+
+INCLUDEPATH += \
+    ../../DataModel
+
+HEADERS += \
+    AllocationCounter.h \
+    ObjCorpus.h
+
+SOURCES += \
+    AllocationCounter.cpp \
+    ObjCorpus.cpp \
+    main.cpp
+
+build_pass:CONFIG(debug, debug|release):CONFIGURATION = debug
+else:build_pass:CONFIG(release, debug|release):CONFIGURATION = release
+
+LIBS += \
+    -L$$OUT_PWD/../../DataModel -L$$OUT_PWD/../../DataModel/$${CONFIGURATION} -lDataModel
@@ -0,0 +1,264 @@
+#include "AllocationCounter.h"
+#include "BenchmarkReport.h"
+#include "ObjCorpus.h"
+
+#include <Mesh/MeshModel.h>
+
+#include <QtCore/QCommandLineParser>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDebug>
+#include <QtCore/QDir>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <vector>
+
+#if defined(Q_OS_LINUX)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// Load generated .obj files of growing size with the mesh loaders and report the load times as JSON.
+// The corpus is written once in --corpus and reused by the next runs. A cold run evicts the file from the page
+// cache before loading it (Linux only, the run is skipped if it fails), a warm run reads it once before. The
+// allocations are counted during the load only, the peak resident memory is the one of the process: the sizes
+// are run in increasing order.
+
+namespace
+{
+    //!< A mesh loader, the mesh is cleared before each load outside of the measure
+    struct Loader
+    {
+        std::function<void(const QString&)> load;
+        std::function<qint64(void)> faceCount;
+        std::function<void(void)> clear;
+    };
+
+    //!< Drop the clean pages of the file, false if the platform cannot
+    static bool evictFromPageCache(const QString& p_filepath)
+    {
+#if defined(Q_OS_LINUX)
+        const int fd{ ::open(QFile::encodeName(p_filepath).constData(), O_RDONLY) };
+        if (fd < 0)
+        {
+            return false;
+        }
+        // the pages written by the generation are dirty until synchronized
+        const bool isEvicted{ ::fdatasync(fd) == 0 && ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED) == 0 };
+        ::close(fd);
+        return isEvicted;
+#else
+        Q_UNUSED(p_filepath);
+        return false;
+#endif
+    }
+
+    static bool readWholeFile(const QString& p_filepath)
+    {
+        QFile file(p_filepath);
+        if (!file.open(QIODevice::ReadOnly))
+        {
+            return false;
+        }
+        QByteArray buffer(1 << 20, Qt::Uninitialized);
+        while (file.read(buffer.data(), buffer.size()) > 0)
+        {
+        }
+        return true;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication a(argc, argv);
+    QCoreApplication::setApplicationName("ObjLoaderBenchmark");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Load time of the .obj loaders on a synthetic corpus");
+    parser.addHelpOption();
+    const QCommandLineOption corpusOption("corpus", "Directory of the generated .obj files, reused if present.", "directory", "obj_corpus");
+    const QCommandLineOption regenerateOption("regenerate", "Write the corpus files again.");
+    const QCommandLineOption trianglesOption("triangles", "Comma separated triangle counts of the files.", "counts", "1000000,10000000,50000000");
+    const QCommandLineOption variantsOption("variants", QString("Comma separated syntaxes among %1.").arg(bench::ObjCorpus::variantNames().join(", ")), "names",
+        bench::ObjCorpus::variantNames().join(','));
+    const QCommandLineOption loadersOption("loaders", "Comma separated loaders among MeshModel.", "names", "MeshModel");
+    const QCommandLineOption cacheOption("cache", "Comma separated page cache states among cold, warm.", "states", "cold,warm");
+    const QCommandLineOption runsOption("runs", "Loads by file and cache state.", "count", "3");
+    const QCommandLineOption outputOption("output", "JSON report.", "file", "obj_loader_benchmark.json");
+    const QCommandLineOption baselineOption("baseline", "JSON report to compare with, the exit code is 2 on a regression.", "file");
+    const QCommandLineOption toleranceOption("tolerance", "Accepted relative increase of the load times and allocations.", "ratio", "0.1");
+    parser.addOptions({ corpusOption, regenerateOption, trianglesOption, variantsOption, loadersOption, cacheOption, runsOption, outputOption,
+        baselineOption, toleranceOption });
+    parser.process(a);
+
+    const int runCount{ parser.value(runsOption).toInt() };
+    std::vector<qint64> triangleCounts;
+    for (const QString& count : parser.value(trianglesOption).split(',', QString::SkipEmptyParts))
+    {
+        triangleCounts.push_back(count.toLongLong());
+    }
+    if (runCount <= 0 || triangleCounts.empty() || std::any_of(triangleCounts.cbegin(), triangleCounts.cend(), [](qint64 p_count) { return p_count <= 0; }))
+    {
+        qCritical() << "Invalid arguments";
+        parser.showHelp(1);
+    }
+    std::sort(triangleCounts.begin(), triangleCounts.end());
+
+    std::vector<bench::ObjCorpus::Variant> variants;
+    for (const QString& name : parser.value(variantsOption).split(',', QString::SkipEmptyParts))
+    {
+        bench::ObjCorpus::Variant variant;
+        if (!bench::ObjCorpus::variantFromName(name, variant))
+        {
+            qCritical() << "Unknown corpus variant" << name;
+            return 1;
+        }
+        variants.push_back(variant);
+    }
+
+    const QStringList cacheStates{ parser.value(cacheOption).split(',', QString::SkipEmptyParts) };
+    for (const QString& cacheState : cacheStates)
+    {
+        if (cacheState != "cold" && cacheState != "warm")
+        {
+            qCritical() << "Unknown page cache state" << cacheState;
+            return 1;
+        }
+    }
+
+    MeshModel mesh;
+    const std::map<QString, Loader> loaders{
+        { "MeshModel", { [&mesh](const QString& p_filepath) { mesh.loadObjPath(p_filepath, false); }, [&mesh]() { return static_cast<qint64>(mesh.faceCount()); }, [&mesh]() { mesh.clear(); } } }
+    };
+    const QStringList loaderNames{ parser.value(loadersOption).split(',', QString::SkipEmptyParts) };
+    for (const QString& name : loaderNames)
+    {
+        if (loaders.count(name) == 0)
+        {
+            qCritical() << "Unknown loader" << name;
+            return 1;
+        }
+    }
+
+    const QDir corpusDir(parser.value(corpusOption));
+    if (!corpusDir.mkpath("."))
+    {
+        qCritical() << "Cannot create the corpus directory" << corpusDir.path();
+        return 1;
+    }
+    if (!bench::isAllocationCountAvailable())
+    {
+        qWarning() << "The allocations are not counted on this platform";
+    }
+
+    QJsonObject benchmarks;
+    for (const qint64 triangleCount : triangleCounts)
+    {
+        for (const bench::ObjCorpus::Variant variant : variants)
+        {
+            const QString filepath{ corpusDir.filePath(QString("%1_%2.obj").arg(bench::ObjCorpus::variantName(variant)).arg(triangleCount)) };
+            if (parser.isSet(regenerateOption) || !QFileInfo::exists(filepath))
+            {
+                qInfo().noquote() << "Writing" << filepath;
+                if (!bench::ObjCorpus::write(filepath, variant, triangleCount))
+                {
+                    return 1;
+                }
+            }
+            const qint64 fileSize{ QFileInfo(filepath).size() };
+
+            for (const QString& loaderName : loaderNames)
+            {
+                const Loader& loader{ loaders.at(loaderName) };
+                for (const QString& cacheState : cacheStates)
+                {
+                    std::vector<double> loadTimes;
+                    bench::AllocationCount allocations;
+                    qint64 faceCount{ 0 };
+                    const bool isCold{ cacheState == "cold" };
+                    bool isEvicted{ true };
+                    for (int run = 0; run < runCount && isEvicted; run++)
+                    {
+                        loader.clear();
+                        if (isCold && !evictFromPageCache(filepath))
+                        {
+                            // a warm run would be reported as cold
+                            qWarning() << "Cannot evict" << filepath << "from the page cache, cold run skipped";
+                            isEvicted = false;
+                            break;
+                        }
+                        if (!isCold && !readWholeFile(filepath))
+                        {
+                            qCritical() << "Cannot read" << filepath;
+                            return 1;
+                        }
+
+                        bench::resetAllocationCount();
+                        QElapsedTimer timer;
+                        timer.start();
+                        loader.load(filepath);
+                        loadTimes.push_back(static_cast<double>(timer.nsecsElapsed()) * 1e-6);
+                        allocations = bench::allocationCount(); // the same at each run
+                        faceCount = loader.faceCount();
+                    }
+                    loader.clear();
+                    if (!isEvicted)
+                    {
+                        continue;
+                    }
+
+                    if (faceCount < triangleCount)
+                    {
+                        qCritical() << loaderName << "loaded" << faceCount << "triangles of" << triangleCount << "in" << filepath;
+                        return 1;
+                    }
+
+                    const double medianTime{ bench::percentile(loadTimes, 0.5) };
+                    const double megabytesPerSecond{ medianTime > 0. ? static_cast<double>(fileSize) / (1024. * 1024.) / (medianTime * 1e-3) : 0. };
+                    QJsonObject result{
+                        { "file", QFileInfo(filepath).fileName() },
+                        { "file_mb", static_cast<double>(fileSize) / (1024. * 1024.) },
+                        { "triangles", faceCount },
+                        { "cache", cacheState },
+                        { "wall_ms", bench::summarize(loadTimes) },
+                        { "mb_per_s", megabytesPerSecond },
+                        { "peak_rss_kb", bench::peakResidentMemory() }
+                    };
+                    if (bench::isAllocationCountAvailable())
+                    {
+                        result.insert("allocations", allocations.allocations);
+                        result.insert("allocated_mb", static_cast<double>(allocations.allocatedBytes) / (1024. * 1024.));
+                        result.insert("peak_heap_mb", static_cast<double>(allocations.peakLiveBytes) / (1024. * 1024.));
+                    }
+
+                    const QString name{ QString("%1/%2/%3/%4").arg(loaderName, bench::ObjCorpus::variantName(variant)).arg(triangleCount).arg(cacheState) };
+                    benchmarks.insert(name, result);
+                    qInfo().noquote() << QString("%1: p50 %2 ms, %3 MB/s, %4 allocations").arg(name, -40)
+                        .arg(medianTime, 0, 'f', 1).arg(megabytesPerSecond, 0, 'f', 1).arg(allocations.allocations);
+                }
+            }
+        }
+    }
+
+    const QJsonObject report{
+        { "corpus", corpusDir.absolutePath() },
+        { "runs", runCount },
+        { "peak_rss_kb", bench::peakResidentMemory() },
+        { "benchmarks", benchmarks }
+    };
+    if (!bench::writeJson(parser.value(outputOption), report))
+    {
+        return 1;
+    }
+
+    if (parser.isSet(baselineOption))
+    {
+        return bench::checkBaseline(report, parser.value(baselineOption), { "wall_ms/p50", "allocations", "peak_heap_mb" }, parser.value(toleranceOption).toDouble());
+    }
+
+    return 0;
+}
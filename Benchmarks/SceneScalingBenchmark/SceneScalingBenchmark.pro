@@ -0,0 +1,14 @@
+TARGET = SceneScalingBenchmark
+TEMPLATE = app
+
+QT = core
+
+CONFIG += console debug_and_release c++17
+CONFIG -= app_bundle
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+include(../Common/RenderBenchmark.pri)
+
+SOURCES += \
+    main.cpp
@@ -0,0 +1,235 @@
+#include "BenchmarkReport.h"
+#include "RenderBenchmark.h"
+
+#include <GLWidgets/CameraSession.h>
+#include <Mesh/SceneGenerator.h>
+#include <Offscreen/OffscreenRenderer.h>
+
+#include <QtGui/QGuiApplication>
+#include <QtCore/QCommandLineParser>
+#include <QtCore/QDebug>
+
+#include <functional>
+#include <map>
+#include <vector>
+
+namespace
+{
+
+    //!< Least squares slope of p_values against p_abscissas, 0 if the abscissas are all equal
+    double slope(const std::vector<double>& p_abscissas, const std::vector<double>& p_values)
+    {
+        const double count{ static_cast<double>(p_abscissas.size()) };
+        double meanX{ 0. }, meanY{ 0. };
+        for (size_t i = 0; i < p_abscissas.size(); i++)
+        {
+            meanX += p_abscissas[i] / count;
+            meanY += p_values[i] / count;
+        }
+        double covariance{ 0. }, variance{ 0. };
+        for (size_t i = 0; i < p_abscissas.size(); i++)
+        {
+            covariance += (p_abscissas[i] - meanX) * (p_values[i] - meanY);
+            variance += (p_abscissas[i] - meanX) * (p_abscissas[i] - meanX);
+        }
+        return variance > 0. ? covariance / variance : 0.;
+    }
+
+}
+
+// Render generated scenes of growing size with the transparency engines and report the frame times as JSON.
+// One parameter of SceneGenerator is swept (triangles, objects, depth complexity or opaque ratio), the others
+// keep their value. Each scene is rendered along the same orbit around its center.
+// The growth of the frame times, and of the draw calls with the GL call counters of the debug build, is fitted by
+// least squares on the swept values: --sweep objects measures the overhead by object of each engine.
+
+int main(int argc, char *argv[])
+{
+    bench::setOpenGLFromArguments(argc, argv); // before the OpenGL library is loaded
+
+    QGuiApplication a(argc, argv);
+    QCoreApplication::setApplicationName("SceneScalingBenchmark");
+
+    const SceneGenerator::Parameters defaults;
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Scaling of the transparency engines with the parameters of generated scenes");
+    parser.addHelpOption();
+    const QCommandLineOption enginesOption("engines", QString("Comma separated engines among %1, or all.").arg(gui::OffscreenRenderer::transparencyEngineNames().join(", ")), "names", "DualDepthPeeling");
+    const QCommandLineOption layoutsOption("layouts", QString("Comma separated scene layouts among %1.").arg(SceneGenerator::layoutNames().join(", ")), "names", SceneGenerator::layoutNames().join(','));
+    const QCommandLineOption sweepOption("sweep", "Swept parameter: triangles, objects, depth or opaque.", "parameter", "depth");
+    const QCommandLineOption valuesOption("values", "Comma separated values of the swept parameter.", "values", "1,2,4,8,16,32");
+    const QCommandLineOption trianglesOption("triangles", "Triangles of the scene.", "count", QString::number(defaults.triangleCount));
+    const QCommandLineOption objectsOption("objects", "Objects of the scene.", "count", "4");
+    const QCommandLineOption depthOption("depth", "Depth complexity at the center of the scene.", "layers", QString::number(defaults.depthComplexity));
+    const QCommandLineOption opaqueOption("opaque", "Ratio of opaque objects.", "ratio", QString::number(defaults.opaqueRatio));
+    const QCommandLineOption seedOption("seed", "Seed of the random blobs.", "seed", QString::number(defaults.seed));
+    const QCommandLineOption opacityOption("opacity", "Opacity of the transparent objects.", "alpha", "0.5");
+    const QCommandLineOption framesOption("frames", "Frames of the orbit of each scene.", "count", "60");
+    const QCommandLineOption sizeOption("size", "Image size in pixels.", "WxH", "1024x768");
+    const QCommandLineOption outputOption("output", "JSON report.", "file", "scene_scaling_benchmark.json");
+    const QCommandLineOption baselineOption("baseline", "JSON report to compare with, the exit code is 2 on a regression.", "file");
+    const QCommandLineOption toleranceOption("tolerance", "Accepted relative increase of the p95 frame times.", "ratio", "0.1");
+    const QCommandLineOption softwareOption("software", "Mesa software rasterizer (llvmpipe).");
+    parser.addOptions({ enginesOption, layoutsOption, sweepOption, valuesOption, trianglesOption, objectsOption, depthOption, opaqueOption, seedOption,
+        opacityOption, framesOption, sizeOption, outputOption, baselineOption, toleranceOption, softwareOption });
+    parser.process(a);
+
+    const QStringList size{ parser.value(sizeOption).split('x') };
+    const int width{ size.value(0).toInt() };
+    const int height{ size.value(1).toInt() };
+    const int frameCount{ parser.value(framesOption).toInt() };
+    if (size.size() != 2 || width <= 0 || height <= 0 || frameCount <= 0)
+    {
+        qCritical() << "Invalid arguments";
+        parser.showHelp(1);
+    }
+
+    const std::map<QString, std::function<void(SceneGenerator::Parameters&, double)>> sweeps{
+        { "triangles", [](SceneGenerator::Parameters& p_parameters, double p_value) { p_parameters.triangleCount = static_cast<int>(p_value); } },
+        { "objects", [](SceneGenerator::Parameters& p_parameters, double p_value) { p_parameters.objectCount = static_cast<int>(p_value); } },
+        { "depth", [](SceneGenerator::Parameters& p_parameters, double p_value) { p_parameters.depthComplexity = static_cast<int>(p_value); } },
+        { "opaque", [](SceneGenerator::Parameters& p_parameters, double p_value) { p_parameters.opaqueRatio = p_value; } }
+    };
+    const QString sweep{ parser.value(sweepOption) };
+    if (sweeps.count(sweep) == 0)
+    {
+        qCritical() << "Unknown swept parameter" << sweep;
+        return 1;
+    }
+
+    std::vector<SceneGenerator::Layout> layouts;
+    for (const QString& name : parser.value(layoutsOption).split(',', QString::SkipEmptyParts))
+    {
+        SceneGenerator::Layout layout;
+        if (!SceneGenerator::layoutFromName(name, layout))
+        {
+            qCritical() << "Unknown scene layout" << name;
+            return 1;
+        }
+        layouts.push_back(layout);
+    }
+
+    QStringList engines{ parser.value(enginesOption).split(',', QString::SkipEmptyParts) };
+    if (engines == QStringList{ "all" })
+    {
+        engines = gui::OffscreenRenderer::transparencyEngineNames();
+    }
+
+    gui::OffscreenRenderer renderer;
+    if (!renderer.initialize(width, height))
+    {
+        return 1;
+    }
+    qInfo().noquote() << "OpenGL:" << renderer.glRendererName();
+
+    // by engine/layout: swept values, p50 frame times and mean draw calls
+    struct Growth
+    {
+        std::vector<double> values;
+        std::vector<double> cpuTimes;
+        std::vector<double> drawCalls;
+    };
+    std::map<QString, Growth> growths;
+
+    QJsonObject benchmarks;
+    for (const SceneGenerator::Layout layout : layouts)
+    {
+        for (const QString& value : parser.value(valuesOption).split(',', QString::SkipEmptyParts))
+        {
+            SceneGenerator::Parameters parameters;
+            parameters.layout = layout;
+            parameters.triangleCount = parser.value(trianglesOption).toInt();
+            parameters.objectCount = parser.value(objectsOption).toInt();
+            parameters.depthComplexity = parser.value(depthOption).toInt();
+            parameters.opaqueRatio = parser.value(opaqueOption).toDouble();
+            parameters.seed = parser.value(seedOption).toUInt();
+            sweeps.at(sweep)(parameters, value.toDouble());
+
+            if (!renderer.loadGeneratedScene(parameters, parser.value(opacityOption).toFloat()))
+            {
+                return 1;
+            }
+            // the orbit starts from the fitted view of each scene
+            const gui::CameraSession orbit{ gui::CameraSession::orbit(renderer.camera(), frameCount) };
+
+            for (const QString& engine : engines)
+            {
+                if (!renderer.setTransparencyEngine(engine))
+                {
+                    qWarning() << "Engine" << engine << "skipped";
+                    continue;
+                }
+
+                orbit.restoreStart(renderer.camera());
+                if (!bench::warmUp(renderer))
+                {
+                    return 1;
+                }
+
+                QJsonObject result{ bench::runCameraSession(renderer, orbit) };
+                if (result.isEmpty())
+                {
+                    return 1;
+                }
+                result.insert("triangles", renderer.faceCount());
+                result.insert("objects", static_cast<qint64>(renderer.sceneObjects().size()));
+
+                const QString name{ QString("%1/%2/%3=%4").arg(engine, SceneGenerator::layoutName(layout), sweep, value) };
+                benchmarks.insert(name, result);
+                const QJsonObject cpu{ result.value("cpu_ms").toObject() };
+                const QJsonObject passes{ result.value("passes").toObject() };
+                const QJsonObject drawCalls{ result.value("gl_calls").toObject().value("draw_calls").toObject() };
+                QString line{ QString("%1: p50 %2 ms, p95 %3 ms, %4 passes").arg(name, -40)
+                    .arg(cpu.value("p50").toDouble(), 0, 'f', 3).arg(cpu.value("p95").toDouble(), 0, 'f', 3).arg(passes.value("max").toDouble()) };
+                if (!drawCalls.isEmpty())
+                {
+                    line += QString(", %1 draw calls").arg(drawCalls.value("mean").toDouble(), 0, 'f', 1);
+                }
+                qInfo().noquote() << line;
+
+                Growth& growth{ growths[QString("%1/%2").arg(engine, SceneGenerator::layoutName(layout))] };
+                growth.values.push_back(value.toDouble());
+                growth.cpuTimes.push_back(cpu.value("p50").toDouble());
+                if (!drawCalls.isEmpty())
+                {
+                    growth.drawCalls.push_back(drawCalls.value("mean").toDouble());
+                }
+            }
+        }
+    }
+
+    // increase by unit of the swept parameter, ex. by object
+    QJsonObject growthReport;
+    for (const auto& [name, growth] : growths)
+    {
+        QJsonObject result{ { "cpu_ms_p50", slope(growth.values, growth.cpuTimes) } };
+        if (growth.drawCalls.size() == growth.values.size())
+        {
+            result.insert("draw_calls", slope(growth.values, growth.drawCalls));
+        }
+        growthReport.insert(name, result);
+        qInfo().noquote() << QString("%1: %2 ms by %3").arg(name, -40).arg(result.value("cpu_ms_p50").toDouble(), 0, 'f', 4).arg(sweep)
+            + (result.contains("draw_calls") ? QString(", %1 draw calls by %2").arg(result.value("draw_calls").toDouble(), 0, 'f', 2).arg(sweep) : QString());
+    }
+
+    const QJsonObject report{
+        { "renderer", renderer.glRendererName() },
+        { "sweep", sweep },
+        { "width", width },
+        { "height", height },
+        { "peak_rss_kb", bench::peakResidentMemory() },
+        { "benchmarks", benchmarks },
+        { "growth", growthReport }
+    };
+    if (!bench::writeJson(parser.value(outputOption), report))
+    {
+        return 1;
+    }
+
+    if (parser.isSet(baselineOption))
+    {
+        return bench::checkBaseline(report, parser.value(baselineOption), { "cpu_ms/p95", "gpu_ms/p95" }, parser.value(toleranceOption).toDouble());
+    }
+
+    return 0;
+}
@@ -2,25 +2,32 @@ TARGET = DataModel
 TEMPLATE = lib
 CONFIG += static debug_and_release c++17
 
-QT = core
+QT = core concurrent
 
 HEADERS += \
+    Geom/AABB.h \
+    Geom/Batch.h \
+    Geom/Frustum.h \
     Geom/Plane.h \
     Geom/Point.h \
+    Geom/Sphere.h \
     Geom/Vec4.h \
+    Geom/Vec4Simd.h \
     Geom/Vector.h \
-    Mesh/MeshModel.h
+    Mesh/MeshModel.h \
+    Mesh/SceneGenerator.h
 
 SOURCES += \
-    Geom/Plane.cpp \
-    Geom/Point.cpp \
-    Geom/Vec4.cpp \
-    Geom/Vector.cpp \
-    Mesh/MeshModel.cpp
+    Geom/Batch.cpp \
+    Mesh/MeshModel.cpp \
+    Mesh/SceneGenerator.cpp
 
 OTHER_FILES += \
+    Geom/AABB.inl.cpp \
+    Geom/Frustum.inl.cpp \
     Geom/Plane.inl.cpp \
     Geom/Point.inl.cpp \
+    Geom/Sphere.inl.cpp \
     Geom/Vec4.inl.cpp \
     Geom/Vector.inl.cpp
 
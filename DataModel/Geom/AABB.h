@@ -0,0 +1,103 @@
+#pragma once
+
+/// @file AABB.h
+/// @brief Contains the declaration of class gps::geom::AABB
+/// @ingroup geom
+
+#include "Geom/Point.h"
+#include "Geom/Vector.h"
+
+namespace geom
+{
+    class Sphere;
+
+    /// @addtogroup geom
+    /// @{
+
+    /// @class AABB AABB.h "GPS/Geom/AABB.h"
+    /// @brief Class describing an axis-aligned box of 3d space.
+    /// @details The box is the set of points between its @link min() minimum @endlink and its @link max() maximum @endlink corners,
+    /// componentwise. A box is empty if its minimum is greater than its maximum along an axis: the default box is empty, with
+    /// infinite corners, and extending it by a point gives the box reduced to this point.
+    /// @sa batch::bounds(), Frustum::intersects()
+    class AABB
+    {
+    public:
+        // CONSTRUCTORS
+
+        /// @brief Default constructor
+        /// @details This initializes an empty box, of minimum (+inf,+inf,+inf) and maximum (-inf,-inf,-inf)
+        constexpr AABB();
+
+        /// @brief Constructor using the two corners
+        /// @note The box is empty if @a p_min is greater than @a p_max along an axis
+        constexpr AABB(const Point& p_min, const Point& p_max);
+
+        // MUTATORS
+
+        /// @brief Updates the two corners of the box.
+        void set(const Point& p_min, const Point& p_max);
+
+        /// @brief Extends the box to contain @a p_point.
+        void extend(const Point& p_point);
+
+        /// @brief Extends the box to contain @a p_box.
+        /// @details Nothing if @a p_box is empty.
+        void extend(const AABB& p_box);
+
+        // ACCESSORS
+
+        /// @brief Gets the minimum corner
+        constexpr const Point& min() const;
+
+        /// @brief Gets the maximum corner
+        constexpr const Point& max() const;
+
+        /// @brief Checks if the box is empty
+        /// @return True if the minimum is greater than the maximum along an axis
+        constexpr bool isEmpty() const;
+
+        /// @brief Gets the center of the box
+        /// @warning The result is not a number if the box is empty.
+        Point center() const;
+
+        /// @brief Gets the vector from the center to the maximum corner, half of the diagonal
+        /// @warning The result is meaningless if the box is empty.
+        Vector halfExtent() const;
+
+        // COMPUTERS
+
+        /// @brief Checks if @a p_point is inside the box or on its boundary.
+        constexpr bool contains(const Point& p_point) const;
+
+        /// @brief Checks if the two boxes have a common point.
+        /// @return False if one of the boxes is empty.
+        constexpr bool intersects(const AABB& p_other) const;
+
+        /// @brief Gets the sphere circumscribed to the box, of radius the half of its diagonal.
+        /// @return An empty Sphere if the box is empty.
+        Sphere boundingSphere() const;
+
+        // OPERATORS
+
+        /// @brief AABB strict equality.
+        /// @return True if the corners are strictly equal
+        bool operator==(const AABB& p_other) const;
+
+        /// @brief Inequality operator
+        /// @sa operator==()
+        bool operator!=(const AABB& p_other) const;
+
+    private:
+        /// @brief Minimum corner
+        Point m_min;
+        /// @brief Maximum corner
+        Point m_max;
+    };
+
+    /// @}
+}
+
+/// @cond PRIVATE
+#include "Geom/AABB.inl.cpp"
+/// @endcond
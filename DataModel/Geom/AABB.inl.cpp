@@ -0,0 +1,139 @@
+#include "Geom/Sphere.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace geom
+{
+    // CONSTRUCTORS
+
+    //-------------------------------------------------------------------------------------------------------------------
+    constexpr AABB::AABB()
+        : m_min(std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity())
+        , m_max(-std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity())
+    //-------------------------------------------------------------------------------------------------------------------
+    {
+    }
+
+    //-------------------------------------------------------------------------------------------------------------------
+    constexpr AABB::AABB(const Point& p_min, const Point& p_max) : m_min(p_min), m_max(p_max)
+    //-------------------------------------------------------------------------------------------------------------------
+    {
+    }
+
+    // MUTATORS
+
+    //-------------------------------------------------------------------------------------------------------------------
+    inline void AABB::set(const Point& p_min, const Point& p_max)
+    //-------------------------------------------------------------------------------------------------------------------
+    {
+        m_min = p_min;
+        m_max = p_max;
+    }
+
+    //-------------------------------------------------------------------------------------------------------------------
+    inline void AABB::extend(const Point& p_point)
+    //-------------------------------------------------------------------------------------------------------------------
+    {
+        m_min.set(std::min(m_min.x(), p_point.x()), std::min(m_min.y(), p_point.y()), std::min(m_min.z(), p_point.z()));
+        m_max.set(std::max(m_max.x(), p_point.x()), std::max(m_max.y(), p_point.y()), std::max(m_max.z(), p_point.z()));
+    }
+
+    //-------------------------------------------------------------------------------------------------------------------
+    inline void AABB::extend(const AABB& p_box)
+    //-------------------------------------------------------------------------------------------------------------------
+    {
+        if (!p_box.isEmpty())
+        {
+            extend(p_box.m_min);
+            extend(p_box.m_max);
+        }
+    }
+
+    // ACCESSORS
+
+    //-------------------------------------------------------------------------------------------------------------------
+    constexpr const Point& AABB::min() const
+    //-------------------------------------------------------------------------------------------------------------------
+    {
+        return m_min;
+    }
+
+    //-------------------------------------------------------------------------------------------------------------------
+    constexpr const Point& AABB::max() const
+    //-------------------------------------------------------------------------------------------------------------------
+    {
+        return m_max;
+    }
+
+    //-------------------------------------------------------------------------------------------------------------------
+    constexpr bool AABB::isEmpty() const
+    //-------------------------------------------------------------------------------------------------------------------
+    {
+        return m_min.x() > m_max.x() || m_min.y() > m_max.y() || m_min.z() > m_max.z();
+    }
+
+    //-------------------------------------------------------------------------------------------------------------------
+    inline Point AABB::center() const
+    //-------------------------------------------------------------------------------------------------------------------
+    {
+        // same operations as the kernels of batch::intersects(), (min + max) * 0.5 componentwise
+        return Point((m_min.x() + m_max.x()) * 0.5, (m_min.y() + m_max.y()) * 0.5, (m_min.z() + m_max.z()) * 0.5);
+    }
+
+    //-------------------------------------------------------------------------------------------------------------------
+    inline Vector AABB::halfExtent() const
+    //-------------------------------------------------------------------------------------------------------------------
+    {
+        return Vector((m_max.x() - m_min.x()) * 0.5, (m_max.y() - m_min.y()) * 0.5, (m_max.z() - m_min.z()) * 0.5);
+    }
+
+    // COMPUTERS
+
+    //-------------------------------------------------------------------------------------------------------------------
+    constexpr bool AABB::contains(const Point& p_point) const
+    //-------------------------------------------------------------------------------------------------------------------
+    {
+        return m_min.x() <= p_point.x() && p_point.x() <= m_max.x()
+            && m_min.y() <= p_point.y() && p_point.y() <= m_max.y()
+            && m_min.z() <= p_point.z() && p_point.z() <= m_max.z();
+    }
+
+    //-------------------------------------------------------------------------------------------------------------------
+    constexpr bool AABB::intersects(const AABB& p_other) const
+    //-------------------------------------------------------------------------------------------------------------------
+    {
+        return !isEmpty() && !p_other.isEmpty()
+            && m_min.x() <= p_other.m_max.x() && p_other.m_min.x() <= m_max.x()
+            && m_min.y() <= p_other.m_max.y() && p_other.m_min.y() <= m_max.y()
+            && m_min.z() <= p_other.m_max.z() && p_other.m_min.z() <= m_max.z();
+    }
+
+    //-------------------------------------------------------------------------------------------------------------------
+    inline Sphere AABB::boundingSphere() const
+    //-------------------------------------------------------------------------------------------------------------------
+    {
+        if (isEmpty())
+        {
+            return Sphere();
+        }
+        return Sphere(center(), halfExtent().length());
+    }
+
+    // OPERATORS
+
+    //-------------------------------------------------------------------------------------------------------------------
+    inline bool AABB::operator==(const AABB& p_other) const
+    //-------------------------------------------------------------------------------------------------------------------
+    {
+        return m_min == p_other.m_min && m_max == p_other.m_max;
+    }
+
+    //-------------------------------------------------------------------------------------------------------------------
+    inline bool AABB::operator!=(const AABB& p_other) const
+    //-------------------------------------------------------------------------------------------------------------------
+    {
+        return !(*this == p_other);
+    }
+}
@@ -0,0 +1,350 @@
+#include "Geom/Batch.h"
+
+#include <QtConcurrent/QtConcurrentMap>
+#include <QtCore/QThread>
+#include <QtCore/QtDebug>
+
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+#include <vector>
+
+namespace geom
+{
+    namespace batch
+    {
+        namespace
+        {
+            // the kernels of geom::simd run on the Vec4 of the types, their only member
+            template <typename T>
+            inline const double* components(const T& p_value)
+            {
+                static_assert(std::is_standard_layout<T>::value && sizeof(T) == 4 * sizeof(double), "T must be a Vec4");
+                return reinterpret_cast<const double*>(&p_value);
+            }
+
+            template <typename T>
+            inline double* components(T& p_value)
+            {
+                static_assert(std::is_standard_layout<T>::value && sizeof(T) == 4 * sizeof(double), "T must be a Vec4");
+                return reinterpret_cast<double*>(&p_value);
+            }
+
+            //!< Elements [begin, end) of an array, index is the position of the range in the array
+            struct Range
+            {
+                size_t index;
+                size_t begin;
+                size_t end;
+            };
+
+            static std::vector<Range> splitRanges(size_t p_count)
+            {
+                const size_t maxRangeCount{ static_cast<size_t>(std::max(1, 4 * QThread::idealThreadCount())) };
+                const size_t rangeCount{ p_count < MIN_PARALLEL_COUNT ? 1 : std::min(maxRangeCount, p_count / (MIN_PARALLEL_COUNT / 4)) };
+                std::vector<Range> ranges;
+                for (size_t i = 0; i < rangeCount; i++)
+                {
+                    ranges.push_back({ i, p_count * i / rangeCount, p_count * (i + 1) / rangeCount });
+                }
+                return ranges;
+            }
+
+            //!< Calls p_function(range) on the ranges, in the global thread pool if there are several
+            template <typename Function>
+            static void parallelFor(std::vector<Range>& p_ranges, Function p_function)
+            {
+                if (p_ranges.size() == 1)
+                {
+                    p_function(p_ranges.front());
+                }
+                else
+                {
+                    QtConcurrent::blockingMap(p_ranges, [&p_function](const Range& p_range) { p_function(p_range); });
+                }
+            }
+
+            //!< p_function(i) for i in [0, p_count)
+            template <typename Function>
+            static void parallelForEach(size_t p_count, Function p_function)
+            {
+                std::vector<Range> ranges{ splitRanges(p_count) };
+                parallelFor(ranges, [&p_function](const Range& p_range)
+                {
+                    for (size_t i = p_range.begin; i < p_range.end; i++)
+                    {
+                        p_function(i);
+                    }
+                });
+            }
+        }
+
+        //-------------------------------------------------------------------------------------------------------------------
+        void transform(const double* p_matrix, const Point* p_points, size_t p_count, Point* p_out)
+        //-------------------------------------------------------------------------------------------------------------------
+        {
+            parallelForEach(p_count, [p_matrix, p_points, p_out](size_t i)
+            {
+                double* const out{ components(p_out[i]) };
+                simd::transform(p_matrix, components(p_points[i]), out);
+                const double w{ out[3] };
+                if (w != 1. && w != 0.)
+                {
+                    simd::scale(out, 1. / w, out);
+                }
+                out[3] = 1.;
+            });
+        }
+
+        //-------------------------------------------------------------------------------------------------------------------
+        void transform(const float* p_matrix, const Point* p_points, size_t p_count, Point* p_out)
+        //-------------------------------------------------------------------------------------------------------------------
+        {
+            double matrix[16];
+            std::copy(p_matrix, p_matrix + 16, matrix);
+            transform(matrix, p_points, p_count, p_out);
+        }
+
+        //-------------------------------------------------------------------------------------------------------------------
+        bool bounds(const Point* p_points, size_t p_count, Point& p_min, Point& p_max)
+        //-------------------------------------------------------------------------------------------------------------------
+        {
+            if (p_count == 0)
+            {
+                return false;
+            }
+
+            std::vector<Range> ranges{ splitRanges(p_count) };
+            std::vector<Point> minima(ranges.size()), maxima(ranges.size());
+            parallelFor(ranges, [p_points, &minima, &maxima](const Range& p_range)
+            {
+                double* const lo{ components(minima[p_range.index]) };
+                double* const hi{ components(maxima[p_range.index]) };
+                std::copy_n(components(p_points[p_range.begin]), 4, lo);
+                std::copy_n(lo, 4, hi);
+                for (size_t i = p_range.begin + 1; i < p_range.end; i++)
+                {
+                    simd::min(components(p_points[i]), lo, lo);
+                    simd::max(components(p_points[i]), hi, hi);
+                }
+            });
+
+            p_min = minima.front();
+            p_max = maxima.front();
+            for (size_t i = 1; i < ranges.size(); i++)
+            {
+                simd::min(components(minima[i]), components(p_min), components(p_min));
+                simd::max(components(maxima[i]), components(p_max), components(p_max));
+            }
+            return true;
+        }
+
+        //-------------------------------------------------------------------------------------------------------------------
+        AABB bounds(const Point* p_points, size_t p_count)
+        //-------------------------------------------------------------------------------------------------------------------
+        {
+            AABB box;
+            Point boxMin, boxMax;
+            if (bounds(p_points, p_count, boxMin, boxMax))
+            {
+                box.set(boxMin, boxMax);
+            }
+            return box;
+        }
+
+        //-------------------------------------------------------------------------------------------------------------------
+        bool boundingSphere(const Point* p_points, size_t p_count, Point& p_center, double& p_radius)
+        //-------------------------------------------------------------------------------------------------------------------
+        {
+            Point boxMin, boxMax;
+            if (!bounds(p_points, p_count, boxMin, boxMax))
+            {
+                return false;
+            }
+
+            Point center;
+            simd::add(components(boxMin), components(boxMax), components(center));
+            simd::scale(components(center), 0.5, components(center));
+
+            std::vector<Range> ranges{ splitRanges(p_count) };
+            std::vector<double> squaredRadii(ranges.size(), 0.);
+            parallelFor(ranges, [p_points, &center, &squaredRadii](const Range& p_range)
+            {
+                double squaredRadius{ 0. };
+                double difference[4];
+                for (size_t i = p_range.begin; i < p_range.end; i++)
+                {
+                    // the fourth components of the points cancel out
+                    simd::sub(components(p_points[i]), components(center), difference);
+                    squaredRadius = std::max(squaredRadius, simd::dot(difference, difference));
+                }
+                squaredRadii[p_range.index] = squaredRadius;
+            });
+
+            p_center = center;
+            p_radius = std::sqrt(*std::max_element(squaredRadii.cbegin(), squaredRadii.cend()));
+            return true;
+        }
+
+        //-------------------------------------------------------------------------------------------------------------------
+        void signedDistances(const Plane& p_plane, const Point* p_points, size_t p_count, double* p_out)
+        //-------------------------------------------------------------------------------------------------------------------
+        {
+            // the fourth component of a point is 1: a.x + b.y + c.z + d
+            const double* const plane{ components(p_plane) };
+            parallelForEach(p_count, [plane, p_points, p_out](size_t i)
+            {
+                p_out[i] = simd::dot(plane, components(p_points[i]));
+            });
+        }
+
+        //-------------------------------------------------------------------------------------------------------------------
+        void project(const Plane& p_plane, const Point* p_points, size_t p_count, Point* p_out)
+        //-------------------------------------------------------------------------------------------------------------------
+        {
+            const double* const plane{ components(p_plane) };
+            const Vector normal{ p_plane.normal() };
+            parallelForEach(p_count, [plane, &normal, p_points, p_out](size_t i)
+            {
+                double offset[4];
+                simd::scale(components(normal), simd::dot(plane, components(p_points[i])), offset);
+                simd::sub(components(p_points[i]), offset, components(p_out[i]));
+            });
+        }
+
+        //-------------------------------------------------------------------------------------------------------------------
+        bool classify(const Plane* p_planes, size_t p_planeCount, const Point* p_points, size_t p_count, quint32* p_outsideMasks)
+        //-------------------------------------------------------------------------------------------------------------------
+        {
+            if (p_planeCount > 32)
+            {
+                qCritical() << "Cannot classify points against" << p_planeCount << "planes, the maximum is 32";
+                return false;
+            }
+
+            parallelForEach(p_count, [p_planes, p_planeCount, p_points, p_outsideMasks](size_t i)
+            {
+                const double* const point{ components(p_points[i]) };
+                quint32 mask{ 0 };
+                for (size_t k = 0; k < p_planeCount; k++)
+                {
+                    if (simd::dot(components(p_planes[k]), point) < 0.)
+                    {
+                        mask |= 1u << k;
+                    }
+                }
+                p_outsideMasks[i] = mask;
+            });
+            return true;
+        }
+
+        //-------------------------------------------------------------------------------------------------------------------
+        void triangleNormals(const Point* p_points, const int* p_indices, size_t p_triangleCount, Vector* p_normals)
+        //-------------------------------------------------------------------------------------------------------------------
+        {
+            parallelForEach(p_triangleCount, [p_points, p_indices, p_normals](size_t i)
+            {
+                const double* const a{ components(p_points[p_indices[3 * i]]) };
+                const double* const b{ components(p_points[p_indices[3 * i + 1]]) };
+                const double* const c{ components(p_points[p_indices[3 * i + 2]]) };
+
+                // same operations as Vector::operator^() and Vector::normalize(), the fourth components are 0
+                double ab[4], ac[4];
+                simd::sub(b, a, ab);
+                simd::sub(c, a, ac);
+                double* const normal{ components(p_normals[i]) };
+                simd::cross3(ab, ac, normal);
+                const double length{ std::sqrt(simd::dot(normal, normal)) };
+                if (length != 0)
+                {
+                    simd::scale(normal, 1.0 / length, normal);
+                }
+            });
+        }
+
+        //-------------------------------------------------------------------------------------------------------------------
+        void intersects(const Frustum& p_frustum, const AABB* p_boxes, size_t p_count, Frustum::Intersection* p_out)
+        //-------------------------------------------------------------------------------------------------------------------
+        {
+            // the half extents are projected on the absolute values of the normals, their fourth components are 0
+            const Plane* const planes{ p_frustum.planes() };
+            double absNormals[Frustum::PLANE_COUNT][4];
+            for (size_t k = 0; k < Frustum::PLANE_COUNT; k++)
+            {
+                const double* const plane{ components(planes[k]) };
+                absNormals[k][0] = std::abs(plane[0]);
+                absNormals[k][1] = std::abs(plane[1]);
+                absNormals[k][2] = std::abs(plane[2]);
+                absNormals[k][3] = 0.;
+            }
+
+            parallelForEach(p_count, [planes, &absNormals, p_boxes, p_out](size_t i)
+            {
+                const AABB& box{ p_boxes[i] };
+                if (box.isEmpty())
+                {
+                    p_out[i] = Frustum::Intersection::OUTSIDE;
+                    return;
+                }
+
+                // the fourth component of the center is 1, the one of the half extent 0
+                double center[4], halfExtent[4];
+                simd::add(components(box.min()), components(box.max()), center);
+                simd::scale(center, 0.5, center);
+                simd::sub(components(box.max()), components(box.min()), halfExtent);
+                simd::scale(halfExtent, 0.5, halfExtent);
+
+                Frustum::Intersection intersection{ Frustum::Intersection::INSIDE };
+                for (size_t k = 0; k < Frustum::PLANE_COUNT; k++)
+                {
+                    const double distance{ simd::dot(components(planes[k]), center) };
+                    const double radius{ simd::dot(absNormals[k], halfExtent) };
+                    if (distance < -radius)
+                    {
+                        intersection = Frustum::Intersection::OUTSIDE;
+                        break;
+                    }
+                    if (distance < radius)
+                    {
+                        intersection = Frustum::Intersection::INTERSECTS;
+                    }
+                }
+                p_out[i] = intersection;
+            });
+        }
+
+        //-------------------------------------------------------------------------------------------------------------------
+        void intersects(const Frustum& p_frustum, const Sphere* p_spheres, size_t p_count, Frustum::Intersection* p_out)
+        //-------------------------------------------------------------------------------------------------------------------
+        {
+            const Plane* const planes{ p_frustum.planes() };
+            parallelForEach(p_count, [planes, p_spheres, p_out](size_t i)
+            {
+                const Sphere& sphere{ p_spheres[i] };
+                if (sphere.isEmpty())
+                {
+                    p_out[i] = Frustum::Intersection::OUTSIDE;
+                    return;
+                }
+
+                const double* const center{ components(sphere.center()) };
+                const double radius{ sphere.radius() };
+                Frustum::Intersection intersection{ Frustum::Intersection::INSIDE };
+                for (size_t k = 0; k < Frustum::PLANE_COUNT; k++)
+                {
+                    const double distance{ simd::dot(components(planes[k]), center) };
+                    if (distance < -radius)
+                    {
+                        intersection = Frustum::Intersection::OUTSIDE;
+                        break;
+                    }
+                    if (distance < radius)
+                    {
+                        intersection = Frustum::Intersection::INTERSECTS;
+                    }
+                }
+                p_out[i] = intersection;
+            });
+        }
+    }
+}
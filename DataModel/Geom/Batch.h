@@ -0,0 +1,92 @@
+#pragma once
+
+/// @file Batch.h
+/// @brief Contains the batch operations of namespace gps::geom::batch
+/// @ingroup geom
+
+#include "Geom/AABB.h"
+#include "Geom/Frustum.h"
+#include "Geom/Plane.h"
+#include "Geom/Point.h"
+#include "Geom/Sphere.h"
+#include "Geom/Vector.h"
+
+#include <QtCore/QtGlobal>
+
+#include <cstddef>
+
+namespace geom
+{
+    /// @addtogroup geom
+    /// @{
+
+    /// @namespace geom::batch
+    /// @brief Operations on arrays of @link Point Points @endlink and of bounding volumes, given as a pointer and a count.
+    /// @details The elements are processed with the kernels of geom::simd, and split in ranges run by the global thread pool
+    /// when the arrays are large enough (see MIN_PARALLEL_COUNT). The results do not depend on the number of threads.\n
+    /// The input and output arrays of an operation may be the same array, they must not partially overlap.
+    namespace batch
+    {
+        /// @brief Arrays smaller than this count are processed by the calling thread
+        constexpr size_t MIN_PARALLEL_COUNT{ 16384 };
+
+        /// @brief Transforms @a p_count points by a 4x4 matrix.
+        /// @param [in] p_matrix: 16 coefficients in column-major order, as QMatrix4x4::constData() and OpenGL.
+        /// @param [in] p_points: Points to transform.
+        /// @param [in] p_count: Number of points.
+        /// @param [out] p_out: Transformed points, divided by their w component if the matrix is projective (as QMatrix4x4::map()).
+        void transform(const double* p_matrix, const Point* p_points, size_t p_count, Point* p_out);
+
+        /// @brief Same as transform(const double*, const Point*, size_t, Point*) with a single precision matrix.
+        void transform(const float* p_matrix, const Point* p_points, size_t p_count, Point* p_out);
+
+        /// @brief Axis-aligned bounding box of @a p_count points.
+        /// @param [out] p_min, p_max: Componentwise minimum and maximum of the points, unchanged if @a p_count is 0.
+        /// @return False if there is no point.
+        bool bounds(const Point* p_points, size_t p_count, Point& p_min, Point& p_max);
+
+        /// @brief Same as bounds(const Point*, size_t, Point&, Point&) returned as an AABB, empty if @a p_count is 0.
+        AABB bounds(const Point* p_points, size_t p_count);
+
+        /// @brief Bounding sphere of @a p_count points.
+        /// @details The center is the center of the bounding box of the points, the radius is the largest distance to the center.
+        /// The sphere is not the smallest one but at most sqrt(3) times larger, and computed in two passes.
+        /// @param [out] p_center, p_radius: Sphere, unchanged if @a p_count is 0.
+        /// @return False if there is no point.
+        bool boundingSphere(const Point* p_points, size_t p_count, Point& p_center, double& p_radius);
+
+        /// @brief Signed distances of @a p_count points to @a p_plane, positive on the side of its normal.
+        void signedDistances(const Plane& p_plane, const Point* p_points, size_t p_count, double* p_out);
+
+        /// @brief Perpendicular projections of @a p_count points onto @a p_plane.
+        /// @details Each point p is projected as p - (n.p + d) * n, n being the unitary normal of the plane:
+        /// the results may differ from Plane::project() in the last bits.
+        void project(const Plane& p_plane, const Point* p_points, size_t p_count, Point* p_out);
+
+        /// @brief Classifies @a p_count points against up to 32 planes.
+        /// @param [in] p_planes, p_planeCount: Planes, the bit i of the masks is the one of the plane p_planes[i].
+        /// @param [out] p_outsideMasks: For each point, the bits of the planes it is strictly behind (negative signed distance).
+        /// A point is inside a convex volume bounded by planes oriented inwards if its mask is 0.
+        /// @return False, and @a p_outsideMasks is unchanged, if there are more than 32 planes.
+        bool classify(const Plane* p_planes, size_t p_planeCount, const Point* p_points, size_t p_count, quint32* p_outsideMasks);
+
+        /// @brief Unitary normals of @a p_triangleCount triangles.
+        /// @param [in] p_points: Vertices of the triangles.
+        /// @param [in] p_indices: 3 indices in @a p_points by triangle, in counter-clockwise order around the normal.
+        /// @param [out] p_normals: Normals (b - a) ^ (c - a) normalized, null for the degenerate triangles, as
+        /// (Vector(b - a) ^ Vector(c - a)).normalized().
+        void triangleNormals(const Point* p_points, const int* p_indices, size_t p_triangleCount, Vector* p_normals);
+
+        /// @brief Positions of @a p_count boxes relative to @a p_frustum, for the culling of the invisible ones.
+        /// @details Same results as Frustum::intersects(const AABB&) const: for each plane, the signed distance of the center
+        /// of the box is compared to the projection of its half extent on the normal, two dot products by plane.
+        /// @param [out] p_out: Position of each box, Frustum::Intersection::OUTSIDE for the empty ones.
+        void intersects(const Frustum& p_frustum, const AABB* p_boxes, size_t p_count, Frustum::Intersection* p_out);
+
+        /// @brief Positions of @a p_count spheres relative to @a p_frustum, as Frustum::intersects(const Sphere&) const.
+        /// @param [out] p_out: Position of each sphere, Frustum::Intersection::OUTSIDE for the empty ones.
+        void intersects(const Frustum& p_frustum, const Sphere* p_spheres, size_t p_count, Frustum::Intersection* p_out);
+    }
+
+    /// @}
+}
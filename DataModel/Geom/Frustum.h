@@ -0,0 +1,112 @@
+#pragma once
+
+/// @file Frustum.h
+/// @brief Contains the declaration of class gps::geom::Frustum
+/// @ingroup geom
+
+#include "Geom/AABB.h"
+#include "Geom/Plane.h"
+#include "Geom/Sphere.h"
+
+#include <cstddef>
+
+namespace geom
+{
+    /// @addtogroup geom
+    /// @{
+
+    /// @class Frustum Frustum.h "GPS/Geom/Frustum.h"
+    /// @brief Class describing the volume viewed by a camera, bounded by 6 planes.
+    /// @details The planes are extracted from a 4x4 projection matrix (Gribb and Hartmann), as the points p for which the clip
+    /// coordinates c = M * p satisfy -c.w <= c.x, c.y, c.z <= c.w (OpenGL convention). The planes are normalized and oriented
+    /// inwards: a point is inside the frustum if its signed distance to each plane is positive or null.\n
+    /// With a model-view-projection matrix, the frustum is in the model space: the bounds of the meshes can be tested without
+    /// transforming them.
+    /// @note The tests of boxes and spheres are conservative: a volume which is not @link Intersection::OUTSIDE OUTSIDE @endlink
+    /// may be outside the frustum near its edges, a volume @link Intersection::OUTSIDE OUTSIDE @endlink is never visible.
+    /// @sa batch::intersects()
+    class Frustum
+    {
+    public:
+        /// @brief Position of a volume relative to the frustum
+        enum class Intersection
+        {
+            OUTSIDE, //!< Entirely behind one of the planes
+            INTERSECTS, //!< Crossing one of the planes at least
+            INSIDE //!< Entirely in front of all the planes
+        };
+
+        /// @brief Index of the planes, the names NEAR and FAR being macros of the Windows headers
+        enum class Side
+        {
+            LEFT, //!< c.x >= -c.w
+            RIGHT, //!< c.x <= c.w
+            BOTTOM, //!< c.y >= -c.w
+            TOP, //!< c.y <= c.w
+            ZNEAR, //!< c.z >= -c.w
+            ZFAR //!< c.z <= c.w
+        };
+
+        /// @brief Number of planes
+        static constexpr size_t PLANE_COUNT{ 6 };
+
+        // CONSTRUCTORS
+
+        /// @brief Default constructor
+        /// @details This initializes the frustum of the identity matrix, the cube [-1, 1]^3 of the normalized device coordinates
+        Frustum();
+
+        /// @brief Constructor using a projection matrix.
+        /// @details If a plane of the matrix is degenerate, Frustum defaults to Frustum() and @a isOk is set to false (if provided).
+        /// @param [in] p_matrix: 16 coefficients in column-major order, as QMatrix4x4::constData() and OpenGL.
+        /// @param [out] isOk: If provided, contains the result of the operation (success or failure).
+        /// @warning This constructor does not necessarily build the object defined by the parameters.
+        explicit Frustum(const double* p_matrix, bool* isOk = nullptr);
+
+        /// @brief Same as Frustum(const double*, bool*) with a single precision matrix.
+        explicit Frustum(const float* p_matrix, bool* isOk = nullptr);
+
+        // MUTATORS
+
+        /// @brief Updates the planes using a projection matrix.
+        /// @details If a plane is degenerate, as the far plane of an infinite projection, @a this is left unchanged and method will return false.
+        /// @param [in] p_matrix: 16 coefficients in column-major order, as QMatrix4x4::constData() and OpenGL.
+        /// @return True on success, false otherwise.
+        bool set(const double* p_matrix);
+
+        /// @brief Same as set(const double*) with a single precision matrix.
+        bool set(const float* p_matrix);
+
+        // ACCESSORS
+
+        /// @brief Gets a plane of the frustum, oriented inwards
+        const Plane& plane(Side p_side) const;
+
+        /// @brief Gets the PLANE_COUNT planes of the frustum, in the order of Side
+        const Plane* planes() const;
+
+        // COMPUTERS
+
+        /// @brief Checks if @a p_point is inside the frustum or on its boundary.
+        bool contains(const Point& p_point) const;
+
+        /// @brief Position of an axis-aligned box relative to the frustum.
+        /// @details The signed distance of the center to each plane is compared to the projection of the half extent on its normal.
+        /// @return Intersection::OUTSIDE if the box is empty.
+        Intersection intersects(const AABB& p_box) const;
+
+        /// @brief Position of a sphere relative to the frustum.
+        /// @return Intersection::OUTSIDE if the sphere is empty.
+        Intersection intersects(const Sphere& p_sphere) const;
+
+    private:
+        /// @brief Planes in the order of Side
+        Plane m_planes[PLANE_COUNT];
+    };
+
+    /// @}
+}
+
+/// @cond PRIVATE
+#include "Geom/Frustum.inl.cpp"
+/// @endcond
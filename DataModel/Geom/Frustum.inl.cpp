@@ -0,0 +1,183 @@
+#include "Geom/Vec4.h"
+
+#include <QtCore/QDebug>
+
+#include <algorithm>
+#include <cmath>
+
+namespace geom
+{
+    // CONSTRUCTORS
+
+    //-------------------------------------------------------------------------------------------------------------------
+    inline Frustum::Frustum()
+    //-------------------------------------------------------------------------------------------------------------------
+    {
+        static constexpr double identity[16]{ 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 };
+        set(identity);
+    }
+
+    //-------------------------------------------------------------------------------------------------------------------
+    inline Frustum::Frustum(const double* p_matrix, bool* isOk /*=nullptr*/) : Frustum()
+    //-------------------------------------------------------------------------------------------------------------------
+    {
+        const bool success{ set(p_matrix) };
+
+        // Check if isOk is defined, no its value
+        if (isOk)
+        {
+            *isOk = success;
+        }
+
+        // On Failure, add log Entry
+        if (!success)
+        {
+            qCritical() << "Set failed. Frustum defaults to Frustum()";
+        }
+    }
+
+    //-------------------------------------------------------------------------------------------------------------------
+    inline Frustum::Frustum(const float* p_matrix, bool* isOk /*=nullptr*/) : Frustum()
+    //-------------------------------------------------------------------------------------------------------------------
+    {
+        const bool success{ set(p_matrix) };
+
+        // Check if isOk is defined, no its value
+        if (isOk)
+        {
+            *isOk = success;
+        }
+
+        // On Failure, add log Entry
+        if (!success)
+        {
+            qCritical() << "Set failed. Frustum defaults to Frustum()";
+        }
+    }
+
+    // MUTATORS
+
+    //-------------------------------------------------------------------------------------------------------------------
+    inline bool Frustum::set(const double* p_matrix)
+    //-------------------------------------------------------------------------------------------------------------------
+    {
+        // coefficient (row, column) of the column-major matrix
+        const auto at = [p_matrix](int p_row, int p_column) { return p_matrix[4 * p_column + p_row]; };
+
+        // -c.w <= c[axis] is (row 3 + row axis) . p >= 0, c[axis] <= c.w is (row 3 - row axis) . p >= 0
+        Plane planes[PLANE_COUNT];
+        for (int axis = 0; axis < 3; axis++)
+        {
+            for (int side = 0; side < 2; side++)
+            {
+                const double sign{ side == 0 ? 1. : -1. };
+                if (!planes[2 * axis + side].set(at(3, 0) + sign * at(axis, 0), at(3, 1) + sign * at(axis, 1),
+                    at(3, 2) + sign * at(axis, 2), at(3, 3) + sign * at(axis, 3)))
+                {
+                    return false;
+                }
+            }
+        }
+
+        std::copy(planes, planes + PLANE_COUNT, m_planes);
+        return true;
+    }
+
+    //-------------------------------------------------------------------------------------------------------------------
+    inline bool Frustum::set(const float* p_matrix)
+    //-------------------------------------------------------------------------------------------------------------------
+    {
+        double matrix[16];
+        std::copy(p_matrix, p_matrix + 16, matrix);
+        return set(matrix);
+    }
+
+    // ACCESSORS
+
+    //-------------------------------------------------------------------------------------------------------------------
+    inline const Plane& Frustum::plane(Side p_side) const
+    //-------------------------------------------------------------------------------------------------------------------
+    {
+        return m_planes[static_cast<size_t>(p_side)];
+    }
+
+    //-------------------------------------------------------------------------------------------------------------------
+    inline const Plane* Frustum::planes() const
+    //-------------------------------------------------------------------------------------------------------------------
+    {
+        return m_planes;
+    }
+
+    // COMPUTERS
+
+    //-------------------------------------------------------------------------------------------------------------------
+    inline bool Frustum::contains(const Point& p_point) const
+    //-------------------------------------------------------------------------------------------------------------------
+    {
+        const Vec4 point(p_point.x(), p_point.y(), p_point.z(), 1);
+        return std::all_of(m_planes, m_planes + PLANE_COUNT, [&point](const Plane& p_plane)
+        {
+            return Vec4(p_plane.a(), p_plane.b(), p_plane.c(), p_plane.d()) * point >= 0;
+        });
+    }
+
+    //-------------------------------------------------------------------------------------------------------------------
+    inline Frustum::Intersection Frustum::intersects(const AABB& p_box) const
+    //-------------------------------------------------------------------------------------------------------------------
+    {
+        if (p_box.isEmpty())
+        {
+            return Intersection::OUTSIDE;
+        }
+
+        // same operations as batch::intersects(): the fourth component of the center is 1, the one of the half extent 0
+        const Vec4 boxMin(p_box.min().x(), p_box.min().y(), p_box.min().z(), 1);
+        const Vec4 boxMax(p_box.max().x(), p_box.max().y(), p_box.max().z(), 1);
+        const Vec4 center{ (boxMin + boxMax) * 0.5 };
+        const Vec4 halfExtent{ (boxMax - boxMin) * 0.5 };
+
+        Intersection intersection{ Intersection::INSIDE };
+        for (const Plane& plane : m_planes)
+        {
+            const double distance{ Vec4(plane.a(), plane.b(), plane.c(), plane.d()) * center };
+            const double radius{ Vec4(std::abs(plane.a()), std::abs(plane.b()), std::abs(plane.c()), 0) * halfExtent };
+            if (distance < -radius)
+            {
+                return Intersection::OUTSIDE;
+            }
+            if (distance < radius)
+            {
+                intersection = Intersection::INTERSECTS;
+            }
+        }
+        return intersection;
+    }
+
+    //-------------------------------------------------------------------------------------------------------------------
+    inline Frustum::Intersection Frustum::intersects(const Sphere& p_sphere) const
+    //-------------------------------------------------------------------------------------------------------------------
+    {
+        if (p_sphere.isEmpty())
+        {
+            return Intersection::OUTSIDE;
+        }
+
+        const Vec4 center(p_sphere.center().x(), p_sphere.center().y(), p_sphere.center().z(), 1);
+        const double radius{ p_sphere.radius() };
+
+        Intersection intersection{ Intersection::INSIDE };
+        for (const Plane& plane : m_planes)
+        {
+            const double distance{ Vec4(plane.a(), plane.b(), plane.c(), plane.d()) * center };
+            if (distance < -radius)
+            {
+                return Intersection::OUTSIDE;
+            }
+            if (distance < radius)
+            {
+                intersection = Intersection::INTERSECTS;
+            }
+        }
+        return intersection;
+    }
+}
@@ -23,27 +23,27 @@ namespace geom
     {
     public:
         /// @brief Plane defined by z=0 with normal oriented along Vector::K()
-        static const Plane& XOY ();
+        static constexpr const Plane& XOY();
         /// @brief Plane defined by z=0 with normal oriented along -1 * Vector::K()
-        static const Plane& YOX ();
+        static constexpr const Plane& YOX();
         /// @brief Plane defined by y=0 with normal oriented along -1 * Vector::J()
-        static const Plane& XOZ ();
+        static constexpr const Plane& XOZ();
         /// @brief Plane defined by y=0 with normal oriented along Vector::J()
-        static const Plane& ZOX ();
+        static constexpr const Plane& ZOX();
         /// @brief Plane defined by x=0 with normal oriented along Vector::I()
-        static const Plane& YOZ ();
+        static constexpr const Plane& YOZ();
         /// @brief Plane defined by x=0 with normal oriented along -1 * Vector::I()
-        static const Plane& ZOY ();
+        static constexpr const Plane& ZOY();
 
         // CONSTRUCTORS
 
         /// @brief Default constructor
         /// @details This initializes the Plane to Plane::YOZ()
-        Plane();
+        constexpr Plane();
 
         /// @brief Copy constructor
         /// @details This is initialized using the attributes of @a p_plane
-        Plane(const Plane& p_plane);
+        constexpr Plane(const Plane& p_plane);
 
         /// @brief Constructor using 4 doubles.
         /// @details If vector(a,b,c) is null, Plane defaults to YOZ() and @a isOk is set to false (if provided).\n
@@ -100,16 +100,16 @@ namespace geom
         // ACCESSORS
 
         /// @brief Gets the x component of the Plane.
-        double a() const;
+        constexpr double a() const;
 
         /// @brief Gets the y component of the Plane.
-        double b() const;
+        constexpr double b() const;
 
         /// @brief Gets the z component of the Plane.
-        double c() const;
+        constexpr double c() const;
 
         /// @brief Gets the constant component of the Plane.
-        double d() const;
+        constexpr double d() const;
 
         /// @brief Gets the normal vector [a,b,c] of the Plane.
         /// @details It is always a unitary vector.
@@ -169,6 +169,13 @@ namespace geom
     protected:
         /// @link Vec4 Vector @endlink (a,b,c,d) defining the plane by the equation ax + by + cz + d = 0
         Vec4 m_plane;
+
+    private:
+        /// @brief Constructor using coefficients already normalized, used by the constant planes
+        constexpr explicit Plane(const Vec4& p_plane);
+
+        /// @brief Values of XOY(), YOX(), XOZ(), ZOX(), YOZ() and ZOY(), initialized at compile time
+        static const Plane s_XOY, s_YOX, s_XOZ, s_ZOX, s_YOZ, s_ZOY;
     };
 
     /// @}
@@ -8,17 +8,72 @@ namespace geom
     // CONSTRUCTORS
 
     //----------------------------------------------------------------------------------------------------------------
-    inline Plane::Plane() : m_plane(1, 0, 0, 0)
+    constexpr Plane::Plane() : m_plane(1, 0, 0, 0)
     //----------------------------------------------------------------------------------------------------------------
     {
     }
 
     //----------------------------------------------------------------------------------------------------------------
-    inline Plane::Plane(const Plane& p_plane) : m_plane(p_plane.m_plane)
+    constexpr Plane::Plane(const Plane& p_plane) : m_plane(p_plane.m_plane)
     //----------------------------------------------------------------------------------------------------------------
     {
     }
 
+    //----------------------------------------------------------------------------------------------------------------
+    constexpr /*explicit*/ Plane::Plane(const Vec4& p_plane) : m_plane(p_plane)
+    //----------------------------------------------------------------------------------------------------------------
+    {
+    }
+
+    inline constexpr Plane Plane::s_XOY(Vec4(0, 0, 1, 0));
+    inline constexpr Plane Plane::s_YOX(Vec4(0, 0, -1, 0));
+    inline constexpr Plane Plane::s_XOZ(Vec4(0, -1, 0, 0));
+    inline constexpr Plane Plane::s_ZOX(Vec4(0, 1, 0, 0));
+    inline constexpr Plane Plane::s_YOZ(Vec4(1, 0, 0, 0));
+    inline constexpr Plane Plane::s_ZOY(Vec4(-1, 0, 0, 0));
+
+    //----------------------------------------------------------------------------------------------------------------
+    /*static*/ constexpr const Plane& Plane::XOY()
+    //----------------------------------------------------------------------------------------------------------------
+    {
+        return s_XOY;
+    }
+
+    //----------------------------------------------------------------------------------------------------------------
+    /*static*/ constexpr const Plane& Plane::YOX()
+    //----------------------------------------------------------------------------------------------------------------
+    {
+        return s_YOX;
+    }
+
+    //----------------------------------------------------------------------------------------------------------------
+    /*static*/ constexpr const Plane& Plane::XOZ()
+    //----------------------------------------------------------------------------------------------------------------
+    {
+        return s_XOZ;
+    }
+
+    //----------------------------------------------------------------------------------------------------------------
+    /*static*/ constexpr const Plane& Plane::ZOX()
+    //----------------------------------------------------------------------------------------------------------------
+    {
+        return s_ZOX;
+    }
+
+    //----------------------------------------------------------------------------------------------------------------
+    /*static*/ constexpr const Plane& Plane::YOZ()
+    //----------------------------------------------------------------------------------------------------------------
+    {
+        return s_YOZ;
+    }
+
+    //----------------------------------------------------------------------------------------------------------------
+    /*static*/ constexpr const Plane& Plane::ZOY()
+    //----------------------------------------------------------------------------------------------------------------
+    {
+        return s_ZOY;
+    }
+
     //----------------------------------------------------------------------------------------------------------------
     inline Plane::Plane(double a, double b, double c, double d, bool *isOk /*=nullptr*/) : Plane()
     //----------------------------------------------------------------------------------------------------------------
@@ -139,28 +194,28 @@ namespace geom
     // ACCESSORS
 
     //----------------------------------------------------------------------------------------------------------------
-    inline double Plane::a() const
+    constexpr double Plane::a() const
     //----------------------------------------------------------------------------------------------------------------
     {
         return m_plane.at(0);
     }
 
     //----------------------------------------------------------------------------------------------------------------
-    inline double Plane::b() const
+    constexpr double Plane::b() const
     //----------------------------------------------------------------------------------------------------------------
     {
         return m_plane.at(1);
     }
 
     //----------------------------------------------------------------------------------------------------------------
-    inline double Plane::c() const
+    constexpr double Plane::c() const
     //----------------------------------------------------------------------------------------------------------------
     {
         return m_plane.at(2);
     }
 
     //----------------------------------------------------------------------------------------------------------------
-    inline double Plane::d() const
+    constexpr double Plane::d() const
     //----------------------------------------------------------------------------------------------------------------
     {
         return m_plane.at(3);
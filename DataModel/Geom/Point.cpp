@@ -1,12 +0,0 @@
-#include "Geom/Point.h"
-
-namespace geom
-{
-    //-------------------------------------------------------------------------------------------------------------------
-    const Point& Point::ORIGIN()
-    //-------------------------------------------------------------------------------------------------------------------
-    {
-        static const Point s_origin(0,0,0);
-        return s_origin;
-    }
-}
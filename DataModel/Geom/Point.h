@@ -24,21 +24,21 @@ namespace geom
 
     public:
         /// @brief Constant Point(0,0,0).
-        static const Point& ORIGIN();
+        static constexpr const Point& ORIGIN();
 
         // CONSTRUCTORS
 
         /// @brief Default constructor
         /// @details This initializes the Point to Point::ORIGIN()
-        Point();
+        constexpr Point();
 
         /// @brief Copy constructor
         /// @details This is initialized using the attributes of @a p_point
-        Point(const Point& p_point);
+        constexpr Point(const Point& p_point);
 
         /// @brief Constructor using 3 doubles (Point coordinates)
         /// @note p_z is optional. Default value is 0
-        Point(double p_x, double p_y, double p_z = 0.0);
+        constexpr Point(double p_x, double p_y, double p_z = 0.0);
 
         // MUTATORS
 
@@ -58,13 +58,13 @@ namespace geom
         // ACCESSORS
 
         /// @brief Gets the x-component
-        double x() const;
+        constexpr double x() const;
 
         /// @brief Gets the y-component
-        double y() const;
+        constexpr double y() const;
 
         /// @brief Gets the z-component
-        double z() const;
+        constexpr double z() const;
 
         // COMPUTERS
 
@@ -124,6 +124,9 @@ namespace geom
         Vector operator-(const Point& p_other) const;
 
     private:
+        /// @brief Value of ORIGIN(), initialized at compile time
+        static const Point s_origin;
+
         /// @brief @link Vec4 Vector @endlink representing the Points coordinates
         /// @note Last coordinate is always 1 (finite Point in homogeneous coordinates)
         Vec4 m_point;
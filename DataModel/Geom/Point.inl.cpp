@@ -4,23 +4,32 @@ namespace geom
 {
 
     //-------------------------------------------------------------------------------------------------------------------
-    inline Point::Point() : m_point(0, 0, 0, 1)
+    constexpr Point::Point() : m_point(0, 0, 0, 1)
     //-------------------------------------------------------------------------------------------------------------------
     {
     }
 
     //-------------------------------------------------------------------------------------------------------------------
-    inline Point::Point(double p_x, double p_y, double p_z) : m_point(p_x, p_y, p_z, 1)
+    constexpr Point::Point(double p_x, double p_y, double p_z) : m_point(p_x, p_y, p_z, 1)
     //-------------------------------------------------------------------------------------------------------------------
     {
     }
 
     //-------------------------------------------------------------------------------------------------------------------
-    inline Point::Point(const Point& p_point) : m_point(p_point.m_point)
+    constexpr Point::Point(const Point& p_point) : m_point(p_point.m_point)
     //-------------------------------------------------------------------------------------------------------------------
     {
     }
 
+    inline constexpr Point Point::s_origin(0, 0, 0);
+
+    //-------------------------------------------------------------------------------------------------------------------
+    /*static*/ constexpr const Point& Point::ORIGIN()
+    //-------------------------------------------------------------------------------------------------------------------
+    {
+        return s_origin;
+    }
+
     //-------------------------------------------------------------------------------------------------------------------
     inline void Point::set(double p_x, double p_y, double p_z)
     //-------------------------------------------------------------------------------------------------------------------
@@ -67,21 +76,21 @@ namespace geom
     //ACCESSORS
 
     //-------------------------------------------------------------------------------------------------------------------
-    inline double Point::x() const
+    constexpr double Point::x() const
     //-------------------------------------------------------------------------------------------------------------------
     {
         return m_point.at(0);
     }
 
     //-------------------------------------------------------------------------------------------------------------------
-    inline double Point::y() const
+    constexpr double Point::y() const
     //-------------------------------------------------------------------------------------------------------------------
     {
         return m_point.at(1);
     }
 
     //-------------------------------------------------------------------------------------------------------------------
-    inline double Point::z() const
+    constexpr double Point::z() const
     //-------------------------------------------------------------------------------------------------------------------
     {
         return m_point.at(2);
@@ -98,11 +107,8 @@ namespace geom
     inline double Point::squaredDistance(const Point& other) const
     //-------------------------------------------------------------------------------------------------------------------
     {
-        const double xDist = x() - other.x();
-        const double yDist = y() - other.y();
-        const double zDist = z() - other.z();
-
-        return xDist*xDist + yDist*yDist + zDist*zDist;
+        // the fourth components of the points cancel out
+        return (m_point - other.m_point).squaredLength();
     }
 
     // OPERATORS
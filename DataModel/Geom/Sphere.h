@@ -0,0 +1,85 @@
+#pragma once
+
+/// @file Sphere.h
+/// @brief Contains the declaration of class gps::geom::Sphere
+/// @ingroup geom
+
+#include "Geom/Point.h"
+
+namespace geom
+{
+    class AABB;
+
+    /// @addtogroup geom
+    /// @{
+
+    /// @class Sphere Sphere.h "GPS/Geom/Sphere.h"
+    /// @brief Class describing a ball of 3d space, given by its center and its radius.
+    /// @details A sphere of negative radius is empty: it is the default sphere, and it contains no point.
+    /// @sa batch::boundingSphere(), AABB::boundingSphere(), Frustum::intersects()
+    class Sphere
+    {
+    public:
+        // CONSTRUCTORS
+
+        /// @brief Default constructor
+        /// @details This initializes an empty sphere centered on Point::ORIGIN(), of radius -1
+        constexpr Sphere();
+
+        /// @brief Constructor using the center and the radius
+        /// @note The sphere is empty if @a p_radius is negative
+        constexpr Sphere(const Point& p_center, double p_radius);
+
+        // MUTATORS
+
+        /// @brief Updates the center and the radius of the sphere.
+        void set(const Point& p_center, double p_radius);
+
+        // ACCESSORS
+
+        /// @brief Gets the center
+        constexpr const Point& center() const;
+
+        /// @brief Gets the radius
+        constexpr double radius() const;
+
+        /// @brief Checks if the sphere is empty
+        /// @return True if the radius is negative
+        constexpr bool isEmpty() const;
+
+        /// @brief Gets the smallest AABB containing the sphere
+        /// @return An empty AABB if the sphere is empty.
+        AABB bounds() const;
+
+        // COMPUTERS
+
+        /// @brief Checks if @a p_point is inside the sphere or on its boundary.
+        bool contains(const Point& p_point) const;
+
+        /// @brief Checks if the two spheres have a common point.
+        /// @return False if one of the spheres is empty.
+        bool intersects(const Sphere& p_other) const;
+
+        // OPERATORS
+
+        /// @brief Sphere strict equality.
+        /// @return True if the centers and the radii are strictly equal
+        bool operator==(const Sphere& p_other) const;
+
+        /// @brief Inequality operator
+        /// @sa operator==()
+        bool operator!=(const Sphere& p_other) const;
+
+    private:
+        /// @brief Center of the sphere
+        Point m_center;
+        /// @brief Radius of the sphere, negative if it is empty
+        double m_radius;
+    };
+
+    /// @}
+}
+
+/// @cond PRIVATE
+#include "Geom/Sphere.inl.cpp"
+/// @endcond
@@ -0,0 +1,95 @@
+#include "Geom/AABB.h"
+
+namespace geom
+{
+    // CONSTRUCTORS
+
+    //-------------------------------------------------------------------------------------------------------------------
+    constexpr Sphere::Sphere() : m_center(0, 0, 0), m_radius(-1)
+    //-------------------------------------------------------------------------------------------------------------------
+    {
+    }
+
+    //-------------------------------------------------------------------------------------------------------------------
+    constexpr Sphere::Sphere(const Point& p_center, double p_radius) : m_center(p_center), m_radius(p_radius)
+    //-------------------------------------------------------------------------------------------------------------------
+    {
+    }
+
+    // MUTATORS
+
+    //-------------------------------------------------------------------------------------------------------------------
+    inline void Sphere::set(const Point& p_center, double p_radius)
+    //-------------------------------------------------------------------------------------------------------------------
+    {
+        m_center = p_center;
+        m_radius = p_radius;
+    }
+
+    // ACCESSORS
+
+    //-------------------------------------------------------------------------------------------------------------------
+    constexpr const Point& Sphere::center() const
+    //-------------------------------------------------------------------------------------------------------------------
+    {
+        return m_center;
+    }
+
+    //-------------------------------------------------------------------------------------------------------------------
+    constexpr double Sphere::radius() const
+    //-------------------------------------------------------------------------------------------------------------------
+    {
+        return m_radius;
+    }
+
+    //-------------------------------------------------------------------------------------------------------------------
+    constexpr bool Sphere::isEmpty() const
+    //-------------------------------------------------------------------------------------------------------------------
+    {
+        return m_radius < 0;
+    }
+
+    //-------------------------------------------------------------------------------------------------------------------
+    inline AABB Sphere::bounds() const
+    //-------------------------------------------------------------------------------------------------------------------
+    {
+        if (isEmpty())
+        {
+            return AABB();
+        }
+        return AABB(m_center.add(-m_radius, -m_radius, -m_radius), m_center.add(m_radius, m_radius, m_radius));
+    }
+
+    // COMPUTERS
+
+    //-------------------------------------------------------------------------------------------------------------------
+    inline bool Sphere::contains(const Point& p_point) const
+    //-------------------------------------------------------------------------------------------------------------------
+    {
+        return !isEmpty() && m_center.squaredDistance(p_point) <= m_radius * m_radius;
+    }
+
+    //-------------------------------------------------------------------------------------------------------------------
+    inline bool Sphere::intersects(const Sphere& p_other) const
+    //-------------------------------------------------------------------------------------------------------------------
+    {
+        const double radii{ m_radius + p_other.m_radius };
+        return !isEmpty() && !p_other.isEmpty() && m_center.squaredDistance(p_other.m_center) <= radii * radii;
+    }
+
+    // OPERATORS
+
+    //-------------------------------------------------------------------------------------------------------------------
+    inline bool Sphere::operator==(const Sphere& p_other) const
+    //-------------------------------------------------------------------------------------------------------------------
+    {
+        return m_center == p_other.m_center && m_radius == p_other.m_radius;
+    }
+
+    //-------------------------------------------------------------------------------------------------------------------
+    inline bool Sphere::operator!=(const Sphere& p_other) const
+    //-------------------------------------------------------------------------------------------------------------------
+    {
+        return !(*this == p_other);
+    }
+}
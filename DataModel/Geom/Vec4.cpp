@@ -1,9 +0,0 @@
-#include "Geom/Vec4.h"
-
-//---------------------------------------------------------------------------------
-/*static*/ const geom::Vec4& geom::Vec4::ZERO()
-//---------------------------------------------------------------------------------
-{
-    static const Vec4 s_zero(0, 0, 0, 0);
-    return s_zero;
-}
@@ -42,20 +42,23 @@ namespace geom
         /// @return A @link Vec4 Vector @endlink containing the result of the multiplication.
         friend Vec4 operator*(double factor, const Vec4& vec);
 
+        // Vector::operator^() runs the cross product kernel on the arrays.
+        friend class Vector;
+
     public:
 
         /// @brief Constant @link Vec4 Vector @endlink with all elements set to 0
-        static const Vec4& ZERO();
+        static constexpr const Vec4& ZERO();
 
         // CONSTRUCTORS
 
         /// @brief Default constructor.
         /// @details This initializes the @link Vec4 Vector @endlink to Vec4::ZERO()
-        Vec4();
+        constexpr Vec4();
 
         /// @brief Copy constructor
         /// @details Builds a @link Vec4 Vector @endlink using the @link Vec4 Vector @endlink provided as parameter.
-        Vec4(const Vec4& other);
+        constexpr Vec4(const Vec4& other);
 
         /// @brief Constructor using 4 doubles.
         /// @details Build a @link Vec4 Vector @endlink using the 4 doubles provided as parameters.
@@ -63,7 +66,7 @@ namespace geom
         /// @param [in] b: Second element
         /// @param [in] c: Third element
         /// @param [in] d: Fourth element
-        explicit Vec4(double a, double b, double c, double d);
+        constexpr explicit Vec4(double a, double b, double c, double d);
 
         /// @brief Constructor using an array of 4 doubles.
         /// @details Build a @link Vec4 Vector @endlink using the array provided as parameter.
@@ -117,7 +120,7 @@ namespace geom
         /// @warning This function does not check if the provided index is in bounds.
         /// If you are not sure that the index is in bound, you should use operator[]() instead.
         /// @sa operator[]()
-        double at(int idx) const;
+        constexpr double at(int idx) const;
 
         // COMPUTERS
 
@@ -186,6 +189,9 @@ namespace geom
         double operator[](int idx) const;
 
     private:
+        /// @brief Value of ZERO(), initialized at compile time
+        static const Vec4 s_zero;
+
         /// @brief Array of doubles containing the elements
         double m_array[4];
     };
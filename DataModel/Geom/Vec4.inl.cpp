@@ -1,3 +1,5 @@
+#include "Geom/Vec4Simd.h"
+
 #include <QtCore/QtDebug>
 
 #include <cmath>
@@ -6,13 +8,13 @@ namespace geom
 {
 
     //---------------------------------------------------------------------------------
-    inline Vec4::Vec4() : m_array{0., 0., 0., 0.}
+    constexpr Vec4::Vec4() : m_array{0., 0., 0., 0.}
     //---------------------------------------------------------------------------------
     {
     }
 
     //---------------------------------------------------------------------------------
-    inline /*explicit*/ Vec4::Vec4(double a, double b, double c, double d): m_array{a, b, c, d}
+    constexpr /*explicit*/ Vec4::Vec4(double a, double b, double c, double d): m_array{a, b, c, d}
     //---------------------------------------------------------------------------------
     {
     }
@@ -29,9 +31,18 @@ namespace geom
     }
 
     //---------------------------------------------------------------------------------
-    inline Vec4::Vec4(const Vec4& other): m_array{ other.m_array[0], other.m_array[1], other.m_array[2], other.m_array[3] }
+    constexpr Vec4::Vec4(const Vec4& other): m_array{ other.m_array[0], other.m_array[1], other.m_array[2], other.m_array[3] }
+    //---------------------------------------------------------------------------------
+    {
+    }
+
+    inline constexpr Vec4 Vec4::s_zero(0, 0, 0, 0);
+
+    //---------------------------------------------------------------------------------
+    /*static*/ constexpr const Vec4& Vec4::ZERO()
     //---------------------------------------------------------------------------------
     {
+        return s_zero;
     }
 
     //---------------------------------------------------------------------------------
@@ -93,7 +104,7 @@ namespace geom
     }
 
     //---------------------------------------------------------------------------------
-    inline double Vec4::at(int idx) const
+    constexpr double Vec4::at(int idx) const
     //---------------------------------------------------------------------------------
     {
         return m_array[idx];
@@ -121,17 +132,16 @@ namespace geom
     inline double Vec4::squaredLength() const
     //---------------------------------------------------------------------------------
     {
-        return sqr(m_array[0]) + sqr(m_array[1]) + sqr(m_array[2]) + sqr(m_array[3]);
+        return simd::dot(m_array, m_array);
     }
 
     //---------------------------------------------------------------------------------
     inline Vec4 Vec4::operator+(const Vec4& other) const
     //---------------------------------------------------------------------------------
     {
-        return Vec4(m_array[0] + other.m_array[0],
-            m_array[1] + other.m_array[1],
-            m_array[2] + other.m_array[2],
-            m_array[3] + other.m_array[3]);
+        Vec4 v;
+        simd::add(m_array, other.m_array, v.m_array);
+        return v;
     }
 
 
@@ -139,37 +149,34 @@ namespace geom
     inline Vec4 Vec4::operator-(const Vec4& other) const
     //---------------------------------------------------------------------------------
     {
-        return Vec4(m_array[0] - other.m_array[0],
-            m_array[1] - other.m_array[1],
-            m_array[2] - other.m_array[2],
-            m_array[3] - other.m_array[3]);
+        Vec4 v;
+        simd::sub(m_array, other.m_array, v.m_array);
+        return v;
     }
 
     //---------------------------------------------------------------------------------
     inline double Vec4::operator*(const Vec4& other) const
     //---------------------------------------------------------------------------------
     {
-        return m_array[0] * other.m_array[0] +
-            m_array[1] * other.m_array[1] +
-            m_array[2] * other.m_array[2] +
-            m_array[3] * other.m_array[3];
+        return simd::dot(m_array, other.m_array);
     }
 
     //---------------------------------------------------------------------------------
     inline Vec4 Vec4::operator*(double factor) const
     //---------------------------------------------------------------------------------
     {
-        return Vec4(factor * m_array[0],
-            factor * m_array[1],
-            factor * m_array[2],
-            factor * m_array[3]);
+        Vec4 v;
+        simd::scale(m_array, factor, v.m_array);
+        return v;
     }
 
     //---------------------------------------------------------------------------------
     inline Vec4 Vec4::operator-() const
     //---------------------------------------------------------------------------------
     {
-        return Vec4(- m_array[0], - m_array[1], - m_array[2], - m_array[3]);
+        Vec4 v;
+        simd::negate(m_array, v.m_array);
+        return v;
     }
 
     //---------------------------------------------------------------------------------
@@ -191,10 +198,7 @@ namespace geom
     inline Vec4& Vec4::operator+=(const Vec4& other)
     //---------------------------------------------------------------------------------
     {
-        m_array[0] += other.m_array[0];
-        m_array[1] += other.m_array[1];
-        m_array[2] += other.m_array[2];
-        m_array[3] += other.m_array[3];
+        simd::add(m_array, other.m_array, m_array);
         return (*this);
     }
 
@@ -202,10 +206,7 @@ namespace geom
     inline Vec4& Vec4::operator-=(const Vec4& other)
     //---------------------------------------------------------------------------------
     {
-        m_array[0] -= other.m_array[0];
-        m_array[1] -= other.m_array[1];
-        m_array[2] -= other.m_array[2];
-        m_array[3] -= other.m_array[3];
+        simd::sub(m_array, other.m_array, m_array);
         return (*this);
     }
 
@@ -213,10 +214,7 @@ namespace geom
     inline Vec4& Vec4::operator*=(double factor)
     //---------------------------------------------------------------------------------
     {
-        m_array[0] *= factor;
-        m_array[1] *= factor;
-        m_array[2] *= factor;
-        m_array[3] *= factor;
+        simd::scale(m_array, factor, m_array);
         return (*this);
     }
 
@@ -249,9 +247,8 @@ namespace geom
     inline /*friend*/ Vec4 operator*(double factor, const Vec4& vec)
     //---------------------------------------------------------------------------------
     {
-        return Vec4(factor * vec.m_array[0],
-            factor * vec.m_array[1],
-            factor * vec.m_array[2],
-            factor * vec.m_array[3]);
+        Vec4 v;
+        simd::scale(vec.m_array, factor, v.m_array);
+        return v;
     }
 }
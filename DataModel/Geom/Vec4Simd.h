@@ -0,0 +1,195 @@
+#pragma once
+
+/// @file Vec4Simd.h
+/// @brief Contains the SIMD kernels of gps::geom::Vec4
+/// @ingroup geom
+
+#if !defined(GEOM_NO_SIMD) && defined(__AVX__)
+    #define GEOM_SIMD_AVX
+    #include <immintrin.h>
+#elif !defined(GEOM_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+    #define GEOM_SIMD_SSE2
+    #include <emmintrin.h>
+#endif
+
+namespace geom
+{
+    /// @addtogroup geom
+    /// @{
+
+    /// @namespace geom::simd
+    /// @brief Kernels on arrays of 4 doubles, used by @link Vec4 Vec4 @endlink, @link Point Point @endlink and @link Vector Vector @endlink.
+    /// @details The instruction set is chosen at compile time: AVX if the compiler targets it (ex. -mavx, -march=native or /arch:AVX),
+    /// SSE2 on x86-64, the scalar fallback otherwise or if GEOM_NO_SIMD is defined. The arrays need no alignment.\n
+    /// The three paths give identical results: the sums of dot() are done in the same order, (p0 + p2) + (p1 + p3) with
+    /// pi = a[i] * b[i], unless the compiler contracts the operations in FMA instructions (-ffp-contract).
+    /// @note Compared to the sequential sum ((p0 + p1) + p2) + p3 of the previous implementation, dot(), and so Vec4::squaredLength(),
+    /// Vec4::length(), Point::distance() and Vector::normalize(), differ by at most 2 ulp of |p0| + |p1| + |p2| + |p3|.
+    /// add(), sub(), scale(), negate() and cross3() are exact and unchanged.
+    namespace simd
+    {
+        /// @brief Name of the compiled path: "avx", "sse2" or "scalar"
+        constexpr const char* instructionSet()
+        {
+#if defined(GEOM_SIMD_AVX)
+            return "avx";
+#elif defined(GEOM_SIMD_SSE2)
+            return "sse2";
+#else
+            return "scalar";
+#endif
+        }
+
+        /// @brief p_out = p_a + p_b
+        inline void add(const double* p_a, const double* p_b, double* p_out)
+        {
+#if defined(GEOM_SIMD_AVX)
+            _mm256_storeu_pd(p_out, _mm256_add_pd(_mm256_loadu_pd(p_a), _mm256_loadu_pd(p_b)));
+#elif defined(GEOM_SIMD_SSE2)
+            _mm_storeu_pd(p_out, _mm_add_pd(_mm_loadu_pd(p_a), _mm_loadu_pd(p_b)));
+            _mm_storeu_pd(p_out + 2, _mm_add_pd(_mm_loadu_pd(p_a + 2), _mm_loadu_pd(p_b + 2)));
+#else
+            for (int i = 0; i < 4; ++i)
+                p_out[i] = p_a[i] + p_b[i];
+#endif
+        }
+
+        /// @brief p_out = p_a - p_b
+        inline void sub(const double* p_a, const double* p_b, double* p_out)
+        {
+#if defined(GEOM_SIMD_AVX)
+            _mm256_storeu_pd(p_out, _mm256_sub_pd(_mm256_loadu_pd(p_a), _mm256_loadu_pd(p_b)));
+#elif defined(GEOM_SIMD_SSE2)
+            _mm_storeu_pd(p_out, _mm_sub_pd(_mm_loadu_pd(p_a), _mm_loadu_pd(p_b)));
+            _mm_storeu_pd(p_out + 2, _mm_sub_pd(_mm_loadu_pd(p_a + 2), _mm_loadu_pd(p_b + 2)));
+#else
+            for (int i = 0; i < 4; ++i)
+                p_out[i] = p_a[i] - p_b[i];
+#endif
+        }
+
+        /// @brief p_out = p_factor * p_a
+        inline void scale(const double* p_a, double p_factor, double* p_out)
+        {
+#if defined(GEOM_SIMD_AVX)
+            _mm256_storeu_pd(p_out, _mm256_mul_pd(_mm256_set1_pd(p_factor), _mm256_loadu_pd(p_a)));
+#elif defined(GEOM_SIMD_SSE2)
+            const __m128d factor = _mm_set1_pd(p_factor);
+            _mm_storeu_pd(p_out, _mm_mul_pd(factor, _mm_loadu_pd(p_a)));
+            _mm_storeu_pd(p_out + 2, _mm_mul_pd(factor, _mm_loadu_pd(p_a + 2)));
+#else
+            for (int i = 0; i < 4; ++i)
+                p_out[i] = p_factor * p_a[i];
+#endif
+        }
+
+        /// @brief p_out = -p_a, the signs of the zeros are flipped as the scalar negation
+        inline void negate(const double* p_a, double* p_out)
+        {
+#if defined(GEOM_SIMD_AVX)
+            _mm256_storeu_pd(p_out, _mm256_xor_pd(_mm256_loadu_pd(p_a), _mm256_set1_pd(-0.0)));
+#elif defined(GEOM_SIMD_SSE2)
+            const __m128d signMask = _mm_set1_pd(-0.0);
+            _mm_storeu_pd(p_out, _mm_xor_pd(_mm_loadu_pd(p_a), signMask));
+            _mm_storeu_pd(p_out + 2, _mm_xor_pd(_mm_loadu_pd(p_a + 2), signMask));
+#else
+            for (int i = 0; i < 4; ++i)
+                p_out[i] = -p_a[i];
+#endif
+        }
+
+        /// @brief Componentwise p_out = p_a < p_b ? p_a : p_b, as _mm_min_pd: p_b if one of them is NaN
+        inline void min(const double* p_a, const double* p_b, double* p_out)
+        {
+#if defined(GEOM_SIMD_AVX)
+            _mm256_storeu_pd(p_out, _mm256_min_pd(_mm256_loadu_pd(p_a), _mm256_loadu_pd(p_b)));
+#elif defined(GEOM_SIMD_SSE2)
+            _mm_storeu_pd(p_out, _mm_min_pd(_mm_loadu_pd(p_a), _mm_loadu_pd(p_b)));
+            _mm_storeu_pd(p_out + 2, _mm_min_pd(_mm_loadu_pd(p_a + 2), _mm_loadu_pd(p_b + 2)));
+#else
+            for (int i = 0; i < 4; ++i)
+                p_out[i] = p_a[i] < p_b[i] ? p_a[i] : p_b[i];
+#endif
+        }
+
+        /// @brief Componentwise p_out = p_a > p_b ? p_a : p_b, as _mm_max_pd: p_b if one of them is NaN
+        inline void max(const double* p_a, const double* p_b, double* p_out)
+        {
+#if defined(GEOM_SIMD_AVX)
+            _mm256_storeu_pd(p_out, _mm256_max_pd(_mm256_loadu_pd(p_a), _mm256_loadu_pd(p_b)));
+#elif defined(GEOM_SIMD_SSE2)
+            _mm_storeu_pd(p_out, _mm_max_pd(_mm_loadu_pd(p_a), _mm_loadu_pd(p_b)));
+            _mm_storeu_pd(p_out + 2, _mm_max_pd(_mm_loadu_pd(p_a + 2), _mm_loadu_pd(p_b + 2)));
+#else
+            for (int i = 0; i < 4; ++i)
+                p_out[i] = p_a[i] > p_b[i] ? p_a[i] : p_b[i];
+#endif
+        }
+
+        /// @brief p_out = M * p_a, M being the 4x4 matrix of coefficients p_matrix in column-major order
+        /// @details p_out[i] = ((M[i][0] * p_a[0] + M[i][1] * p_a[1]) + M[i][2] * p_a[2]) + M[i][3] * p_a[3] in the three paths.
+        inline void transform(const double* p_matrix, const double* p_a, double* p_out)
+        {
+#if defined(GEOM_SIMD_AVX)
+            const __m256d xy = _mm256_add_pd(_mm256_mul_pd(_mm256_loadu_pd(p_matrix), _mm256_set1_pd(p_a[0])),
+                _mm256_mul_pd(_mm256_loadu_pd(p_matrix + 4), _mm256_set1_pd(p_a[1])));
+            const __m256d xyz = _mm256_add_pd(xy, _mm256_mul_pd(_mm256_loadu_pd(p_matrix + 8), _mm256_set1_pd(p_a[2])));
+            _mm256_storeu_pd(p_out, _mm256_add_pd(xyz, _mm256_mul_pd(_mm256_loadu_pd(p_matrix + 12), _mm256_set1_pd(p_a[3]))));
+#elif defined(GEOM_SIMD_SSE2)
+            const __m128d x = _mm_set1_pd(p_a[0]), y = _mm_set1_pd(p_a[1]), z = _mm_set1_pd(p_a[2]), w = _mm_set1_pd(p_a[3]);
+            for (int i = 0; i < 4; i += 2)
+            {
+                const __m128d xy = _mm_add_pd(_mm_mul_pd(_mm_loadu_pd(p_matrix + i), x), _mm_mul_pd(_mm_loadu_pd(p_matrix + 4 + i), y));
+                const __m128d xyz = _mm_add_pd(xy, _mm_mul_pd(_mm_loadu_pd(p_matrix + 8 + i), z));
+                _mm_storeu_pd(p_out + i, _mm_add_pd(xyz, _mm_mul_pd(_mm_loadu_pd(p_matrix + 12 + i), w)));
+            }
+#else
+            const double x = p_a[0], y = p_a[1], z = p_a[2], w = p_a[3];
+            for (int i = 0; i < 4; ++i)
+                p_out[i] = ((p_matrix[i] * x + p_matrix[4 + i] * y) + p_matrix[8 + i] * z) + p_matrix[12 + i] * w;
+#endif
+        }
+
+        /// @brief Dot product of the 4 components, see the note of the namespace for the summation order
+        inline double dot(const double* p_a, const double* p_b)
+        {
+#if defined(GEOM_SIMD_AVX)
+            const __m256d products = _mm256_mul_pd(_mm256_loadu_pd(p_a), _mm256_loadu_pd(p_b));
+            const __m128d sums = _mm_add_pd(_mm256_castpd256_pd128(products), _mm256_extractf128_pd(products, 1));
+            return _mm_cvtsd_f64(_mm_add_sd(sums, _mm_unpackhi_pd(sums, sums)));
+#elif defined(GEOM_SIMD_SSE2)
+            const __m128d sums = _mm_add_pd(_mm_mul_pd(_mm_loadu_pd(p_a), _mm_loadu_pd(p_b)), _mm_mul_pd(_mm_loadu_pd(p_a + 2), _mm_loadu_pd(p_b + 2)));
+            return _mm_cvtsd_f64(_mm_add_sd(sums, _mm_unpackhi_pd(sums, sums)));
+#else
+            return (p_a[0] * p_b[0] + p_a[2] * p_b[2]) + (p_a[1] * p_b[1] + p_a[3] * p_b[3]);
+#endif
+        }
+
+        /// @brief Cross product of the 3 first components, p_out[3] is 0
+        /// @details Same operations as the scalar formula: p_out[0] = p_a[1] * p_b[2] - p_a[2] * p_b[1], etc.
+        inline void cross3(const double* p_a, const double* p_b, double* p_out)
+        {
+#if defined(GEOM_SIMD_AVX) || defined(GEOM_SIMD_SSE2)
+            // c = a * b.yzx - a.yzx * b is (z, x, y, 0) of the cross product
+            const __m128d a01 = _mm_loadu_pd(p_a), a23 = _mm_loadu_pd(p_a + 2);
+            const __m128d b01 = _mm_loadu_pd(p_b), b23 = _mm_loadu_pd(p_b + 2);
+            const __m128d a12 = _mm_shuffle_pd(a01, a23, 0b01), a03 = _mm_shuffle_pd(a01, a23, 0b10);
+            const __m128d b12 = _mm_shuffle_pd(b01, b23, 0b01), b03 = _mm_shuffle_pd(b01, b23, 0b10);
+            const __m128d c01 = _mm_sub_pd(_mm_mul_pd(a01, b12), _mm_mul_pd(a12, b01));
+            const __m128d c2 = _mm_sub_sd(_mm_mul_sd(a23, b03), _mm_mul_sd(a03, b23));
+            _mm_storeu_pd(p_out, _mm_shuffle_pd(c01, c2, 0b01));
+            _mm_storeu_pd(p_out + 2, _mm_unpacklo_pd(c01, _mm_setzero_pd()));
+#else
+            const double x = p_a[1] * p_b[2] - p_a[2] * p_b[1];
+            const double y = p_a[2] * p_b[0] - p_a[0] * p_b[2];
+            const double z = p_a[0] * p_b[1] - p_a[1] * p_b[0];
+            p_out[0] = x;
+            p_out[1] = y;
+            p_out[2] = z;
+            p_out[3] = 0.;
+#endif
+        }
+    }
+
+    /// @}
+}
@@ -32,27 +32,27 @@ namespace geom
 
     public:
         /// @brief Constant null Vector.
-        static const Vector& ZERO();
+        static constexpr const Vector& ZERO();
         /// @brief Constant unit Vector in x direction.
-        static const Vector& I();
+        static constexpr const Vector& I();
         /// @brief Constant unit Vector in y direction.
-        static const Vector& J();
+        static constexpr const Vector& J();
         /// @brief Constant unit Vector in z direction.
-        static const Vector& K();
+        static constexpr const Vector& K();
 
         // CONSTRUCTORS
 
         /// @brief Default constructor
         /// @details This initializes the Vector to Vector::ZERO()
-        Vector();
+        constexpr Vector();
 
         /// @brief Copy constructor
         /// @details This is initialized using the attributes of @a p_vec
-        Vector(const Vector& p_vec);
+        constexpr Vector(const Vector& p_vec);
 
         /// @brief Constructor using 3 doubles (Vector coordinates)
         /// @note p_z is optional. Default value is 0
-        explicit Vector(double p_x, double p_y, double p_z = 0.0);
+        constexpr explicit Vector(double p_x, double p_y, double p_z = 0.0);
 
         /// @brief Constructor using 2 @link Point Points @endlink
         /// @note Vector is oriented from @a p_point1 to @a p_point2
@@ -80,13 +80,13 @@ namespace geom
         // ACCESSORS
 
         /// @brief Gets the x-component
-        double x() const;
+        constexpr double x() const;
 
         /// @brief Gets the y-component
-        double y() const;
+        constexpr double y() const;
 
         /// @brief Gets the z-component
-        double z() const;
+        constexpr double z() const;
 
         /// @brief Gets the normalized vector pointing to the same direction
         /// @details If @a this is null, Vector::ZERO() is returned
@@ -186,6 +186,9 @@ namespace geom
         Vector operator^(const Vector& p_other) const;
 
     private:
+        /// @brief Values of ZERO(), I(), J() and K(), initialized at compile time
+        static const Vector s_zero, s_i, s_j, s_k;
+
         /// @link Vec4 Vector of double @endlink containing the vector coordinates
         /// @note Last coordinate is always 0 (Infinite Point in homogeneous coordinates)
         Vec4 m_vec;
@@ -6,13 +6,13 @@ namespace geom
 {
 
     //-------------------------------------------------------------------------------------------------------------------
-    inline Vector::Vector() : m_vec(0, 0, 0, 0)
+    constexpr Vector::Vector() : m_vec(0, 0, 0, 0)
     //-------------------------------------------------------------------------------------------------------------------
     {
     }
 
     //-------------------------------------------------------------------------------------------------------------------
-    inline Vector::Vector(double p_x, double p_y, double p_z /*=0*/) : m_vec(p_x, p_y, p_z, 0)
+    constexpr Vector::Vector(double p_x, double p_y, double p_z /*=0*/) : m_vec(p_x, p_y, p_z, 0)
     //-------------------------------------------------------------------------------------------------------------------
     {
     }
@@ -25,11 +25,44 @@ namespace geom
     }
 
     //--------------------------------------------------------------------------------------------------------------
-    inline Vector::Vector(const Vector& p_vec) : m_vec(p_vec.m_vec)
+    constexpr Vector::Vector(const Vector& p_vec) : m_vec(p_vec.m_vec)
     //--------------------------------------------------------------------------------------------------------------
     {
     }
 
+    inline constexpr Vector Vector::s_zero(0, 0, 0);
+    inline constexpr Vector Vector::s_i(1, 0, 0);
+    inline constexpr Vector Vector::s_j(0, 1, 0);
+    inline constexpr Vector Vector::s_k(0, 0, 1);
+
+    //--------------------------------------------------------------------------------------------------------------
+    /*static*/ constexpr const Vector& Vector::ZERO()
+    //--------------------------------------------------------------------------------------------------------------
+    {
+        return s_zero;
+    }
+
+    //--------------------------------------------------------------------------------------------------------------
+    /*static*/ constexpr const Vector& Vector::I()
+    //--------------------------------------------------------------------------------------------------------------
+    {
+        return s_i;
+    }
+
+    //--------------------------------------------------------------------------------------------------------------
+    /*static*/ constexpr const Vector& Vector::J()
+    //--------------------------------------------------------------------------------------------------------------
+    {
+        return s_j;
+    }
+
+    //--------------------------------------------------------------------------------------------------------------
+    /*static*/ constexpr const Vector& Vector::K()
+    //--------------------------------------------------------------------------------------------------------------
+    {
+        return s_k;
+    }
+
     //--------------------------------------------------------------------------------------------------------------
     inline void Vector::set(double p_x, double p_y, double p_z)
     //--------------------------------------------------------------------------------------------------------------
@@ -66,21 +99,21 @@ namespace geom
     }
 
     //--------------------------------------------------------------------------------------------------------------
-    inline double Vector::x() const
+    constexpr double Vector::x() const
     //--------------------------------------------------------------------------------------------------------------
     {
         return m_vec.at(0);
     }
 
     //--------------------------------------------------------------------------------------------------------------
-    inline double Vector::y() const
+    constexpr double Vector::y() const
     //--------------------------------------------------------------------------------------------------------------
     {
         return m_vec.at(1);
     }
 
     //--------------------------------------------------------------------------------------------------------------
-    inline double Vector::z() const
+    constexpr double Vector::z() const
     //--------------------------------------------------------------------------------------------------------------
     {
         return m_vec.at(2);
@@ -135,8 +168,8 @@ namespace geom
         }
         else
         {
-            const double invFactor = 1.0 / p_factor;
-            const Vector v(x() * invFactor, y() * invFactor, z() * invFactor);
+            Vector v;
+            v.m_vec = m_vec * (1.0 / p_factor);
             return v;
         }
     }
@@ -152,10 +185,7 @@ namespace geom
         }
         else
         {
-            double invFactor = 1.0 / p_factor;
-            m_vec.at(0) = m_vec.at(0) * invFactor;
-            m_vec.at(1) = m_vec.at(1) * invFactor;
-            m_vec.at(2) = m_vec.at(2) * invFactor;
+            m_vec *= 1.0 / p_factor;
             return (*this);
         }
     }
@@ -189,10 +219,8 @@ namespace geom
 
         if (d != 0)
         {
-            const double invd = 1.0 / d;
-            m_vec.at(0) = m_vec.at(0) * invd;
-            m_vec.at(1) = m_vec.at(1) * invd;
-            m_vec.at(2) = m_vec.at(2) * invd;
+            // the fourth component of a vector is 0
+            m_vec *= 1.0 / d;
             return true;
         }
         else
@@ -253,7 +281,8 @@ namespace geom
     inline Vector Vector::operator*(double p_factor) const
     //--------------------------------------------------------------------------------------------------------------
     {
-        const Vector v(x() * p_factor, y() * p_factor, z() * p_factor);
+        Vector v;
+        v.m_vec = m_vec * p_factor;
         return v;
     }
 
@@ -262,9 +291,9 @@ namespace geom
     //-----------------------------------------------------------------------------------
     {
         // Cross Product is written here because there is no generic cross product for 4D Vectors
-        return Vector(y() * p_vector2.z() - z() * p_vector2.y(),
-            z() * p_vector2.x() - x() * p_vector2.z(),
-            x() * p_vector2.y() - y() * p_vector2.x());
+        Vector v;
+        simd::cross3(m_vec.m_array, p_vector2.m_vec.m_array, v.m_vec.m_array);
+        return v;
     }
 
     //-----------------------------------------------------------------------------------
@@ -1,21 +1,34 @@
 #include "Mesh/MeshModel.h"
 
+#include "Geom/Batch.h"
+
 #include <QtCore/QFile>
 #include <QtCore/QtDebug>
 #include <QtCore/QTextStream>
 #include <QtCore/QVarLengthArray>
 
+#include <atomic>
+
+namespace
+{
+    static std::atomic<quint64> s_lastRevision{ 0 };
+}
+
 //-----------------------------------------------------------------------------
 MeshModel::MeshModel()
+    : m_revision(0)
 //-----------------------------------------------------------------------------
 {
+    updateRevision();
 }
 
 //-----------------------------------------------------------------------------
 MeshModel::MeshModel(const QString &p_filePath, bool p_flipY/*=false*/, bool p_copyNormals/*=false*/)
     : m_fileName(p_filePath)
+    , m_revision(0)
 //-----------------------------------------------------------------------------
 {
+    updateRevision();
     loadObjFile(m_fileName, p_flipY, p_copyNormals);
 }
 
@@ -34,6 +47,8 @@ void MeshModel::clear()
     m_normals.clear();
     m_texIndices.clear();
     m_pointIndices.clear();
+    m_bounds = geom::AABB();
+    updateRevision();
 }
 
 //-----------------------------------------------------------------------------
@@ -44,9 +59,6 @@ void MeshModel::loadObjFile(const QString& p_filePath, bool p_flipY, bool p_copy
 
     bool hasNormals = false;
 
-    geom::Point boundsMin( 1e9, 1e9, 1e9);
-    geom::Point boundsMax(-1e9,-1e9,-1e9);
-
     QFile file(p_filePath);
     if (!file.open(QIODevice::ReadOnly))
     {
@@ -68,13 +80,6 @@ void MeshModel::loadObjFile(const QString& p_filePath, bool p_flipY, bool p_copy
         {
             double px, py, pz;
             ts >> px >> py >> pz;
-            boundsMin.x(qMin(boundsMin.x(), px));
-            boundsMin.y(qMin(boundsMin.y(), py));
-            boundsMin.z(qMin(boundsMin.z(), pz));
-            boundsMax.x(qMax(boundsMax.x(), px));
-            boundsMax.y(qMax(boundsMax.y(), py));
-            boundsMax.z(qMax(boundsMax.z(), pz));
-
             m_points << geom::Point(px,p_flipY?-py:py,pz);
         }
         else if (id == "f" || id == "fo")
@@ -145,21 +150,11 @@ void MeshModel::loadObjFile(const QString& p_filePath, bool p_flipY, bool p_copy
 
     }
 
+    computeBounds();
 
     if (!p_copyNormals || !hasNormals) // re-computes normals by default, or if normals were supposed to be copied but there were none in input file
     {
-        m_normals.resize(m_points.size());
-        for (int i = 0; i < m_pointIndices.size(); i += 3)
-        {
-            const geom::Point a = m_points.at(m_pointIndices.at(i));
-            const geom::Point b = m_points.at(m_pointIndices.at(i+1));
-            const geom::Point c = m_points.at(m_pointIndices.at(i+2));
-
-            const geom::Vector normal = (geom::Vector(b - a)^geom::Vector(c - a)).normalized();
-      
-            for (int j = 0; j < 3; ++j)
-                m_normals[m_pointIndices.at(i + j)] += normal;
-        }
+        computeNormals();
     }
 
     file.close();
@@ -171,3 +166,50 @@ void MeshModel::loadObjPath(const QString& p_filePath, bool p_flipY)
 {
     loadObjFile(p_filePath, p_flipY, false /*compute normals*/);
 }
+
+//-----------------------------------------------------------------------------
+void MeshModel::setTriangles(const QString& p_name, const QVector<geom::Point>& p_points, const QVector<int>& p_pointIndices)
+//-----------------------------------------------------------------------------
+{
+    clear();
+    m_fileName = p_name;
+    m_points = p_points;
+    m_pointIndices = p_pointIndices;
+    computeBounds();
+    computeNormals();
+}
+
+//-----------------------------------------------------------------------------
+void MeshModel::computeNormals()
+//-----------------------------------------------------------------------------
+{
+    m_normals.fill(geom::Vector(), m_points.size());
+
+    // the face normals are computed in parallel by chunks, then summed in the face order
+    const int chunkSize = 1 << 16;
+    QVector<geom::Vector> faceNormals(qMin(chunkSize, faceCount()));
+    for (int first = 0; first < faceCount(); first += chunkSize)
+    {
+        const int count = qMin(chunkSize, faceCount() - first);
+        geom::batch::triangleNormals(m_points.constData(), m_pointIndices.constData() + 3 * first, static_cast<size_t>(count), faceNormals.data());
+
+        for (int i = 0; i < count; ++i)
+            for (int j = 0; j < 3; ++j)
+                m_normals[m_pointIndices.at(3 * (first + i) + j)] += faceNormals.at(i);
+    }
+}
+
+//-----------------------------------------------------------------------------
+void MeshModel::computeBounds()
+//-----------------------------------------------------------------------------
+{
+    m_bounds = geom::batch::bounds(m_points.constData(), static_cast<size_t>(m_points.size()));
+    updateRevision();
+}
+
+//-----------------------------------------------------------------------------
+void MeshModel::updateRevision()
+//-----------------------------------------------------------------------------
+{
+    m_revision = ++s_lastRevision;
+}
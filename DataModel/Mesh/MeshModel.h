@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Geom/AABB.h"
 #include "Geom/Point.h"
 
 #include <QtCore/QString>
@@ -24,15 +25,35 @@ public:
     
     inline const QVector<int>& vtxIndices() const { return m_pointIndices; }
 
+    /// \brief Bounding box of the vertices, empty if there is no vertex
+    inline const geom::AABB& bounds() const { return m_bounds; }
+
+    /// \brief Changes at each modification of the geometry, unique among all the meshes of the process:
+    /// the caches built from a mesh (ex. the triangle sorters) compare it to know if they are still valid
+    inline quint64 revision() const { return m_revision; }
+
     /// \brief Call \c loadObjFile but open the file given by the path \c p_filePath before
     void loadObjPath(const QString& p_filePath, bool p_flipY);
 
+    /// \brief Replace the mesh by the triangles \c p_pointIndices (3 by face) of \c p_points, normals are computed.
+    /// Used by the procedural meshes (SceneGenerator), \c p_name is returned by fileName()
+    void setTriangles(const QString& p_name, const QVector<geom::Point>& p_points, const QVector<int>& p_pointIndices);
+
 protected:
 
     /// \brief Load data from file \c p_filePath.
     /// Normals are computed, not read, expected if p_copyNormals is set to true
     void loadObjFile(const QString& p_filePath, bool p_flipY, bool p_copyNormals);
 
+    /// \brief Vertex normals as the sum of the normals of their faces
+    void computeNormals();
+
+    /// \brief Bounding box of the vertices, see bounds(). Called after each geometry change, it updates the revision
+    void computeBounds();
+
+    /// \brief New value of revision()
+    void updateRevision();
+
 private:
     QString m_fileName;
 
@@ -41,4 +62,8 @@ private:
 
     QVector<int> m_texIndices;
     QVector<int> m_pointIndices; 
+
+    geom::AABB m_bounds;
+
+    quint64 m_revision;
 }; 
@@ -0,0 +1,226 @@
+#include "Mesh/SceneGenerator.h"
+
+#include <QtCore/QVector>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace
+{
+    static constexpr double sceneSize() { return 100.; }
+    static constexpr double pi() { return 3.14159265358979323846; }
+
+    struct Surface
+    {
+        QVector<geom::Point> points;
+        QVector<int> indices;
+    };
+
+    // std::mt19937 gives the same numbers on all the platforms, not the std distributions
+    static double random(std::mt19937& p_generator, double p_min, double p_max)
+    {
+        return p_min + (p_max - p_min) * (static_cast<double>(p_generator()) / 4294967296.);
+    }
+
+    //!< UV sphere of about p_triangleCount triangles, counterclockwise seen from outside, p_radius(theta, phi)
+    template <typename RadiusFunction>
+    static Surface sphere(const geom::Point& p_center, int p_triangleCount, RadiusFunction p_radius)
+    {
+        // 4 * rings * (rings - 1) triangles with 2 * rings segments
+        const int ringCount{ std::max(2, static_cast<int>(std::lround((1. + std::sqrt(1. + p_triangleCount)) / 2.))) };
+        const int segmentCount{ 2 * ringCount };
+
+        Surface surface;
+        const auto vertex = [&](double p_theta, double p_phi)
+        {
+            const double radius{ p_radius(p_theta, p_phi) };
+            surface.points << p_center + geom::Vector(radius * std::sin(p_theta) * std::cos(p_phi), radius * std::cos(p_theta), radius * std::sin(p_theta) * std::sin(p_phi));
+        };
+
+        vertex(0., 0.);
+        for (int i = 1; i < ringCount; i++)
+        {
+            for (int j = 0; j < segmentCount; j++)
+            {
+                vertex(pi() * i / ringCount, 2. * pi() * j / segmentCount);
+            }
+        }
+        vertex(pi(), 0.);
+
+        const int southPole{ surface.points.size() - 1 };
+        const auto ringVertex = [&](int p_ring, int p_segment)
+        {
+            if (p_ring == 0)
+            {
+                return 0;
+            }
+            if (p_ring == ringCount)
+            {
+                return southPole;
+            }
+            return 1 + (p_ring - 1) * segmentCount + p_segment % segmentCount;
+        };
+
+        for (int i = 0; i < ringCount; i++)
+        {
+            for (int j = 0; j < segmentCount; j++)
+            {
+                const int a{ ringVertex(i, j) }, b{ ringVertex(i + 1, j) }, c{ ringVertex(i + 1, j + 1) }, d{ ringVertex(i, j + 1) };
+                if (i != ringCount - 1)
+                {
+                    surface.indices << a << c << b;
+                }
+                if (i != 0)
+                {
+                    surface.indices << a << d << c;
+                }
+            }
+        }
+        return surface;
+    }
+
+    //!< Square grid of side sceneSize() at p_z facing +z, about p_triangleCount triangles
+    static Surface plane(double p_z, int p_triangleCount)
+    {
+        const int quadCount{ std::max(1, static_cast<int>(std::lround(std::sqrt(p_triangleCount / 2.)))) };
+        const double step{ sceneSize() / quadCount };
+
+        Surface surface;
+        for (int i = 0; i <= quadCount; i++)
+        {
+            for (int j = 0; j <= quadCount; j++)
+            {
+                surface.points << geom::Point(-sceneSize() / 2. + j * step, -sceneSize() / 2. + i * step, p_z);
+            }
+        }
+        for (int i = 0; i < quadCount; i++)
+        {
+            for (int j = 0; j < quadCount; j++)
+            {
+                const int a{ i * (quadCount + 1) + j }, b{ a + 1 }, c{ b + quadCount + 1 }, d{ a + quadCount + 1 };
+                surface.indices << a << b << c << a << c << d;
+            }
+        }
+        return surface;
+    }
+
+    static std::vector<Surface> surfaces(const SceneGenerator::Parameters& p_parameters)
+    {
+        const int depthComplexity{ std::max(1, p_parameters.depthComplexity) };
+        std::vector<Surface> result;
+        switch (p_parameters.layout)
+        {
+        case SceneGenerator::Layout::NESTED_SHELLS:
+        {
+            const int shellCount{ (depthComplexity + 1) / 2 };
+            for (int i = 0; i < shellCount; i++)
+            {
+                const double radius{ sceneSize() / 2. * (i + 1) / shellCount };
+                result.push_back(sphere(geom::Point::ORIGIN(), p_parameters.triangleCount / shellCount, [radius](double, double) { return radius; }));
+            }
+            break;
+        }
+        case SceneGenerator::Layout::STACKED_PLANES:
+        {
+            for (int i = 0; i < depthComplexity; i++)
+            {
+                const double z{ depthComplexity == 1 ? 0. : sceneSize() * (static_cast<double>(i) / (depthComplexity - 1) - 0.5) };
+                result.push_back(plane(z, p_parameters.triangleCount / depthComplexity));
+            }
+            break;
+        }
+        case SceneGenerator::Layout::RANDOM_BLOBS:
+        {
+            // N spheres of radius r in a cube of side L are crossed 2 * N * pi * r^2 / L^2 times in mean by a line of sight
+            const int blobCount{ std::max(1, p_parameters.objectCount) };
+            const double radius{ std::clamp(sceneSize() * std::sqrt(depthComplexity / (2. * pi() * blobCount)), 1., sceneSize() / 2.) };
+            std::mt19937 generator(p_parameters.seed);
+            for (int i = 0; i < blobCount; i++)
+            {
+                const double margin{ sceneSize() / 2. - radius };
+                const geom::Point center(random(generator, -margin, margin), random(generator, -margin, margin), random(generator, -margin, margin));
+                const double frequency{ std::floor(random(generator, 2., 6.)) };
+                const double thetaPhase{ random(generator, 0., 2. * pi()) };
+                const double phiPhase{ random(generator, 0., 2. * pi()) };
+                result.push_back(sphere(center, p_parameters.triangleCount / blobCount, [=](double p_theta, double p_phi)
+                {
+                    return radius * (1. + 0.15 * std::sin(frequency * p_theta + thetaPhase) * std::sin(frequency * p_phi + phiPhase));
+                }));
+            }
+            break;
+        }
+        }
+        return result;
+    }
+}
+
+//-----------------------------------------------------------------------------
+std::vector<SceneGenerator::Object> SceneGenerator::generate(const Parameters& p_parameters)
+//-----------------------------------------------------------------------------
+{
+    const std::vector<Surface> sceneSurfaces{ surfaces(p_parameters) };
+
+    // the surfaces are interleaved so each object spans the depth of the scene
+    const int objectCount{ std::clamp(p_parameters.objectCount, 1, static_cast<int>(sceneSurfaces.size())) };
+    const double opaqueRatio{ std::clamp(p_parameters.opaqueRatio, 0., 1.) };
+
+    std::vector<Object> objects(static_cast<size_t>(objectCount));
+    for (int i = 0; i < objectCount; i++)
+    {
+        QVector<geom::Point> points;
+        QVector<int> indices;
+        for (size_t j = static_cast<size_t>(i); j < sceneSurfaces.size(); j += static_cast<size_t>(objectCount))
+        {
+            const int offset{ points.size() };
+            points << sceneSurfaces[j].points;
+            for (const int index : sceneSurfaces[j].indices)
+            {
+                indices << offset + index;
+            }
+        }
+
+        Object& object{ objects[static_cast<size_t>(i)] };
+        object.mesh.setTriangles(QString("%1_%2").arg(layoutName(p_parameters.layout)).arg(i), points, indices);
+        // the opaque objects are spread among the others, not all the outer ones
+        object.isOpaque = std::floor((i + 1) * opaqueRatio) > std::floor(i * opaqueRatio);
+    }
+    return objects;
+}
+
+//-----------------------------------------------------------------------------
+QString SceneGenerator::layoutName(Layout p_layout)
+//-----------------------------------------------------------------------------
+{
+    switch (p_layout)
+    {
+    case Layout::NESTED_SHELLS:
+        return "shells";
+    case Layout::STACKED_PLANES:
+        return "planes";
+    default:
+        return "blobs";
+    }
+}
+
+//-----------------------------------------------------------------------------
+bool SceneGenerator::layoutFromName(const QString& p_name, Layout& p_layout)
+//-----------------------------------------------------------------------------
+{
+    for (const Layout layout : { Layout::NESTED_SHELLS, Layout::STACKED_PLANES, Layout::RANDOM_BLOBS })
+    {
+        if (p_name == layoutName(layout))
+        {
+            p_layout = layout;
+            return true;
+        }
+    }
+    return false;
+}
+
+//-----------------------------------------------------------------------------
+QStringList SceneGenerator::layoutNames()
+//-----------------------------------------------------------------------------
+{
+    return { layoutName(Layout::NESTED_SHELLS), layoutName(Layout::STACKED_PLANES), layoutName(Layout::RANDOM_BLOBS) };
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "Mesh/MeshModel.h"
+
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+
+#include <vector>
+
+/// \brief Procedural scenes of transparent and opaque meshes for the scaling studies of the transparency engines
+///
+/// The depth complexity is the number of surfaces crossed by the view axis at the center of the scene:
+/// - NESTED_SHELLS: concentric spheres, each shell is crossed twice
+/// - STACKED_PLANES: square grids facing the z axis, one layer each, the depth complexity is the same on the whole square
+/// - RANDOM_BLOBS: bumpy spheres spread in a cube, their radius gives the requested mean depth complexity
+/// The triangles are shared evenly by the surfaces, the surfaces by the objects. The same parameters give the same scene.
+class SceneGenerator
+{
+public:
+    enum class Layout { NESTED_SHELLS, STACKED_PLANES, RANDOM_BLOBS };
+
+    struct Parameters
+    {
+        Layout layout = Layout::NESTED_SHELLS;
+        int triangleCount = 100000; //!< total, approximated by the tessellation
+        int objectCount = 1; //!< meshes, for RANDOM_BLOBS the number of blobs
+        int depthComplexity = 8; //!< surfaces crossed at the center of the scene
+        double opaqueRatio = 0.; //!< part of the objects in [0, 1] to render opaque
+        unsigned int seed = 1; //!< random placement and shape of the blobs
+    };
+
+    struct Object
+    {
+        MeshModel mesh;
+        bool isOpaque = false;
+    };
+
+    /// \brief The objects of the scene, in a cube of 100 units centered on the origin
+    static std::vector<Object> generate(const Parameters& p_parameters);
+
+    static QString layoutName(Layout p_layout); //!< "shells", "planes" or "blobs"
+    static bool layoutFromName(const QString& p_name, Layout& p_layout);
+    static QStringList layoutNames();
+};
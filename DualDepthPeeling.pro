@@ -3,7 +3,14 @@ TEMPLATE = subdirs
 SUBDIRS = \
     Gui \
     DataModel \
-    App
+    App \
+    Headless \
+    Benchmarks
 
 App.file = App/DualDepthPeelingApp.pro
 App.depends = DataModel Gui
+
+Headless.file = App/Headless/DualDepthPeelingHeadless.pro
+Headless.depends = DataModel Gui
+
+Benchmarks.depends = DataModel Gui
@@ -0,0 +1,219 @@
+#include "GLWidgets/CameraSession.h"
+
+#include "GLWidgets/Camera.h"
+
+#include <QtCore/QDebug>
+#include <QtCore/QFile>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+
+#include <algorithm>
+
+namespace
+{
+    static const char* actionName(gui::CameraSession::Action p_action)
+    {
+        switch (p_action)
+        {
+        case gui::CameraSession::Action::ROTATE:
+            return "rotate";
+        case gui::CameraSession::Action::TRANSLATE:
+            return "translate";
+        default:
+            return "zoom";
+        }
+    }
+
+    static QJsonArray matrixToJson(const QMatrix4x4& p_matrix)
+    {
+        QJsonArray values;
+        for (int i = 0; i < 16; i++)
+        {
+            values.append(static_cast<double>(p_matrix.constData()[i]));
+        }
+        return values;
+    }
+
+    static QMatrix4x4 matrixFromJson(const QJsonArray& p_values)
+    {
+        QMatrix4x4 matrix;
+        for (int i = 0; i < 16 && i < p_values.size(); i++)
+        {
+            matrix.data()[i] = static_cast<float>(p_values.at(i).toDouble());
+        }
+        return matrix;
+    }
+}
+
+namespace gui
+{
+
+    //-----------------------------------------------------------------------------
+    CameraSession::CameraSession() : m_startZoom(1.)
+    //-----------------------------------------------------------------------------
+    {
+    }
+
+    //-----------------------------------------------------------------------------
+    void CameraSession::start(const Camera& p_camera)
+    //-----------------------------------------------------------------------------
+    {
+        m_steps.clear();
+        m_startRotMatrix = p_camera.rotMatrix();
+        m_startTrMatrix = p_camera.trMatrix();
+        m_startScalingMatrix = p_camera.scalingMatrix();
+        m_startZoom = p_camera.getZoom();
+        m_timer.start();
+    }
+
+    //-----------------------------------------------------------------------------
+    void CameraSession::addStep(Action p_action, const QPointF& p_move)
+    //-----------------------------------------------------------------------------
+    {
+        m_steps.push_back({ p_action, p_move, m_timer.isValid() ? m_timer.elapsed() : 0 });
+    }
+
+    //-----------------------------------------------------------------------------
+    void CameraSession::restoreStart(Camera& p_camera) const
+    //-----------------------------------------------------------------------------
+    {
+        p_camera.setCameraConfig(m_startRotMatrix, m_startTrMatrix, m_startScalingMatrix, m_startZoom);
+    }
+
+    //-----------------------------------------------------------------------------
+    void CameraSession::applyStep(Camera& p_camera, const Step& p_step)
+    //-----------------------------------------------------------------------------
+    {
+        // same calls as GLWidget
+        switch (p_step.action)
+        {
+        case Action::ROTATE:
+            p_camera.rotate(static_cast<float>(p_step.move.x()), static_cast<float>(p_step.move.y()));
+            break;
+        case Action::TRANSLATE:
+            p_camera.incXTranslation(static_cast<float>(p_step.move.x() / 10.));
+            p_camera.incYTranslation(static_cast<float>(p_step.move.y() / 10.));
+            break;
+        case Action::ZOOM:
+            p_camera.zoom(static_cast<float>(p_step.move.x()));
+            break;
+        }
+    }
+
+    //-----------------------------------------------------------------------------
+    bool CameraSession::save(const QString& p_filepath) const
+    //-----------------------------------------------------------------------------
+    {
+        QFile file(p_filepath);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        {
+            qCritical() << "Cannot write the camera session" << p_filepath;
+            return false;
+        }
+
+        QJsonArray steps;
+        for (const Step& step : m_steps)
+        {
+            steps.append(QJsonObject{ { "action", actionName(step.action) }, { "dx", step.move.x() }, { "dy", step.move.y() }, { "time_ms", static_cast<qint64>(step.time) } });
+        }
+
+        const QJsonObject session{
+            { "start", QJsonObject{
+                { "rotation", matrixToJson(m_startRotMatrix) },
+                { "translation", matrixToJson(m_startTrMatrix) },
+                { "scaling", matrixToJson(m_startScalingMatrix) },
+                { "zoom", m_startZoom } } },
+            { "steps", steps }
+        };
+        return file.write(QJsonDocument(session).toJson()) >= 0;
+    }
+
+    //-----------------------------------------------------------------------------
+    bool CameraSession::load(const QString& p_filepath)
+    //-----------------------------------------------------------------------------
+    {
+        QFile file(p_filepath);
+        if (!file.open(QIODevice::ReadOnly))
+        {
+            qCritical() << "Cannot read the camera session" << p_filepath;
+            return false;
+        }
+
+        const QJsonDocument document{ QJsonDocument::fromJson(file.readAll()) };
+        if (!document.isObject() || !document.object().value("steps").isArray())
+        {
+            qCritical() << "Invalid camera session" << p_filepath;
+            return false;
+        }
+
+        const QJsonObject start{ document.object().value("start").toObject() };
+        m_startRotMatrix = matrixFromJson(start.value("rotation").toArray());
+        m_startTrMatrix = matrixFromJson(start.value("translation").toArray());
+        m_startScalingMatrix = matrixFromJson(start.value("scaling").toArray());
+        m_startZoom = start.value("zoom").toDouble(1.);
+
+        m_steps.clear();
+        for (const QJsonValue& value : document.object().value("steps").toArray())
+        {
+            const QJsonObject step{ value.toObject() };
+            const QString action{ step.value("action").toString() };
+            const Action stepAction{ action == "rotate" ? Action::ROTATE : (action == "translate" ? Action::TRANSLATE : Action::ZOOM) };
+            m_steps.push_back({ stepAction, QPointF(step.value("dx").toDouble(), step.value("dy").toDouble()), static_cast<qint64>(step.value("time_ms").toDouble()) });
+        }
+        m_timer.invalidate();
+        return true;
+    }
+
+    //-----------------------------------------------------------------------------
+    CameraSession CameraSession::orbit(const Camera& p_camera, int p_frameCount, float p_move)
+    //-----------------------------------------------------------------------------
+    {
+        CameraSession session;
+        session.start(p_camera);
+        session.m_timer.invalidate();
+        for (int i = 0; i < p_frameCount; i++)
+        {
+            session.addStep(Action::ROTATE, QPointF(p_move, 0.));
+        }
+        return session;
+    }
+
+    //-----------------------------------------------------------------------------
+    CameraSession CameraSession::zoomSweep(const Camera& p_camera, int p_frameCount)
+    //-----------------------------------------------------------------------------
+    {
+        CameraSession session;
+        session.start(p_camera);
+        session.m_timer.invalidate();
+        for (int i = 0; i < p_frameCount; i++)
+        {
+            session.addStep(Action::ZOOM, QPointF(i < p_frameCount / 2 ? 120. : -120., 0.));
+        }
+        return session;
+    }
+
+    //-----------------------------------------------------------------------------
+    CameraSession CameraSession::closeUp(const Camera& p_camera, int p_frameCount)
+    //-----------------------------------------------------------------------------
+    {
+        // 60 zoom steps of 4% magnify 10 times: the mesh covers the screen with its depth complexity
+        CameraSession session;
+        session.start(p_camera);
+        session.m_timer.invalidate();
+        const int zoomCount{ std::min(p_frameCount / 2, 60) };
+        for (int i = 0; i < p_frameCount; i++)
+        {
+            if (i < zoomCount)
+            {
+                session.addStep(Action::ZOOM, QPointF(120., 0.));
+            }
+            else
+            {
+                session.addStep(Action::ROTATE, QPointF(2., 1.));
+            }
+        }
+        return session;
+    }
+
+}
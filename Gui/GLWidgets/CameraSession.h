@@ -0,0 +1,64 @@
+#pragma once
+
+#include <QtGui/QMatrix4x4>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QPointF>
+#include <QtCore/QString>
+
+#include <vector>
+
+namespace gui
+{
+    class Camera;
+
+    /**
+     * \class CameraSession
+     * \brief Sequence of camera moves, recorded from the mouse and wheel events of GLWidget or scripted
+     *
+     * A step is one call of the Camera (rotate, incXTranslation/incYTranslation or zoom) with the values computed
+     * by GLWidget from the events, so a replay gives the same views whatever the window. The camera configuration at the
+     * start of the session is kept to replay it from the same view. Saved as JSON.
+     */
+    class CameraSession
+    {
+    public:
+        enum class Action { ROTATE, TRANSLATE, ZOOM };
+        struct Step
+        {
+            Action action;
+            QPointF move; //!< mouse move in pixels, for ZOOM the wheel delta in x
+            qint64 time; //!< milliseconds since the start of the recording, 0 if scripted
+        };
+
+        CameraSession();
+
+        void start(const Camera& p_camera); //!< clear the steps and keep the camera configuration
+        void addStep(Action p_action, const QPointF& p_move);
+        inline const std::vector<Step>& steps() const { return m_steps; }
+        inline bool isEmpty() const { return m_steps.empty(); }
+
+        void restoreStart(Camera& p_camera) const; //!< camera configuration of start()
+        static void applyStep(Camera& p_camera, const Step& p_step);
+
+        bool save(const QString& p_filepath) const;
+        bool load(const QString& p_filepath);
+
+        //!< Scripted sessions from the current configuration of p_camera, one step by frame
+        ///@{
+        static CameraSession orbit(const Camera& p_camera, int p_frameCount, float p_move = 4.f); //!< turn around the vertical axis
+        static CameraSession zoomSweep(const Camera& p_camera, int p_frameCount); //!< zoom in, then back out
+        static CameraSession closeUp(const Camera& p_camera, int p_frameCount); //!< zoom in the mesh, then turn
+        ///@}
+
+    protected:
+        std::vector<Step> m_steps;
+
+        QMatrix4x4 m_startRotMatrix;
+        QMatrix4x4 m_startTrMatrix;
+        QMatrix4x4 m_startScalingMatrix;
+        double m_startZoom;
+
+        QElapsedTimer m_timer;
+    };
+
+}
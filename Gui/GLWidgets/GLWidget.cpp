@@ -1,8 +1,12 @@
 #include "GLWidgets/GLWidget.h"
 
+#include "Renderers/GlFunctions.h"
+#include "Renderers/GpuProfiler.h"
+
 #include <QtWidgets/QApplication>
 #include <QtWidgets/QMessageBox>
 #include <QtGui/QMouseEvent>
+#include <QtGui/QPainter>
 #include <QtCore/QDebug>
 
 namespace gui
@@ -11,6 +15,8 @@ namespace gui
     //-----------------------------------------------------------------------------
     GLWidget::GLWidget(QWidget* p_parent) : QOpenGLWidget(p_parent)
         , m_scene()
+        , m_profilerOverlay(nullptr)
+        , m_isCameraRecording(false)
     //-----------------------------------------------------------------------------
     {
         // SBO 2020/03/03 force palette background color to black to avoid solarization effects with Qt5.12.6
@@ -139,11 +145,19 @@ namespace gui
                 {
                     m_camera.incXTranslation(move.x() / 10.);
                     m_camera.incYTranslation(move.y() / 10.);
+                    if (m_isCameraRecording)
+                    {
+                        m_cameraSession.addStep(CameraSession::Action::TRANSLATE, move);
+                    }
                 }
             }
             else
             {
                 m_camera.rotate(move.x(), move.y());
+                if (m_isCameraRecording)
+                {
+                    m_cameraSession.addStep(CameraSession::Action::ROTATE, move);
+                }
 
             }
         }
@@ -160,6 +174,10 @@ namespace gui
         if (p_event->delta() != 0)
         {
             m_camera.zoom(p_event->delta());
+            if (m_isCameraRecording)
+            {
+                m_cameraSession.addStep(CameraSession::Action::ZOOM, QPointF(p_event->delta(), 0.));
+            }
 
             update();
         }
@@ -197,9 +215,62 @@ namespace gui
         if (changeFlags & QPinchGesture::ScaleFactorChanged)
         {
             m_camera.zoom(gesture->totalScaleFactor() > 1. ? 100 : -100);
+            if (m_isCameraRecording)
+            {
+                m_cameraSession.addStep(CameraSession::Action::ZOOM, QPointF(gesture->totalScaleFactor() > 1. ? 100. : -100., 0.));
+            }
         }
 
         update();
     }
 
+    //-----------------------------------------------------------------------------------------------
+    void GLWidget::setCameraRecording(bool p_isRecording)
+    //-----------------------------------------------------------------------------------------------
+    {
+        if (p_isRecording && !m_isCameraRecording)
+        {
+            m_cameraSession.start(m_camera);
+        }
+        m_isCameraRecording = p_isRecording;
+    }
+
+    //-----------------------------------------------------------------------------------------------
+    void GLWidget::paintGpuProfilerOverlay()
+    //-----------------------------------------------------------------------------------------------
+    {
+        if (m_profilerOverlay == nullptr || !m_profilerOverlay->isEnabled())
+        {
+            return;
+        }
+
+        QStringList lines;
+        lines << QString("GPU %1 ms").arg(m_profilerOverlay->averageFrameTime(), 0, 'f', 3);
+        for (const gl::GpuProfiler::StageTiming& stage : m_profilerOverlay->averageStages())
+        {
+            lines << QString("  %1 %2 ms").arg(stage.name, -16).arg(stage.time, 7, 'f', 3);
+        }
+        if (m_profilerOverlay->droppedFrameCount() > 0)
+        {
+            lines << QString("%1 frames dropped").arg(m_profilerOverlay->droppedFrameCount());
+        }
+#ifdef DEBUG_GL_CALL_COUNTERS
+        lines << gl::GlCallCounters::toString(gl::GlCallCounters::lastFrame().total);
+#endif
+
+        QFont font("Monospace");
+        font.setStyleHint(QFont::TypeWriter);
+
+        QPainter painter(this);
+        painter.setFont(font);
+        const QRect textRect{ painter.boundingRect(QRect(10, 10, width(), height()), Qt::AlignLeft | Qt::AlignTop, lines.join('\n')) };
+        painter.fillRect(textRect.adjusted(-5, -5, 5, 5), QColor(0, 0, 0, 160));
+        painter.setPen(Qt::white);
+        painter.drawText(textRect, Qt::AlignLeft | Qt::AlignTop, lines.join('\n'));
+        painter.end();
+
+        // QPainter leaves its own GL states, the renderers expect the depth test
+        glEnable(GL_DEPTH_TEST);
+    }
+
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "GLWidgets/Camera.h"
+#include "GLWidgets/CameraSession.h"
 #include "GLWidgets/Scene.h"
 
 #include <QtGui/QColor>
@@ -11,6 +12,11 @@
 #include <QtCore/QString>
 #include <QtCore/QPoint>
 
+namespace gui::gl
+{
+    class GpuProfiler;
+}
+
 namespace gui
 {
 
@@ -30,6 +36,14 @@ namespace gui
         void setZoom(double p_zoom);
         void resetCameraParameters();
 
+        //!< Draw the averaged timings of p_profiler over the frame (not owner), nullptr to hide
+        inline void setGpuProfilerOverlay(const gl::GpuProfiler* p_profiler) { m_profilerOverlay = p_profiler; update(); }
+
+        //!< Record the camera moves of the mouse and wheel events, starting from the current view
+        void setCameraRecording(bool p_isRecording);
+        inline bool isCameraRecording() const { return m_isCameraRecording; }
+        inline const CameraSession& cameraSession() const { return m_cameraSession; } //!< the last recording
+
     protected:
         virtual void resizeGL( int w, int h ) override;
         virtual void initializeGL() override;
@@ -42,11 +56,18 @@ namespace gui
         virtual bool gestureEvent(QGestureEvent * p_event);
         void pinchTriggered(QPinchGesture *gesture);
 
+        void paintGpuProfilerOverlay(); //!< at the end of paintGL
+
     protected:
         Scene m_scene;
         Camera m_camera;
 
         QPoint m_lastPos; // 2D pos of mouse
+
+        const gl::GpuProfiler* m_profilerOverlay;
+
+        bool m_isCameraRecording;
+        CameraSession m_cameraSession;
     };
 
 }
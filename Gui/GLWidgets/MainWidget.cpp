@@ -1,18 +1,33 @@
 #include "GLWidgets/MainWidget.h"
 
 #include <QtGui/QGuiApplication>
+#include <QtGui/QKeyEvent>
+#include <QtCore/QDir>
 #include <QtCore/QThread>
 
 namespace
 {
     static constexpr const char* meshName() { return "dragon"; }
+
+    using Engines = gui::gl::TransparencyEngineFactory;
 }
 
 //---------------------------------------------------------------------------------------
 MainWidget::MainWidget(QWidget *parent) : GLWidget(parent)
 //---------------------------------------------------------------------------------------
     , m_meshRenderer(nullptr)
-    , m_transparencyRenderer(m_scene, m_camera)
+    , m_dualDepthPeelingRenderer(m_scene, m_camera)
+    , m_weightedBlendedRenderer(m_scene, m_camera)
+    , m_aBufferRenderer(m_scene, m_camera)
+    , m_momentRenderer(m_scene, m_camera)
+    , m_multiLayerPeelingRenderer(m_scene, m_camera)
+    , m_stochasticRenderer(m_scene, m_camera)
+    , m_sortedRenderer(m_scene, m_camera)
+    , m_presortedRenderer(m_scene, m_camera)
+    , m_transparencyRenderers{ { &m_dualDepthPeelingRenderer, &m_weightedBlendedRenderer, &m_aBufferRenderer, &m_momentRenderer, &m_multiLayerPeelingRenderer, &m_stochasticRenderer, &m_sortedRenderer, &m_presortedRenderer } }
+    , m_transparencyEngine(Engines::DUAL_DEPTH_PEELING)
+    , m_isEngineCalibrated(false)
+    , m_isCalibrationForced(false)
 #ifdef _DEBUG
     , m_logger(this)
 #endif
@@ -20,7 +35,19 @@ MainWidget::MainWidget(QWidget *parent) : GLWidget(parent)
     m_camera.setZoom(1.);
 
     static const QColor skyColor(44, 183, 185);
-    m_transparencyRenderer.setBackgroundColor(QVector3D(skyColor.redF(), skyColor.greenF(), skyColor.blueF()));
+    for (gui::gl::TransparencyRenderer* const renderer : m_transparencyRenderers)
+    {
+        renderer->setBackgroundColor(QVector3D(skyColor.redF(), skyColor.greenF(), skyColor.blueF()));
+        renderer->setGpuProfiler(&m_gpuProfiler);
+    }
+
+    // default settings of each engine, the calibration applies the settings of its selection
+    for (int engine = 0; engine < Engines::ENGINE_COUNT; engine++)
+    {
+        Engines::configure(Engines::name(static_cast<TransparencyEngine>(engine)), *m_transparencyRenderers.at(engine));
+    }
+
+    setFocusPolicy(Qt::StrongFocus); // key events
 }
 
 //---------------------------------------------------------------------------------------
@@ -34,7 +61,11 @@ MainWidget::~MainWidget()
     m_meshRenderer->cleanup();
     delete m_meshRenderer;
 
-    m_transparencyRenderer.cleanup();
+    for (gui::gl::TransparencyRenderer* const renderer : m_transparencyRenderers)
+    {
+        renderer->cleanup();
+    }
+    m_gpuProfiler.cleanup();
 
 #ifdef _DEBUG
     m_logger.stopLogging();
@@ -79,14 +110,14 @@ void MainWidget::initializeGL()
 #endif
 
     loadModel();
-    m_transparencyRenderer.initialize(scaleToHighDpi(width()), scaleToHighDpi(height()));
+    transparencyRenderer().initialize(scaleToHighDpi(width()), scaleToHighDpi(height()));
 }
 
 //---------------------------------------------------------------------------------------
 void MainWidget::loadModel()
 //---------------------------------------------------------------------------------------
 {
-    if (m_transparencyRenderer.containsTransparentObject(::meshName()))
+    if (transparencyRenderer().containsTransparentObject(::meshName()))
     {
         // already loaded
         return;
@@ -105,89 +136,245 @@ void MainWidget::loadModel()
     static const QVector3D rust3DColor(rustColor.redF(), rustColor.greenF(), rustColor.blueF());
     m_meshRenderer->setMaterialAmbiantColor(rust3DColor);
     m_meshRenderer->setOpacity(0.5f);
+    // static model: the presorted orders are built in parallel with its buffers, at load rather than at the engine switch
+    m_meshRenderer->setPresortedDirectionCount(Engines::PRESORTED_DIRECTION_COUNT);
 
-    m_transparencyRenderer.appendTransparentObject(::meshName(), m_meshRenderer);
+    for (gui::gl::TransparencyRenderer* const renderer : m_transparencyRenderers)
+    {
+        renderer->appendTransparentObject(::meshName(), m_meshRenderer);
+    }
 
-    geom::Point modelMin, modelMax;
-    computeBoundingBox(modelMin, modelMax);
-    const double diag{ modelMax.distance(modelMin) };
+    const geom::AABB& modelBounds{ m_model.bounds() };
+    if (modelBounds.isEmpty())
+    {
+        return;
+    }
+    const double diag{ modelBounds.max().distance(modelBounds.min()) };
     const double scale{ (1. / diag) * 100. };
     m_camera.setScaling(static_cast<float>(scale));
-    geom::Point tr{ (modelMin + geom::Vector{ modelMin, modelMax } * 0.5) };
+    geom::Point tr{ modelBounds.center() };
     tr = tr.mul(-scale, -scale, -scale);
     m_camera.setTranslation(QVector3D(tr.x(), tr.y(), tr.z()));
 }
 
 //---------------------------------------------------------------------------------------
-//componentwise min
-inline geom::Point min(const geom::Point& lhs, const geom::Point& rhs)
+void MainWidget::resizeGL(int w, int h)
+//---------------------------------------------------------------------------------------
 {
-    geom::Point rt;
-    rt.x(std::min(lhs.x(), rhs.x()));
-    rt.y(std::min(lhs.y(), rhs.y()));
-    rt.z(std::min(lhs.z(), rhs.z()));
-    return rt;
+    const int width{ scaleToHighDpi(w) };
+    const int height{ scaleToHighDpi(h) };
+
+    GLWidget::resizeGL(width, height);
+
+    glViewport(0, 0, width, height);
+
+    static constexpr float znear{ -1000.0f }, zfar{ 1000.0f };
+    m_camera.configure({ 0.f, 0.f, static_cast<float>(width), static_cast<float>(height) }, znear, zfar);
+
+    for (gui::gl::TransparencyRenderer* const renderer : m_transparencyRenderers)
+    {
+        if (renderer == &transparencyRenderer())
+        {
+            renderer->setSize(width, height);
+        }
+        else
+        {
+            renderer->prepareForResize(); // initialized when active
+        }
+    }
 }
-// componentwise max
-inline geom::Point max(const geom::Point& lhs, const geom::Point& rhs)
+
+//---------------------------------------------------------------------------------------
+void MainWidget::paintGL()
+//---------------------------------------------------------------------------------------
 {
-    geom::Point rt;
-    rt.x(std::max(lhs.x(), rhs.x()));
-    rt.y(std::max(lhs.y(), rhs.y()));
-    rt.z(std::max(lhs.z(), rhs.z()));
-    return rt;
+    GLWidget::paintGL();
+
+    glClearColor(0, 0, 0, 0);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+    // shaders reloaded with AUTO_SHADER, or engine resized when it was not active
+    if (!transparencyRenderer().isInitialized())
+    {
+        transparencyRenderer().initialize(scaleToHighDpi(width()), scaleToHighDpi(height()));
+    }
+
+    if (!m_isEngineCalibrated)
+    {
+        calibrateTransparencyEngine();
+    }
+
+    transparencyRenderer().render();
+
+    // the stochastic noise decreases with the frames accumulated while the camera does not move
+    if (m_transparencyEngine == Engines::STOCHASTIC && !m_stochasticRenderer.isAccumulationConverged())
+    {
+        update();
+    }
+
+    paintGpuProfilerOverlay();
+    if (m_gpuProfiler.isEnabled())
+    {
+        update(); // continuous frames to measure
+    }
 }
-void MainWidget::computeBoundingBox(geom::Point& p_minVal, geom::Point& p_maxVal)
+
+//---------------------------------------------------------------------------------------
+void MainWidget::calibrateTransparencyEngine(void)
 //---------------------------------------------------------------------------------------
 {
-    if (m_model.faceCount() == 0)
+    m_isEngineCalibrated = true;
+
+    // the reference first: dual depth peeling is exact
+    m_calibrator.clearCandidates();
+    for (const QString& name : Engines::names())
+    {
+        const TransparencyEngine engine{ Engines::engine(name) };
+        if (isTransparencyEngineSupported(engine))
+        {
+            gui::gl::TransparencyRenderer* const renderer{ m_transparencyRenderers.at(engine) };
+            m_calibrator.addCandidate(name, renderer, [this, name, engine, renderer]() { Engines::configure(name, *renderer); setTransparencyEngine(engine); });
+        }
+    }
+
+    if (!m_isCalibrationForced && m_calibrator.applySavedSelection())
     {
         return;
     }
+    m_isCalibrationForced = false;
 
-    p_minVal = geom::Point{ HUGE_VAL, HUGE_VAL, HUGE_VAL };
-    p_maxVal = p_minVal.mul(-1., -1., -1.);
+    QGuiApplication::setOverrideCursor(Qt::WaitCursor);
+    if (m_calibrator.calibrate(scaleToHighDpi(width()), scaleToHighDpi(height())).isEmpty())
+    {
+        setTransparencyEngine(Engines::DUAL_DEPTH_PEELING);
+    }
+    QGuiApplication::restoreOverrideCursor();
 
-    for (int i = 0; i < m_model.vtxIndices().size(); i++)
+    // engines initialized by the calibration
+    if (!transparencyRenderer().isInitialized())
     {
-        const geom::Point& pt = m_model.vertices()[m_model.vtxIndices()[i]];
-        p_minVal = min(p_minVal, pt);
-        p_maxVal = max(p_maxVal, pt);
+        transparencyRenderer().initialize(scaleToHighDpi(width()), scaleToHighDpi(height()));
     }
 }
 
 //---------------------------------------------------------------------------------------
-void MainWidget::resizeGL(int w, int h)
+void MainWidget::setGpuProfilerEnable(bool p_isEnabled)
 //---------------------------------------------------------------------------------------
 {
-    const int width{ scaleToHighDpi(w) };
-    const int height{ scaleToHighDpi(h) };
+    m_gpuProfiler.setEnable(p_isEnabled);
+    setGpuProfilerOverlay(p_isEnabled ? &m_gpuProfiler : nullptr);
+}
 
-    GLWidget::resizeGL(width, height);
+//---------------------------------------------------------------------------------------
+void MainWidget::setDepthComplexityModeEnable(bool p_isEnabled)
+//---------------------------------------------------------------------------------------
+{
+    m_dualDepthPeelingRenderer.setDepthComplexityModeEnable(p_isEnabled);
+    if (p_isEnabled)
+    {
+        setTransparencyEngine(Engines::DUAL_DEPTH_PEELING);
+    }
+    update();
+}
 
-    glViewport(0, 0, width, height);
+//---------------------------------------------------------------------------------------
+void MainWidget::switchCameraRecording(void)
+//---------------------------------------------------------------------------------------
+{
+    if (!isCameraRecording())
+    {
+        qInfo() << "Camera recording started";
+        setCameraRecording(true);
+        return;
+    }
 
-    static constexpr float znear{ -1000.0f }, zfar{ 1000.0f };
-    m_camera.configure({ 0.f, 0.f, static_cast<float>(width), static_cast<float>(height) }, znear, zfar);
+    setCameraRecording(false);
+    const QString filepath{ QDir::current().filePath("camera_session.json") };
+    if (cameraSession().save(filepath))
+    {
+        qInfo() << "Camera session of" << cameraSession().steps().size() << "moves saved to" << filepath;
+    }
+}
 
-    m_transparencyRenderer.setSize(width, height);
+//---------------------------------------------------------------------------------------
+bool MainWidget::exportGpuProfile(const QString& p_filepathWithoutExtension) const
+//---------------------------------------------------------------------------------------
+{
+    const bool isOk{ m_gpuProfiler.exportCsv(p_filepathWithoutExtension + ".csv") && m_gpuProfiler.exportJson(p_filepathWithoutExtension + ".json") };
+    if (isOk)
+    {
+        qInfo() << "GPU profile exported to" << p_filepathWithoutExtension;
+    }
+    return isOk;
 }
 
 //---------------------------------------------------------------------------------------
-void MainWidget::paintGL()
+void MainWidget::setTransparencyEngine(TransparencyEngine p_engine)
 //---------------------------------------------------------------------------------------
 {
-    GLWidget::paintGL();
+    if (p_engine == m_transparencyEngine || p_engine == Engines::ENGINE_COUNT)
+    {
+        return;
+    }
 
-    glClearColor(0, 0, 0, 0);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    if (!isTransparencyEngineSupported(p_engine))
+    {
+        qCritical() << "Transparency engine" << p_engine << "is not supported by the OpenGL context";
+        return;
+    }
+
+    m_transparencyEngine = p_engine;
+    update();
+}
+
+//---------------------------------------------------------------------------------------
+bool MainWidget::isTransparencyEngineSupported(TransparencyEngine p_engine) const
+//---------------------------------------------------------------------------------------
+{
+    return Engines::isSupported(p_engine, context());
+}
 
-#ifdef AUTO_SHADER
-    if (!m_transparencyRenderer.isInitialized())
+//---------------------------------------------------------------------------------------
+void MainWidget::keyPressEvent(QKeyEvent* p_event)
+//---------------------------------------------------------------------------------------
+{
+    if (p_event->key() == Qt::Key_T)
     {
-        m_transparencyRenderer.initialize(scaleToHighDpi(width()), scaleToHighDpi(height()));
+        // skip the engines which need a more recent OpenGL
+        TransparencyEngine engine{ m_transparencyEngine };
+        do
+        {
+            engine = static_cast<TransparencyEngine>((engine + 1) % Engines::ENGINE_COUNT);
+        } while (!isTransparencyEngineSupported(engine));
+
+        setTransparencyEngine(engine);
+        return;
+    }
+    if (p_event->key() == Qt::Key_C)
+    {
+        requestTransparencyEngineCalibration(true);
+        return;
+    }
+    if (p_event->key() == Qt::Key_P)
+    {
+        setGpuProfilerEnable(!m_gpuProfiler.isEnabled());
+        return;
+    }
+    if (p_event->key() == Qt::Key_R)
+    {
+        switchCameraRecording();
+        return;
+    }
+    if (p_event->key() == Qt::Key_H)
+    {
+        setDepthComplexityModeEnable(!m_dualDepthPeelingRenderer.isDepthComplexityMode());
+        return;
+    }
+    if (p_event->key() == Qt::Key_E && m_gpuProfiler.isEnabled())
+    {
+        exportGpuProfile(QDir::current().filePath("gpu_profile"));
+        return;
     }
-#endif
 
-    m_transparencyRenderer.render();
+    GLWidget::keyPressEvent(p_event);
 }
@@ -1,8 +1,17 @@
 #pragma once
 
 #include "GLWidgets/GLWidget.h"
+#include "Renderers/GpuProfiler.h"
 #include "Renderers/MeshRenderer.h"
+#include "Renderers/UnorderedTransparency/ABufferRenderer.h"
 #include "Renderers/UnorderedTransparency/DualDepthPeelingRenderer.h"
+#include "Renderers/UnorderedTransparency/MomentTransparencyRenderer.h"
+#include "Renderers/UnorderedTransparency/MultiLayerPeelingRenderer.h"
+#include "Renderers/UnorderedTransparency/SortedTransparencyRenderer.h"
+#include "Renderers/UnorderedTransparency/StochasticTransparencyRenderer.h"
+#include "Renderers/UnorderedTransparency/TransparencyEngineCalibrator.h"
+#include "Renderers/UnorderedTransparency/TransparencyEngineFactory.h"
+#include "Renderers/UnorderedTransparency/WeightedBlendedRenderer.h"
 
 #include <Mesh/MeshModel.h>
 
@@ -22,15 +31,40 @@ public:
 
     inline void setModelFilepath(const QString& p_filepath) { m_modelFilepath = p_filepath; }
 
+    //!< Order independent transparency techniques, the T key switches to the next one
+    using TransparencyEngine = gui::gl::TransparencyEngineFactory::Engine;
+    void setTransparencyEngine(TransparencyEngine p_engine);
+    inline TransparencyEngine transparencyEngine(void) const { return m_transparencyEngine; }
+    bool isTransparencyEngineSupported(TransparencyEngine p_engine) const; //!< false before initializeGL
+
+    //!< The first frame selects the fastest engine of the graphic card close to the dual depth peeling image, or reloads
+    //!< the selection of a previous run. The C key forces a new calibration.
+    inline void requestTransparencyEngineCalibration(bool p_force) { m_isEngineCalibrated = false; m_isCalibrationForced = p_force; update(); }
+
+    //!< GPU time of the rendering stages, drawn over the frame. The P key switches it, the E key exports it
+    void setGpuProfilerEnable(bool p_isEnabled);
+    bool exportGpuProfile(const QString& p_filepathWithoutExtension) const; //!< .csv and .json files
+
+    //!< Heatmap of the transparent layers by pixel with the dual depth peeling, statistics logged. The H key switches it
+    void setDepthComplexityModeEnable(bool p_isEnabled);
+
+    //!< The R key starts a recording of the camera moves, the next one saves it to camera_session.json for the benchmarks
+    void switchCameraRecording(void);
+
 protected:
     void initializeGL() override;
 
     void loadModel();
-    void computeBoundingBox(geom::Point& p_minVal, geom::Point& p_maxVal);
 
     void resizeGL(int w, int h) override;
     void paintGL() override;
 
+    void keyPressEvent(QKeyEvent* p_event) override;
+
+    void calibrateTransparencyEngine(void); //!< need the scene and the size of the widget
+
+    inline gui::gl::TransparencyRenderer& transparencyRenderer(void) { return *m_transparencyRenderers.at(m_transparencyEngine); }
+
     inline int scaleToHighDpi(int p_screenSize) const { return static_cast<int>(static_cast<qreal>(p_screenSize) * devicePixelRatioF()); }
 
 protected slots:
@@ -43,7 +77,20 @@ protected:
     MeshModel m_model;
 
     gui::gl::MeshRenderer* m_meshRenderer;
-    gui::gl::DualDepthPeelingRenderer m_transparencyRenderer;
+    gui::gl::DualDepthPeelingRenderer m_dualDepthPeelingRenderer;
+    gui::gl::WeightedBlendedRenderer m_weightedBlendedRenderer;
+    gui::gl::ABufferRenderer m_aBufferRenderer;
+    gui::gl::MomentTransparencyRenderer m_momentRenderer;
+    gui::gl::MultiLayerPeelingRenderer m_multiLayerPeelingRenderer;
+    gui::gl::StochasticTransparencyRenderer m_stochasticRenderer;
+    gui::gl::SortedTransparencyRenderer m_sortedRenderer;
+    gui::gl::SortedTransparencyRenderer m_presortedRenderer; //!< same engine, with the orders sorted at initialization
+    std::array<gui::gl::TransparencyRenderer*, gui::gl::TransparencyEngineFactory::ENGINE_COUNT> m_transparencyRenderers; //!< all the engines, indexed by TransparencyEngine
+    TransparencyEngine m_transparencyEngine;
+    gui::gl::TransparencyEngineCalibrator m_calibrator;
+    gui::gl::GpuProfiler m_gpuProfiler;
+    bool m_isEngineCalibrated;
+    bool m_isCalibrationForced;
 
 #ifdef _DEBUG
     QOpenGLDebugLogger m_logger;
@@ -2,7 +2,7 @@ TARGET = Gui
 TEMPLATE = lib
 CONFIG += static debug_and_release c++17 qtquickcompiler
 
-QT = core gui widgets
+QT = core gui widgets concurrent
 
 DEFINES += GL_SILENCE_DEPRECATION
 
@@ -11,36 +11,74 @@ INCLUDEPATH += \
 
 HEADERS += \
     GLWidgets/Camera.h \
+    GLWidgets/CameraSession.h \
     GLWidgets/GLWidget.h \
     GLWidgets/MainWidget.h \
     GLWidgets/Scene.h \
+    Offscreen/OffscreenRenderer.h \
     Renderers/AbstractRenderer.h \
+    Renderers/Common/ImageComparison.h \
     Renderers/Common/MultipleLightsRenderer.h \
+    Renderers/GlFunctions.h \
+    Renderers/GpuProfiler.h \
     Renderers/MeshRenderer.h \
     Renderers/PathRenderer.h \
     Renderers/PlaneRenderer.h \
+    Renderers/Software/SoftwareDualDepthPeelingRenderer.h \
+    Renderers/UnorderedTransparency/ABufferRenderer.h \
+    Renderers/UnorderedTransparency/DepthComplexityStatistics.h \
     Renderers/UnorderedTransparency/DualDepthPeelingRenderer.h \
-    Renderers/UnorderedTransparency/TransparencyRenderer.h
+    Renderers/UnorderedTransparency/MomentTransparencyRenderer.h \
+    Renderers/UnorderedTransparency/MultiLayerPeelingRenderer.h \
+    Renderers/UnorderedTransparency/PassBudgetController.h \
+    Renderers/UnorderedTransparency/SortedTransparencyRenderer.h \
+    Renderers/UnorderedTransparency/StochasticTransparencyRenderer.h \
+    Renderers/UnorderedTransparency/TransparencyEngineCalibrator.h \
+    Renderers/UnorderedTransparency/TransparencyEngineFactory.h \
+    Renderers/UnorderedTransparency/TransparencyRenderer.h \
+    Renderers/UnorderedTransparency/TriangleSorter.h \
+    Renderers/UnorderedTransparency/WeightedBlendedRenderer.h
 
 SOURCES += \
     GLWidgets/Camera.cpp \
+    GLWidgets/CameraSession.cpp \
     GLWidgets/GLWidget.cpp \
     GLWidgets/MainWidget.cpp \
     GLWidgets/Scene.cpp \
+    Offscreen/OffscreenRenderer.cpp \
     Renderers/AbstractRenderer.cpp \
+    Renderers/Common/ImageComparison.cpp \
     Renderers/Common/MultipleLightsRenderer.cpp \
+    Renderers/GpuProfiler.cpp \
     Renderers/MeshRenderer.cpp \
     Renderers/PathRenderer.cpp \
     Renderers/PlaneRenderer.cpp \
+    Renderers/Software/SoftwareDualDepthPeelingRenderer.cpp \
+    Renderers/UnorderedTransparency/ABufferRenderer.cpp \
+    Renderers/UnorderedTransparency/DepthComplexityStatistics.cpp \
     Renderers/UnorderedTransparency/DualDepthPeelingRenderer.cpp \
-    Renderers/UnorderedTransparency/TransparencyRenderer.cpp
+    Renderers/UnorderedTransparency/MomentTransparencyRenderer.cpp \
+    Renderers/UnorderedTransparency/MultiLayerPeelingRenderer.cpp \
+    Renderers/UnorderedTransparency/PassBudgetController.cpp \
+    Renderers/UnorderedTransparency/SortedTransparencyRenderer.cpp \
+    Renderers/UnorderedTransparency/StochasticTransparencyRenderer.cpp \
+    Renderers/UnorderedTransparency/TransparencyEngineCalibrator.cpp \
+    Renderers/UnorderedTransparency/TransparencyEngineFactory.cpp \
+    Renderers/UnorderedTransparency/TransparencyRenderer.cpp \
+    Renderers/UnorderedTransparency/TriangleSorter.cpp \
+    Renderers/UnorderedTransparency/WeightedBlendedRenderer.cpp
 
 build_pass:CONFIG(debug, debug|release) {
     DEFINES += \
         AUTO_SHADER \
+        GL_CALL_COUNTERS \
         PROJECT_DIR=$$_PRO_FILE_PWD_
-    HEADERS += Renderers/Debug/AutoShaderReloader.h
-    SOURCES += Renderers/Debug/AutoShaderReloader.cpp
+    HEADERS += \
+        Renderers/Debug/AutoShaderReloader.h \
+        Renderers/Debug/GlCallCounters.h
+    SOURCES += \
+        Renderers/Debug/AutoShaderReloader.cpp \
+        Renderers/Debug/GlCallCounters.cpp
 }
 
 RESOURCES += \
@@ -0,0 +1,447 @@
+#include "Offscreen/OffscreenRenderer.h"
+
+#include "Renderers/MeshRenderer.h"
+#include "Renderers/Software/SoftwareDualDepthPeelingRenderer.h"
+#include "Renderers/UnorderedTransparency/DualDepthPeelingRenderer.h"
+#include "Renderers/UnorderedTransparency/TransparencyEngineFactory.h"
+#include "Renderers/UnorderedTransparency/TransparencyRenderer.h"
+
+#include <Geom/AABB.h>
+
+#include <QtGui/QColor>
+#include <QtCore/QDebug>
+#include <QtCore/QElapsedTimer>
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace
+{
+    static QString objectName(size_t p_index) { return QString("mesh%1").arg(p_index); }
+}
+
+namespace gui
+{
+
+    //---------------------------------------------------------------------------------------
+    OffscreenRenderer::OffscreenRenderer(void)
+        : m_width(0)
+        , m_height(0)
+        , m_frameTimeBudget(0.)
+    //---------------------------------------------------------------------------------------
+    {
+        m_camera.setZoom(1.);
+    }
+
+    //---------------------------------------------------------------------------------------
+    OffscreenRenderer::~OffscreenRenderer(void)
+    //---------------------------------------------------------------------------------------
+    {
+        cleanup();
+    }
+
+    //---------------------------------------------------------------------------------------
+    bool OffscreenRenderer::makeCurrent(void)
+    //---------------------------------------------------------------------------------------
+    {
+        if (!m_context.makeCurrent(&m_surface))
+        {
+            qCritical() << "Cannot make the offscreen OpenGL context current";
+            return false;
+        }
+        return true;
+    }
+
+    //---------------------------------------------------------------------------------------
+    bool OffscreenRenderer::initialize(int p_width, int p_height, bool p_withOpenGL)
+    //---------------------------------------------------------------------------------------
+    {
+        if (p_width <= 0 || p_height <= 0)
+        {
+            qCritical() << "Invalid offscreen size" << p_width << "x" << p_height;
+            return false;
+        }
+        if (p_withOpenGL && !initializeOpenGL(p_width, p_height))
+        {
+            return false;
+        }
+
+        m_width = p_width;
+        m_height = p_height;
+        static constexpr float znear{ -1000.0f }, zfar{ 1000.0f };
+        m_camera.configure({ 0.f, 0.f, static_cast<float>(m_width), static_cast<float>(m_height) }, znear, zfar);
+        if (hasOpenGL())
+        {
+            glViewport(0, 0, m_width, m_height);
+        }
+
+        return true;
+    }
+
+    //---------------------------------------------------------------------------------------
+    bool OffscreenRenderer::initializeOpenGL(int p_width, int p_height)
+    //---------------------------------------------------------------------------------------
+    {
+        // the default format of the application if it asks for a 3.3 core profile (see App/main.cpp), without multisampling:
+        // the engines render in their own targets, the output framebuffer only receives the final image
+        QSurfaceFormat format{ QSurfaceFormat::defaultFormat() };
+        format.setVersion(3, 3);
+        format.setProfile(QSurfaceFormat::CoreProfile);
+        format.setDepthBufferSize(24);
+        format.setStencilBufferSize(8);
+        format.setSamples(0);
+
+        m_surface.setFormat(format);
+        m_surface.create();
+        m_context.setFormat(format);
+        if (!m_surface.isValid() || !m_context.create())
+        {
+            qCritical() << "Cannot create an offscreen OpenGL context";
+            return false;
+        }
+
+        const QSurfaceFormat contextFormat{ m_context.format() };
+        if (!makeCurrent() || std::make_pair(contextFormat.majorVersion(), contextFormat.minorVersion()) < std::make_pair(3, 3) || !initializeOpenGLFunctions())
+        {
+            qCritical() << "OpenGL 3.3 core is not available, got" << contextFormat.majorVersion() << "." << contextFormat.minorVersion();
+            return false;
+        }
+
+        m_framebuffer = std::make_unique<QOpenGLFramebufferObject>(p_width, p_height, QOpenGLFramebufferObject::CombinedDepthStencil);
+        if (!m_framebuffer->isValid())
+        {
+            qCritical() << "Cannot create the offscreen framebuffer" << p_width << "x" << p_height;
+            m_framebuffer.reset();
+            return false;
+        }
+
+        return true;
+    }
+
+    //---------------------------------------------------------------------------------------
+    QString OffscreenRenderer::glRendererName(void) const
+    //---------------------------------------------------------------------------------------
+    {
+        if (!hasOpenGL())
+        {
+            return QString();
+        }
+
+        const auto glString = [this](GLenum p_name) { return QString::fromLatin1(reinterpret_cast<const char*>(m_context.functions()->glGetString(p_name))); };
+        return QString("%1 %2 %3").arg(glString(GL_VENDOR), glString(GL_RENDERER), glString(GL_VERSION));
+    }
+
+    //---------------------------------------------------------------------------------------
+    bool OffscreenRenderer::loadModel(const QString& p_filepath, float p_opacity)
+    //---------------------------------------------------------------------------------------
+    {
+        std::vector<SceneGenerator::Object> objects(1);
+        objects.front().mesh.loadObjPath(p_filepath, false);
+        if (objects.front().mesh.faceCount() == 0)
+        {
+            qCritical() << "Cannot load the model" << p_filepath;
+            return false;
+        }
+        return setScene(std::move(objects), p_opacity);
+    }
+
+    //---------------------------------------------------------------------------------------
+    bool OffscreenRenderer::loadGeneratedScene(const SceneGenerator::Parameters& p_parameters, float p_opacity)
+    //---------------------------------------------------------------------------------------
+    {
+        return setScene(SceneGenerator::generate(p_parameters), p_opacity);
+    }
+
+    //---------------------------------------------------------------------------------------
+    int OffscreenRenderer::faceCount(void) const
+    //---------------------------------------------------------------------------------------
+    {
+        int count{ 0 };
+        for (const SceneGenerator::Object& object : m_sceneObjects)
+        {
+            count += object.mesh.faceCount();
+        }
+        return count;
+    }
+
+    //---------------------------------------------------------------------------------------
+    bool OffscreenRenderer::setScene(std::vector<SceneGenerator::Object>&& p_objects, float p_opacity)
+    //---------------------------------------------------------------------------------------
+    {
+        if (!isInitialized() || (hasOpenGL() && !makeCurrent()))
+        {
+            return false;
+        }
+
+        clearScene();
+        m_sceneObjects = std::move(p_objects);
+        for (const SceneGenerator::Object& object : m_sceneObjects)
+        {
+            auto meshRenderer{ std::make_unique<gl::MeshRenderer>(object.mesh, m_scene, m_camera) };
+            static const QColor rustColor(100, 60, 20);
+            static const QColor steelColor(70, 80, 90);
+            const QColor& color{ object.isOpaque ? steelColor : rustColor };
+            meshRenderer->setMaterialAmbiantColor(QVector3D(color.redF(), color.greenF(), color.blueF()));
+            meshRenderer->setOpacity(object.isOpaque ? 1.f : p_opacity);
+            m_meshRenderers.push_back(std::move(meshRenderer));
+        }
+        appendSceneObjects();
+        fitCamera();
+
+        return true;
+    }
+
+    //---------------------------------------------------------------------------------------
+    void OffscreenRenderer::clearScene(void)
+    //---------------------------------------------------------------------------------------
+    {
+        for (size_t i = 0; i < m_meshRenderers.size(); i++)
+        {
+            if (m_transparencyRenderer != nullptr)
+            {
+                m_transparencyRenderer->removeOpaqueObject(::objectName(i));
+                m_transparencyRenderer->removeTransparentObject(::objectName(i));
+            }
+            if (m_softwareRenderer != nullptr)
+            {
+                m_softwareRenderer->removeObject(::objectName(i));
+            }
+            m_meshRenderers[i]->cleanup();
+        }
+        m_meshRenderers.clear();
+        m_sceneObjects.clear();
+    }
+
+    //---------------------------------------------------------------------------------------
+    void OffscreenRenderer::appendSceneObjects(void)
+    //---------------------------------------------------------------------------------------
+    {
+        if (m_softwareRenderer != nullptr)
+        {
+            for (size_t i = 0; i < m_meshRenderers.size(); i++)
+            {
+                if (m_sceneObjects[i].isOpaque)
+                {
+                    m_softwareRenderer->appendOpaqueObject(::objectName(i), m_meshRenderers[i].get());
+                }
+                else
+                {
+                    m_softwareRenderer->appendTransparentObject(::objectName(i), m_meshRenderers[i].get());
+                }
+            }
+        }
+        if (m_transparencyRenderer == nullptr)
+        {
+            return;
+        }
+
+        for (size_t i = 0; i < m_meshRenderers.size(); i++)
+        {
+            if (m_sceneObjects[i].isOpaque)
+            {
+                m_transparencyRenderer->appendOpaqueObject(::objectName(i), m_meshRenderers[i].get());
+            }
+            else
+            {
+                m_transparencyRenderer->appendTransparentObject(::objectName(i), m_meshRenderers[i].get());
+            }
+            // the presorted orders cost memory by direction, built only for this engine
+            const bool isPresorted{ gl::TransparencyEngineFactory::engine(m_engineName) == gl::TransparencyEngineFactory::PRESORTED };
+            m_meshRenderers[i]->setPresortedDirectionCount(isPresorted && !m_sceneObjects[i].isOpaque ? gl::TransparencyEngineFactory::PRESORTED_DIRECTION_COUNT : 0);
+        }
+    }
+
+    //---------------------------------------------------------------------------------------
+    void OffscreenRenderer::fitCamera(void)
+    //---------------------------------------------------------------------------------------
+    {
+        // the scene is scaled to 100 units in the [-1000, 1000] depth range of the camera
+        // the bounds of the meshes are the boxes of their vertices, the generated meshes have no unused vertex
+        geom::AABB modelBounds;
+        for (const SceneGenerator::Object& object : m_sceneObjects)
+        {
+            modelBounds.extend(object.mesh.bounds());
+        }
+        if (modelBounds.isEmpty())
+        {
+            return;
+        }
+
+        const double scale{ 100. / modelBounds.max().distance(modelBounds.min()) };
+        m_camera.setScaling(static_cast<float>(scale));
+        const geom::Point center{ modelBounds.center().mul(-scale, -scale, -scale) };
+        m_camera.setTranslation(QVector3D(center.x(), center.y(), center.z()));
+    }
+
+    //---------------------------------------------------------------------------------------
+    QStringList OffscreenRenderer::transparencyEngineNames(void)
+    //---------------------------------------------------------------------------------------
+    {
+        return gl::TransparencyEngineFactory::names() << "Software";
+    }
+
+    //---------------------------------------------------------------------------------------
+    bool OffscreenRenderer::setTransparencyEngine(const QString& p_name)
+    //---------------------------------------------------------------------------------------
+    {
+        if (!isInitialized() || (hasOpenGL() && !makeCurrent()))
+        {
+            return false;
+        }
+
+        std::unique_ptr<gl::TransparencyRenderer> renderer;
+        std::unique_ptr<software::SoftwareDualDepthPeelingRenderer> softwareRenderer;
+        if (p_name == "Software")
+        {
+            softwareRenderer = std::make_unique<software::SoftwareDualDepthPeelingRenderer>(m_scene, m_camera);
+            softwareRenderer->setSize(m_width, m_height);
+        }
+        else if (!hasOpenGL())
+        {
+            // only the CPU engine without context
+        }
+        else if (gl::TransparencyEngineFactory::isSupported(gl::TransparencyEngineFactory::engine(p_name), &m_context))
+        {
+            renderer = gl::TransparencyEngineFactory::create(p_name, m_scene, m_camera);
+        }
+
+        if (renderer == nullptr && softwareRenderer == nullptr)
+        {
+            qCritical() << "Transparency engine" << p_name << "is unknown or not supported by the OpenGL context";
+            return false;
+        }
+
+        if (m_transparencyRenderer != nullptr)
+        {
+            m_transparencyRenderer->cleanup();
+        }
+        m_transparencyRenderer = std::move(renderer);
+        m_softwareRenderer = std::move(softwareRenderer);
+        m_softwareImage = QImage();
+        m_engineName = p_name;
+
+        static const QColor skyColor(44, 183, 185);
+        const QVector3D backgroundColor(skyColor.redF(), skyColor.greenF(), skyColor.blueF());
+        if (m_softwareRenderer != nullptr)
+        {
+            // the opaque targets of the GL engines are cleared with the black of renderFrame
+            m_softwareRenderer->setBackgroundColor(backgroundColor);
+        }
+        else
+        {
+            m_transparencyRenderer->setBackgroundColor(backgroundColor);
+            m_transparencyRenderer->setGpuProfiler(&m_gpuProfiler);
+            m_transparencyRenderer->setOutputFramebuffer(m_framebuffer->handle());
+        }
+        setFrameTimeBudget(m_frameTimeBudget);
+        appendSceneObjects();
+        return true;
+    }
+
+    //---------------------------------------------------------------------------------------
+    void OffscreenRenderer::setFrameTimeBudget(double p_milliseconds)
+    //---------------------------------------------------------------------------------------
+    {
+        m_frameTimeBudget = p_milliseconds;
+        if (auto* const renderer{ dynamic_cast<gl::DualDepthPeelingRenderer*>(m_transparencyRenderer.get()) })
+        {
+            renderer->setFrameTimeBudget(m_frameTimeBudget);
+        }
+    }
+
+    //---------------------------------------------------------------------------------------
+    double OffscreenRenderer::renderFrame(void)
+    //---------------------------------------------------------------------------------------
+    {
+        QElapsedTimer timer;
+        if (m_softwareRenderer != nullptr)
+        {
+            timer.start();
+            m_softwareImage = m_softwareRenderer->render();
+            return m_softwareImage.isNull() ? -1. : static_cast<double>(timer.nsecsElapsed()) * 1e-6;
+        }
+
+        if (m_transparencyRenderer == nullptr || !makeCurrent())
+        {
+            return -1.;
+        }
+
+        timer.start();
+
+        if (!m_transparencyRenderer->isInitialized() && !m_transparencyRenderer->initialize(m_width, m_height))
+        {
+            qCritical() << "Cannot initialize the transparency engine" << m_engineName;
+            return -1.;
+        }
+
+        m_framebuffer->bind();
+        glViewport(0, 0, m_width, m_height);
+        glClearColor(0, 0, 0, 0);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+        m_transparencyRenderer->render();
+        glFinish();
+
+        return static_cast<double>(timer.nsecsElapsed()) * 1e-6;
+    }
+
+    //---------------------------------------------------------------------------------------
+    void OffscreenRenderer::flushGpuProfiler(void)
+    //---------------------------------------------------------------------------------------
+    {
+        if (!hasOpenGL() || !m_gpuProfiler.isEnabled() || !makeCurrent())
+        {
+            return;
+        }
+
+        // an empty frame reads the pending ones, available after the glFinish of renderFrame
+        glFinish();
+        m_gpuProfiler.beginFrame();
+        m_gpuProfiler.endFrame();
+    }
+
+    //---------------------------------------------------------------------------------------
+    QImage OffscreenRenderer::grabImage(void)
+    //---------------------------------------------------------------------------------------
+    {
+        if (m_softwareRenderer != nullptr)
+        {
+            return m_softwareImage;
+        }
+        if (!hasOpenGL() || !makeCurrent())
+        {
+            return QImage();
+        }
+        return m_framebuffer->toImage();
+    }
+
+    //---------------------------------------------------------------------------------------
+    void OffscreenRenderer::cleanup(void)
+    //---------------------------------------------------------------------------------------
+    {
+        if (!isInitialized() || (hasOpenGL() && !makeCurrent()))
+        {
+            return;
+        }
+
+        if (m_transparencyRenderer != nullptr)
+        {
+            m_transparencyRenderer->cleanup();
+            m_transparencyRenderer.reset();
+        }
+        m_softwareRenderer.reset();
+        m_softwareImage = QImage();
+        clearScene();
+        m_width = 0;
+        m_height = 0;
+
+        if (hasOpenGL())
+        {
+            m_gpuProfiler.cleanup();
+            m_framebuffer.reset();
+            m_context.doneCurrent();
+        }
+    }
+
+}
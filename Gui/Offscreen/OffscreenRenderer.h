@@ -0,0 +1,117 @@
+#pragma once
+
+#include "GLWidgets/Camera.h"
+#include "GLWidgets/Scene.h"
+#include "Renderers/GpuProfiler.h"
+
+#include <Mesh/MeshModel.h>
+#include <Mesh/SceneGenerator.h>
+
+#include <QtGui/QImage>
+#include <QtGui/QOffscreenSurface>
+#include <QtGui/QOpenGLContext>
+#include <QtGui/QOpenGLFramebufferObject>
+#include <QtGui/QOpenGLFunctions_3_3_Core>
+#include <QtCore/QStringList>
+
+#include <memory>
+#include <vector>
+
+namespace gui
+{
+    namespace gl
+    {
+        class MeshRenderer;
+        class TransparencyRenderer;
+    }
+
+    namespace software
+    {
+        class SoftwareDualDepthPeelingRenderer;
+    }
+
+    /**
+     * \class OffscreenRenderer
+     * \brief Render a mesh or a generated scene with a transparency engine without window
+     *
+     * Same renderer stack as MainWidget, in a QOffscreenSurface: the engine renders in a framebuffer object of the
+     * requested size (AbstractRenderer::setOutputFramebuffer) instead of the default framebuffer. Works with a
+     * software OpenGL as Mesa llvmpipe, for the command line rendering and the benchmarks. Without OpenGL, the
+     * "Software" engine (SoftwareDualDepthPeelingRenderer) renders on the CPU.
+     * Needs a QGuiApplication, all the functions are called from its thread.
+     */
+    class OffscreenRenderer : protected QOpenGLFunctions_3_3_Core
+    {
+    public:
+        explicit OffscreenRenderer(void);
+        virtual ~OffscreenRenderer(void);
+
+        //!< Create an OpenGL 3.3 core context and the output framebuffer, false if the platform cannot.
+        //!< Without OpenGL (p_withOpenGL false, machines without GPU), only the "Software" engine is available.
+        bool initialize(int p_width, int p_height, bool p_withOpenGL = true);
+        inline bool isInitialized(void) const { return m_width > 0; }
+        inline bool hasOpenGL(void) const { return m_framebuffer != nullptr; }
+        QString glRendererName(void) const; //!< vendor, renderer and version of the context
+
+        //!< Load an .obj and fit the camera on it as MainWidget, the mesh is drawn with the opacity p_opacity
+        bool loadModel(const QString& p_filepath, float p_opacity = 0.5f);
+        //!< Replace the scene by a SceneGenerator scene and fit the camera on it, the transparent objects are drawn with the opacity p_opacity
+        bool loadGeneratedScene(const SceneGenerator::Parameters& p_parameters, float p_opacity = 0.5f);
+        inline const std::vector<SceneGenerator::Object>& sceneObjects(void) const { return m_sceneObjects; }
+        int faceCount(void) const; //!< triangles of the scene
+
+        //!< TransparencyEngineFactory::names() (ex. "DualDepthPeeling", "MultiLayerPeeling4"), then "Software"
+        static QStringList transparencyEngineNames(void);
+        //!< false if unknown or not supported by the context, need initialize() before
+        bool setTransparencyEngine(const QString& p_name);
+        inline const QString& transparencyEngineName(void) const { return m_engineName; }
+        inline gl::TransparencyRenderer* transparencyRenderer(void) { return m_transparencyRenderer.get(); } //!< nullptr for "Software"
+        inline software::SoftwareDualDepthPeelingRenderer* softwareRenderer(void) { return m_softwareRenderer.get(); } //!< "Software" only
+
+        //!< GPU time budget of the transparency passes of the engines which bound their passes with it (dual depth peeling),
+        //!< kept for the next engines. Milliseconds, 0 to disable (default)
+        void setFrameTimeBudget(double p_milliseconds);
+        inline double frameTimeBudget(void) const { return m_frameTimeBudget; }
+
+        inline Camera& camera(void) { return m_camera; }
+        inline const Scene& scene(void) const { return m_scene; }
+        inline gl::GpuProfiler& gpuProfiler(void) { return m_gpuProfiler; }
+
+        //!< Render one frame and wait for the GPU, returns the wall time in milliseconds (-1 on error)
+        double renderFrame(void);
+        //!< Read back the pending GPU profiler frames, call it after the last renderFrame
+        void flushGpuProfiler(void);
+        QImage grabImage(void); //!< the last frame
+
+        void cleanup(void); //!< Free GL memory, called by the destructor
+
+    private:
+        bool initializeOpenGL(int p_width, int p_height);
+        bool makeCurrent(void);
+
+        bool setScene(std::vector<SceneGenerator::Object>&& p_objects, float p_opacity);
+        void clearScene(void);
+        void appendSceneObjects(void); //!< to the transparency engine
+        void fitCamera(void);
+
+        QOffscreenSurface m_surface;
+        QOpenGLContext m_context;
+        std::unique_ptr<QOpenGLFramebufferObject> m_framebuffer;
+        int m_width;
+        int m_height;
+
+        Scene m_scene;
+        Camera m_camera;
+        std::vector<SceneGenerator::Object> m_sceneObjects; // not resized while the renderers point to the meshes
+        std::vector<std::unique_ptr<gl::MeshRenderer>> m_meshRenderers; // one by scene object
+        std::unique_ptr<gl::TransparencyRenderer> m_transparencyRenderer;
+        std::unique_ptr<software::SoftwareDualDepthPeelingRenderer> m_softwareRenderer;
+        QImage m_softwareImage; // last frame of m_softwareRenderer
+        QString m_engineName;
+        double m_frameTimeBudget;
+        gl::GpuProfiler m_gpuProfiler;
+
+        Q_DISABLE_COPY(OffscreenRenderer);
+    };
+
+}
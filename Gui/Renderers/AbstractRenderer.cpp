@@ -1,5 +1,9 @@
 #include "Renderers/AbstractRenderer.h"
 
+#include "GLWidgets/Camera.h"
+#include "GLWidgets/Scene.h"
+#include "Renderers/GpuProfiler.h"
+
 #include <QtCore/QDebug>
 #include <QtCore/QDir>
 #include <QtGui/QOpenGLFramebufferObject>
@@ -29,6 +33,8 @@ namespace gui::gl
     AbstractRenderer::AbstractRenderer(const Scene& p_scene, const Camera& p_camera) : QOpenGLFunctions_3_3_Core()
         , m_scene(p_scene)
         , m_camera(p_camera)
+        , m_gpuProfiler(nullptr)
+        , m_outputFramebufferId(0)
         , m_shaderInitialized(false)
         , m_renderTargetsInitialized(false)
         , m_otherGlFunctionsInitialized(false)
@@ -141,14 +147,14 @@ namespace gui::gl
         }
 #endif
 
-        QOpenGLFramebufferObject::bindDefault();
+        bindOutputFramebuffer();
 
         m_isFullyInitialized = true;
         return true;
     }
 
     //---------------------------------------------------------------------------------------
-    bool AbstractRenderer::addCacheableShaderFromSourceFileList(QOpenGLShaderProgram& p_program, QOpenGLShader::ShaderTypeBit p_shaderType, const QStringList& p_filepathList)
+    bool AbstractRenderer::addCacheableShaderFromSourceFileList(ShaderProgram& p_program, QOpenGLShader::ShaderTypeBit p_shaderType, const QStringList& p_filepathList)
     //---------------------------------------------------------------------------------------
     {
         bool addOk(true);
@@ -165,7 +171,7 @@ namespace gui::gl
     }
 
     //---------------------------------------------------------------------------------------
-    bool AbstractRenderer::loadShaders(QOpenGLShaderProgram& p_program, const QStringList& p_vertexFilepathList, const QStringList& p_fragmentFilepathList)
+    bool AbstractRenderer::loadShaders(ShaderProgram& p_program, const QStringList& p_vertexFilepathList, const QStringList& p_fragmentFilepathList)
     //---------------------------------------------------------------------------------------
     {
         bool addOk = addCacheableShaderFromSourceFileList(p_program, QOpenGLShader::Vertex, p_vertexFilepathList);
@@ -182,7 +188,7 @@ namespace gui::gl
     }
 
     //---------------------------------------------------------------------------------------
-    bool AbstractRenderer::loadShaders(QOpenGLShaderProgram& p_program, const QStringList& p_vertexFilepathList, const QStringList& p_geometryFilepathList, const QStringList& p_fragmentFilepathList)
+    bool AbstractRenderer::loadShaders(ShaderProgram& p_program, const QStringList& p_vertexFilepathList, const QStringList& p_geometryFilepathList, const QStringList& p_fragmentFilepathList)
     //---------------------------------------------------------------------------------------
     {
         const bool addOk = addCacheableShaderFromSourceFileList(p_program, QOpenGLShader::Geometry, p_geometryFilepathList);
@@ -195,4 +201,57 @@ namespace gui::gl
         return loadShaders(p_program, p_vertexFilepathList, p_fragmentFilepathList);
     }
 
+    //---------------------------------------------------------------------------------------
+    void AbstractRenderer::beginGpuStage(const char* p_name)
+    //---------------------------------------------------------------------------------------
+    {
+        if (m_gpuProfiler != nullptr && m_gpuProfiler->isRecording())
+        {
+            m_gpuProfiler->beginStage(QString::fromLatin1(p_name));
+        }
+#ifdef DEBUG_GL_CALL_COUNTERS
+        GlCallCounters::beginStage(QString::fromLatin1(p_name));
+#endif
+    }
+
+    //---------------------------------------------------------------------------------------
+    void AbstractRenderer::beginGpuStage(const char* p_name, size_t p_pass)
+    //---------------------------------------------------------------------------------------
+    {
+        // the name is only built when it is recorded
+        if (m_gpuProfiler != nullptr && m_gpuProfiler->isRecording())
+        {
+            m_gpuProfiler->beginStage(QString("%1 %2").arg(QString::fromLatin1(p_name)).arg(p_pass));
+        }
+#ifdef DEBUG_GL_CALL_COUNTERS
+        if (GlCallCounters::isRecording())
+        {
+            GlCallCounters::beginStage(QString("%1 %2").arg(QString::fromLatin1(p_name)).arg(p_pass));
+        }
+#endif
+    }
+
+    //---------------------------------------------------------------------------------------
+    void AbstractRenderer::bindOutputFramebuffer(void)
+    //---------------------------------------------------------------------------------------
+    {
+        if (m_outputFramebufferId == 0u)
+        {
+            QOpenGLFramebufferObject::bindDefault();
+        }
+        else
+        {
+            glBindFramebuffer(GL_FRAMEBUFFER, m_outputFramebufferId);
+        }
+    }
+
+    //---------------------------------------------------------------------------------------
+    geom::Frustum AbstractRenderer::viewFrustum(void) const
+    //---------------------------------------------------------------------------------------
+    {
+        // same matrix as the ModelViewProjectionMatrix of the shaders
+        const QMatrix4x4 modelViewProjectionMatrix{ m_camera.projMatrix() * m_camera.viewMatrix() * m_scene.modelMatrix() };
+        return geom::Frustum(modelViewProjectionMatrix.constData());
+    }
+
 }
@@ -5,9 +5,9 @@
 #include "Renderers/Debug/AutoShaderReloader.h"
 #endif
 
-#include <QtGui/QOpenGLFunctions_3_3_Core>
+#include "Renderers/GlFunctions.h"
 
-#include <QtGui/QOpenGLShaderProgram>
+#include <Geom/Frustum.h>
 
 namespace gui
 {
@@ -37,12 +37,13 @@ Class& operator=(Class&&) noexcept Q_DECL_EQ_DELETE;
 
 namespace gui::gl
 {
+    class GpuProfiler;
 
     /**
      * Base class to render an OpenGL Object.
      * This class allows to pushRef and popRef for each rendering objects
      */
-    class AbstractRenderer : protected QOpenGLFunctions_3_3_Core
+    class AbstractRenderer : protected GlFunctions
     {
 #ifdef DEBUG_AUTO_SHADER
         friend class AutoShaderReloader;
@@ -61,6 +62,17 @@ namespace gui::gl
 
         virtual void render(void) = 0; //!< render GL textures
 
+        //!< Record the GPU time of the rendering stages in p_profiler (not owner), nullptr to stop
+        inline void setGpuProfiler(GpuProfiler* p_profiler) { m_gpuProfiler = p_profiler; }
+        inline GpuProfiler* gpuProfiler(void) const { return m_gpuProfiler; }
+
+        //!< Framebuffer of the final image, 0 (default) for the default framebuffer of the context (ex. of the QOpenGLWidget)
+        inline void setOutputFramebuffer(GLuint p_framebufferId) { m_outputFramebufferId = p_framebufferId; }
+        inline GLuint outputFramebuffer(void) const { return m_outputFramebufferId; }
+
+        //!< Frustum of the camera in the model space of the scene, to cull the objects outside the view by their bounds
+        geom::Frustum viewFrustum(void) const;
+
         //!< Call cleanup(), delete @a p_ptr and assign it to nullptr
         //! Use Macro below to populate @a p_ptrObject, @a p_file and @a p_line
         template <class Class>
@@ -87,17 +99,28 @@ namespace gui::gl
         virtual bool initShaders(void) = 0;
         virtual void deleteShaders(void) = 0;
 
-        DECLARE_STATIC bool addCacheableShaderFromSourceFileList(QOpenGLShaderProgram& p_program, QOpenGLShader::ShaderTypeBit p_shaderType, const QStringList& p_filepathList);
-        //!< use this to load and link a QOpenGLShaderProgram with shaders list
+        DECLARE_STATIC bool addCacheableShaderFromSourceFileList(ShaderProgram& p_program, QOpenGLShader::ShaderTypeBit p_shaderType, const QStringList& p_filepathList);
+        //!< use this to load and link a ShaderProgram with shaders list
+        ///@{
+        DECLARE_STATIC bool loadShaders(ShaderProgram& p_program, const QStringList& p_vertexFilepathList, const QStringList& p_fragmentFilepathList);
+        DECLARE_STATIC bool loadShaders(ShaderProgram& p_program, const QStringList& p_vertexFilepathList, const QStringList& p_geometryFilepathList, const QStringList& p_fragmentFilepathList);
+        ///@}
+
+        //!< Start a stage of the frame recorded by the profiler, it ends the previous one. Nothing if there is no profiler
         ///@{
-        DECLARE_STATIC bool loadShaders(QOpenGLShaderProgram& p_program, const QStringList& p_vertexFilepathList, const QStringList& p_fragmentFilepathList);
-        DECLARE_STATIC bool loadShaders(QOpenGLShaderProgram& p_program, const QStringList& p_vertexFilepathList, const QStringList& p_geometryFilepathList, const QStringList& p_fragmentFilepathList);
+        void beginGpuStage(const char* p_name);
+        void beginGpuStage(const char* p_name, size_t p_pass); //!< named "p_name p_pass"
         ///@}
 
+        void bindOutputFramebuffer(void); //!< see setOutputFramebuffer
+
         const Scene& m_scene;
         const Camera& m_camera;
 
     private:
+        GpuProfiler* m_gpuProfiler;
+        GLuint m_outputFramebufferId;
+
         bool m_shaderInitialized; //!< if false, reload the shaders
         bool m_renderTargetsInitialized; //!< if false, reload the render targets (specially for GL buffers)
         bool m_otherGlFunctionsInitialized; //!< if false, reload other GL functions
@@ -0,0 +1,63 @@
+#include "Renderers/Common/ImageComparison.h"
+
+#include <QtCore/QDebug>
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace gui
+{
+
+    //---------------------------------------------------------------------------------------
+    ImageDifference compareImages(const QImage& p_image, const QImage& p_reference, int p_tolerance, bool p_withDifferenceImage)
+    //---------------------------------------------------------------------------------------
+    {
+        ImageDifference difference;
+        if (p_image.size() != p_reference.size() || p_image.isNull())
+        {
+            qCritical() << "Cannot compare images of sizes" << p_image.size() << "and" << p_reference.size();
+            difference.maxDifference = 255;
+            difference.meanDifference = 255.;
+            difference.differentPixelRatio = 1.;
+            return difference;
+        }
+
+        const QImage image{ p_image.convertToFormat(QImage::Format_RGB32) };
+        const QImage reference{ p_reference.convertToFormat(QImage::Format_RGB32) };
+        if (p_withDifferenceImage)
+        {
+            difference.differenceImage = QImage(image.size(), QImage::Format_RGB32);
+        }
+        qint64 differenceSum{ 0 };
+        for (int y = 0; y < image.height(); y++)
+        {
+            const QRgb* const line{ reinterpret_cast<const QRgb*>(image.constScanLine(y)) };
+            const QRgb* const referenceLine{ reinterpret_cast<const QRgb*>(reference.constScanLine(y)) };
+            QRgb* const differenceLine{ p_withDifferenceImage ? reinterpret_cast<QRgb*>(difference.differenceImage.scanLine(y)) : nullptr };
+            for (int x = 0; x < image.width(); x++)
+            {
+                const int red{ std::abs(qRed(line[x]) - qRed(referenceLine[x])) };
+                const int green{ std::abs(qGreen(line[x]) - qGreen(referenceLine[x])) };
+                const int blue{ std::abs(qBlue(line[x]) - qBlue(referenceLine[x])) };
+                const int pixelDifference{ std::max({ red, green, blue }) };
+
+                difference.maxDifference = std::max(difference.maxDifference, pixelDifference);
+                differenceSum += red + green + blue;
+                if (pixelDifference > p_tolerance)
+                {
+                    difference.differentPixelCount++;
+                }
+                if (differenceLine != nullptr)
+                {
+                    differenceLine[x] = qRgb(std::min(255, 8 * red), std::min(255, 8 * green), std::min(255, 8 * blue));
+                }
+            }
+        }
+
+        const double pixelCount{ static_cast<double>(image.width()) * image.height() };
+        difference.meanDifference = static_cast<double>(differenceSum) / (3. * pixelCount);
+        difference.differentPixelRatio = static_cast<double>(difference.differentPixelCount) / pixelCount;
+        return difference;
+    }
+
+}
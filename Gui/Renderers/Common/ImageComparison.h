@@ -0,0 +1,23 @@
+#pragma once
+
+#include <QtGui/QImage>
+
+namespace gui
+{
+
+    //!< Difference of an image with a reference of the same size, by channel in [0, 255]
+    struct ImageDifference
+    {
+        int maxDifference = 0;
+        double meanDifference = 0.; //!< mean absolute difference by channel
+        qint64 differentPixelCount = 0; //!< pixels with a channel over the tolerance
+        double differentPixelRatio = 0.;
+        QImage differenceImage; //!< absolute difference, scaled to be visible, null if not requested
+    };
+
+    //!< Anti-aliasing, rasterization rules and float precision differ between the GL drivers and the engines: the images are
+    //!< comparable when a small ratio of pixels (the triangle edges) is over p_tolerance. Compared in RGB, alpha ignored.
+    //!< Different sizes are reported as fully different
+    ImageDifference compareImages(const QImage& p_image, const QImage& p_reference, int p_tolerance, bool p_withDifferenceImage = true);
+
+}
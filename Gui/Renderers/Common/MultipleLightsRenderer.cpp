@@ -11,6 +11,39 @@
 namespace gui::gl
 {
 
+    //---------------------------------------------------------------------------------------
+    const MultipleLightsRenderer::DirLight& MultipleLightsRenderer::dirLight(void)
+    //---------------------------------------------------------------------------------------
+    {
+        static const DirLight light{
+            QVector3D(0.0f, 0.0f, -1.0f),
+            QVector3D(0.2f, 0.2f, 0.2f),
+            QVector3D(0.7f, 0.7f, 0.7f),
+            QVector3D(0.3f, 0.3f, 0.3f)
+        };
+        return light;
+    }
+
+    //---------------------------------------------------------------------------------------
+    const MultipleLightsRenderer::SpotLight& MultipleLightsRenderer::spotLight(void)
+    //---------------------------------------------------------------------------------------
+    {
+        static const SpotLight light{
+            QVector3D(200.f, 100.f, 500.f),
+            QVector3D(0.f, .7f, -.7f),
+            static_cast<float>(std::cos(M_PI * 70.f / 180.f)),
+            static_cast<float>(std::cos(M_PI * 0.f / 180.f)),
+            // The attenuation factors are (1, 0, 0), resulting in no attenuation
+            1.0f,
+            0.0f,
+            0.0f,
+            QVector3D(0.1f, 0.1f, 0.1f),
+            QVector3D(0.4f, 0.4f, 0.4f),
+            QVector3D(0.0f, 0.0f, 0.0f)
+        };
+        return light;
+    }
+
     //---------------------------------------------------------------------------------------
     MultipleLightsRenderer::MultipleLightsRenderer(void)
         : m_useAmbiantLight(true)
@@ -21,7 +54,7 @@ namespace gui::gl
     }
 
     //---------------------------------------------------------------------------------------
-    void MultipleLightsRenderer::bindLightColor(QOpenGLShaderProgram& p_program, const QMatrix4x4& p_modelViewMatrix) const
+    void MultipleLightsRenderer::bindLightColor(ShaderProgram& p_program, const QMatrix4x4& p_modelViewMatrix) const
     //---------------------------------------------------------------------------------------
     {
         p_program.setUniformValue("UseAmbiantLight", m_useAmbiantLight);
@@ -39,27 +72,23 @@ namespace gui::gl
 
             p_program.setUniformValue("materialOn", m_materialOn);
 
-            // directional light
-            p_program.setUniformValue("dirLight.direction", 0.0f, 0.0f, -1.0f);
-            p_program.setUniformValue("dirLight.ambient", 0.2f, 0.2f, 0.2f);
-            p_program.setUniformValue("dirLight.diffuse", 0.7f, 0.7f, 0.7f);
-            p_program.setUniformValue("dirLight.specular", 0.3f, 0.3f, 0.3f);
+            const DirLight& directional{ dirLight() };
+            p_program.setUniformValue("dirLight.direction", directional.direction);
+            p_program.setUniformValue("dirLight.ambient", directional.ambient);
+            p_program.setUniformValue("dirLight.diffuse", directional.diffuse);
+            p_program.setUniformValue("dirLight.specular", directional.specular);
 
-            // spotLight
-            p_program.setUniformValue("spotLight.position", 200.f, 100.f, 500.f);
-            static const QVector3D spotDirection(0.f, .7f, -.7f);
-            p_program.setUniformValue("spotLight.direction", spotDirection);
-            p_program.setUniformValue("spotLight.ambient", 0.1f, 0.1f, 0.1f);
-            p_program.setUniformValue("spotLight.diffuse", 0.4f, 0.4f, 0.4f);
-            p_program.setUniformValue("spotLight.specular", 0.0f, 0.0f, 0.0f);
-            p_program.setUniformValue("spotLight.constant", 1.0f);
-            // The attenuation factors are (1, 0, 0), resulting in no attenuation
-            p_program.setUniformValue("spotLight.linear", 0.0f);
-            p_program.setUniformValue("spotLight.quadratic", 0.0f);
-            static const float cutOff = std::cos(M_PI * 70.f / 180.f);
-            p_program.setUniformValue("spotLight.cutOff", cutOff);
-            static const float outerCutOff = std::cos(M_PI * 0.f / 180.f);
-            p_program.setUniformValue("spotLight.outerCutOff", outerCutOff);
+            const SpotLight& spot{ spotLight() };
+            p_program.setUniformValue("spotLight.position", spot.position);
+            p_program.setUniformValue("spotLight.direction", spot.direction);
+            p_program.setUniformValue("spotLight.ambient", spot.ambient);
+            p_program.setUniformValue("spotLight.diffuse", spot.diffuse);
+            p_program.setUniformValue("spotLight.specular", spot.specular);
+            p_program.setUniformValue("spotLight.constant", spot.constant);
+            p_program.setUniformValue("spotLight.linear", spot.linear);
+            p_program.setUniformValue("spotLight.quadratic", spot.quadratic);
+            p_program.setUniformValue("spotLight.cutOff", spot.cutOff);
+            p_program.setUniformValue("spotLight.outerCutOff", spot.outerCutOff);
         }
     }
 
@@ -1,10 +1,10 @@
 #pragma once
 
+#include "Renderers/GlFunctions.h"
+
 #include <QtGui/QVector3D>
 #include <QtOpenGL/QGL>
 
-class QOpenGLShaderProgram;
-
 namespace gui::gl
 {
 
@@ -17,6 +17,30 @@ namespace gui::gl
         friend class DualDepthPeelingRenderer;
 
     public:
+        //!< Lights of shade_fragment.glsl in eye coordinates, the same for all the meshes
+        struct DirLight
+        {
+            QVector3D direction;
+            QVector3D ambient;
+            QVector3D diffuse;
+            QVector3D specular;
+        };
+        struct SpotLight
+        {
+            QVector3D position;
+            QVector3D direction;
+            float cutOff;
+            float outerCutOff;
+            float constant;
+            float linear;
+            float quadratic;
+            QVector3D ambient;
+            QVector3D diffuse;
+            QVector3D specular;
+        };
+        static const DirLight& dirLight(void);
+        static const SpotLight& spotLight(void);
+
         explicit MultipleLightsRenderer(void);
 
         inline void setUseAmbiantLight(bool p_useAmbiantLight) { m_useAmbiantLight = p_useAmbiantLight; } //!< use spots if true, otherwise the mesh lights the scene
@@ -30,11 +54,18 @@ namespace gui::gl
         inline void setMaterialDiffuseColor(const QVector3D& p_color) { m_materialColor.diffuse = p_color; }
         inline void setMaterialSpecularColor(const QVector3D& p_color) { m_materialColor.specular = p_color; }
 
+        inline bool useAmbiantLight(void) const { return m_useAmbiantLight; }
+        inline bool isMaterialOn(void) const { return m_materialOn; }
+        inline const QVector3D& color(void) const { return m_color; }
+        inline const QVector3D& materialAmbiantColor(void) const { return m_materialColor.ambiant; }
+        inline const QVector3D& materialDiffuseColor(void) const { return m_materialColor.diffuse; }
+        inline const QVector3D& materialSpecularColor(void) const { return m_materialColor.specular; }
+
     protected:
         static constexpr const char* shadeVertex(void) { return "Shaders:Common/shade_vertex.glsl"; }
         static constexpr const char* shadeFragment(void) { return "Shaders:Common/shade_fragment.glsl"; }
 
-        void bindLightColor(QOpenGLShaderProgram& p_program, const QMatrix4x4& p_modelViewMatrix) const;
+        void bindLightColor(ShaderProgram& p_program, const QMatrix4x4& p_modelViewMatrix) const;
 
     private:
         struct Material
@@ -0,0 +1,102 @@
+#include "Renderers/Debug/GlCallCounters.h"
+
+#if defined(_DEBUG) && defined(GL_CALL_COUNTERS)
+
+namespace gui::gl
+{
+
+    bool GlCallCounters::s_isRecording{ false };
+    QString GlCallCounters::s_stageName;
+    GlCallCounters::Count GlCallCounters::s_current;
+    GlCallCounters::FrameCount GlCallCounters::s_frame;
+    GlCallCounters::FrameCount GlCallCounters::s_lastFrame;
+
+    //---------------------------------------------------------------------------------------
+    GlCallCounters::Count& GlCallCounters::Count::operator+=(const Count& p_count)
+    //---------------------------------------------------------------------------------------
+    {
+        drawCalls += p_count.drawCalls;
+        vertices += p_count.vertices;
+        programBinds += p_count.programBinds;
+        textureBinds += p_count.textureBinds;
+        framebufferBinds += p_count.framebufferBinds;
+        uniformUpdates += p_count.uniformUpdates;
+        bufferUploadBytes += p_count.bufferUploadBytes;
+        queries += p_count.queries;
+        return *this;
+    }
+
+    //---------------------------------------------------------------------------------------
+    void GlCallCounters::beginFrame(void)
+    //---------------------------------------------------------------------------------------
+    {
+        if (s_isRecording)
+        {
+            endFrame();
+        }
+
+        // the calls between two frames (ex. uploads of a new mesh) are counted in the first one
+        s_frame = FrameCount();
+        s_stageName.clear();
+        s_isRecording = true;
+    }
+
+    //---------------------------------------------------------------------------------------
+    void GlCallCounters::endFrame(void)
+    //---------------------------------------------------------------------------------------
+    {
+        if (!s_isRecording)
+        {
+            return;
+        }
+
+        endStage();
+        s_lastFrame = std::move(s_frame);
+        s_frame = FrameCount();
+        s_isRecording = false;
+    }
+
+    //---------------------------------------------------------------------------------------
+    void GlCallCounters::beginStage(const QString& p_name)
+    //---------------------------------------------------------------------------------------
+    {
+        if (!s_isRecording)
+        {
+            return;
+        }
+
+        endStage();
+        s_stageName = p_name;
+    }
+
+    //---------------------------------------------------------------------------------------
+    void GlCallCounters::endStage(void)
+    //---------------------------------------------------------------------------------------
+    {
+        s_frame.total += s_current;
+        if (!s_stageName.isEmpty())
+        {
+            s_frame.stages.push_back({ s_stageName, s_current });
+        }
+        s_stageName.clear();
+        s_current = Count();
+    }
+
+    //---------------------------------------------------------------------------------------
+    QString GlCallCounters::toString(const Count& p_count)
+    //---------------------------------------------------------------------------------------
+    {
+        return QString("%1 draws, %2 vertices, %3 programs, %4 textures, %5 fbos, %6 uniforms, %7 bytes uploaded, %8 queries")
+            .arg(p_count.drawCalls)
+            .arg(p_count.vertices)
+            .arg(p_count.programBinds)
+            .arg(p_count.textureBinds)
+            .arg(p_count.framebufferBinds)
+            .arg(p_count.uniformUpdates)
+            .arg(p_count.bufferUploadBytes)
+            .arg(p_count.queries);
+    }
+
+}
+
+#endif
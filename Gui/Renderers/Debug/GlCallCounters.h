@@ -0,0 +1,188 @@
+#pragma once
+
+#ifndef _DEBUG
+#ifdef GL_CALL_COUNTERS
+#error This class must be used only in debug mode
+#endif
+#endif
+
+#include <QtGui/QOpenGLFunctions_3_3_Core>
+#include <QtGui/QOpenGLShaderProgram>
+#include <QtCore/QString>
+
+#include <utility>
+#include <vector>
+
+namespace gui::gl
+{
+
+    /**
+     * \class GlCallCounters
+     * \brief Count the GL calls and state changes of the renderers by frame and by stage
+     *
+     * Debug class: the renderers call OpenGL through CountedGlFunctions and CountedShaderProgram (see GlFunctions.h),
+     * which increment the counts of the current stage before forwarding the call. A frame is opened by
+     * TransparencyRenderer::render() and split by the stages of AbstractRenderer::beginGpuStage(), as the GpuProfiler.
+     * The calls of the Qt objects other than the shader programs (ex. QOpenGLFramebufferObject::bindDefault) are not counted.
+     * Static state: the renderers of one rendering thread only.
+     */
+    class GlCallCounters
+    {
+    public:
+        struct Count
+        {
+            quint64 drawCalls = 0;
+            quint64 vertices = 0; //!< submitted by the draw calls, instances included
+            quint64 programBinds = 0;
+            quint64 textureBinds = 0;
+            quint64 framebufferBinds = 0;
+            quint64 uniformUpdates = 0;
+            quint64 bufferUploadBytes = 0; //!< glBufferData with data and glBufferSubData
+            quint64 queries = 0; //!< glBeginQuery and glQueryCounter
+
+            Count& operator+=(const Count& p_count);
+        };
+        struct StageCount
+        {
+            QString name;
+            Count count;
+        };
+        struct FrameCount
+        {
+            Count total; //!< the calls before the first stage included
+            std::vector<StageCount> stages;
+        };
+
+        GlCallCounters(void) = delete;
+
+        static void beginFrame(void); //!< ends the current frame
+        static void endFrame(void);
+        static inline bool isRecording(void) { return s_isRecording; }
+        static void beginStage(const QString& p_name); //!< ends the current stage, nothing out of a frame
+
+        //!< Count of the current stage, the calls out of a frame are counted until the next frame
+        static inline Count& current(void) { return s_current; }
+        //!< Last frame ended, to compare the driver overhead of the engines or of the number of meshes
+        static inline const FrameCount& lastFrame(void) { return s_lastFrame; }
+
+        static QString toString(const Count& p_count); //!< one line
+
+    private:
+        static void endStage(void);
+
+        static bool s_isRecording;
+        static QString s_stageName; //!< empty before the first stage of a frame
+        static Count s_current;
+        static FrameCount s_frame;
+        static FrameCount s_lastFrame;
+    };
+
+    /**
+     * \class CountedGlFunctions
+     * \brief QOpenGLFunctions_3_3_Core which counts the calls of GlCallCounters, hides the counted functions
+     */
+    class CountedGlFunctions : public QOpenGLFunctions_3_3_Core
+    {
+    public:
+        inline void glDrawArrays(GLenum p_mode, GLint p_first, GLsizei p_count)
+        {
+            countDraw(p_count, 1);
+            QOpenGLFunctions_3_3_Core::glDrawArrays(p_mode, p_first, p_count);
+        }
+        inline void glDrawArraysInstanced(GLenum p_mode, GLint p_first, GLsizei p_count, GLsizei p_instanceCount)
+        {
+            countDraw(p_count, p_instanceCount);
+            QOpenGLFunctions_3_3_Core::glDrawArraysInstanced(p_mode, p_first, p_count, p_instanceCount);
+        }
+        inline void glDrawElements(GLenum p_mode, GLsizei p_count, GLenum p_type, const GLvoid* p_indices)
+        {
+            countDraw(p_count, 1);
+            QOpenGLFunctions_3_3_Core::glDrawElements(p_mode, p_count, p_type, p_indices);
+        }
+        inline void glDrawElementsInstanced(GLenum p_mode, GLsizei p_count, GLenum p_type, const GLvoid* p_indices, GLsizei p_instanceCount)
+        {
+            countDraw(p_count, p_instanceCount);
+            QOpenGLFunctions_3_3_Core::glDrawElementsInstanced(p_mode, p_count, p_type, p_indices, p_instanceCount);
+        }
+
+        inline void glUseProgram(GLuint p_program)
+        {
+            GlCallCounters::current().programBinds++;
+            QOpenGLFunctions_3_3_Core::glUseProgram(p_program);
+        }
+        inline void glBindTexture(GLenum p_target, GLuint p_texture)
+        {
+            GlCallCounters::current().textureBinds++;
+            QOpenGLFunctions_3_3_Core::glBindTexture(p_target, p_texture);
+        }
+        inline void glBindFramebuffer(GLenum p_target, GLuint p_framebuffer)
+        {
+            GlCallCounters::current().framebufferBinds++;
+            QOpenGLFunctions_3_3_Core::glBindFramebuffer(p_target, p_framebuffer);
+        }
+
+        inline void glBufferData(GLenum p_target, GLsizeiptr p_size, const GLvoid* p_data, GLenum p_usage)
+        {
+            if (p_data != nullptr) // else an allocation only
+            {
+                GlCallCounters::current().bufferUploadBytes += static_cast<quint64>(p_size);
+            }
+            QOpenGLFunctions_3_3_Core::glBufferData(p_target, p_size, p_data, p_usage);
+        }
+        inline void glBufferSubData(GLenum p_target, GLintptr p_offset, GLsizeiptr p_size, const GLvoid* p_data)
+        {
+            GlCallCounters::current().bufferUploadBytes += static_cast<quint64>(p_size);
+            QOpenGLFunctions_3_3_Core::glBufferSubData(p_target, p_offset, p_size, p_data);
+        }
+
+        inline void glBeginQuery(GLenum p_target, GLuint p_id)
+        {
+            GlCallCounters::current().queries++;
+            QOpenGLFunctions_3_3_Core::glBeginQuery(p_target, p_id);
+        }
+        inline void glQueryCounter(GLuint p_id, GLenum p_target)
+        {
+            GlCallCounters::current().queries++;
+            QOpenGLFunctions_3_3_Core::glQueryCounter(p_id, p_target);
+        }
+
+    private:
+        static inline void countDraw(GLsizei p_count, GLsizei p_instanceCount)
+        {
+            GlCallCounters::Count& count{ GlCallCounters::current() };
+            count.drawCalls++;
+            count.vertices += static_cast<quint64>(p_count) * static_cast<quint64>(p_instanceCount);
+        }
+    };
+
+    /**
+     * \class CountedShaderProgram
+     * \brief QOpenGLShaderProgram which counts the binds and the uniform updates of GlCallCounters
+     */
+    class CountedShaderProgram : public QOpenGLShaderProgram
+    {
+    public:
+        using QOpenGLShaderProgram::QOpenGLShaderProgram;
+
+        inline bool bind(void)
+        {
+            GlCallCounters::current().programBinds++;
+            return QOpenGLShaderProgram::bind();
+        }
+
+        template <typename... Args>
+        inline void setUniformValue(Args&&... p_args)
+        {
+            GlCallCounters::current().uniformUpdates++;
+            QOpenGLShaderProgram::setUniformValue(std::forward<Args>(p_args)...);
+        }
+
+        template <typename... Args>
+        inline void setUniformValueArray(Args&&... p_args)
+        {
+            GlCallCounters::current().uniformUpdates++;
+            QOpenGLShaderProgram::setUniformValueArray(std::forward<Args>(p_args)...);
+        }
+    };
+
+}
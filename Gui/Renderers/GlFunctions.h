@@ -0,0 +1,24 @@
+#pragma once
+
+#if defined(_DEBUG) && defined(GL_CALL_COUNTERS)
+#define DEBUG_GL_CALL_COUNTERS
+#include "Renderers/Debug/GlCallCounters.h"
+#endif
+
+#include <QtGui/QOpenGLFunctions_3_3_Core>
+#include <QtGui/QOpenGLShaderProgram>
+
+namespace gui::gl
+{
+
+    //!< OpenGL entry points and shader program of the renderers, counted by GlCallCounters in debug with GL_CALL_COUNTERS
+    //!< Same types as Qt otherwise: the counters are compiled out
+#ifdef DEBUG_GL_CALL_COUNTERS
+    using GlFunctions = CountedGlFunctions;
+    using ShaderProgram = CountedShaderProgram;
+#else
+    using GlFunctions = QOpenGLFunctions_3_3_Core;
+    using ShaderProgram = QOpenGLShaderProgram;
+#endif
+
+}
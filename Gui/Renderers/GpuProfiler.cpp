@@ -0,0 +1,296 @@
+#include "Renderers/GpuProfiler.h"
+
+#include <QtCore/QDebug>
+#include <QtCore/QFile>
+#include <QtCore/QHash>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QTextStream>
+
+namespace gui::gl
+{
+
+    //---------------------------------------------------------------------------------------
+    GpuProfiler::GpuProfiler(void)
+        : m_isEnabled(false)
+        , m_isInitialized(false)
+        , m_isRecording(false)
+        , m_isStageOpen(false)
+        , m_frameId(0)
+        , m_droppedFrameCount(0)
+    //---------------------------------------------------------------------------------------
+    {
+    }
+
+    //---------------------------------------------------------------------------------------
+    GpuProfiler::~GpuProfiler(void)
+    //---------------------------------------------------------------------------------------
+    {
+    }
+
+    //---------------------------------------------------------------------------------------
+    void GpuProfiler::setEnable(bool p_isEnabled)
+    //---------------------------------------------------------------------------------------
+    {
+        m_isEnabled = p_isEnabled;
+        if (!m_isEnabled)
+        {
+            for (PendingFrame& frame : m_pendingFrames)
+            {
+                frame.stageNames.clear();
+            }
+            m_history.clear();
+            m_droppedFrameCount = 0;
+        }
+    }
+
+    //---------------------------------------------------------------------------------------
+    void GpuProfiler::cleanup(void)
+    //---------------------------------------------------------------------------------------
+    {
+        if (!m_isInitialized)
+        {
+            return;
+        }
+
+        for (PendingFrame& frame : m_pendingFrames)
+        {
+            if (!frame.queryIds.empty())
+            {
+                glDeleteQueries(static_cast<GLsizei>(frame.queryIds.size()), frame.queryIds.data());
+            }
+            frame.queryIds.clear();
+            frame.stageNames.clear();
+        }
+        m_isRecording = false;
+        m_isStageOpen = false;
+        m_isInitialized = false; // the functions of a new context are resolved by the next beginFrame()
+    }
+
+    //---------------------------------------------------------------------------------------
+    void GpuProfiler::beginFrame(void)
+    //---------------------------------------------------------------------------------------
+    {
+        if (!m_isEnabled)
+        {
+            return;
+        }
+
+        if (!m_isInitialized)
+        {
+            initializeOpenGLFunctions();
+            m_isInitialized = true;
+        }
+
+        if (m_isRecording)
+        {
+            endFrame();
+        }
+
+        // oldest frame first, the last one is the slot of the new frame
+        for (size_t i = 1; i <= PENDING_FRAME_COUNT; i++)
+        {
+            PendingFrame& frame{ m_pendingFrames.at((m_frameId + i) % PENDING_FRAME_COUNT) };
+            if (!frame.stageNames.empty())
+            {
+                readPendingFrame(frame);
+            }
+        }
+
+        PendingFrame& frame{ m_pendingFrames.at(m_frameId % PENDING_FRAME_COUNT) };
+        if (!frame.stageNames.empty())
+        {
+            m_droppedFrameCount++;
+        }
+        frame.frameId = m_frameId;
+        frame.stageNames.clear();
+        m_isRecording = true;
+    }
+
+    //---------------------------------------------------------------------------------------
+    void GpuProfiler::endFrame(void)
+    //---------------------------------------------------------------------------------------
+    {
+        if (!m_isRecording)
+        {
+            return;
+        }
+
+        endStage();
+        m_isRecording = false;
+        m_frameId++;
+    }
+
+    //---------------------------------------------------------------------------------------
+    void GpuProfiler::beginStage(const QString& p_name)
+    //---------------------------------------------------------------------------------------
+    {
+        if (!m_isRecording)
+        {
+            return;
+        }
+
+        endStage();
+
+        PendingFrame& frame{ m_pendingFrames.at(m_frameId % PENDING_FRAME_COUNT) };
+        const size_t stageId{ frame.stageNames.size() };
+        if (frame.queryIds.size() <= stageId)
+        {
+            frame.queryIds.push_back(0);
+            glGenQueries(1, &frame.queryIds.back());
+        }
+
+        glBeginQuery(GL_TIME_ELAPSED, frame.queryIds.at(stageId));
+        frame.stageNames.push_back(p_name);
+        m_isStageOpen = true;
+    }
+
+    //---------------------------------------------------------------------------------------
+    void GpuProfiler::endStage(void)
+    //---------------------------------------------------------------------------------------
+    {
+        if (!m_isStageOpen)
+        {
+            return;
+        }
+
+        glEndQuery(GL_TIME_ELAPSED);
+        m_isStageOpen = false;
+    }
+
+    //---------------------------------------------------------------------------------------
+    void GpuProfiler::readPendingFrame(PendingFrame& p_frame)
+    //---------------------------------------------------------------------------------------
+    {
+        // the queries end in order, the last one available means all are
+        GLuint isAvailable{ GL_FALSE };
+        glGetQueryObjectuiv(p_frame.queryIds.at(p_frame.stageNames.size() - 1), GL_QUERY_RESULT_AVAILABLE, &isAvailable);
+        if (isAvailable == GL_FALSE)
+        {
+            return;
+        }
+
+        FrameTiming frameTiming{ p_frame.frameId, 0., {} };
+        frameTiming.stages.reserve(p_frame.stageNames.size());
+        for (size_t i = 0; i < p_frame.stageNames.size(); i++)
+        {
+            GLuint64 elapsedTime{ 0 };
+            glGetQueryObjectui64v(p_frame.queryIds.at(i), GL_QUERY_RESULT, &elapsedTime);
+            const double time{ static_cast<double>(elapsedTime) * 1e-6 };
+            frameTiming.stages.push_back({ p_frame.stageNames.at(i), time });
+            frameTiming.time += time;
+        }
+        p_frame.stageNames.clear();
+
+        m_history.push_back(std::move(frameTiming));
+        if (m_history.size() > HISTORY_SIZE)
+        {
+            m_history.pop_front();
+        }
+    }
+
+    //---------------------------------------------------------------------------------------
+    std::vector<GpuProfiler::StageTiming> GpuProfiler::averageStages(void) const
+    //---------------------------------------------------------------------------------------
+    {
+        std::vector<StageTiming> averages;
+        QHash<QString, size_t> stageIds; // in the order of the first appearance
+        for (const FrameTiming& frame : m_history)
+        {
+            for (const StageTiming& stage : frame.stages)
+            {
+                auto it = stageIds.find(stage.name);
+                if (it == stageIds.end())
+                {
+                    it = stageIds.insert(stage.name, averages.size());
+                    averages.push_back({ stage.name, 0. });
+                }
+                averages.at(it.value()).time += stage.time;
+            }
+        }
+
+        for (StageTiming& average : averages)
+        {
+            average.time /= static_cast<double>(m_history.size());
+        }
+        return averages;
+    }
+
+    //---------------------------------------------------------------------------------------
+    double GpuProfiler::averageFrameTime(void) const
+    //---------------------------------------------------------------------------------------
+    {
+        if (m_history.empty())
+        {
+            return 0.;
+        }
+
+        double sum{ 0. };
+        for (const FrameTiming& frame : m_history)
+        {
+            sum += frame.time;
+        }
+        return sum / static_cast<double>(m_history.size());
+    }
+
+    //---------------------------------------------------------------------------------------
+    bool GpuProfiler::exportCsv(const QString& p_filepath) const
+    //---------------------------------------------------------------------------------------
+    {
+        QFile file(p_filepath);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
+        {
+            qCritical() << "Cannot write the GPU profile" << p_filepath;
+            return false;
+        }
+
+        QTextStream stream(&file);
+        stream << "frame,stage,time_ms\n";
+        for (const FrameTiming& frame : m_history)
+        {
+            for (const StageTiming& stage : frame.stages)
+            {
+                stream << frame.frameId << ',' << stage.name << ',' << stage.time << '\n';
+            }
+        }
+        return stream.status() == QTextStream::Ok;
+    }
+
+    //---------------------------------------------------------------------------------------
+    bool GpuProfiler::exportJson(const QString& p_filepath) const
+    //---------------------------------------------------------------------------------------
+    {
+        QFile file(p_filepath);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        {
+            qCritical() << "Cannot write the GPU profile" << p_filepath;
+            return false;
+        }
+
+        const auto stagesToJson = [](const std::vector<StageTiming>& p_stages)
+        {
+            QJsonArray stages;
+            for (const StageTiming& stage : p_stages)
+            {
+                stages.append(QJsonObject{ { "name", stage.name }, { "time_ms", stage.time } });
+            }
+            return stages;
+        };
+
+        QJsonArray frames;
+        for (const FrameTiming& frame : m_history)
+        {
+            frames.append(QJsonObject{ { "frame", static_cast<qint64>(frame.frameId) }, { "time_ms", frame.time }, { "stages", stagesToJson(frame.stages) } });
+        }
+
+        const QJsonObject profile{
+            { "average_time_ms", averageFrameTime() },
+            { "average_stages", stagesToJson(averageStages()) },
+            { "dropped_frames", static_cast<qint64>(m_droppedFrameCount) },
+            { "frames", frames }
+        };
+        return file.write(QJsonDocument(profile).toJson()) >= 0;
+    }
+
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <QtGui/QOpenGLFunctions_3_3_Core>
+#include <QtCore/QString>
+
+#include <array>
+#include <deque>
+#include <vector>
+
+namespace gui::gl
+{
+
+    /**
+     * \class GpuProfiler
+     * \brief Measure the GPU time of the stages of a frame
+     *
+     * A frame is split into consecutive stages: beginStage() ends the previous one, so the stages cover the whole frame.
+     * Each stage is a GL_TIME_ELAPSED query, the queries of a frame are read PENDING_FRAME_COUNT frames later to not
+     * stall the pipeline (a frame still not available is dropped). The stages cannot be nested in another
+     * GL_TIME_ELAPSED query, use GL_TIMESTAMP counters around a profiled frame.
+     * The last HISTORY_SIZE frames are kept for the rolling averages and the exports.
+     */
+    class GpuProfiler : protected QOpenGLFunctions_3_3_Core
+    {
+    public:
+        struct StageTiming
+        {
+            QString name;
+            double time; //!< milliseconds
+        };
+        struct FrameTiming
+        {
+            quint64 frameId;
+            double time; //!< sum of the stages, milliseconds
+            std::vector<StageTiming> stages;
+        };
+
+        explicit GpuProfiler(void);
+        virtual ~GpuProfiler(void);
+
+        void setEnable(bool p_isEnabled); //!< default false, disabling clears the history
+        inline bool isEnabled(void) const { return m_isEnabled; }
+        void cleanup(void); //!< Free GL memory, needs a current context
+
+        //!< Need a current context: read the available frames, then start a new one
+        void beginFrame(void);
+        void endFrame(void);
+        inline bool isRecording(void) const { return m_isRecording; }
+
+        void beginStage(const QString& p_name); //!< ends the current stage
+        void endStage(void);
+
+        //!< Last frame read back, nullptr if none
+        inline const FrameTiming* lastFrame(void) const { return m_history.empty() ? nullptr : &m_history.back(); }
+        //!< Mean of the stages on the history, a stage absent of a frame counts for 0 in it
+        std::vector<StageTiming> averageStages(void) const;
+        double averageFrameTime(void) const;
+        inline size_t droppedFrameCount(void) const { return m_droppedFrameCount; } //!< results not available in time
+
+        bool exportCsv(const QString& p_filepath) const; //!< one line by stage of the history: frame;stage;time_ms
+        bool exportJson(const QString& p_filepath) const; //!< the history and the averages
+
+        static constexpr size_t PENDING_FRAME_COUNT = 3;
+        static constexpr size_t HISTORY_SIZE = 120;
+
+    private:
+        struct PendingFrame
+        {
+            quint64 frameId = 0;
+            std::vector<QString> stageNames; //!< the stages of the frame, empty if nothing is pending
+            std::vector<GLuint> queryIds; //!< grows with the stage count, reused by the next frames
+        };
+
+        void readPendingFrame(PendingFrame& p_frame);
+
+        bool m_isEnabled;
+        bool m_isInitialized;
+        bool m_isRecording;
+        bool m_isStageOpen;
+        quint64 m_frameId;
+        size_t m_droppedFrameCount;
+
+        std::array<PendingFrame, PENDING_FRAME_COUNT> m_pendingFrames;
+        std::deque<FrameTiming> m_history;
+    };
+
+}
@@ -2,9 +2,16 @@
 
 #include "GLWidgets/Camera.h"
 #include "GLWidgets/Scene.h"
+#include "Renderers/UnorderedTransparency/TriangleSorter.h"
 
 #include <Mesh/MeshModel.h>
 
+#include <QtConcurrent/QtConcurrentMap>
+#include <QtCore/QtMath>
+
+#include <algorithm>
+#include <cmath>
+
 namespace gui::gl
 {
 
@@ -13,6 +20,8 @@ namespace gui::gl
         , m_mesh(p_mesh)
         , m_vaoID(0)
         , m_vboID(0)
+        , m_frameVisibility(FrameVisibility::UNKNOWN)
+        , m_presortedDirectionCount(0)
     //---------------------------------------------------------------------------------------
     {
         setUseAmbiantLight(defaultAmbiantLightUser());
@@ -33,7 +42,7 @@ namespace gui::gl
     bool MeshRenderer::isOtherGlFunctionsInitialized(void) const
     //---------------------------------------------------------------------------------------
     {
-        return (m_vaoID != 0 && m_vboID != 0);
+        return (m_vaoID != 0 && m_vboID != 0 && m_presortedElementBufferIds.size() == static_cast<size_t>(m_presortedDirectionCount));
     }
 
     //---------------------------------------------------------------------------------------
@@ -86,6 +95,8 @@ namespace gui::gl
         glBindBuffer(GL_ARRAY_BUFFER, 0);
         glBindVertexArray(0);
 
+        updatePresortedElementBuffers();
+
         return true;
     }
 
@@ -122,6 +133,112 @@ namespace gui::gl
         m_vboID = 0;
         glDeleteVertexArrays(1, &m_vaoID);
         m_vaoID = 0;
+        deletePresortedElementBuffers();
+    }
+
+    //---------------------------------------------------------------------------------------
+    void MeshRenderer::setPresortedDirectionCount(int p_count)
+    //---------------------------------------------------------------------------------------
+    {
+        if (p_count < 0)
+        {
+            qCritical() << "Invalid number of presorted directions" << p_count;
+            return;
+        }
+
+        if (m_presortedDirectionCount != p_count)
+        {
+            m_presortedDirectionCount = p_count;
+            requestUpdateOtherGlFunctions();
+        }
+    }
+
+    //---------------------------------------------------------------------------------------
+    GLuint MeshRenderer::presortedElementBuffer(const QVector3D& p_viewDirection, QVector3D* p_presortedDirection) const
+    //---------------------------------------------------------------------------------------
+    {
+        if (m_presortedElementBufferIds.empty() || m_presortedElementBufferIds.size() != m_presortedDirections.size())
+        {
+            return 0;
+        }
+
+        size_t nearestId{ 0 };
+        float nearestDot{ -2.f };
+        for (size_t i = 0; i < m_presortedDirections.size(); i++)
+        {
+            const float dot{ QVector3D::dotProduct(m_presortedDirections[i], p_viewDirection) };
+            if (dot > nearestDot)
+            {
+                nearestDot = dot;
+                nearestId = i;
+            }
+        }
+
+        if (p_presortedDirection != nullptr)
+        {
+            *p_presortedDirection = m_presortedDirections[nearestId];
+        }
+        return m_presortedElementBufferIds[nearestId];
+    }
+
+    //---------------------------------------------------------------------------------------
+    void MeshRenderer::updatePresortedElementBuffers(void)
+    //---------------------------------------------------------------------------------------
+    {
+        deletePresortedElementBuffers();
+        if (m_presortedDirectionCount == 0)
+        {
+            return;
+        }
+
+        // spherical Fibonacci set: nearly uniform for any number of directions
+        const int count{ m_presortedDirectionCount };
+        const float goldenAngle{ static_cast<float>(M_PI * (3. - std::sqrt(5.))) };
+        m_presortedDirections.resize(static_cast<size_t>(count));
+        for (int i = 0; i < count; i++)
+        {
+            const float y{ 1.f - 2.f * (static_cast<float>(i) + 0.5f) / static_cast<float>(count) };
+            const float radius{ std::sqrt(std::max(1.f - y * y, 0.f)) };
+            const float phi{ goldenAngle * static_cast<float>(i) };
+            m_presortedDirections[static_cast<size_t>(i)] = QVector3D(std::cos(phi) * radius, y, std::sin(phi) * radius);
+        }
+
+        // the centroids are computed once, the directions are sorted in parallel into one index array
+        TriangleSorter sorter;
+        sorter.setMesh(m_mesh);
+        const size_t indexCount{ 3 * static_cast<size_t>(sorter.triangleCount()) };
+        std::vector<GLuint> indices(indexCount * m_presortedDirections.size());
+        std::vector<size_t> directionIds(m_presortedDirections.size());
+        for (size_t i = 0; i < directionIds.size(); i++)
+        {
+            directionIds[i] = i;
+        }
+        QtConcurrent::blockingMap(directionIds, [this, &sorter, &indices, indexCount](const size_t& p_id)
+            {
+                sorter.sortElementIndices(QVector4D(m_presortedDirections[p_id], 0.f), indices.data() + p_id * indexCount);
+            });
+
+        // the element buffer binding belongs to the vao, upload through the array buffer target
+        m_presortedElementBufferIds.resize(m_presortedDirections.size());
+        glGenBuffers(static_cast<GLsizei>(m_presortedElementBufferIds.size()), m_presortedElementBufferIds.data());
+        for (size_t i = 0; i < m_presortedElementBufferIds.size(); i++)
+        {
+            glBindBuffer(GL_ARRAY_BUFFER, m_presortedElementBufferIds[i]);
+            glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(indexCount * sizeof(GLuint)), indices.data() + i * indexCount, GL_STATIC_DRAW);
+        }
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    //---------------------------------------------------------------------------------------
+    void MeshRenderer::deletePresortedElementBuffers(void)
+    //---------------------------------------------------------------------------------------
+    {
+        if (!m_presortedElementBufferIds.empty())
+        {
+            glDeleteBuffers(static_cast<GLsizei>(m_presortedElementBufferIds.size()), m_presortedElementBufferIds.data());
+        }
+        m_presortedElementBufferIds.clear();
+        m_presortedDirections.clear();
     }
 
     //---------------------------------------------------------------------------------------
@@ -144,9 +261,57 @@ namespace gui::gl
     }
 
     //---------------------------------------------------------------------------------------
-    void MeshRenderer::renderMesh(QOpenGLShaderProgram& p_program, bool p_withLightColorShader, std::function<void()> p_beforeRenderMeshFunc, std::function<void()> p_afterRenderMeshFunc)
+    void MeshRenderer::renderMesh(ShaderProgram& p_program, bool p_withLightColorShader, std::function<void()> p_beforeRenderMeshFunc, std::function<void()> p_afterRenderMeshFunc)
+    //---------------------------------------------------------------------------------------
+    {
+        drawMesh(p_program, p_withLightColorShader, 0, p_beforeRenderMeshFunc, p_afterRenderMeshFunc);
+    }
+
+    //---------------------------------------------------------------------------------------
+    void MeshRenderer::renderMeshElements(ShaderProgram& p_program, bool p_withLightColorShader, GLuint p_elementBufferId, std::function<void()> p_beforeRenderMeshFunc, std::function<void()> p_afterRenderMeshFunc)
     //---------------------------------------------------------------------------------------
     {
+        if (p_elementBufferId == 0u)
+        {
+            qCritical() << "Cannot render a mesh with a null element buffer";
+            return;
+        }
+
+        drawMesh(p_program, p_withLightColorShader, p_elementBufferId, p_beforeRenderMeshFunc, p_afterRenderMeshFunc);
+    }
+
+    //---------------------------------------------------------------------------------------
+    const geom::AABB& MeshRenderer::bounds(void) const
+    //---------------------------------------------------------------------------------------
+    {
+        return m_mesh.bounds();
+    }
+
+    //---------------------------------------------------------------------------------------
+    bool MeshRenderer::isInViewFrustum(void) const
+    //---------------------------------------------------------------------------------------
+    {
+        return viewFrustum().intersects(bounds()) != geom::Frustum::Intersection::OUTSIDE;
+    }
+
+    //---------------------------------------------------------------------------------------
+    void MeshRenderer::setFrameFrustum(const geom::Frustum& p_frustum)
+    //---------------------------------------------------------------------------------------
+    {
+        m_frameVisibility = p_frustum.intersects(bounds()) != geom::Frustum::Intersection::OUTSIDE ? FrameVisibility::INSIDE : FrameVisibility::OUTSIDE;
+    }
+
+    //---------------------------------------------------------------------------------------
+    void MeshRenderer::drawMesh(ShaderProgram& p_program, bool p_withLightColorShader, GLuint p_elementBufferId, const std::function<void()>& p_beforeRenderMeshFunc, const std::function<void()>& p_afterRenderMeshFunc)
+    //---------------------------------------------------------------------------------------
+    {
+        // all the triangles of a mesh outside the view would be clipped, the before and after functions are paired
+        const bool isVisible{ m_frameVisibility == FrameVisibility::UNKNOWN ? isInViewFrustum() : m_frameVisibility == FrameVisibility::INSIDE };
+        if (!isVisible)
+        {
+            return;
+        }
+
         if (p_program.bind())
         {
             const bool enableBlending{ isClassicalRendering() && opacity() < 1.f };
@@ -167,7 +332,17 @@ namespace gui::gl
             // lock vao
             glBindVertexArray(m_vaoID);
 
-            glDrawArrays(GL_TRIANGLES, 0, 3 * m_mesh.faceCount());
+            if (p_elementBufferId != 0u)
+            {
+                // the element buffer binding is a state of the vao, restore it for the next glDrawArrays
+                glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, p_elementBufferId);
+                glDrawElements(GL_TRIANGLES, 3 * m_mesh.faceCount(), GL_UNSIGNED_INT, nullptr);
+                glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+            }
+            else
+            {
+                glDrawArrays(GL_TRIANGLES, 0, 3 * m_mesh.faceCount());
+            }
 
             // unlock vao
             glBindVertexArray(0);
@@ -193,7 +368,14 @@ namespace gui::gl
             return;
         }
 
-        renderMesh(m_shaderMultipleLights, true);
+        // a transparent mesh drawn alone is blended in the order of the nearest presorted direction
+        GLuint elementBufferId{ 0 };
+        if (isClassicalRendering() && opacity() < 1.f)
+        {
+            elementBufferId = presortedElementBuffer((m_camera.viewMatrix() * m_scene.modelMatrix()).row(2).toVector3D().normalized());
+        }
+
+        drawMesh(m_shaderMultipleLights, true, elementBufferId, []() {}, []() {});
     }
 
 }
@@ -3,6 +3,10 @@
 #include "Renderers/AbstractRenderer.h"
 #include "Renderers/Common/MultipleLightsRenderer.h"
 
+#include <QtGui/QVector3D>
+
+#include <vector>
+
 class MeshModel;
 
 namespace gui::gl
@@ -28,7 +32,29 @@ namespace gui::gl
          * \param p_beforeRenderMeshFunc other parameters to pass to p_program in a (lambda) function before rendering a mesh (ex a texture binding)
          * \param p_afterRenderMeshFunc other parameters to pass to p_program in a (lambda) function after rendering a mesh (ex a texture unbinding)
          */
-        void renderMesh(QOpenGLShaderProgram& p_program, bool p_withLightColorShader, std::function<void()> p_beforeRenderMeshFunc = []() {}, std::function<void()> p_afterRenderMeshFunc = []() {});
+        void renderMesh(ShaderProgram& p_program, bool p_withLightColorShader, std::function<void()> p_beforeRenderMeshFunc = []() {}, std::function<void()> p_afterRenderMeshFunc = []() {});
+
+        /**
+         * \brief Same as renderMesh, but the triangles are drawn in the order of an element buffer
+         * \param p_elementBufferId GL_ELEMENT_ARRAY_BUFFER of 3 * faceCount GL_UNSIGNED_INT vertex indices (triangle i is made of the vertices 3i, 3i + 1 and 3i + 2)
+         */
+        void renderMeshElements(ShaderProgram& p_program, bool p_withLightColorShader, GLuint p_elementBufferId, std::function<void()> p_beforeRenderMeshFunc = []() {}, std::function<void()> p_afterRenderMeshFunc = []() {});
+
+        inline const MeshModel& mesh(void) const { return m_mesh; }
+
+        const geom::AABB& bounds(void) const; //!< Bounding box of the mesh, in the model space as viewFrustum()
+        bool isInViewFrustum(void) const; //!< False if the bounding box is outside the view frustum, the mesh is not drawn
+        //!< Test the bounding box once against p_frustum for all the draws of a frame (multi pass engines), until
+        //!< resetFrameFrustum(). Otherwise each draw tests the view frustum of the camera
+        void setFrameFrustum(const geom::Frustum& p_frustum);
+        inline void resetFrameFrustum(void) { m_frameVisibility = FrameVisibility::UNKNOWN; }
+
+        //!< Transparency mode for static meshes: the triangles are sorted back to front at initialization for p_count
+        //!< view directions spread on the sphere, 0 to disable (default). Costs p_count element buffers of 12 bytes by triangle.
+        void setPresortedDirectionCount(int p_count);
+        inline int presortedDirectionCount(void) const { return m_presortedDirectionCount; }
+        //!< Element buffer of the presorted direction nearest to p_viewDirection (model space, toward the camera), 0 if none
+        GLuint presortedElementBuffer(const QVector3D& p_viewDirection, QVector3D* p_presortedDirection = nullptr) const;
 
         inline void setIsClassicalRendering(bool p_rendering) { m_isClassicalRendering = p_rendering; }
         inline bool isClassicalRendering(void) const { return m_isClassicalRendering; } //!< If true, enable GL_BLEND when opacity is different from one
@@ -55,7 +81,13 @@ namespace gui::gl
         virtual inline QVector3D defaultMaterialSpecularColor(void) const { return QVector3D(0.0f, 0.0f, 0.0f); }
 
     private:
-        QOpenGLShaderProgram m_shaderMultipleLights;
+        enum class FrameVisibility { UNKNOWN, INSIDE, OUTSIDE }; //!< UNKNOWN: no frame frustum, tested at each draw
+
+        void drawMesh(ShaderProgram& p_program, bool p_withLightColorShader, GLuint p_elementBufferId, const std::function<void()>& p_beforeRenderMeshFunc, const std::function<void()>& p_afterRenderMeshFunc);
+        void updatePresortedElementBuffers(void); //!< sort the directions in parallel, then upload them
+        void deletePresortedElementBuffers(void);
+
+        ShaderProgram m_shaderMultipleLights;
 
         bool m_isClassicalRendering;
 
@@ -64,6 +96,12 @@ namespace gui::gl
         GLuint m_vaoID; // array object: data access
         GLuint m_vboID; // buffer object: data
 
+        FrameVisibility m_frameVisibility;
+
+        int m_presortedDirectionCount;
+        std::vector<QVector3D> m_presortedDirections;
+        std::vector<GLuint> m_presortedElementBufferIds; // one by direction
+
         Q_DISABLE_COPY_MOVE(MeshRenderer);
     };
 
@@ -55,7 +55,7 @@ namespace gui::gl
 
         bool m_renderWithStrip;
 
-        QOpenGLShaderProgram m_shaderPath;
+        ShaderProgram m_shaderPath;
 
         Q_DISABLE_COPY_MOVE(PathRenderer);
     };
@@ -62,7 +62,7 @@ namespace gui::gl
         GLfloat m_planeWidth;
         GLfloat m_planeShift;
 
-        QOpenGLShaderProgram m_shaderPlane;
+        ShaderProgram m_shaderPlane;
 
         Q_DISABLE_COPY_MOVE(PlaneRenderer);
     };
@@ -0,0 +1,738 @@
+#include "Renderers/Software/SoftwareDualDepthPeelingRenderer.h"
+
+#include "GLWidgets/Camera.h"
+#include "GLWidgets/Scene.h"
+#include "Renderers/MeshRenderer.h"
+#include "Renderers/UnorderedTransparency/PassBudgetController.h"
+
+#include <Geom/Batch.h>
+#include <Geom/Vector.h>
+#include <Mesh/MeshModel.h>
+
+#include <QtConcurrent/QtConcurrentMap>
+#include <QtCore/QDebug>
+#include <QtCore/QThread>
+#include <QtGui/QVector2D>
+#include <QtGui/QVector4D>
+
+#include <cmath>
+#include <tuple>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SOFTWARE_RASTERIZER_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+    static constexpr float MAX_DEPTH{ 1.f }; // as peel_fragment.glsl
+
+    //!< Calls p_function(begin, end) on ranges of [0, p_count) in the global thread pool
+    template <typename Function>
+    static void parallelFor(size_t p_count, Function p_function)
+    {
+        const size_t rangeCount{ std::min(p_count, static_cast<size_t>(std::max(1, 4 * QThread::idealThreadCount()))) };
+        std::vector<std::pair<size_t, size_t>> ranges;
+        for (size_t i = 0; i < rangeCount; i++)
+        {
+            ranges.emplace_back(p_count * i / rangeCount, p_count * (i + 1) / rangeCount);
+        }
+        QtConcurrent::blockingMap(ranges, [&p_function](const std::pair<size_t, size_t>& p_range) { p_function(p_range.first, p_range.second); });
+    }
+
+    static QVector3D clamp01(const QVector3D& p_color)
+    {
+        return QVector3D(std::clamp(p_color.x(), 0.f, 1.f), std::clamp(p_color.y(), 0.f, 1.f), std::clamp(p_color.z(), 0.f, 1.f));
+    }
+
+    static QVector2D max(const QVector2D& p_a, const QVector2D& p_b)
+    {
+        return QVector2D(std::max(p_a.x(), p_b.x()), std::max(p_a.y(), p_b.y()));
+    }
+
+    static QVector4D max(const QVector4D& p_a, const QVector4D& p_b)
+    {
+        return QVector4D(std::max(p_a.x(), p_b.x()), std::max(p_a.y(), p_b.y()), std::max(p_a.z(), p_b.z()), std::max(p_a.w(), p_b.w()));
+    }
+
+    //!< ShadeFragment() of Common/shade_fragment.glsl
+    static QVector4D shadeFragment(const gui::gl::MultipleLightsRenderer& p_material, const QVector3D& p_normal, const QVector3D& p_lightDir)
+    {
+        QVector3D color;
+        if (p_material.useAmbiantLight())
+        {
+            QVector3D ambient, diffuse, specular;
+
+            // phase 1: directional lighting, the light comes from the camera
+            const gui::gl::MultipleLightsRenderer::DirLight& dirLight{ gui::gl::MultipleLightsRenderer::dirLight() };
+            const QVector3D dirLightDir(0.f, 0.f, 1.f);
+            ambient += dirLight.ambient;
+            diffuse += dirLight.diffuse * std::max(QVector3D::dotProduct(p_normal, dirLightDir), 0.f);
+            specular += dirLight.specular; // the shininess is disabled, see shade_fragment.glsl
+
+            // phase 2: spot light
+            const gui::gl::MultipleLightsRenderer::SpotLight& spotLight{ gui::gl::MultipleLightsRenderer::spotLight() };
+            const QVector3D spotLightDir{ (spotLight.position - p_lightDir).normalized() };
+            const float diff{ std::max(QVector3D::dotProduct(p_normal, spotLightDir), 0.f) };
+            const float distance{ (spotLight.position - p_lightDir).length() };
+            const float attenuation{ 1.f / (spotLight.constant + spotLight.linear * distance + spotLight.quadratic * (distance * distance)) };
+            const float theta{ QVector3D::dotProduct(spotLightDir, (-spotLight.direction).normalized()) };
+            const float epsilon{ spotLight.cutOff - spotLight.outerCutOff };
+            const float intensity{ std::clamp((theta - spotLight.outerCutOff) / epsilon, 0.f, 1.f) };
+            ambient += spotLight.ambient * attenuation * intensity;
+            diffuse += spotLight.diffuse * diff * attenuation * intensity;
+            specular += spotLight.specular * attenuation * intensity;
+
+            if (p_material.isMaterialOn())
+            {
+                const QVector3D sceneColor{ p_material.materialAmbiantColor() * QVector3D(0.4f, 0.2f, 0.2f) };
+                color = sceneColor + ambient * p_material.materialAmbiantColor() + diffuse * p_material.materialDiffuseColor() + specular * p_material.materialSpecularColor();
+            }
+            else
+            {
+                color = ambient * p_material.color() + diffuse * p_material.color() + specular * p_material.color();
+            }
+            color = clamp01(color);
+        }
+        else
+        {
+            const float diffuse{ std::abs(QVector3D::dotProduct(p_normal, p_lightDir)) };
+            color = p_material.color() * (0.42f + 0.58f * diffuse);
+        }
+        return QVector4D(color, p_material.opacity());
+    }
+}
+
+namespace gui::software
+{
+
+    struct SoftwareDualDepthPeelingRenderer::Triangle
+    {
+        float x[3], y[3], z[3]; // window coordinates, y up
+        float invW[3];
+        QVector3D normal[3]; // shade_vertex.glsl outputs
+        QVector3D lightDir[3];
+        const gl::MeshRenderer* object;
+        bool isOpaque;
+        bool isVisible;
+    };
+
+    struct SoftwareDualDepthPeelingRenderer::Fragment
+    {
+        float depth;
+        quint32 pixel; // in the tile
+        quint32 order; // of the triangle in the tile, to sort the equal depths as the GL primitive order
+        QVector4D color;
+    };
+
+    struct SoftwareDualDepthPeelingRenderer::Tile
+    {
+        int x0, y0, width, height; // window pixels, y up
+        std::vector<quint32> triangleIds; // in submission order
+
+        std::vector<float> opaqueDepth;
+        std::vector<QVector4D> opaqueColor;
+
+        std::vector<Fragment> fragments; // sorted by pixel, then depth
+        std::vector<quint32> pixelOffsets; // first fragment of each pixel, pixel count + 1 values
+
+        // peeling result by pixel
+        std::vector<QVector4D> front;
+        std::vector<QVector3D> back;
+        std::vector<quint8> peeledPassCount; // passes until the pixel has no layer left
+        quint64 samplePassMask; // bit i: a back layer has been blended at pass i + 1 in the tile
+    };
+
+    //---------------------------------------------------------------------------------------
+    SoftwareDualDepthPeelingRenderer::SoftwareDualDepthPeelingRenderer(const Scene& p_scene, const Camera& p_camera)
+        : m_scene(p_scene)
+        , m_camera(p_camera)
+        , m_width(0)
+        , m_height(0)
+        , m_tileSize(32)
+        , m_numberOfPasses(0)
+        , m_lastPassCount(0)
+        , m_lastFragmentCount(0)
+        , m_maxDepthComplexity(0)
+    //---------------------------------------------------------------------------------------
+    {
+    }
+
+    //---------------------------------------------------------------------------------------
+    SoftwareDualDepthPeelingRenderer::~SoftwareDualDepthPeelingRenderer(void)
+    //---------------------------------------------------------------------------------------
+    {
+    }
+
+    //---------------------------------------------------------------------------------------
+    void SoftwareDualDepthPeelingRenderer::setSize(int p_width, int p_height)
+    //---------------------------------------------------------------------------------------
+    {
+        m_width = std::max(0, p_width);
+        m_height = std::max(0, p_height);
+    }
+
+    //---------------------------------------------------------------------------------------
+    void SoftwareDualDepthPeelingRenderer::appendOpaqueObject(const QString& p_objectName, const gl::MeshRenderer* p_object)
+    //---------------------------------------------------------------------------------------
+    {
+        m_opaqueObjects.insert(p_objectName, p_object);
+    }
+
+    //---------------------------------------------------------------------------------------
+    void SoftwareDualDepthPeelingRenderer::appendTransparentObject(const QString& p_objectName, const gl::MeshRenderer* p_object)
+    //---------------------------------------------------------------------------------------
+    {
+        m_transparentObjects.insert(p_objectName, p_object);
+    }
+
+    //---------------------------------------------------------------------------------------
+    void SoftwareDualDepthPeelingRenderer::removeObject(const QString& p_objectName)
+    //---------------------------------------------------------------------------------------
+    {
+        m_opaqueObjects.remove(p_objectName);
+        m_transparentObjects.remove(p_objectName);
+    }
+
+    //---------------------------------------------------------------------------------------
+    void SoftwareDualDepthPeelingRenderer::transformObjects(std::vector<Triangle>& p_triangles) const
+    //---------------------------------------------------------------------------------------
+    {
+        std::vector<std::pair<const gl::MeshRenderer*, bool>> objects;
+        for (const gl::MeshRenderer* const object : m_opaqueObjects)
+        {
+            objects.emplace_back(object, true);
+        }
+        for (const gl::MeshRenderer* const object : m_transparentObjects)
+        {
+            objects.emplace_back(object, false);
+        }
+
+        const QMatrix4x4 modelViewMatrix{ m_camera.viewMatrix() * m_scene.modelMatrix() };
+        const QMatrix4x4 modelViewProjectionMatrix{ m_camera.projMatrix() * modelViewMatrix };
+
+        // the objects outside the view frustum have no visible triangle, they are not transformed
+        std::vector<geom::AABB> bounds;
+        for (const auto& object : objects)
+        {
+            bounds.push_back(object.first->bounds());
+        }
+        std::vector<geom::Frustum::Intersection> intersections(objects.size());
+        geom::batch::intersects(geom::Frustum(modelViewProjectionMatrix.constData()), bounds.data(), bounds.size(), intersections.data());
+        for (size_t i = objects.size(); i-- > 0;)
+        {
+            if (intersections[i] == geom::Frustum::Intersection::OUTSIDE)
+            {
+                objects.erase(objects.begin() + static_cast<std::ptrdiff_t>(i));
+            }
+        }
+
+        size_t triangleCount{ 0 };
+        for (const auto& object : objects)
+        {
+            triangleCount += static_cast<size_t>(object.first->mesh().faceCount());
+        }
+        p_triangles.resize(triangleCount);
+
+        const QMatrix3x3 normalMatrix{ modelViewMatrix.normalMatrix() };
+        const float width{ static_cast<float>(m_width) };
+        const float height{ static_cast<float>(m_height) };
+
+        size_t firstTriangle{ 0 };
+        for (const auto& [object, isOpaque] : objects)
+        {
+            const MeshModel& mesh{ object->mesh() };
+            const size_t faceCount{ static_cast<size_t>(mesh.faceCount()) };
+            parallelFor(faceCount, [&, object = object, isOpaque = isOpaque](size_t p_begin, size_t p_end)
+            {
+                for (size_t i = p_begin; i < p_end; i++)
+                {
+                    Triangle& triangle{ p_triangles[firstTriangle + i] };
+                    triangle.object = object;
+                    triangle.isOpaque = isOpaque;
+
+                    // peel_vertex.glsl and shade_vertex.glsl
+                    QVector4D clip[3];
+                    for (int j = 0; j < 3; j++)
+                    {
+                        const int vertexId{ mesh.vtxIndices()[static_cast<int>(3 * i) + j] };
+                        const geom::Point& point{ mesh.vertices()[vertexId] };
+                        const geom::Vector& normal{ mesh.normals()[vertexId] };
+                        const QVector4D position(static_cast<float>(point.x()), static_cast<float>(point.y()), static_cast<float>(point.z()), 1.f);
+
+                        clip[j] = modelViewProjectionMatrix * position;
+                        const float* const n{ normalMatrix.constData() }; // column major
+                        const QVector3D vertexNormal(static_cast<float>(normal.x()), static_cast<float>(normal.y()), static_cast<float>(normal.z()));
+                        triangle.normal[j] = QVector3D(
+                            n[0] * vertexNormal.x() + n[3] * vertexNormal.y() + n[6] * vertexNormal.z(),
+                            n[1] * vertexNormal.x() + n[4] * vertexNormal.y() + n[7] * vertexNormal.z(),
+                            n[2] * vertexNormal.x() + n[5] * vertexNormal.y() + n[8] * vertexNormal.z()).normalized();
+                        triangle.lightDir[j] = (modelViewMatrix * position).toVector3D().normalized();
+                    }
+
+                    // the triangles crossing w = 0 are not clipped: the camera is orthographic
+                    triangle.isVisible = clip[0].w() > 0.f && clip[1].w() > 0.f && clip[2].w() > 0.f;
+                    for (int axis = 0; axis < 3 && triangle.isVisible; axis++)
+                    {
+                        const auto outside = [&clip, axis](float p_sign)
+                        {
+                            return p_sign * clip[0][axis] > clip[0].w() && p_sign * clip[1][axis] > clip[1].w() && p_sign * clip[2][axis] > clip[2].w();
+                        };
+                        triangle.isVisible = !outside(1.f) && !outside(-1.f);
+                    }
+
+                    for (int j = 0; j < 3; j++)
+                    {
+                        const float invW{ triangle.isVisible ? 1.f / clip[j].w() : 0.f };
+                        triangle.invW[j] = invW;
+                        triangle.x[j] = (clip[j].x() * invW * 0.5f + 0.5f) * width;
+                        triangle.y[j] = (clip[j].y() * invW * 0.5f + 0.5f) * height;
+                        triangle.z[j] = clip[j].z() * invW * 0.5f + 0.5f;
+                    }
+                }
+            });
+            firstTriangle += faceCount;
+        }
+    }
+
+    //---------------------------------------------------------------------------------------
+    void SoftwareDualDepthPeelingRenderer::binTriangles(const std::vector<Triangle>& p_triangles, std::vector<Tile>& p_tiles) const
+    //---------------------------------------------------------------------------------------
+    {
+        const int tileCountX{ (m_width + m_tileSize - 1) / m_tileSize };
+        const int tileCountY{ (m_height + m_tileSize - 1) / m_tileSize };
+        p_tiles.resize(static_cast<size_t>(tileCountX * tileCountY));
+        for (int ty = 0; ty < tileCountY; ty++)
+        {
+            for (int tx = 0; tx < tileCountX; tx++)
+            {
+                Tile& tile{ p_tiles[static_cast<size_t>(ty * tileCountX + tx)] };
+                tile.x0 = tx * m_tileSize;
+                tile.y0 = ty * m_tileSize;
+                tile.width = std::min(m_tileSize, m_width - tile.x0);
+                tile.height = std::min(m_tileSize, m_height - tile.y0);
+            }
+        }
+
+        // each range of triangles is binned by a thread, then the bins are concatenated in the range order to keep the submission order
+        const size_t rangeCount{ static_cast<size_t>(std::max(1, QThread::idealThreadCount())) };
+        std::vector<std::vector<std::vector<quint32>>> rangeBins(rangeCount, std::vector<std::vector<quint32>>(p_tiles.size()));
+        std::vector<size_t> rangeIds(rangeCount);
+        for (size_t i = 0; i < rangeCount; i++)
+        {
+            rangeIds[i] = i;
+        }
+        QtConcurrent::blockingMap(rangeIds, [&](const size_t& p_rangeId)
+        {
+            std::vector<std::vector<quint32>>& bins{ rangeBins[p_rangeId] };
+            const size_t end{ p_triangles.size() * (p_rangeId + 1) / rangeCount };
+            for (size_t i = p_triangles.size() * p_rangeId / rangeCount; i < end; i++)
+            {
+                const Triangle& triangle{ p_triangles[i] };
+                if (!triangle.isVisible)
+                {
+                    continue;
+                }
+
+                const float minX{ std::min({ triangle.x[0], triangle.x[1], triangle.x[2] }) };
+                const float maxX{ std::max({ triangle.x[0], triangle.x[1], triangle.x[2] }) };
+                const float minY{ std::min({ triangle.y[0], triangle.y[1], triangle.y[2] }) };
+                const float maxY{ std::max({ triangle.y[0], triangle.y[1], triangle.y[2] }) };
+                const int firstTileX{ std::max(0, static_cast<int>(std::floor(minX)) / m_tileSize) };
+                const int lastTileX{ std::min(tileCountX - 1, static_cast<int>(std::ceil(maxX)) / m_tileSize) };
+                const int firstTileY{ std::max(0, static_cast<int>(std::floor(minY)) / m_tileSize) };
+                const int lastTileY{ std::min(tileCountY - 1, static_cast<int>(std::ceil(maxY)) / m_tileSize) };
+                for (int ty = firstTileY; ty <= lastTileY; ty++)
+                {
+                    for (int tx = firstTileX; tx <= lastTileX; tx++)
+                    {
+                        bins[static_cast<size_t>(ty * tileCountX + tx)].push_back(static_cast<quint32>(i));
+                    }
+                }
+            }
+        });
+
+        parallelFor(p_tiles.size(), [&](size_t p_begin, size_t p_end)
+        {
+            for (size_t i = p_begin; i < p_end; i++)
+            {
+                for (const std::vector<std::vector<quint32>>& bins : rangeBins)
+                {
+                    p_tiles[i].triangleIds.insert(p_tiles[i].triangleIds.end(), bins[i].cbegin(), bins[i].cend());
+                }
+            }
+        });
+    }
+
+    //---------------------------------------------------------------------------------------
+    void SoftwareDualDepthPeelingRenderer::rasterizeTile(const std::vector<Triangle>& p_triangles, Tile& p_tile) const
+    //---------------------------------------------------------------------------------------
+    {
+        const size_t pixelCount{ static_cast<size_t>(p_tile.width * p_tile.height) };
+        p_tile.opaqueDepth.assign(pixelCount, MAX_DEPTH); // default clear depth
+        p_tile.opaqueColor.assign(pixelCount, QVector4D(m_opaqueClearColor, 0.f));
+        p_tile.fragments.clear();
+
+        for (quint32 order = 0; order < p_tile.triangleIds.size(); order++)
+        {
+            const Triangle& triangle{ p_triangles[p_tile.triangleIds[order]] };
+
+            // counterclockwise, the faces are not culled
+            int v[3]{ 0, 1, 2 };
+            float area{ (triangle.x[1] - triangle.x[0]) * (triangle.y[2] - triangle.y[0]) - (triangle.x[2] - triangle.x[0]) * (triangle.y[1] - triangle.y[0]) };
+            if (area == 0.f)
+            {
+                continue;
+            }
+            if (area < 0.f)
+            {
+                std::swap(v[1], v[2]);
+                area = -area;
+            }
+
+            // edge i is opposite to the vertex i: E(p) = A * (p.x - a.x) + B * (p.y - a.y), positive inside
+            float edgeA[3], edgeB[3], edgeX[3], edgeY[3];
+            bool isTopLeft[3];
+            for (int i = 0; i < 3; i++)
+            {
+                const int a{ v[(i + 1) % 3] }, b{ v[(i + 2) % 3] };
+                edgeA[i] = triangle.y[a] - triangle.y[b];
+                edgeB[i] = triangle.x[b] - triangle.x[a];
+                edgeX[i] = triangle.x[a];
+                edgeY[i] = triangle.y[a];
+                // the pixel centers on a left or top edge belong to the triangle, not on a right or bottom edge
+                isTopLeft[i] = edgeA[i] > 0.f || (edgeA[i] == 0.f && edgeB[i] < 0.f);
+            }
+
+            const int minX{ std::max(p_tile.x0, static_cast<int>(std::floor(std::min({ triangle.x[0], triangle.x[1], triangle.x[2] }) - 0.5f))) };
+            const int maxX{ std::min(p_tile.x0 + p_tile.width - 1, static_cast<int>(std::ceil(std::max({ triangle.x[0], triangle.x[1], triangle.x[2] }) - 0.5f))) };
+            const int minY{ std::max(p_tile.y0, static_cast<int>(std::floor(std::min({ triangle.y[0], triangle.y[1], triangle.y[2] }) - 0.5f))) };
+            const int maxY{ std::min(p_tile.y0 + p_tile.height - 1, static_cast<int>(std::ceil(std::max({ triangle.y[0], triangle.y[1], triangle.y[2] }) - 0.5f))) };
+            if (minX > maxX || minY > maxY)
+            {
+                continue;
+            }
+
+            const auto emitFragment = [&](int p_x, int p_y, const float* p_edges)
+            {
+                const float b[3]{ p_edges[0] / area, p_edges[1] / area, p_edges[2] / area };
+                // gl_FragCoord.z is linear in screen space, the outputs of the vertex shader are perspective correct
+                float depth{ 0.f }, perspectiveSum{ 0.f };
+                float weights[3];
+                for (int i = 0; i < 3; i++)
+                {
+                    depth += b[i] * triangle.z[v[i]];
+                    weights[i] = b[i] * triangle.invW[v[i]];
+                    perspectiveSum += weights[i];
+                }
+                if (depth < 0.f || depth > 1.f)
+                {
+                    return; // near and far planes
+                }
+
+                QVector3D normal, lightDir;
+                for (int i = 0; i < 3; i++)
+                {
+                    normal += triangle.normal[v[i]] * (weights[i] / perspectiveSum);
+                    lightDir += triangle.lightDir[v[i]] * (weights[i] / perspectiveSum);
+                }
+
+                const size_t pixel{ static_cast<size_t>((p_y - p_tile.y0) * p_tile.width + (p_x - p_tile.x0)) };
+                if (triangle.isOpaque)
+                {
+                    if (depth < p_tile.opaqueDepth[pixel]) // GL_LESS
+                    {
+                        p_tile.opaqueDepth[pixel] = depth;
+                        p_tile.opaqueColor[pixel] = shadeFragment(*triangle.object, normal, lightDir);
+                    }
+                }
+                else
+                {
+                    p_tile.fragments.push_back({ depth, static_cast<quint32>(pixel), order, shadeFragment(*triangle.object, normal, lightDir) });
+                }
+            };
+
+            for (int y = minY; y <= maxY; y++)
+            {
+                const float py{ static_cast<float>(y) + 0.5f };
+#ifdef SOFTWARE_RASTERIZER_SSE2
+                // 4 pixels of the row by iteration
+                const __m128 laneOffsets{ _mm_set_ps(3.f, 2.f, 1.f, 0.f) };
+                for (int x = minX; x <= maxX; x += 4)
+                {
+                    const __m128 px{ _mm_add_ps(_mm_set1_ps(static_cast<float>(x) + 0.5f), laneOffsets) };
+                    __m128 edges[3];
+                    __m128 inside{ _mm_castsi128_ps(_mm_set1_epi32(-1)) };
+                    for (int i = 0; i < 3; i++)
+                    {
+                        edges[i] = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(edgeA[i]), _mm_sub_ps(px, _mm_set1_ps(edgeX[i]))), _mm_set1_ps(edgeB[i] * (py - edgeY[i])));
+                        const __m128 edgeInside{ isTopLeft[i] ? _mm_cmpge_ps(edges[i], _mm_setzero_ps()) : _mm_cmpgt_ps(edges[i], _mm_setzero_ps()) };
+                        inside = _mm_and_ps(inside, edgeInside);
+                    }
+
+                    const int mask{ _mm_movemask_ps(inside) };
+                    if (mask == 0)
+                    {
+                        continue;
+                    }
+
+                    alignas(16) float laneEdges[3][4];
+                    for (int i = 0; i < 3; i++)
+                    {
+                        _mm_store_ps(laneEdges[i], edges[i]);
+                    }
+                    for (int lane = 0; lane < 4 && x + lane <= maxX; lane++)
+                    {
+                        if (mask & (1 << lane))
+                        {
+                            const float laneEdge[3]{ laneEdges[0][lane], laneEdges[1][lane], laneEdges[2][lane] };
+                            emitFragment(x + lane, y, laneEdge);
+                        }
+                    }
+                }
+#else
+                for (int x = minX; x <= maxX; x++)
+                {
+                    const float px{ static_cast<float>(x) + 0.5f };
+                    float edges[3];
+                    bool isInside{ true };
+                    for (int i = 0; i < 3; i++)
+                    {
+                        edges[i] = edgeA[i] * (px - edgeX[i]) + edgeB[i] * (py - edgeY[i]);
+                        isInside = isInside && (isTopLeft[i] ? edges[i] >= 0.f : edges[i] > 0.f);
+                    }
+                    if (isInside)
+                    {
+                        emitFragment(x, y, edges);
+                    }
+                }
+#endif
+            }
+        }
+
+        // sort the fragments by pixel and depth, the equal depths in the primitive order
+        std::sort(p_tile.fragments.begin(), p_tile.fragments.end(), [](const Fragment& p_a, const Fragment& p_b)
+        {
+            return std::tie(p_a.pixel, p_a.depth, p_a.order) < std::tie(p_b.pixel, p_b.depth, p_b.order);
+        });
+        p_tile.pixelOffsets.assign(pixelCount + 1, 0);
+        for (const Fragment& fragment : p_tile.fragments)
+        {
+            p_tile.pixelOffsets[fragment.pixel + 1]++;
+        }
+        for (size_t i = 0; i < pixelCount; i++)
+        {
+            p_tile.pixelOffsets[i + 1] += p_tile.pixelOffsets[i];
+        }
+    }
+
+    //---------------------------------------------------------------------------------------
+    void SoftwareDualDepthPeelingRenderer::peelTile(Tile& p_tile, size_t p_passCount) const
+    //---------------------------------------------------------------------------------------
+    {
+        const size_t pixelCount{ static_cast<size_t>(p_tile.width * p_tile.height) };
+        const size_t maxPassCount{ p_passCount > 0 ? p_passCount : gl::PassBudgetController::MAX_PASSES };
+        const bool isFirstPeeling{ p_tile.front.empty() };
+        if (isFirstPeeling)
+        {
+            p_tile.front.assign(pixelCount, QVector4D());
+            p_tile.back.assign(pixelCount, m_backgroundColor);
+            p_tile.peeledPassCount.assign(pixelCount, 0);
+            p_tile.samplePassMask = 0;
+        }
+
+        for (size_t pixel = 0; pixel < pixelCount; pixel++)
+        {
+            const quint32 first{ p_tile.pixelOffsets[pixel] };
+            const quint32 last{ p_tile.pixelOffsets[pixel + 1] };
+            // the peeling is replayed only for the pixels not finished in p_passCount passes
+            if (first == last || (!isFirstPeeling && p_tile.peeledPassCount[pixel] <= p_passCount))
+            {
+                continue;
+            }
+
+            const float opaqueDepth{ p_tile.opaqueDepth[pixel] };
+            const QVector4D& opaqueColor{ p_tile.opaqueColor[pixel] };
+
+            // 1. init_fragment.glsl with MAX blending: (-minDepth, maxDepth)
+            QVector2D depthBlender(-MAX_DEPTH, -MAX_DEPTH);
+            for (quint32 i = first; i < last; i++)
+            {
+                depthBlender = ::max(depthBlender, QVector2D(-p_tile.fragments[i].depth, p_tile.fragments[i].depth));
+            }
+
+            // 2. peel_fragment.glsl for each fragment, the render targets are cleared then MAX blended
+            QVector4D frontBlender;
+            QVector3D backBlender{ m_backgroundColor };
+            size_t pass{ 1 };
+            for (; pass <= maxPassCount; pass++)
+            {
+                QVector2D depth(-MAX_DEPTH, -MAX_DEPTH);
+                QVector4D frontColor;
+                QVector4D backColor;
+
+                const float nearestDepth{ -depthBlender.x() };
+                const float farthestDepth{ depthBlender.y() };
+                const float alphaMultiplier{ 1.f - frontBlender.w() };
+                for (quint32 i = first; i < last; i++)
+                {
+                    const float fragDepth{ p_tile.fragments[i].depth };
+                    QVector4D fragFront{ frontBlender };
+                    QVector4D fragBack;
+                    if (fragDepth < nearestDepth || fragDepth > farthestDepth)
+                    {
+                        depth = ::max(depth, QVector2D(-MAX_DEPTH, -MAX_DEPTH));
+                        frontColor = ::max(frontColor, fragFront);
+                        continue;
+                    }
+                    if (fragDepth > nearestDepth && fragDepth < farthestDepth && opaqueDepth > farthestDepth)
+                    {
+                        depth = ::max(depth, QVector2D(-fragDepth, opaqueDepth));
+                        frontColor = ::max(frontColor, fragFront);
+                        continue;
+                    }
+
+                    const QVector4D& color{ p_tile.fragments[i].color };
+                    if (fragDepth == nearestDepth)
+                    {
+                        fragFront.setX(fragFront.x() + color.x() * color.w() * alphaMultiplier);
+                        fragFront.setY(fragFront.y() + color.y() * color.w() * alphaMultiplier);
+                        fragFront.setZ(fragFront.z() + color.z() * color.w() * alphaMultiplier);
+                        fragFront.setW(1.f - alphaMultiplier * (1.f - color.w()));
+                    }
+                    else
+                    {
+                        fragBack = color;
+                    }
+
+                    if (opaqueDepth < fragDepth)
+                    {
+                        if (opaqueColor.w() == 1.f)
+                        {
+                            continue; // discard
+                        }
+                        fragFront = QVector4D(fragFront.toVector3D() * opaqueColor.toVector3D(), fragFront.w());
+                    }
+
+                    depth = ::max(depth, QVector2D(-MAX_DEPTH, -MAX_DEPTH));
+                    frontColor = ::max(frontColor, fragFront);
+                    backColor = ::max(backColor, fragBack);
+                }
+
+                // blend_fragment.glsl: the pixels without back layer are discarded, the others are counted by the occlusion query
+                if (backColor.w() != 0.f)
+                {
+                    backBlender = backColor.toVector3D() * backColor.w() + backBlender * (1.f - backColor.w());
+                    if (isFirstPeeling && pass <= 64)
+                    {
+                        p_tile.samplePassMask |= quint64(1) << (pass - 1);
+                    }
+                }
+
+                depthBlender = depth;
+                frontBlender = frontColor;
+                if (depth == QVector2D(-MAX_DEPTH, -MAX_DEPTH))
+                {
+                    break; // no layer left, the next passes do not change the pixel
+                }
+            }
+
+            p_tile.front[pixel] = frontBlender;
+            p_tile.back[pixel] = backBlender;
+            if (isFirstPeeling)
+            {
+                p_tile.peeledPassCount[pixel] = static_cast<quint8>(std::min(pass, maxPassCount));
+            }
+        }
+    }
+
+    //---------------------------------------------------------------------------------------
+    void SoftwareDualDepthPeelingRenderer::compositeTile(const Tile& p_tile, QImage& p_image) const
+    //---------------------------------------------------------------------------------------
+    {
+        // final_fragment.glsl, the window y axis is up
+        const auto toByte = [](float p_value) { return static_cast<int>(std::lround(std::clamp(p_value, 0.f, 1.f) * 255.f)); };
+        for (int y = 0; y < p_tile.height; y++)
+        {
+            QRgb* const line{ reinterpret_cast<QRgb*>(p_image.scanLine(m_height - 1 - (p_tile.y0 + y))) };
+            for (int x = 0; x < p_tile.width; x++)
+            {
+                const size_t pixel{ static_cast<size_t>(y * p_tile.width + x) };
+                const QVector4D& frontColor{ p_tile.front[pixel] };
+                const float alphaMultiplier{ 1.f - frontColor.w() };
+                const QVector3D color{ frontColor.toVector3D() + (p_tile.back[pixel] + p_tile.opaqueColor[pixel].toVector3D()) * alphaMultiplier };
+                line[p_tile.x0 + x] = qRgb(toByte(color.x()), toByte(color.y()), toByte(color.z()));
+            }
+        }
+    }
+
+    //---------------------------------------------------------------------------------------
+    QImage SoftwareDualDepthPeelingRenderer::render(void)
+    //---------------------------------------------------------------------------------------
+    {
+        if (m_width == 0 || m_height == 0)
+        {
+            qCritical() << "Internal error: the size of the software renderer is not set";
+            return QImage();
+        }
+
+        // 0. Vertex processing and binning
+        std::vector<Triangle> triangles;
+        transformObjects(triangles);
+        std::vector<Tile> tiles;
+        binTriangles(triangles, tiles);
+
+        // the most loaded tiles first: the threads of the pool take the next tile when they are idle,
+        // so the small tiles fill the end of the frame instead of waiting for a big one
+        std::vector<Tile*> tileOrder(tiles.size());
+        for (size_t i = 0; i < tiles.size(); i++)
+        {
+            tileOrder[i] = &tiles[i];
+        }
+        std::stable_sort(tileOrder.begin(), tileOrder.end(), [](const Tile* p_a, const Tile* p_b) { return p_a->triangleIds.size() > p_b->triangleIds.size(); });
+
+        // 1. Rasterization, shading and peeling of each pixel until it has no layer left
+        QtConcurrent::blockingMap(tileOrder, [this, &triangles](Tile* p_tile)
+        {
+            rasterizeTile(triangles, *p_tile);
+            peelTile(*p_tile, m_numberOfPasses);
+        });
+
+        // 2. Pass count of the GL loop: it stops after the first pass without back layer in the image
+        size_t passCount{ m_numberOfPasses };
+        if (passCount == 0)
+        {
+            quint64 samplePassMask{ 0 };
+            for (const Tile& tile : tiles)
+            {
+                samplePassMask |= tile.samplePassMask;
+            }
+            passCount = 1;
+            while (passCount < gl::PassBudgetController::MAX_PASSES && (samplePassMask & (quint64(1) << (passCount - 1))) != 0)
+            {
+                passCount++;
+            }
+
+            // the pixels with layers left after the last pass are peeled again with the GL pass count
+            QtConcurrent::blockingMap(tileOrder, [this, passCount](Tile* p_tile) { peelTile(*p_tile, passCount); });
+        }
+        m_lastPassCount = passCount;
+
+        // 3. Final pass
+        QImage image(m_width, m_height, QImage::Format_RGB32);
+        m_lastFragmentCount = 0;
+        m_maxDepthComplexity = 0;
+        for (const Tile& tile : tiles)
+        {
+            compositeTile(tile, image);
+            m_lastFragmentCount += tile.fragments.size();
+            for (size_t i = 0; i + 1 < tile.pixelOffsets.size(); i++)
+            {
+                m_maxDepthComplexity = std::max(m_maxDepthComplexity, static_cast<int>(tile.pixelOffsets[i + 1] - tile.pixelOffsets[i]));
+            }
+        }
+        return image;
+    }
+
+}
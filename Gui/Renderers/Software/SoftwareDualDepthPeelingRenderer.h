@@ -0,0 +1,97 @@
+#pragma once
+
+#include <QtCore/QHash>
+#include <QtCore/QString>
+#include <QtGui/QImage>
+#include <QtGui/QVector3D>
+
+#include <algorithm>
+#include <vector>
+
+namespace gui
+{
+    class Camera;
+    class Scene;
+
+    namespace gl
+    {
+        class MeshRenderer;
+    }
+}
+
+namespace gui::software
+{
+
+    /**
+     * \class SoftwareDualDepthPeelingRenderer
+     * \brief CPU reference of DualDepthPeelingRenderer, for the machines without GPU and to validate the GL engines
+     *
+     * Same inputs as a TransparencyRenderer: the MeshRenderer objects give the meshes and their materials, the Scene
+     * and the Camera the matrices. The triangles are transformed, binned in screen tiles, and the tiles are rasterized
+     * in parallel. Each tile resolves the opaque objects with a depth buffer and keeps all the transparent fragments,
+     * shaded as Common/shade_fragment.glsl, then sorts them by pixel and depth.
+     * The peeling is not approximated: the passes of peel_fragment.glsl are replayed on the fragments of each pixel
+     * with the MAX blending and the opaque depth rules, the back layers are blended as blend_fragment.glsl, and the
+     * pixel is composited as final_fragment.glsl. The pass count is the one of the GL loop with OpenGlQuery (the first
+     * pass without back sample in the whole image), or a fixed number of passes.
+     * Only the default configuration of DualDepthPeelingRenderer is reproduced (no fused back blending).
+     */
+    class SoftwareDualDepthPeelingRenderer
+    {
+    public:
+        explicit SoftwareDualDepthPeelingRenderer(const Scene& p_scene, const Camera& p_camera);
+        ~SoftwareDualDepthPeelingRenderer(void);
+
+        void setSize(int p_width, int p_height);
+        inline void setBackgroundColor(const QVector3D& p_color) { m_backgroundColor = p_color; }
+        //!< Same as the clear color of the opaque targets, black and transparent by default
+        inline void setOpaqueClearColor(const QVector3D& p_color) { m_opaqueClearColor = p_color; }
+
+        //!< NOT OWNER, the meshes and materials are read at each render
+        void appendOpaqueObject(const QString& p_objectName, const gl::MeshRenderer* p_object);
+        void appendTransparentObject(const QString& p_objectName, const gl::MeshRenderer* p_object);
+        void removeObject(const QString& p_objectName);
+        inline void clearObjects(void) { m_opaqueObjects.clear(); m_transparentObjects.clear(); }
+
+        //!< Peel passes after the initialization, 0 to stop at the first pass without back sample as OpenGlQuery (default)
+        inline void setNumberOfPasses(size_t p_number) { m_numberOfPasses = p_number; }
+        inline void setTileSize(int p_size) { m_tileSize = std::max(4, p_size - p_size % 4); } //!< pixels, multiple of 4 (default 32)
+
+        //!< Render a frame, QImage::Format_RGB32 top-down as QOpenGLFramebufferObject::toImage
+        QImage render(void);
+
+        inline size_t lastPassCount(void) const { return m_lastPassCount; }
+        inline size_t lastFragmentCount(void) const { return m_lastFragmentCount; } //!< transparent fragments of the last frame
+        inline int maxDepthComplexity(void) const { return m_maxDepthComplexity; } //!< transparent fragments of the deepest pixel
+
+    private:
+        struct Triangle;
+        struct Fragment;
+        struct Tile;
+
+        void transformObjects(std::vector<Triangle>& p_triangles) const;
+        void binTriangles(const std::vector<Triangle>& p_triangles, std::vector<Tile>& p_tiles) const;
+        void rasterizeTile(const std::vector<Triangle>& p_triangles, Tile& p_tile) const;
+        void peelTile(Tile& p_tile, size_t p_passCount) const; //!< 0: until each pixel is fully peeled
+        void compositeTile(const Tile& p_tile, QImage& p_image) const;
+
+        const Scene& m_scene;
+        const Camera& m_camera;
+
+        int m_width;
+        int m_height;
+        int m_tileSize;
+        size_t m_numberOfPasses;
+
+        QVector3D m_backgroundColor;
+        QVector3D m_opaqueClearColor;
+
+        QHash<QString, const gl::MeshRenderer*> m_opaqueObjects;
+        QHash<QString, const gl::MeshRenderer*> m_transparentObjects;
+
+        size_t m_lastPassCount;
+        size_t m_lastFragmentCount;
+        int m_maxDepthComplexity;
+    };
+
+}
@@ -0,0 +1,332 @@
+#include "Renderers/UnorderedTransparency/ABufferRenderer.h"
+
+#include "GLWidgets/Camera.h"
+#include "GLWidgets/Scene.h"
+
+#include <QtGui/QOpenGLContext>
+#include <QtGui/QOpenGLFunctions_4_3_Core>
+#include <QtCore/QDebug>
+
+#include <algorithm>
+#include <array>
+#include <limits>
+
+namespace gui::gl
+{
+
+    //---------------------------------------------------------------------------------------
+    ABufferRenderer::ABufferRenderer(const Scene& p_scene, const Camera& p_camera) : TransparencyRenderer(p_scene, p_camera)
+        , m_functions43(nullptr)
+        , m_memoryBudget(256 * 1024 * 1024)
+        , m_initialDepthComplexity(8)
+        , m_maxFragmentCount(32)
+        , m_nodeCapacity(0)
+        , m_overflowFragmentCount(0)
+        , m_headPointerTexId(0)
+        , m_headPointerFboId(0)
+        , m_storeFboId(0)
+        , m_nodeBufferId(0)
+        , m_nodeCounterBufferId(0)
+        , m_nodeCounterFence(nullptr)
+    //---------------------------------------------------------------------------------------
+    {
+    }
+
+    //---------------------------------------------------------------------------------------
+    ABufferRenderer::~ABufferRenderer(void)
+    //---------------------------------------------------------------------------------------
+    {
+    }
+
+    //---------------------------------------------------------------------------------------
+    bool ABufferRenderer::isSupported(const QOpenGLContext* p_context)
+    //---------------------------------------------------------------------------------------
+    {
+        return (p_context != nullptr && !p_context->isOpenGLES() && p_context->format().version() >= qMakePair(4, 3));
+    }
+
+    //---------------------------------------------------------------------------------------
+    bool ABufferRenderer::isOtherGlFunctionsInitialized(void) const
+    //---------------------------------------------------------------------------------------
+    {
+        if (!TransparencyRenderer::isOtherGlFunctionsInitialized())
+        {
+            return false;
+        }
+
+        return (m_functions43 != nullptr && m_nodeCounterBufferId != 0u);
+    }
+
+    //---------------------------------------------------------------------------------------
+    bool ABufferRenderer::updateOtherGlFunctions(void)
+    //---------------------------------------------------------------------------------------
+    {
+        // do not call glGenBuffers
+        return TransparencyRenderer::updateOtherGlFunctions();
+    }
+
+    //---------------------------------------------------------------------------------------
+    bool ABufferRenderer::initOtherGlFunctions(void)
+    //---------------------------------------------------------------------------------------
+    {
+        if (!TransparencyRenderer::initOtherGlFunctions())
+        {
+            return false;
+        }
+
+        QOpenGLContext* const context{ QOpenGLContext::currentContext() };
+        m_functions43 = isSupported(context) ? context->versionFunctions<QOpenGLFunctions_4_3_Core>() : nullptr;
+        if (m_functions43 == nullptr || !m_functions43->initializeOpenGLFunctions())
+        {
+            qCritical() << "The A-Buffer needs OpenGL 4.3";
+            m_functions43 = nullptr;
+            return false;
+        }
+
+        glGenBuffers(1, &m_nodeCounterBufferId);
+        glBindBuffer(GL_ATOMIC_COUNTER_BUFFER, m_nodeCounterBufferId);
+        glBufferData(GL_ATOMIC_COUNTER_BUFFER, sizeof(GLuint), nullptr, GL_DYNAMIC_COPY);
+        glBindBuffer(GL_ATOMIC_COUNTER_BUFFER, 0);
+
+        return true;
+    }
+
+    //---------------------------------------------------------------------------------------
+    void ABufferRenderer::deleteOtherGlFunctions(void)
+    //---------------------------------------------------------------------------------------
+    {
+        TransparencyRenderer::deleteOtherGlFunctions();
+
+        glDeleteBuffers(1, &m_nodeCounterBufferId);
+        m_nodeCounterBufferId = 0;
+        if (m_nodeCounterFence != nullptr)
+        {
+            glDeleteSync(m_nodeCounterFence);
+            m_nodeCounterFence = nullptr;
+        }
+        m_functions43 = nullptr;
+    }
+
+    //---------------------------------------------------------------------------------------
+    bool ABufferRenderer::isRenderTargetsInitialized(void) const
+    //---------------------------------------------------------------------------------------
+    {
+        if (!TransparencyRenderer::isRenderTargetsInitialized())
+        {
+            return false;
+        }
+
+        return (m_headPointerTexId != 0u && m_headPointerFboId != 0u && m_storeFboId != 0u && m_nodeBufferId != 0u);
+    }
+
+    //---------------------------------------------------------------------------------------
+    bool ABufferRenderer::updateTransparentRenderTargets()
+    //---------------------------------------------------------------------------------------
+    {
+        glBindTexture(USING_GL_TEXTURE, m_headPointerTexId);
+        glTexImage2D(USING_GL_TEXTURE, 0, GL_R32UI, m_width, m_height, 0, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+
+        // keep the grown lists
+        allocateNodeBuffer(std::max(m_nodeCapacity, static_cast<size_t>(m_width) * static_cast<size_t>(m_height) * m_initialDepthComplexity));
+
+        return true;
+    }
+
+    //---------------------------------------------------------------------------------------
+    bool ABufferRenderer::initTransparentRenderTargets()
+    //---------------------------------------------------------------------------------------
+    {
+        glGenTextures(1, &m_headPointerTexId);
+        glBindTexture(USING_GL_TEXTURE, m_headPointerTexId);
+        glTexParameteri(USING_GL_TEXTURE, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+        glTexParameteri(USING_GL_TEXTURE, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+        glTexParameteri(USING_GL_TEXTURE, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(USING_GL_TEXTURE, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexImage2D(USING_GL_TEXTURE, 0, GL_R32UI, m_width, m_height, 0, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+
+        glGenFramebuffers(1, &m_headPointerFboId);
+        glBindFramebuffer(GL_FRAMEBUFFER, m_headPointerFboId);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, USING_GL_TEXTURE, m_headPointerTexId, 0);
+
+        // the fragments are written in the lists, not in color attachments
+        glGenFramebuffers(1, &m_storeFboId);
+        glBindFramebuffer(GL_FRAMEBUFFER, m_storeFboId);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, USING_GL_TEXTURE, m_opaqueDepthTexId, 0);
+        glDrawBuffer(GL_NONE);
+        glReadBuffer(GL_NONE);
+
+        glGenBuffers(1, &m_nodeBufferId);
+        m_nodeCapacity = 0;
+        allocateNodeBuffer(static_cast<size_t>(m_width) * static_cast<size_t>(m_height) * m_initialDepthComplexity);
+
+        return true;
+    }
+
+    //---------------------------------------------------------------------------------------
+    void ABufferRenderer::deleteRenderTargets(void)
+    //---------------------------------------------------------------------------------------
+    {
+        TransparencyRenderer::deleteRenderTargets();
+
+        glDeleteTextures(1, &m_headPointerTexId);
+        glDeleteFramebuffers(1, &m_headPointerFboId);
+        glDeleteFramebuffers(1, &m_storeFboId);
+        glDeleteBuffers(1, &m_nodeBufferId);
+        m_nodeCapacity = 0;
+    }
+
+    //---------------------------------------------------------------------------------------
+    void ABufferRenderer::allocateNodeBuffer(size_t p_nodeCount)
+    //---------------------------------------------------------------------------------------
+    {
+        // the node index is a 32 bits integer in the shaders
+        const size_t maxNodeCount{ std::clamp(m_memoryBudget / NODE_SIZE, size_t(1), static_cast<size_t>(std::numeric_limits<GLuint>::max() - 1)) };
+        const size_t nodeCount{ std::clamp(p_nodeCount, size_t(1), maxNodeCount) };
+        if (nodeCount == m_nodeCapacity)
+        {
+            return;
+        }
+
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_nodeBufferId);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, static_cast<GLsizeiptr>(nodeCount * NODE_SIZE), nullptr, GL_DYNAMIC_COPY);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+        m_nodeCapacity = nodeCount;
+    }
+
+    //---------------------------------------------------------------------------------------
+    void ABufferRenderer::readNodeCounter(void)
+    //---------------------------------------------------------------------------------------
+    {
+        if (m_nodeCounterFence == nullptr)
+        {
+            return;
+        }
+
+        const GLenum status{ glClientWaitSync(m_nodeCounterFence, 0, 0) };
+        glDeleteSync(m_nodeCounterFence);
+        m_nodeCounterFence = nullptr;
+        if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+        {
+            // the GPU is late, the count is dropped rather than waiting
+            return;
+        }
+
+        GLuint nodeCount{ 0 };
+        glBindBuffer(GL_ATOMIC_COUNTER_BUFFER, m_nodeCounterBufferId);
+        glGetBufferSubData(GL_ATOMIC_COUNTER_BUFFER, 0, sizeof(GLuint), &nodeCount);
+        glBindBuffer(GL_ATOMIC_COUNTER_BUFFER, 0);
+
+        m_overflowFragmentCount = nodeCount > m_nodeCapacity ? nodeCount - m_nodeCapacity : 0;
+        if (m_overflowFragmentCount > 0)
+        {
+            // a margin for the depth complexity growing between frames
+            allocateNodeBuffer(static_cast<size_t>(nodeCount) + static_cast<size_t>(nodeCount) / 4);
+        }
+    }
+
+    //---------------------------------------------------------------------------------------
+    bool ABufferRenderer::initShaders(void)
+    //---------------------------------------------------------------------------------------
+    {
+        if (!isSupported(QOpenGLContext::currentContext()))
+        {
+            qCritical() << "The A-Buffer needs OpenGL 4.3";
+            return false;
+        }
+
+        bool isOk{ loadShaders(m_shaderStore,
+            { MultipleLightsRenderer::shadeVertex(), "Shaders:UnorderedTransparency/peel_vertex.glsl" },
+            { MultipleLightsRenderer::shadeFragment(), "Shaders:UnorderedTransparency/abuffer_store_fragment.glsl" })
+        };
+
+        isOk &= loadShaders(m_shaderResolve, { quadVertex() }, { "Shaders:UnorderedTransparency/abuffer_resolve_fragment.glsl" });
+
+        return isOk;
+    }
+
+    //---------------------------------------------------------------------------------------
+    void ABufferRenderer::deleteShaders(void)
+    //---------------------------------------------------------------------------------------
+    {
+        m_shaderStore.removeAllShaders();
+        m_shaderResolve.removeAllShaders();
+    }
+
+    //---------------------------------------------------------------------------------------
+    void ABufferRenderer::renderTransparentObjects(void)
+    //---------------------------------------------------------------------------------------
+    {
+        readNodeCounter();
+
+        // ---------------------------------------------------------------------
+        // 1. Clear the lists
+        // ---------------------------------------------------------------------
+        beginGpuStage("clear");
+
+        glBindFramebuffer(GL_FRAMEBUFFER, m_headPointerFboId);
+        glDrawBuffer(GL_COLOR_ATTACHMENT0);
+        constexpr std::array<GLuint, 4> END_OF_LIST_COLOR{ END_OF_LIST, END_OF_LIST, END_OF_LIST, END_OF_LIST };
+        glClearBufferuiv(GL_COLOR, 0, END_OF_LIST_COLOR.data());
+
+        constexpr GLuint ZERO{ 0 };
+        glBindBuffer(GL_ATOMIC_COUNTER_BUFFER, m_nodeCounterBufferId);
+        glBufferSubData(GL_ATOMIC_COUNTER_BUFFER, 0, sizeof(GLuint), &ZERO);
+        glBindBuffer(GL_ATOMIC_COUNTER_BUFFER, 0);
+
+        // ---------------------------------------------------------------------
+        // 2. Store the transparent fragments
+        // ---------------------------------------------------------------------
+        beginGpuStage("store");
+
+        m_functions43->glBindImageTexture(0, m_headPointerTexId, 0, GL_FALSE, 0, GL_READ_WRITE, GL_R32UI);
+        glBindBufferBase(GL_ATOMIC_COUNTER_BUFFER, 0, m_nodeCounterBufferId);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, m_nodeBufferId);
+
+        glBindFramebuffer(GL_FRAMEBUFFER, m_storeFboId);
+        glEnable(GL_DEPTH_TEST);
+        glDepthMask(GL_FALSE);
+        glDisable(GL_BLEND);
+
+        const GLuint nodeCapacity{ static_cast<GLuint>(m_nodeCapacity) };
+        for (MeshRenderer* const renderer : m_transparencyRendererMap)
+        {
+            renderer->renderMesh(m_shaderStore, true,
+                [this, nodeCapacity]()
+                {
+                    m_shaderStore.setUniformValue("NodeCapacity", nodeCapacity);
+                });
+        }
+
+        glDepthMask(GL_TRUE);
+        glDisable(GL_DEPTH_TEST);
+
+        m_functions43->glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT);
+
+        // ---------------------------------------------------------------------
+        // 3. Sort and blend the lists with the opaque objects
+        // ---------------------------------------------------------------------
+        beginGpuStage("final");
+
+        bindOutputFramebuffer();
+
+        m_shaderResolve.bind();
+        m_shaderResolve.setUniformValue("BackgroundColor", m_backgroundColor);
+        m_shaderResolve.setUniformValue("MaxFragments", m_maxFragmentCount);
+        m_shaderResolve.setUniformValue("NodeCapacity", nodeCapacity);
+        bindTexture(m_shaderResolve, "OpaqueTex", m_opaqueTexId, 0);
+        drawFullScreenQuad();
+        unbindTexture(0);
+        m_shaderResolve.release();
+
+        m_functions43->glBindImageTexture(0, 0, 0, GL_FALSE, 0, GL_READ_WRITE, GL_R32UI);
+        glBindBufferBase(GL_ATOMIC_COUNTER_BUFFER, 0, 0);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, 0);
+
+        // the fragment count is read at a next frame
+        m_nodeCounterFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+        glEnable(GL_DEPTH_TEST);
+    }
+
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "Renderers/UnorderedTransparency/TransparencyRenderer.h"
+
+class QOpenGLContext;
+class QOpenGLFunctions_4_3_Core;
+
+namespace gui::gl
+{
+
+    /*
+     * \class ABufferRenderer
+     * \brief Render a RMeshModel with transparency
+     *
+     * Class to make exact independent transparency with an A-Buffer: one geometry pass appends the transparent
+     * fragments to a linked list by pixel (shader storage buffer and head pointer image), then one full screen pass
+     * sorts and blends the nearest fragments of each pixel.
+     * Needs OpenGL 4.3 (image load store, atomic counters and shader storage buffers).
+     *
+    */
+    class ABufferRenderer final : public TransparencyRenderer
+    {
+    public:
+        explicit ABufferRenderer(const Scene& p_scene, const Camera& p_camera);
+        virtual ~ABufferRenderer(void);
+
+        static bool isSupported(const QOpenGLContext* p_context); //!< true if @a p_context is OpenGL 4.3 or more
+
+        //!< Maximal GPU memory of the fragment lists in bytes (default 256 MB)
+        inline void setMemoryBudget(size_t p_bytes) { m_memoryBudget = p_bytes; requestUpdateRenderTargets(); }
+        inline size_t memoryBudget(void) const { return m_memoryBudget; }
+        //!< Number of fragments by pixel allocated for the first frame, the lists grow with the scene until the memory budget (default 8)
+        inline void setInitialDepthComplexity(size_t p_count) { m_initialDepthComplexity = p_count; requestUpdateRenderTargets(); }
+        //!< Number of sorted and blended fragments by pixel, the farthest ones are dropped (default and maximum 32)
+        inline void setMaxFragmentCount(int p_count) { m_maxFragmentCount = p_count; }
+
+        inline size_t nodeCapacity(void) const { return m_nodeCapacity; } //!< number of fragments which can be stored
+        //!< Quality indicator: fragments of a previous frame which did not fit in the lists, 0 if the scene was exact
+        inline size_t overflowFragmentCount(void) const { return m_overflowFragmentCount; }
+
+    protected:
+        bool isOtherGlFunctionsInitialized(void) const override;
+        bool updateOtherGlFunctions(void) override;
+        bool initOtherGlFunctions(void) override;
+        void deleteOtherGlFunctions(void) override;
+
+        void renderTransparentObjects(void) override;
+
+        bool isRenderTargetsInitialized(void) const override;
+        bool updateTransparentRenderTargets() override;
+        bool initTransparentRenderTargets() override;
+        void deleteRenderTargets(void) override;
+
+        inline bool isShadersInitialized(void) const override { return (m_shaderStore.isLinked() && m_shaderResolve.isLinked()); }
+        bool initShaders(void) override;
+        void deleteShaders(void) override;
+
+    private:
+        void allocateNodeBuffer(size_t p_nodeCount); //!< bounded by the memory budget
+        void readNodeCounter(void); //!< grow the lists with the fragment count of a previous frame, without waiting for the GPU
+
+        QOpenGLFunctions_4_3_Core* m_functions43; //!< NOT OWNER, null if the context is too old
+
+        ShaderProgram m_shaderStore;
+        ShaderProgram m_shaderResolve;
+
+        size_t m_memoryBudget;
+        size_t m_initialDepthComplexity;
+        int m_maxFragmentCount;
+
+        size_t m_nodeCapacity;
+        size_t m_overflowFragmentCount;
+
+        GLuint m_headPointerTexId;
+        GLuint m_headPointerFboId; //!< to clear the head pointers
+        GLuint m_storeFboId; //!< opaque depth texture only, to reject hidden fragments
+        GLuint m_nodeBufferId;
+        GLuint m_nodeCounterBufferId;
+        GLsync m_nodeCounterFence; //!< signaled when the fragment count of the last frame can be read
+
+        static constexpr size_t NODE_SIZE = 4 * sizeof(GLuint); //!< packed color, depth, next node, padding
+        static constexpr GLuint END_OF_LIST = 0xFFFFFFFFu;
+
+        Q_DISABLE_COPY_MOVE(ABufferRenderer);
+    };
+
+}
@@ -0,0 +1,74 @@
+#include "Renderers/UnorderedTransparency/DepthComplexityStatistics.h"
+
+#include <cmath>
+
+namespace gui::gl
+{
+
+    //---------------------------------------------------------------------------------------
+    DepthComplexityStatistics::DepthComplexityStatistics(void)
+        : m_maxDepthComplexity(0)
+        , m_coveredPixelCount(0)
+        , m_meanDepthComplexity(0.)
+        , m_isMeanLowerBound(false)
+    //---------------------------------------------------------------------------------------
+    {
+    }
+
+    //---------------------------------------------------------------------------------------
+    void DepthComplexityStatistics::reset(void)
+    //---------------------------------------------------------------------------------------
+    {
+        m_histogram.clear();
+        m_passSampleCounts.clear();
+        m_maxDepthComplexity = 0;
+        m_coveredPixelCount = 0;
+        m_meanDepthComplexity = 0.;
+        m_isMeanLowerBound = false;
+    }
+
+    //---------------------------------------------------------------------------------------
+    void DepthComplexityStatistics::setHistogram(const std::vector<quint64>& p_histogram, size_t p_maxDepthComplexity)
+    //---------------------------------------------------------------------------------------
+    {
+        m_histogram = p_histogram;
+        m_maxDepthComplexity = p_maxDepthComplexity;
+
+        // the bin 0 counts the pixels without transparent fragment
+        m_coveredPixelCount = 0;
+        double fragmentSum{ 0. };
+        for (size_t i = 1; i < m_histogram.size(); i++)
+        {
+            m_coveredPixelCount += m_histogram.at(i);
+            fragmentSum += static_cast<double>(i) * static_cast<double>(m_histogram.at(i));
+        }
+        m_meanDepthComplexity = m_coveredPixelCount > 0 ? fragmentSum / static_cast<double>(m_coveredPixelCount) : 0.;
+
+        // the last bin holds every pixel with at least its index of fragments, they are all counted exactly only if the max is this index
+        const size_t lastBin{ m_histogram.empty() ? 0 : m_histogram.size() - 1 };
+        m_isMeanLowerBound = lastBin > 0 && m_histogram.at(lastBin) > 0 && m_maxDepthComplexity > lastBin;
+    }
+
+    //---------------------------------------------------------------------------------------
+    size_t DepthComplexityStatistics::percentile(double p_ratio) const
+    //---------------------------------------------------------------------------------------
+    {
+        if (m_coveredPixelCount == 0)
+        {
+            return 0;
+        }
+
+        const double pixelCount{ std::ceil(p_ratio * static_cast<double>(m_coveredPixelCount)) };
+        quint64 cumulatedPixelCount{ 0 };
+        for (size_t i = 1; i < m_histogram.size(); i++)
+        {
+            cumulatedPixelCount += m_histogram.at(i);
+            if (static_cast<double>(cumulatedPixelCount) >= pixelCount)
+            {
+                return i;
+            }
+        }
+        return m_histogram.size() - 1;
+    }
+
+}
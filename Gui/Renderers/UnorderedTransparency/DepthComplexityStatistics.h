@@ -0,0 +1,55 @@
+#pragma once
+
+#include <QtGui/qopengl.h>
+#include <QtCore/QtGlobal>
+
+#include <cstddef>
+#include <vector>
+
+namespace gui::gl
+{
+
+    /**
+     * \class DepthComplexityStatistics
+     * \brief Distribution of the number of transparent fragments by pixel
+     *
+     * Filled by the depth complexity mode of DualDepthPeelingRenderer from a histogram reduced on the GPU: the bin i
+     * counts the pixels with i transparent fragments in front of the opaque objects, the last bin counts the pixels
+     * with more. The maximum is exact whatever the number of bins.
+     */
+    class DepthComplexityStatistics
+    {
+    public:
+        explicit DepthComplexityStatistics(void);
+
+        void setHistogram(const std::vector<quint64>& p_histogram, size_t p_maxDepthComplexity);
+        //!< Samples written by each peel pass (occlusion queries), the first pass without sample ends the list
+        inline void setPassSampleCounts(const std::vector<GLuint>& p_sampleCounts) { m_passSampleCounts = p_sampleCounts; }
+        void reset(void);
+
+        inline const std::vector<quint64>& histogram(void) const { return m_histogram; }
+        inline const std::vector<GLuint>& passSampleCounts(void) const { return m_passSampleCounts; }
+        inline size_t maxDepthComplexity(void) const { return m_maxDepthComplexity; }
+        inline quint64 coveredPixelCount(void) const { return m_coveredPixelCount; } //!< pixels with at least one transparent fragment
+        inline double meanDepthComplexity(void) const { return m_meanDepthComplexity; } //!< on the covered pixels, the last bin counts for its index
+        //!< True when the last bin holds pixels deeper than its index: the mean is then understated, a lower bound
+        inline bool isMeanLowerBound(void) const { return m_isMeanLowerBound; }
+        //!< Number of fragments not exceeded by p_ratio of the covered pixels (ex. 0.9 for the 90th percentile)
+        //!< Bounded by the last bin: the pixels of this bin are only known to have at least this number of fragments
+        size_t percentile(double p_ratio) const;
+
+        //!< Peel passes needed to peel every pixel when each pass peels p_layersPerPass layers (2 for dual depth peeling)
+        inline size_t requiredPassCount(size_t p_layersPerPass) const { return p_layersPerPass > 0 ? (m_maxDepthComplexity + p_layersPerPass - 1) / p_layersPerPass : 0; }
+
+        inline bool isValid(void) const { return !m_histogram.empty(); }
+
+    private:
+        std::vector<quint64> m_histogram;
+        std::vector<GLuint> m_passSampleCounts;
+        size_t m_maxDepthComplexity;
+        quint64 m_coveredPixelCount;
+        double m_meanDepthComplexity;
+        bool m_isMeanLowerBound;
+    };
+
+}
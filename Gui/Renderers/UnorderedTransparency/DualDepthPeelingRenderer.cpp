@@ -3,8 +3,12 @@
 #include "GLWidgets/Camera.h"
 #include "GLWidgets/Scene.h"
 
-#include <QtGui/QOpenGLFramebufferObject>
 #include <QtCore/QDebug>
+#include <QtCore/QStringList>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
 namespace gui::gl
 {
@@ -14,12 +18,34 @@ namespace gui::gl
         , m_useOQ(true)
         , m_queryId(0)
         , m_numberOfPasses(4)
+        , m_lastPassCount(0)
+        , m_useUnpeeledQuery(false)
+        , m_unpeeledSampleCount(0)
+        , m_unpeeledQueryId(0)
+        , m_unpeeledQueryPending(false)
+        , m_timerQueryIds{}
+        , m_timerPassCount{}
+        , m_frameId(0)
+        , m_useNonStallingOQ(false)
+        , m_passQueryCount{}
+        , m_predictedPassCount(INITIAL_PREDICTED_PASS_COUNT)
+        , m_avoidedStallCount(0)
+        , m_useStencilMask(false)
+        , m_transmittanceEpsilon(1.f / 255.f)
+        , m_useFusedBackBlend(false)
+        , m_useDepthComplexityMode(false)
+        , m_complexityFboId(0)
+        , m_complexityTexId(0)
+        , m_histogramFboId(0)
+        , m_histogramTexId(0)
+        , m_histogramVertexArrayId(0)
         //, m_dualBackBlenderFboId(0)
         , m_dualPeelingSingleFboId(0)
         , m_dualBackBlenderTexId(0)
         , m_dualDepthTexId{ {0, 0} }
         , m_dualFrontBlenderTexId{ {0, 0} }
         , m_dualBackTempTexId{ {0, 0} }
+        , m_dualStencilRenderbufferId(0)
     //---------------------------------------------------------------------------------------
     {
     }
@@ -39,7 +65,7 @@ namespace gui::gl
             return false;
         }
 
-        return (m_queryId != 0u);
+        return (m_queryId != 0u && m_unpeeledQueryId != 0u && m_timerQueryIds.front().front() != 0u && m_histogramVertexArrayId != 0u);
     }
 
     //---------------------------------------------------------------------------------------
@@ -60,6 +86,16 @@ namespace gui::gl
         }
 
         glGenQueries(1, &m_queryId);
+        glGenQueries(1, &m_unpeeledQueryId);
+        for (std::array<GLuint, TIMESTAMP_COUNT>& timerQueryIds : m_timerQueryIds)
+        {
+            glGenQueries(TIMESTAMP_COUNT, timerQueryIds.data());
+        }
+        m_timerPassCount.fill(0);
+        m_passQueryCount.fill(0);
+        m_unpeeledQueryPending = false;
+
+        glGenVertexArrays(1, &m_histogramVertexArrayId);
 
         return true;
     }
@@ -71,6 +107,91 @@ namespace gui::gl
         TransparencyRenderer::deleteOtherGlFunctions();
 
         glDeleteQueries(1, &m_queryId);
+        glDeleteQueries(1, &m_unpeeledQueryId);
+        for (std::array<GLuint, TIMESTAMP_COUNT>& timerQueryIds : m_timerQueryIds)
+        {
+            glDeleteQueries(TIMESTAMP_COUNT, timerQueryIds.data());
+            timerQueryIds.fill(0);
+        }
+        for (std::vector<GLuint>& passQueryIds : m_passQueryIds)
+        {
+            glDeleteQueries(static_cast<GLsizei>(passQueryIds.size()), passQueryIds.data());
+            passQueryIds.clear();
+        }
+        glDeleteVertexArrays(1, &m_histogramVertexArrayId);
+        m_histogramVertexArrayId = 0;
+    }
+
+    //---------------------------------------------------------------------------------------
+    void DualDepthPeelingRenderer::setFrameTimeBudget(double p_milliseconds)
+    //---------------------------------------------------------------------------------------
+    {
+        m_passBudgetController.setTargetFrameTime(p_milliseconds);
+        m_passBudgetController.reset();
+        m_timerPassCount.fill(0);
+    }
+
+    //---------------------------------------------------------------------------------------
+    size_t DualDepthPeelingRenderer::maxPassCount(void) const
+    //---------------------------------------------------------------------------------------
+    {
+        size_t passCount{ m_passBudgetController.isEnabled() ? m_passBudgetController.passBudget() : std::numeric_limits<size_t>::max() };
+        if (!m_useOQ)
+        {
+            // the fixed number of passes counts the initialization pass
+            passCount = std::min(passCount, m_numberOfPasses > 0 ? m_numberOfPasses - 1 : 0);
+        }
+        return passCount;
+    }
+
+    //---------------------------------------------------------------------------------------
+    void DualDepthPeelingRenderer::readTimerQueries(void)
+    //---------------------------------------------------------------------------------------
+    {
+        // the oldest frame is read just before its queries are reused
+        const size_t frameId{ m_frameId % PENDING_FRAME_COUNT };
+        const std::array<GLuint, TIMESTAMP_COUNT>& timerQueryIds{ m_timerQueryIds.at(frameId) };
+        if (m_timerPassCount.at(frameId) == 0)
+        {
+            return;
+        }
+
+        GLuint isAvailable{ GL_FALSE };
+        glGetQueryObjectuiv(timerQueryIds.at(FRAME_END), GL_QUERY_RESULT_AVAILABLE, &isAvailable);
+        if (isAvailable == GL_TRUE)
+        {
+            std::array<GLuint64, TIMESTAMP_COUNT> timeStamps{};
+            for (size_t i = 0; i < TIMESTAMP_COUNT; i++)
+            {
+                glGetQueryObjectui64v(timerQueryIds.at(i), GL_QUERY_RESULT, &timeStamps.at(i));
+            }
+
+            constexpr double NS_TO_MS{ 1e-6 };
+            const double loopTime{ static_cast<double>(timeStamps.at(LOOP_END) - timeStamps.at(LOOP_START)) * NS_TO_MS };
+            const double fixedTime{ static_cast<double>((timeStamps.at(LOOP_START) - timeStamps.at(FRAME_START)) + (timeStamps.at(FRAME_END) - timeStamps.at(LOOP_END))) * NS_TO_MS };
+            m_passBudgetController.addFrameTiming(fixedTime, loopTime, m_timerPassCount.at(frameId));
+        }
+        // else the GPU is late, the measure is dropped rather than waiting
+
+        m_timerPassCount.at(frameId) = 0;
+    }
+
+    //---------------------------------------------------------------------------------------
+    void DualDepthPeelingRenderer::readUnpeeledQuery(void)
+    //---------------------------------------------------------------------------------------
+    {
+        if (!m_unpeeledQueryPending)
+        {
+            return;
+        }
+
+        GLuint isAvailable{ GL_FALSE };
+        glGetQueryObjectuiv(m_unpeeledQueryId, GL_QUERY_RESULT_AVAILABLE, &isAvailable);
+        if (isAvailable == GL_TRUE)
+        {
+            glGetQueryObjectuiv(m_unpeeledQueryId, GL_QUERY_RESULT, &m_unpeeledSampleCount);
+        }
+        m_unpeeledQueryPending = false;
     }
 
     //---------------------------------------------------------------------------------------
@@ -82,7 +203,8 @@ namespace gui::gl
             return false;
         }
 
-        bool isInitialized{ m_dualPeelingSingleFboId != 0u && m_dualBackBlenderTexId != 0u };
+        bool isInitialized{ m_dualPeelingSingleFboId != 0u && m_dualBackBlenderTexId != 0u && m_dualStencilRenderbufferId != 0u };
+        isInitialized = isInitialized && m_complexityFboId != 0u && m_complexityTexId != 0u && m_histogramFboId != 0u && m_histogramTexId != 0u;
         for (size_t i = 0; i < 2 && isInitialized; i++)
         {
             isInitialized = isInitialized && m_dualDepthTexId.at(i) != 0u;
@@ -111,6 +233,12 @@ namespace gui::gl
         glBindTexture(USING_GL_TEXTURE, m_dualBackBlenderTexId);
         glTexImage2D(USING_GL_TEXTURE, 0, GL_RGB32F, m_width, m_height, 0, GL_RGB, GL_FLOAT, nullptr);
 
+        glBindRenderbuffer(GL_RENDERBUFFER, m_dualStencilRenderbufferId);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, m_width, m_height);
+
+        glBindTexture(USING_GL_TEXTURE, m_complexityTexId);
+        glTexImage2D(USING_GL_TEXTURE, 0, GL_R32F, m_width, m_height, 0, GL_RED, GL_FLOAT, nullptr);
+
         return true;
     }
 
@@ -173,6 +301,36 @@ namespace gui::gl
 
         glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT6, USING_GL_TEXTURE, m_dualBackBlenderTexId, 0);
 
+        // stencil only attachments are not supported everywhere
+        glGenRenderbuffers(1, &m_dualStencilRenderbufferId);
+        glBindRenderbuffer(GL_RENDERBUFFER, m_dualStencilRenderbufferId);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, m_width, m_height);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, m_dualStencilRenderbufferId);
+
+        // depth complexity mode: 32 bits float counts are exact up to 2^24 fragments by pixel or pixels by bin
+        glGenTextures(1, &m_complexityTexId);
+        glBindTexture(USING_GL_TEXTURE, m_complexityTexId);
+        glTexParameteri(USING_GL_TEXTURE, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+        glTexParameteri(USING_GL_TEXTURE, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+        glTexParameteri(USING_GL_TEXTURE, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(USING_GL_TEXTURE, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexImage2D(USING_GL_TEXTURE, 0, GL_R32F, m_width, m_height, 0, GL_RED, GL_FLOAT, nullptr);
+
+        glGenFramebuffers(1, &m_complexityFboId);
+        glBindFramebuffer(GL_FRAMEBUFFER, m_complexityFboId);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, USING_GL_TEXTURE, m_complexityTexId, 0);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, USING_GL_TEXTURE, m_opaqueDepthTexId, 0);
+
+        glGenTextures(1, &m_histogramTexId);
+        glBindTexture(USING_GL_TEXTURE, m_histogramTexId);
+        glTexParameteri(USING_GL_TEXTURE, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(USING_GL_TEXTURE, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexImage2D(USING_GL_TEXTURE, 0, GL_R32F, HISTOGRAM_BIN_COUNT + 1, 1, 0, GL_RED, GL_FLOAT, nullptr);
+
+        glGenFramebuffers(1, &m_histogramFboId);
+        glBindFramebuffer(GL_FRAMEBUFFER, m_histogramFboId);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, USING_GL_TEXTURE, m_histogramTexId, 0);
+
         return true;
     }
 
@@ -188,6 +346,12 @@ namespace gui::gl
         glDeleteTextures(2, m_dualDepthTexId.data());
         glDeleteTextures(2, m_dualFrontBlenderTexId.data());
         glDeleteTextures(2, m_dualBackTempTexId.data());
+        glDeleteRenderbuffers(1, &m_dualStencilRenderbufferId);
+
+        glDeleteFramebuffers(1, &m_complexityFboId);
+        glDeleteTextures(1, &m_complexityTexId);
+        glDeleteFramebuffers(1, &m_histogramFboId);
+        glDeleteTextures(1, &m_histogramTexId);
     }
 
     //---------------------------------------------------------------------------------------
@@ -207,6 +371,20 @@ namespace gui::gl
 
         isOk &= loadShaders(m_shaderDualFinal, { quadVertex() }, { "Shaders:UnorderedTransparency/final_fragment.glsl" });
 
+        isOk &= loadShaders(m_shaderDualClear, { quadVertex() }, { "Shaders:UnorderedTransparency/clear_fragment.glsl" });
+
+        isOk &= loadShaders(m_shaderDualMask, { quadVertex() }, { "Shaders:UnorderedTransparency/mask_fragment.glsl" });
+
+        isOk &= loadShaders(m_shaderComplexityCount,
+            { "Shaders:UnorderedTransparency/init_vertex.glsl" },
+            { "Shaders:UnorderedTransparency/complexity_count_fragment.glsl" });
+
+        isOk &= loadShaders(m_shaderComplexityHistogram,
+            { "Shaders:UnorderedTransparency/complexity_histogram_vertex.glsl" },
+            { "Shaders:UnorderedTransparency/complexity_histogram_fragment.glsl" });
+
+        isOk &= loadShaders(m_shaderComplexityHeatmap, { quadVertex() }, { "Shaders:UnorderedTransparency/complexity_heatmap_fragment.glsl" });
+
         return isOk;
     }
 
@@ -218,18 +396,346 @@ namespace gui::gl
         m_shaderDualPeel.removeAllShaders();
         m_shaderDualBlend.removeAllShaders();
         m_shaderDualFinal.removeAllShaders();
+        m_shaderDualClear.removeAllShaders();
+        m_shaderDualMask.removeAllShaders();
+        m_shaderComplexityCount.removeAllShaders();
+        m_shaderComplexityHistogram.removeAllShaders();
+        m_shaderComplexityHeatmap.removeAllShaders();
+    }
+
+    //---------------------------------------------------------------------------------------
+    void DualDepthPeelingRenderer::readPassQueries(void)
+    //---------------------------------------------------------------------------------------
+    {
+        // the oldest frame is read just before its queries are reused
+        const size_t frameId{ m_frameId % PENDING_FRAME_COUNT };
+        const size_t passCount{ m_passQueryCount.at(frameId) };
+        if (passCount == 0)
+        {
+            return;
+        }
+        m_passQueryCount.at(frameId) = 0;
+
+        const std::vector<GLuint>& passQueryIds{ m_passQueryIds.at(frameId) };
+        GLuint isAvailable{ GL_TRUE };
+        for (size_t i = 0; i < passCount && isAvailable == GL_TRUE; i++)
+        {
+            glGetQueryObjectuiv(passQueryIds.at(i), GL_QUERY_RESULT_AVAILABLE, &isAvailable);
+        }
+        if (isAvailable != GL_TRUE)
+        {
+            // the GPU is late, keep the previous prediction rather than waiting
+            m_timerPassCount.at(frameId) = 0;
+            return;
+        }
+
+        // the first pass without sample is the last needed one, the next passes have been skipped on the GPU
+        size_t neededPassCount{ 0 };
+        GLuint sampleCount{ 1u };
+        m_passSampleCounts.clear();
+        while (neededPassCount < passCount && sampleCount > 0u)
+        {
+            glGetQueryObjectuiv(passQueryIds.at(neededPassCount), GL_QUERY_RESULT, &sampleCount);
+            m_passSampleCounts.push_back(sampleCount);
+            neededPassCount++;
+        }
+
+        m_timerPassCount.at(frameId) = neededPassCount;
+        if (sampleCount > 0u)
+        {
+            // all the passes have been used, the scene is deeper than the prediction
+            m_predictedPassCount = std::min(2 * passCount, PassBudgetController::MAX_PASSES);
+        }
+        else
+        {
+            // one more pass as a margin for the depth complexity growing between frames
+            m_predictedPassCount = std::min(neededPassCount + 1, PassBudgetController::MAX_PASSES);
+        }
+
+        if (m_useDepthComplexityMode)
+        {
+            m_depthComplexityStatistics.setPassSampleCounts(m_passSampleCounts);
+            if (m_depthComplexityStatistics.isValid())
+            {
+                // two layers by pass, then one pass without sample to stop
+                const size_t measuredPassCount{ m_depthComplexityStatistics.requiredPassCount(2) + 1 };
+                m_predictedPassCount = std::min(std::max(m_predictedPassCount, measuredPassCount), PassBudgetController::MAX_PASSES);
+            }
+        }
+    }
+
+    //---------------------------------------------------------------------------------------
+    void DualDepthPeelingRenderer::renderPeelPass(size_t p_currId)
+    //---------------------------------------------------------------------------------------
+    {
+        const size_t prevId{ 1 - p_currId };
+        const size_t bufId{ p_currId * 3 };
+
+        //glBindFramebuffer(GL_FRAMEBUFFER, m_dualPeelingFboId[currId]);
+
+        if (m_useStencilMask)
+        {
+            // glClear ignores the stencil test, the finished pixels must keep their last peeled values
+            glDisable(GL_BLEND);
+            glDrawBuffers(m_useFusedBackBlend ? 2 : 3, &DRAW_BUFFERS.at(bufId + 0));
+            m_shaderDualClear.bind();
+            drawFullScreenQuad();
+            m_shaderDualClear.release();
+            glEnable(GL_BLEND);
+        }
+        else
+        {
+            // the fused back blender is never cleared, a pixel without fragment in a pass keeps its accumulated back color
+            glDrawBuffers(m_useFusedBackBlend ? 1 : 2, &DRAW_BUFFERS.at(bufId + 1));
+            glClearColor(0.f, 0.f, 0.f, 0.f);
+            glClear(GL_COLOR_BUFFER_BIT);
+
+            glDrawBuffer(DRAW_BUFFERS.at(bufId + 0));
+            glClearColor(-MAX_DEPTH, -MAX_DEPTH, 0, 0);
+            glClear(GL_COLOR_BUFFER_BIT);
+        }
+
+        // Render target 0: RG32F MAX blending
+        // Render target 1: RGBA MAX blending
+        // Render target 2: RGBA MAX blending
+        glDrawBuffers(3, &DRAW_BUFFERS.at(bufId + 0));
+        glBlendEquation(GL_MAX);
+
+        for (MeshRenderer* const renderer : m_transparencyRendererMap)
+        {
+            renderer->renderMesh(m_shaderDualPeel, true,
+                [this, &prevId]()
+                {
+                    bindTexture(m_shaderDualPeel, "DepthBlenderTex", m_dualDepthTexId.at(prevId), 0);
+                    bindTexture(m_shaderDualPeel, "FrontBlenderTex", m_dualFrontBlenderTexId.at(prevId), 1);
+                    bindTexture(m_shaderDualPeel, "OpaqueDepthTex", m_opaqueDepthTexId, 2);
+                    bindTexture(m_shaderDualPeel, "OpaqueColorTex", m_opaqueTexId, 3);
+                    bindTexture(m_shaderDualPeel, "BackBlenderTex", m_dualBackTempTexId.at(prevId), 4);
+                    m_shaderDualPeel.setUniformValue("FusedBackBlend", m_useFusedBackBlend);
+                    //m_shaderDualPeel.setUniformValue("Width", static_cast<GLfloat>(m_width));
+                    //m_shaderDualPeel.setUniformValue("Height", static_cast<GLfloat>(m_height));
+                },
+                [this]()
+                {
+                    unbindTexture(0);
+                    unbindTexture(1);
+                    unbindTexture(2);
+                    unbindTexture(3);
+                    unbindTexture(4);
+                });
+        }
+
+    }
+
+    //---------------------------------------------------------------------------------------
+    void DualDepthPeelingRenderer::renderBlendPass(size_t p_currId)
+    //---------------------------------------------------------------------------------------
+    {
+        // Full screen pass to alpha-blend the back color
+        glDrawBuffer(DRAW_BUFFERS[6]);
+
+        glBlendEquation(GL_FUNC_ADD);
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+        m_shaderDualBlend.bind();
+        bindTexture(m_shaderDualBlend, "TempTex", m_dualBackTempTexId.at(p_currId), 0);
+        drawFullScreenQuad();
+        unbindTexture(0);
+        m_shaderDualBlend.release();
+    }
+
+    //---------------------------------------------------------------------------------------
+    void DualDepthPeelingRenderer::renderMaskPass(size_t p_currId, bool p_countRemaining)
+    //---------------------------------------------------------------------------------------
+    {
+        // Full screen pass which only writes the stencil of the finished pixels, or nothing when counting in an occlusion query
+        glDisable(GL_BLEND);
+        glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+        if (!p_countRemaining)
+        {
+            glStencilOp(GL_KEEP, GL_KEEP, GL_ZERO);
+        }
+
+        m_shaderDualMask.bind();
+        m_shaderDualMask.setUniformValue("TransmittanceEpsilon", m_transmittanceEpsilon);
+        m_shaderDualMask.setUniformValue("CountRemaining", p_countRemaining);
+        bindTexture(m_shaderDualMask, "DepthBlenderTex", m_dualDepthTexId.at(p_currId), 0);
+        bindTexture(m_shaderDualMask, "FrontBlenderTex", m_dualFrontBlenderTexId.at(p_currId), 1);
+        drawFullScreenQuad();
+        unbindTexture(0);
+        unbindTexture(1);
+        m_shaderDualMask.release();
+
+        glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
+        glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+        glEnable(GL_BLEND);
+    }
+
+    //---------------------------------------------------------------------------------------
+    void DualDepthPeelingRenderer::renderFinalPass(size_t p_currId)
+    //---------------------------------------------------------------------------------------
+    {
+        bindOutputFramebuffer();
+
+        // When passes are skipped on the GPU or pixels are out of the stencil mask, the last written front blender is unknown on the CPU.
+        // The front alpha only increases between passes, so the most opaque front blender is the last one.
+        const bool selectFrontBlender{ isNonStallingQueryUsed() || m_useStencilMask };
+
+        m_shaderDualFinal.bind();
+        m_shaderDualFinal.setUniformValue("SelectFrontBlender", selectFrontBlender);
+        m_shaderDualFinal.setUniformValue("FusedBackBlend", m_useFusedBackBlend);
+        m_shaderDualFinal.setUniformValue("BackgroundColor", m_backgroundColor);
+        bindTexture(m_shaderDualFinal, "OpaqueTex", m_opaqueTexId, 0);
+        bindTexture(m_shaderDualFinal, "FrontBlenderTex", m_dualFrontBlenderTexId.at(p_currId), 1);
+        bindTexture(m_shaderDualFinal, "BackBlenderTex", m_useFusedBackBlend ? m_dualBackTempTexId.at(p_currId) : m_dualBackBlenderTexId, 2);
+        bindTexture(m_shaderDualFinal, "OtherFrontBlenderTex", m_dualFrontBlenderTexId.at(1 - p_currId), 3);
+        bindTexture(m_shaderDualFinal, "OtherBackBlenderTex", m_dualBackTempTexId.at(1 - p_currId), 4);
+        drawFullScreenQuad();
+        unbindTexture(0);
+        unbindTexture(1);
+        unbindTexture(2);
+        unbindTexture(3);
+        unbindTexture(4);
+        m_shaderDualFinal.release();
+    }
+
+    //---------------------------------------------------------------------------------------
+    void DualDepthPeelingRenderer::renderDepthComplexity(void)
+    //---------------------------------------------------------------------------------------
+    {
+        beginGpuStage("depth complexity");
+
+        // Count the transparent fragments in front of the opaque objects
+        glBindFramebuffer(GL_FRAMEBUFFER, m_complexityFboId);
+        glDrawBuffer(GL_COLOR_ATTACHMENT0);
+        glClearColor(0, 0, 0, 0);
+        glClear(GL_COLOR_BUFFER_BIT);
+
+        glEnable(GL_DEPTH_TEST);
+        glDepthFunc(GL_LESS);
+        glDepthMask(GL_FALSE);
+        glEnable(GL_BLEND);
+        glBlendEquation(GL_FUNC_ADD);
+        glBlendFunc(GL_ONE, GL_ONE);
+
+        for (MeshRenderer* const renderer : m_transparencyRendererMap)
+        {
+            renderer->renderMesh(m_shaderComplexityCount, false);
+        }
+
+        glDepthMask(GL_TRUE);
+        glDisable(GL_DEPTH_TEST);
+
+        // Histogram and max reduced by blending one point by pixel
+        glBindFramebuffer(GL_FRAMEBUFFER, m_histogramFboId);
+        glDrawBuffer(GL_COLOR_ATTACHMENT0);
+        glViewport(0, 0, HISTOGRAM_BIN_COUNT + 1, 1);
+        glClear(GL_COLOR_BUFFER_BIT);
+
+        m_shaderComplexityHistogram.bind();
+        m_shaderComplexityHistogram.setUniformValue("BinCount", HISTOGRAM_BIN_COUNT);
+        bindTexture(m_shaderComplexityHistogram, "FragmentCountTex", m_complexityTexId, 0);
+        glBindVertexArray(m_histogramVertexArrayId);
+
+        m_shaderComplexityHistogram.setUniformValue("ReduceMax", false);
+        glDrawArrays(GL_POINTS, 0, m_width * m_height);
+
+        m_shaderComplexityHistogram.setUniformValue("ReduceMax", true);
+        glBlendEquation(GL_MAX);
+        glDrawArrays(GL_POINTS, 0, m_width * m_height);
+
+        glBindVertexArray(0);
+        unbindTexture(0);
+        m_shaderComplexityHistogram.release();
+
+        glBlendEquation(GL_FUNC_ADD);
+        glDisable(GL_BLEND);
+        glViewport(0, 0, m_width, m_height);
+
+        // diagnostic mode: a few floats read back, the stall is accepted
+        std::array<GLfloat, HISTOGRAM_BIN_COUNT + 1> bins{};
+        glReadBuffer(GL_COLOR_ATTACHMENT0);
+        glReadPixels(0, 0, HISTOGRAM_BIN_COUNT + 1, 1, GL_RED, GL_FLOAT, bins.data());
+
+        std::vector<quint64> histogram(HISTOGRAM_BIN_COUNT);
+        for (size_t i = 0; i < histogram.size(); i++)
+        {
+            histogram.at(i) = static_cast<quint64>(std::llround(bins.at(i)));
+        }
+        const size_t maxDepthComplexity{ static_cast<size_t>(std::llround(bins.back())) };
+
+        const bool isChanged{ histogram != m_depthComplexityStatistics.histogram() };
+        m_depthComplexityStatistics.setHistogram(histogram, maxDepthComplexity);
+        if (isChanged)
+        {
+            logDepthComplexityStatistics();
+        }
+
+        // Heatmap instead of the final pass
+        bindOutputFramebuffer();
+
+        m_shaderComplexityHeatmap.bind();
+        m_shaderComplexityHeatmap.setUniformValue("BackgroundColor", m_backgroundColor);
+        m_shaderComplexityHeatmap.setUniformValue("MaxFragmentCount", static_cast<GLfloat>(maxDepthComplexity));
+        bindTexture(m_shaderComplexityHeatmap, "FragmentCountTex", m_complexityTexId, 0);
+        bindTexture(m_shaderComplexityHeatmap, "OpaqueTex", m_opaqueTexId, 1);
+        drawFullScreenQuad();
+        unbindTexture(0);
+        unbindTexture(1);
+        m_shaderComplexityHeatmap.release();
+    }
+
+    //---------------------------------------------------------------------------------------
+    void DualDepthPeelingRenderer::logDepthComplexityStatistics(void) const
+    //---------------------------------------------------------------------------------------
+    {
+        const DepthComplexityStatistics& statistics{ m_depthComplexityStatistics };
+
+        QStringList passSampleCounts;
+        for (const GLuint sampleCount : statistics.passSampleCounts())
+        {
+            passSampleCounts << QString::number(sampleCount);
+        }
+
+        qInfo().noquote() << QString("Depth complexity: max %1, mean %2%3, percentiles 50/90/99 %4/%5/%6, %7 covered pixels, samples by peel pass [%8]")
+            .arg(statistics.maxDepthComplexity())
+            .arg(statistics.isMeanLowerBound() ? ">= " : "")
+            .arg(statistics.meanDepthComplexity(), 0, 'f', 2)
+            .arg(statistics.percentile(0.5))
+            .arg(statistics.percentile(0.9))
+            .arg(statistics.percentile(0.99))
+            .arg(statistics.coveredPixelCount())
+            .arg(passSampleCounts.join(", "));
     }
 
     //---------------------------------------------------------------------------------------
     void DualDepthPeelingRenderer::renderTransparentObjects(void)
     //---------------------------------------------------------------------------------------
     {
+        const bool isNonStalling{ isNonStallingQueryUsed() };
+        if (isNonStalling)
+        {
+            // before readTimerQueries() to give it the number of executed passes
+            readPassQueries();
+        }
+
+        const bool isTimed{ m_passBudgetController.isEnabled() };
+        const size_t frameId{ m_frameId % PENDING_FRAME_COUNT };
+        const std::array<GLuint, TIMESTAMP_COUNT>& timerQueryIds{ m_timerQueryIds.at(frameId) };
+        if (isTimed)
+        {
+            readTimerQueries();
+            glQueryCounter(timerQueryIds.at(FRAME_START), GL_TIMESTAMP);
+        }
+        readUnpeeledQuery();
+
         glDisable(GL_DEPTH_TEST);
         glEnable(GL_BLEND);
 
         // ---------------------------------------------------------------------
         // 1. Initialize Min-Max Depth Buffer
         // ---------------------------------------------------------------------
+        beginGpuStage("init");
 
         glBindFramebuffer(GL_FRAMEBUFFER, m_dualPeelingSingleFboId);
 
@@ -239,6 +745,29 @@ namespace gui::gl
         glDrawBuffers(2, &DRAW_BUFFERS[1]);
         glClearColor(0, 0, 0, 0);
         glClear(GL_COLOR_BUFFER_BIT);
+        if (m_useFusedBackBlend && !m_useStencilMask)
+        {
+            glDrawBuffer(DRAW_BUFFERS[5]);
+            glClear(GL_COLOR_BUFFER_BIT);
+        }
+
+        if (m_useStencilMask)
+        {
+            // the pixels out of the mask are never cleared by the peel passes, the final pass reads both front blenders
+            glDrawBuffers(2, &DRAW_BUFFERS[4]);
+            glClear(GL_COLOR_BUFFER_BIT);
+            glDrawBuffer(DRAW_BUFFERS[3]);
+            glClearColor(-MAX_DEPTH, -MAX_DEPTH, 0, 0);
+            glClear(GL_COLOR_BUFFER_BIT);
+
+            // the initialization pass marks the pixels with transparent objects
+            glClearStencil(0);
+            glClear(GL_STENCIL_BUFFER_BIT);
+            glEnable(GL_STENCIL_TEST);
+            glStencilMask(0xFF);
+            glStencilFunc(GL_ALWAYS, 1, 0xFF);
+            glStencilOp(GL_KEEP, GL_KEEP, GL_REPLACE);
+        }
 
         // Render target 0 stores (-minDepth, maxDepth, alphaMultiplier)
         glDrawBuffer(DRAW_BUFFERS[0]);
@@ -251,6 +780,13 @@ namespace gui::gl
             renderer->renderMesh(m_shaderDualInit, false);
         }
 
+        if (m_useStencilMask)
+        {
+            // the next passes only run on the marked pixels
+            glStencilFunc(GL_EQUAL, 1, 0xFF);
+            glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
+        }
+
         // ---------------------------------------------------------------------
         // 2. Dual Depth Peeling + Blending
         // ---------------------------------------------------------------------
@@ -262,94 +798,174 @@ namespace gui::gl
         glClearColor(m_backgroundColor[0], m_backgroundColor[1], m_backgroundColor[2], 0);
         glClear(GL_COLOR_BUFFER_BIT);
 
+        if (isTimed)
+        {
+            glQueryCounter(timerQueryIds.at(LOOP_START), GL_TIMESTAMP);
+        }
+
+        size_t maxPass{ maxPassCount() };
+        std::vector<GLuint>& passQueryIds{ m_passQueryIds.at(frameId) };
+        if (isNonStalling)
+        {
+            maxPass = std::min(maxPass, m_predictedPassCount);
+            if (passQueryIds.size() < maxPass)
+            {
+                const size_t firstId{ passQueryIds.size() };
+                passQueryIds.resize(maxPass);
+                glGenQueries(static_cast<GLsizei>(maxPass - firstId), &passQueryIds.at(firstId));
+            }
+        }
+
+        if (m_useDepthComplexityMode && !isNonStalling)
+        {
+            m_passSampleCounts.clear();
+        }
+
         size_t currId{ 0 };
+        size_t pass{ 1 };
         GLuint sampleCount{ 1u };
-        for (size_t pass = 1; (m_useOQ && sampleCount > 0u) || (!m_useOQ && pass < m_numberOfPasses); pass++)
+        for (; pass <= maxPass && (!m_useOQ || sampleCount > 0u); pass++)
         {
             currId = pass % 2;
-            const size_t prevId{ 1 - currId };
-            const size_t bufId{ currId * 3 };
 
-            //glBindFramebuffer(GL_FRAMEBUFFER, m_dualPeelingFboId[currId]);
+            // the pass is skipped on the GPU if the previous one has written no sample
+            const bool isConditional{ isNonStalling && pass > 1 };
 
-            glDrawBuffers(2, &DRAW_BUFFERS.at(bufId + 1));
-            glClearColor(0.f, 0.f, 0.f, 0.f);
-            glClear(GL_COLOR_BUFFER_BIT);
+            if (isConditional)
+            {
+                glBeginConditionalRender(passQueryIds.at(pass - 2), GL_QUERY_WAIT);
+            }
 
-            glDrawBuffer(DRAW_BUFFERS.at(bufId + 0));
-            glClearColor(-MAX_DEPTH, -MAX_DEPTH, 0, 0);
-            glClear(GL_COLOR_BUFFER_BIT);
+            beginGpuStage("peel", pass);
+            renderPeelPass(currId);
+            beginGpuStage("blend", pass);
 
-            // Render target 0: RG32F MAX blending
-            // Render target 1: RGBA MAX blending
-            // Render target 2: RGBA MAX blending
-            glDrawBuffers(3, &DRAW_BUFFERS.at(bufId + 0));
-            glBlendEquation(GL_MAX);
+            if (isNonStalling)
+            {
+                // a skipped pass writes no sample, so the next passes are skipped too
+                glBeginQuery(GL_SAMPLES_PASSED, passQueryIds.at(pass - 1));
+            }
+            else if (m_useOQ || m_useDepthComplexityMode)
+            {
+                glBeginQuery(GL_SAMPLES_PASSED, m_queryId);
+            }
 
-            for (MeshRenderer* const renderer : m_transparencyRendererMap)
+            if (!m_useFusedBackBlend)
             {
-                renderer->renderMesh(m_shaderDualPeel, true,
-                    [this, &prevId]()
-                    {
-                        bindTexture(m_shaderDualPeel, "DepthBlenderTex", m_dualDepthTexId.at(prevId), 0);
-                        bindTexture(m_shaderDualPeel, "FrontBlenderTex", m_dualFrontBlenderTexId.at(prevId), 1);
-                        bindTexture(m_shaderDualPeel, "OpaqueDepthTex", m_opaqueDepthTexId, 2);
-                        bindTexture(m_shaderDualPeel, "OpaqueColorTex", m_opaqueTexId, 3);
-                        //m_shaderDualPeel.setUniformValue("Width", static_cast<GLfloat>(m_width));
-                        //m_shaderDualPeel.setUniformValue("Height", static_cast<GLfloat>(m_height));
-                    },
-                    [this]()
-                    {
-                        unbindTexture(0);
-                        unbindTexture(1);
-                        unbindTexture(2);
-                        unbindTexture(3);
-                    });
+                renderBlendPass(currId);
+            }
+            else if (isNonStalling || m_useOQ || m_useDepthComplexityMode)
+            {
+                renderMaskPass(currId, true);
             }
 
-            // Full screen pass to alpha-blend the back color
-            glDrawBuffer(DRAW_BUFFERS[6]);
+            if (isNonStalling)
+            {
+                glEndQuery(GL_SAMPLES_PASSED);
+                // the synchronous readback would have waited here only if the result is not available yet
+                GLuint isAvailable{ GL_FALSE };
+                glGetQueryObjectuiv(passQueryIds.at(pass - 1), GL_QUERY_RESULT_AVAILABLE, &isAvailable);
+                if (isAvailable != GL_TRUE)
+                {
+                    m_avoidedStallCount++;
+                }
+            }
+            else if (m_useOQ || m_useDepthComplexityMode)
+            {
+                glEndQuery(GL_SAMPLES_PASSED);
+                glGetQueryObjectuiv(m_queryId, GL_QUERY_RESULT, &sampleCount);
+                if (m_useDepthComplexityMode)
+                {
+                    m_passSampleCounts.push_back(sampleCount);
+                }
+            }
 
-            glBlendEquation(GL_FUNC_ADD);
-            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+            if (m_useStencilMask)
+            {
+                // out of the occlusion query to not count the finished pixels
+                renderMaskPass(currId, false);
+            }
 
-            if (m_useOQ)
+            if (isConditional)
             {
-                glBeginQuery(GL_SAMPLES_PASSED, m_queryId);
+                glEndConditionalRender();
             }
+        }
 
-            m_shaderDualBlend.bind();
-            bindTexture(m_shaderDualBlend, "TempTex", m_dualBackTempTexId.at(currId), 0);
-            drawFullScreenQuad();
-            unbindTexture(0);
-            m_shaderDualBlend.release();
+        m_lastPassCount = pass - 1;
+        if (isNonStalling)
+        {
+            // the executed passes are known when the queries are read
+            m_passQueryCount.at(frameId) = m_lastPassCount;
+        }
+        else if (m_useDepthComplexityMode)
+        {
+            m_depthComplexityStatistics.setPassSampleCounts(m_passSampleCounts);
+        }
 
-            if (m_useOQ)
+        if (isUnpeeledQueryUsed())
+        {
+            if (m_useOQ && !isNonStalling && sampleCount == 0u)
+            {
+                // the loop has stopped by itself, the scene is fully peeled
+                m_unpeeledSampleCount = 0;
+            }
+            else
             {
+                // the min-max depth buffer of the last pass is still cleared where no layer is left, read at next frame.
+                // A pass skipped on the GPU writes no buffer: the count is skipped too after a last pass without sample
+                const bool isConditional{ isNonStalling && m_lastPassCount > 0 };
+                if (isConditional)
+                {
+                    glBeginConditionalRender(passQueryIds.at(m_lastPassCount - 1), GL_QUERY_WAIT);
+                }
+                glBeginQuery(GL_SAMPLES_PASSED, m_unpeeledQueryId);
+                renderMaskPass(currId, true);
                 glEndQuery(GL_SAMPLES_PASSED);
-                glGetQueryObjectuiv(m_queryId, GL_QUERY_RESULT, &sampleCount);
+                if (isConditional)
+                {
+                    glEndConditionalRender();
+                }
+                m_unpeeledQueryPending = true;
             }
         }
 
+        if (isTimed)
+        {
+            glQueryCounter(timerQueryIds.at(LOOP_END), GL_TIMESTAMP);
+        }
+
         glDisable(GL_BLEND);
+        if (m_useStencilMask)
+        {
+            glDisable(GL_STENCIL_TEST);
+        }
 
         // ---------------------------------------------------------------------
         // 3. Final Pass
         // ---------------------------------------------------------------------
+        beginGpuStage("final");
 
-        QOpenGLFramebufferObject::bindDefault();
-
-        m_shaderDualFinal.bind();
-        bindTexture(m_shaderDualFinal, "OpaqueTex", m_opaqueTexId, 0);
-        bindTexture(m_shaderDualFinal, "FrontBlenderTex", m_dualFrontBlenderTexId.at(currId), 1);
-        bindTexture(m_shaderDualFinal, "BackBlenderTex", m_dualBackBlenderTexId, 2);
-        drawFullScreenQuad();
-        unbindTexture(0);
-        unbindTexture(1);
-        unbindTexture(2);
-        m_shaderDualFinal.release();
+        if (m_useDepthComplexityMode)
+        {
+            renderDepthComplexity();
+        }
+        else
+        {
+            renderFinalPass(currId);
+        }
 
         glEnable(GL_DEPTH_TEST);
+
+        if (isTimed)
+        {
+            glQueryCounter(timerQueryIds.at(FRAME_END), GL_TIMESTAMP);
+            if (!isNonStalling)
+            {
+                m_timerPassCount.at(frameId) = m_lastPassCount;
+            }
+        }
+        m_frameId++;
     }
 
 }
@@ -1,8 +1,11 @@
 #pragma once
 
 #include "Renderers/UnorderedTransparency/TransparencyRenderer.h"
+#include "Renderers/UnorderedTransparency/DepthComplexityStatistics.h"
+#include "Renderers/UnorderedTransparency/PassBudgetController.h"
 
 #include <array>
+#include <vector>
 
 namespace gui::gl
 {
@@ -25,6 +28,49 @@ namespace gui::gl
         //!< Set a fixed number of passes, OpenGlQuery must be disabled
         inline void setNumberOfPasses(size_t p_number) { m_numberOfPasses = p_number; }
 
+        //!< Bound the number of passes with a GPU time budget of the transparency passes (milliseconds, 0 to disable, default)
+        //!< The budget is an upper bound for both OpenGlQuery and fixed number of passes modes
+        void setFrameTimeBudget(double p_milliseconds);
+        inline double frameTimeBudget(void) const { return m_passBudgetController.targetFrameTime(); }
+        inline size_t passBudget(void) const { return m_passBudgetController.passBudget(); } //!< pass cap of the next frame
+        inline size_t lastPassCount(void) const { return m_lastPassCount; } //!< number of peel passes issued at the last frame
+        //!< Geometry passes issued at the last frame, initialization pass included: one by peel pass, which peels two layers
+        inline size_t lastGeometryPassCount(void) const { return m_lastPassCount + 1; }
+
+        //!< Quality indicator (default false, always on with a frame time budget): pixels with layers left to peel when the
+        //!< loop stopped, 0 if the scene is fully peeled. An extra full screen pass counts them in an occlusion query after the
+        //!< last pass when the loop has not stopped by itself, the value comes from a previous frame
+        inline void setUnpeeledQueryEnable(bool p_isEnabled) { m_useUnpeeledQuery = p_isEnabled; }
+        inline bool isUnpeeledQueryUsed(void) const { return m_useUnpeeledQuery || m_passBudgetController.isEnabled(); }
+        inline GLuint unpeeledSampleCount(void) const { return m_unpeeledSampleCount; }
+
+        //!< With OpenGlQuery, do not wait for the query result after each pass (default false).
+        //!< The number of passes is predicted from the queries of a previous frame, read only when they are available,
+        //!< and each pass is skipped on the GPU by conditional rendering when the previous pass has written no sample.
+        inline void setNonStallingQueryEnable(bool p_isEnabled) { m_useNonStallingOQ = p_isEnabled; }
+        inline bool isNonStallingQueryUsed(void) const { return m_useOQ && m_useNonStallingOQ; }
+        inline size_t predictedPassCount(void) const { return m_predictedPassCount; }
+        //!< Number of passes since the creation whose query result was not available at the end of the pass in the non stalling
+        //!< mode: the synchronous readback of OpenGlQuery would have stalled the CPU there
+        inline size_t avoidedStallCount(void) const { return m_avoidedStallCount; }
+
+        //!< Stop peeling the pixels without transparent object or hidden by their front layers with a stencil mask (default false)
+        inline void setStencilMaskEnable(bool p_isEnabled) { m_useStencilMask = p_isEnabled; }
+        //!< A pixel is finished when the transmittance of its front layers is below this value (default 1/255)
+        inline void setTransmittanceEpsilon(GLfloat p_epsilon) { m_transmittanceEpsilon = p_epsilon; }
+
+        //!< Accumulate the back layers in the peel pass instead of a full screen blend pass after each peel pass (default false).
+        //!< The termination query is then done on a lighter full screen pass which only reads the depth, and is skipped without OpenGlQuery.
+        inline void setFusedBackBlendEnable(bool p_isEnabled) { m_useFusedBackBlend = p_isEnabled; }
+
+        //!< Diagnostic mode (default false): an extra pass counts the transparent fragments of each pixel, the frame shows
+        //!< them as a heatmap instead of the transparency and their histogram is reduced on the GPU and read back (stall).
+        //!< The samples of each peel pass are queried too, and the non stalling prediction never goes under the measured depth.
+        inline void setDepthComplexityModeEnable(bool p_isEnabled) { m_useDepthComplexityMode = p_isEnabled; m_depthComplexityStatistics.reset(); }
+        inline bool isDepthComplexityMode(void) const { return m_useDepthComplexityMode; }
+        //!< Statistics of the last frame rendered in depth complexity mode
+        inline const DepthComplexityStatistics& depthComplexityStatistics(void) const { return m_depthComplexityStatistics; }
+
     protected:
         bool isOtherGlFunctionsInitialized(void) const override;
         bool updateOtherGlFunctions(void) override;
@@ -38,26 +84,87 @@ namespace gui::gl
         bool initTransparentRenderTargets() override;
         void deleteRenderTargets(void) override;
 
-        inline bool isShadersInitialized(void) const override { return (m_shaderDualInit.isLinked() && m_shaderDualPeel.isLinked() && m_shaderDualBlend.isLinked() && m_shaderDualFinal.isLinked()); }
+        inline bool isShadersInitialized(void) const override
+        {
+            return (m_shaderDualInit.isLinked() && m_shaderDualPeel.isLinked() && m_shaderDualBlend.isLinked() && m_shaderDualFinal.isLinked() && m_shaderDualClear.isLinked() && m_shaderDualMask.isLinked()
+                && m_shaderComplexityCount.isLinked() && m_shaderComplexityHistogram.isLinked() && m_shaderComplexityHeatmap.isLinked());
+        }
         bool initShaders(void) override;
         void deleteShaders(void) override;
 
     private:
-        QOpenGLShaderProgram m_shaderDualInit;
-        QOpenGLShaderProgram m_shaderDualPeel;
-        QOpenGLShaderProgram m_shaderDualBlend;
-        QOpenGLShaderProgram m_shaderDualFinal;
+        size_t maxPassCount(void) const; //!< pass cap of the current frame
+
+        void renderPeelPass(size_t p_currId); //!< peel the front and back layers
+        void renderBlendPass(size_t p_currId); //!< blend the back layer
+        //!< remove the finished pixels from the stencil mask, or count the pixels with layers left if @a p_countRemaining
+        void renderMaskPass(size_t p_currId, bool p_countRemaining);
+        void renderFinalPass(size_t p_currId);
+        void renderDepthComplexity(void); //!< count, reduce and show the transparent fragments instead of the final pass
+        void logDepthComplexityStatistics(void) const;
+
+        void readTimerQueries(void);
+        void readUnpeeledQuery(void);
+        void readPassQueries(void); //!< update the predicted number of passes with the oldest available frame
+
+        ShaderProgram m_shaderDualInit;
+        ShaderProgram m_shaderDualPeel;
+        ShaderProgram m_shaderDualBlend;
+        ShaderProgram m_shaderDualFinal;
+        ShaderProgram m_shaderDualClear;
+        ShaderProgram m_shaderDualMask;
+        ShaderProgram m_shaderComplexityCount;
+        ShaderProgram m_shaderComplexityHistogram;
+        ShaderProgram m_shaderComplexityHeatmap;
 
         bool m_useOQ;
         GLuint m_queryId;
         size_t m_numberOfPasses;
 
+        PassBudgetController m_passBudgetController;
+        size_t m_lastPassCount;
+        bool m_useUnpeeledQuery;
+        GLuint m_unpeeledSampleCount;
+        GLuint m_unpeeledQueryId; //!< pixels with layers left after the last pass
+        bool m_unpeeledQueryPending;
+
+        //!< Timestamps (start, peel loop start, peel loop end, end) of the last frames, read when they are available to not stall the GPU
+        static constexpr size_t PENDING_FRAME_COUNT = 3;
+        enum TimeStamp { FRAME_START, LOOP_START, LOOP_END, FRAME_END, TIMESTAMP_COUNT };
+        std::array<std::array<GLuint, TIMESTAMP_COUNT>, PENDING_FRAME_COUNT> m_timerQueryIds;
+        std::array<size_t, PENDING_FRAME_COUNT> m_timerPassCount; //!< 0 if the frame has not been measured
+        size_t m_frameId;
+
+        bool m_useNonStallingOQ;
+        std::array<std::vector<GLuint>, PENDING_FRAME_COUNT> m_passQueryIds; //!< one query by pass of the last frames
+        std::array<size_t, PENDING_FRAME_COUNT> m_passQueryCount; //!< number of issued passes, 0 if the frame has not been queried
+        size_t m_predictedPassCount;
+        size_t m_avoidedStallCount;
+
+        static constexpr size_t INITIAL_PREDICTED_PASS_COUNT = 8;
+
+        bool m_useStencilMask;
+        GLfloat m_transmittanceEpsilon;
+
+        bool m_useFusedBackBlend;
+
+        bool m_useDepthComplexityMode;
+        DepthComplexityStatistics m_depthComplexityStatistics;
+        std::vector<GLuint> m_passSampleCounts; //!< of the current frame in depth complexity mode
+        GLuint m_complexityFboId; //!< opaque depth texture is attached to reject hidden fragments
+        GLuint m_complexityTexId; //!< transparent fragments by pixel
+        GLuint m_histogramFboId;
+        GLuint m_histogramTexId; //!< HISTOGRAM_BIN_COUNT bins, then the max
+        GLuint m_histogramVertexArrayId; //!< empty, the histogram points are generated from gl_VertexID
+        static constexpr int HISTOGRAM_BIN_COUNT = 64;
+
         //GLuint m_dualBackBlenderFboId;
         GLuint m_dualPeelingSingleFboId;
         GLuint m_dualBackBlenderTexId;
         std::array<GLuint, 2> m_dualDepthTexId;
         std::array<GLuint, 2> m_dualFrontBlenderTexId;
         std::array<GLuint, 2> m_dualBackTempTexId;
+        GLuint m_dualStencilRenderbufferId; //!< transmittance mask
 
         static constexpr GLfloat MAX_DEPTH = 1.f;
         static constexpr std::array<GLenum, 7> DRAW_BUFFERS{
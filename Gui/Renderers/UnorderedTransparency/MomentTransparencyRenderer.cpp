@@ -0,0 +1,261 @@
+#include "Renderers/UnorderedTransparency/MomentTransparencyRenderer.h"
+
+#include "GLWidgets/Camera.h"
+#include "GLWidgets/Scene.h"
+
+#include <QtCore/QDebug>
+
+namespace gui::gl
+{
+
+    //---------------------------------------------------------------------------------------
+    MomentTransparencyRenderer::MomentTransparencyRenderer(const Scene& p_scene, const Camera& p_camera) : TransparencyRenderer(p_scene, p_camera)
+        , m_momentCount(4)
+        , m_useHalfPrecision(false)
+        , m_momentDepthRange(0.f, 1.f)
+        , m_momentFboId(0)
+        , m_opticalDepthTexId(0)
+        , m_moments1234TexId(0)
+        , m_moments56TexId(0)
+        , m_accumulationTexId(0)
+    //---------------------------------------------------------------------------------------
+    {
+    }
+
+    //---------------------------------------------------------------------------------------
+    MomentTransparencyRenderer::~MomentTransparencyRenderer(void)
+    //---------------------------------------------------------------------------------------
+    {
+    }
+
+    //---------------------------------------------------------------------------------------
+    void MomentTransparencyRenderer::setMomentCount(int p_count)
+    //---------------------------------------------------------------------------------------
+    {
+        if (p_count != 4 && p_count != 6)
+        {
+            qCritical() << "Only 4 or 6 moments are supported, not" << p_count;
+            return;
+        }
+
+        m_momentCount = p_count;
+    }
+
+    //---------------------------------------------------------------------------------------
+    void MomentTransparencyRenderer::setHalfPrecisionEnable(bool p_isEnabled)
+    //---------------------------------------------------------------------------------------
+    {
+        if (m_useHalfPrecision != p_isEnabled)
+        {
+            m_useHalfPrecision = p_isEnabled;
+            requestUpdateRenderTargets();
+        }
+    }
+
+    //---------------------------------------------------------------------------------------
+    GLfloat MomentTransparencyRenderer::momentBias(void) const
+    //---------------------------------------------------------------------------------------
+    {
+        // values of the paper for power moments
+        if (m_momentCount == 6)
+        {
+            return m_useHalfPrecision ? 6e-4f : 5e-6f;
+        }
+        return m_useHalfPrecision ? 6e-5f : 5e-7f;
+    }
+
+    //---------------------------------------------------------------------------------------
+    bool MomentTransparencyRenderer::isRenderTargetsInitialized(void) const
+    //---------------------------------------------------------------------------------------
+    {
+        if (!TransparencyRenderer::isRenderTargetsInitialized())
+        {
+            return false;
+        }
+
+        return (m_momentFboId != 0u && m_opticalDepthTexId != 0u && m_moments1234TexId != 0u && m_moments56TexId != 0u && m_accumulationTexId != 0u);
+    }
+
+    //---------------------------------------------------------------------------------------
+    void MomentTransparencyRenderer::allocateTextures(void)
+    //---------------------------------------------------------------------------------------
+    {
+        glBindTexture(USING_GL_TEXTURE, m_opticalDepthTexId);
+        glTexImage2D(USING_GL_TEXTURE, 0, m_useHalfPrecision ? GL_R16F : GL_R32F, m_width, m_height, 0, GL_RED, GL_FLOAT, nullptr);
+
+        glBindTexture(USING_GL_TEXTURE, m_moments1234TexId);
+        glTexImage2D(USING_GL_TEXTURE, 0, m_useHalfPrecision ? GL_RGBA16F : GL_RGBA32F, m_width, m_height, 0, GL_RGBA, GL_FLOAT, nullptr);
+
+        glBindTexture(USING_GL_TEXTURE, m_moments56TexId);
+        glTexImage2D(USING_GL_TEXTURE, 0, m_useHalfPrecision ? GL_RG16F : GL_RG32F, m_width, m_height, 0, GL_RG, GL_FLOAT, nullptr);
+
+        glBindTexture(USING_GL_TEXTURE, m_accumulationTexId);
+        glTexImage2D(USING_GL_TEXTURE, 0, m_useHalfPrecision ? GL_RGBA16F : GL_RGBA32F, m_width, m_height, 0, GL_RGBA, GL_FLOAT, nullptr);
+    }
+
+    //---------------------------------------------------------------------------------------
+    bool MomentTransparencyRenderer::updateTransparentRenderTargets()
+    //---------------------------------------------------------------------------------------
+    {
+        allocateTextures();
+        return true;
+    }
+
+    //---------------------------------------------------------------------------------------
+    bool MomentTransparencyRenderer::initTransparentRenderTargets()
+    //---------------------------------------------------------------------------------------
+    {
+        glGenTextures(1, &m_opticalDepthTexId);
+        glGenTextures(1, &m_moments1234TexId);
+        glGenTextures(1, &m_moments56TexId);
+        glGenTextures(1, &m_accumulationTexId);
+
+        for (const GLuint texId : { m_opticalDepthTexId, m_moments1234TexId, m_moments56TexId, m_accumulationTexId })
+        {
+            glBindTexture(USING_GL_TEXTURE, texId);
+            glTexParameteri(USING_GL_TEXTURE, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+            glTexParameteri(USING_GL_TEXTURE, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+            glTexParameteri(USING_GL_TEXTURE, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+            glTexParameteri(USING_GL_TEXTURE, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        }
+        allocateTextures();
+
+        glGenFramebuffers(1, &m_momentFboId);
+        glBindFramebuffer(GL_FRAMEBUFFER, m_momentFboId);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, USING_GL_TEXTURE, m_opticalDepthTexId, 0);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, USING_GL_TEXTURE, m_moments1234TexId, 0);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT2, USING_GL_TEXTURE, m_moments56TexId, 0);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT3, USING_GL_TEXTURE, m_accumulationTexId, 0);
+
+        // the depth test rejects the transparent fragments behind the opaque objects, without writing the depth
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, USING_GL_TEXTURE, m_opaqueDepthTexId, 0);
+
+        return true;
+    }
+
+    //---------------------------------------------------------------------------------------
+    void MomentTransparencyRenderer::deleteRenderTargets(void)
+    //---------------------------------------------------------------------------------------
+    {
+        TransparencyRenderer::deleteRenderTargets();
+
+        glDeleteFramebuffers(1, &m_momentFboId);
+        glDeleteTextures(1, &m_opticalDepthTexId);
+        glDeleteTextures(1, &m_moments1234TexId);
+        glDeleteTextures(1, &m_moments56TexId);
+        glDeleteTextures(1, &m_accumulationTexId);
+    }
+
+    //---------------------------------------------------------------------------------------
+    bool MomentTransparencyRenderer::initShaders(void)
+    //---------------------------------------------------------------------------------------
+    {
+        bool isOk{ loadShaders(m_shaderGenerate,
+            { MultipleLightsRenderer::shadeVertex(), "Shaders:UnorderedTransparency/peel_vertex.glsl" },
+            { MultipleLightsRenderer::shadeFragment(), "Shaders:UnorderedTransparency/moment_generate_fragment.glsl" })
+        };
+
+        isOk &= loadShaders(m_shaderResolve,
+            { MultipleLightsRenderer::shadeVertex(), "Shaders:UnorderedTransparency/peel_vertex.glsl" },
+            { MultipleLightsRenderer::shadeFragment(), "Shaders:UnorderedTransparency/moment_math.glsl", "Shaders:UnorderedTransparency/moment_resolve_fragment.glsl" });
+
+        isOk &= loadShaders(m_shaderComposite, { quadVertex() }, { "Shaders:UnorderedTransparency/moment_composite_fragment.glsl" });
+
+        return isOk;
+    }
+
+    //---------------------------------------------------------------------------------------
+    void MomentTransparencyRenderer::deleteShaders(void)
+    //---------------------------------------------------------------------------------------
+    {
+        m_shaderGenerate.removeAllShaders();
+        m_shaderResolve.removeAllShaders();
+        m_shaderComposite.removeAllShaders();
+    }
+
+    //---------------------------------------------------------------------------------------
+    void MomentTransparencyRenderer::renderTransparentObjects(void)
+    //---------------------------------------------------------------------------------------
+    {
+        const GLsizei momentBufferCount{ m_momentCount > 4 ? 3 : 2 };
+
+        glBindFramebuffer(GL_FRAMEBUFFER, m_momentFboId);
+        glDrawBuffers(4, DRAW_BUFFERS.data());
+        glClearColor(0, 0, 0, 0);
+        glClear(GL_COLOR_BUFFER_BIT);
+
+        glEnable(GL_DEPTH_TEST);
+        glDepthMask(GL_FALSE);
+        glEnable(GL_BLEND);
+        glBlendEquation(GL_FUNC_ADD);
+        glBlendFunc(GL_ONE, GL_ONE);
+
+        // ---------------------------------------------------------------------
+        // 1. Sum the moments of the optical depth
+        // ---------------------------------------------------------------------
+        beginGpuStage("moments");
+
+        glDrawBuffers(momentBufferCount, DRAW_BUFFERS.data());
+        for (MeshRenderer* const renderer : m_transparencyRendererMap)
+        {
+            renderer->renderMesh(m_shaderGenerate, true,
+                [this]()
+                {
+                    m_shaderGenerate.setUniformValue("DepthRange", m_momentDepthRange);
+                    m_shaderGenerate.setUniformValue("MomentCount", m_momentCount);
+                });
+        }
+
+        // ---------------------------------------------------------------------
+        // 2. Sum the colors weighted by the reconstructed transmittance
+        // ---------------------------------------------------------------------
+        beginGpuStage("colors");
+
+        glDrawBuffer(DRAW_BUFFERS[3]);
+        const GLfloat bias{ momentBias() };
+        for (MeshRenderer* const renderer : m_transparencyRendererMap)
+        {
+            renderer->renderMesh(m_shaderResolve, true,
+                [this, &bias]()
+                {
+                    m_shaderResolve.setUniformValue("DepthRange", m_momentDepthRange);
+                    m_shaderResolve.setUniformValue("MomentCount", m_momentCount);
+                    m_shaderResolve.setUniformValue("MomentBias", bias);
+                    bindTexture(m_shaderResolve, "OpticalDepthTex", m_opticalDepthTexId, 0);
+                    bindTexture(m_shaderResolve, "Moments1234Tex", m_moments1234TexId, 1);
+                    bindTexture(m_shaderResolve, "Moments56Tex", m_moments56TexId, 2);
+                },
+                [this]()
+                {
+                    unbindTexture(0);
+                    unbindTexture(1);
+                    unbindTexture(2);
+                });
+        }
+
+        glDepthMask(GL_TRUE);
+        glDisable(GL_DEPTH_TEST);
+
+        // ---------------------------------------------------------------------
+        // 3. Composite with the opaque objects
+        // ---------------------------------------------------------------------
+        beginGpuStage("final");
+
+        bindOutputFramebuffer();
+        glDisable(GL_BLEND);
+
+        m_shaderComposite.bind();
+        m_shaderComposite.setUniformValue("BackgroundColor", m_backgroundColor);
+        bindTexture(m_shaderComposite, "OpaqueTex", m_opaqueTexId, 0);
+        bindTexture(m_shaderComposite, "OpticalDepthTex", m_opticalDepthTexId, 1);
+        bindTexture(m_shaderComposite, "AccumulationTex", m_accumulationTexId, 2);
+        drawFullScreenQuad();
+        unbindTexture(0);
+        unbindTexture(1);
+        unbindTexture(2);
+        m_shaderComposite.release();
+
+        glEnable(GL_DEPTH_TEST);
+    }
+
+}
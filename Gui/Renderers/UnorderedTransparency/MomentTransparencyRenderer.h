@@ -0,0 +1,78 @@
+#pragma once
+
+#include "Renderers/UnorderedTransparency/TransparencyRenderer.h"
+
+#include <QtGui/QVector2D>
+
+#include <array>
+
+namespace gui::gl
+{
+
+    /*
+     * \class MomentTransparencyRenderer
+     * \brief Render a RMeshModel with transparency
+     *
+     * Class to make approximated independent transparency with Moment-Based OIT (Münstermann et al.):
+     * a first geometry pass sums the power moments of the optical depth, a second shaded geometry pass weights
+     * each fragment by the transmittance reconstructed from the moments, then one full screen pass composites them.
+     * The cost is two geometry passes whatever the depth complexity.
+     *
+    */
+    class MomentTransparencyRenderer final : public TransparencyRenderer
+    {
+    public:
+        explicit MomentTransparencyRenderer(const Scene& p_scene, const Camera& p_camera);
+        virtual ~MomentTransparencyRenderer(void);
+
+        //!< Number of power moments, 4 or 6 (default 4)
+        void setMomentCount(int p_count);
+        inline int momentCount(void) const { return m_momentCount; }
+        //!< Store the moments in 16 bits floats instead of 32 bits (default false), the reconstruction is more biased
+        void setHalfPrecisionEnable(bool p_isEnabled);
+
+        //!< Window depth range mapped to the moments depth [-1, 1] (default [0, 1])
+        //!< Set it close to the depth range of the transparent objects for a better precision
+        inline void setMomentDepthRange(GLfloat p_near, GLfloat p_far) { m_momentDepthRange = QVector2D(p_near, p_far); }
+
+    protected:
+        void renderTransparentObjects(void) override;
+
+        bool isRenderTargetsInitialized(void) const override;
+        bool updateTransparentRenderTargets() override;
+        bool initTransparentRenderTargets() override;
+        void deleteRenderTargets(void) override;
+
+        inline bool isShadersInitialized(void) const override { return (m_shaderGenerate.isLinked() && m_shaderResolve.isLinked() && m_shaderComposite.isLinked()); }
+        bool initShaders(void) override;
+        void deleteShaders(void) override;
+
+    private:
+        GLfloat momentBias(void) const; //!< smallest bias which keeps the reconstruction stable with the storage precision
+        void allocateTextures(void);
+
+        ShaderProgram m_shaderGenerate;
+        ShaderProgram m_shaderResolve;
+        ShaderProgram m_shaderComposite;
+
+        int m_momentCount;
+        bool m_useHalfPrecision;
+        QVector2D m_momentDepthRange;
+
+        GLuint m_momentFboId; //!< opaque depth texture is attached to reject hidden fragments
+        GLuint m_opticalDepthTexId; //!< sum(-ln(1 - alpha))
+        GLuint m_moments1234TexId; //!< sum(opticalDepth * z^k), k in [1, 4]
+        GLuint m_moments56TexId; //!< sum(opticalDepth * z^k), k in [5, 6], unused with 4 moments
+        GLuint m_accumulationTexId; //!< sum(transmittance * (color * alpha, alpha))
+
+        static constexpr std::array<GLenum, 4> DRAW_BUFFERS{
+            GL_COLOR_ATTACHMENT0,
+            GL_COLOR_ATTACHMENT1,
+            GL_COLOR_ATTACHMENT2,
+            GL_COLOR_ATTACHMENT3
+        };
+
+        Q_DISABLE_COPY_MOVE(MomentTransparencyRenderer);
+    };
+
+}
@@ -0,0 +1,423 @@
+#include "Renderers/UnorderedTransparency/MultiLayerPeelingRenderer.h"
+
+#include "GLWidgets/Camera.h"
+#include "GLWidgets/Scene.h"
+
+#include <QtCore/QDebug>
+
+#include <algorithm>
+#include <vector>
+
+namespace gui::gl
+{
+
+    //---------------------------------------------------------------------------------------
+    MultiLayerPeelingRenderer::MultiLayerPeelingRenderer(const Scene& p_scene, const Camera& p_camera) : TransparencyRenderer(p_scene, p_camera)
+        , m_layersPerPass(MAX_LAYERS_PER_PASS)
+        , m_useOQ(true)
+        , m_queryId(0)
+        , m_numberOfPasses(4)
+        , m_lastGeometryPassCount(0)
+        , m_depthFboId(0)
+        , m_colorFboId(0)
+        , m_mergeFboId(0)
+        , m_minMaxDepthTexId(0)
+        , m_bucketDepthTexId{}
+        , m_layerColorTexId{}
+        , m_missedDepthTexId(0)
+        , m_accumulationTexId{}
+        , m_peeledDepthTexId{}
+    //---------------------------------------------------------------------------------------
+    {
+    }
+
+    //---------------------------------------------------------------------------------------
+    MultiLayerPeelingRenderer::~MultiLayerPeelingRenderer(void)
+    //---------------------------------------------------------------------------------------
+    {
+    }
+
+    //---------------------------------------------------------------------------------------
+    void MultiLayerPeelingRenderer::setLayersPerPass(int p_count)
+    //---------------------------------------------------------------------------------------
+    {
+        if (p_count < 1 || p_count > MAX_LAYERS_PER_PASS)
+        {
+            qCritical() << "The number of layers by pass must be in [1," << MAX_LAYERS_PER_PASS << "], not" << p_count;
+            return;
+        }
+
+        m_layersPerPass = p_count;
+    }
+
+    //---------------------------------------------------------------------------------------
+    bool MultiLayerPeelingRenderer::isOtherGlFunctionsInitialized(void) const
+    //---------------------------------------------------------------------------------------
+    {
+        if (!TransparencyRenderer::isOtherGlFunctionsInitialized())
+        {
+            return false;
+        }
+
+        return (m_queryId != 0u);
+    }
+
+    //---------------------------------------------------------------------------------------
+    bool MultiLayerPeelingRenderer::updateOtherGlFunctions(void)
+    //---------------------------------------------------------------------------------------
+    {
+        return TransparencyRenderer::updateOtherGlFunctions();
+    }
+
+    //---------------------------------------------------------------------------------------
+    bool MultiLayerPeelingRenderer::initOtherGlFunctions(void)
+    //---------------------------------------------------------------------------------------
+    {
+        if (!TransparencyRenderer::initOtherGlFunctions())
+        {
+            return false;
+        }
+
+        glGenQueries(1, &m_queryId);
+        return true;
+    }
+
+    //---------------------------------------------------------------------------------------
+    void MultiLayerPeelingRenderer::deleteOtherGlFunctions(void)
+    //---------------------------------------------------------------------------------------
+    {
+        TransparencyRenderer::deleteOtherGlFunctions();
+
+        glDeleteQueries(1, &m_queryId);
+    }
+
+    //---------------------------------------------------------------------------------------
+    bool MultiLayerPeelingRenderer::isRenderTargetsInitialized(void) const
+    //---------------------------------------------------------------------------------------
+    {
+        if (!TransparencyRenderer::isRenderTargetsInitialized())
+        {
+            return false;
+        }
+
+        return (m_depthFboId != 0u && m_colorFboId != 0u && m_mergeFboId != 0u && m_minMaxDepthTexId != 0u && m_missedDepthTexId != 0u);
+    }
+
+    //---------------------------------------------------------------------------------------
+    void MultiLayerPeelingRenderer::allocateTextures(void)
+    //---------------------------------------------------------------------------------------
+    {
+        glBindTexture(USING_GL_TEXTURE, m_minMaxDepthTexId);
+        glTexImage2D(USING_GL_TEXTURE, 0, GL_RG32F, m_width, m_height, 0, GL_RG, GL_FLOAT, nullptr);
+
+        for (const GLuint texId : m_bucketDepthTexId)
+        {
+            glBindTexture(USING_GL_TEXTURE, texId);
+            glTexImage2D(USING_GL_TEXTURE, 0, GL_RGBA32F, m_width, m_height, 0, GL_RGBA, GL_FLOAT, nullptr);
+        }
+
+        for (const GLuint texId : m_layerColorTexId)
+        {
+            glBindTexture(USING_GL_TEXTURE, texId);
+            glTexImage2D(USING_GL_TEXTURE, 0, GL_RGBA16F, m_width, m_height, 0, GL_RGBA, GL_FLOAT, nullptr);
+        }
+
+        glBindTexture(USING_GL_TEXTURE, m_missedDepthTexId);
+        glTexImage2D(USING_GL_TEXTURE, 0, GL_R32F, m_width, m_height, 0, GL_RED, GL_FLOAT, nullptr);
+
+        for (size_t i = 0; i < 2; i++)
+        {
+            glBindTexture(USING_GL_TEXTURE, m_accumulationTexId[i]);
+            glTexImage2D(USING_GL_TEXTURE, 0, GL_RGBA32F, m_width, m_height, 0, GL_RGBA, GL_FLOAT, nullptr);
+
+            glBindTexture(USING_GL_TEXTURE, m_peeledDepthTexId[i]);
+            glTexImage2D(USING_GL_TEXTURE, 0, GL_R32F, m_width, m_height, 0, GL_RED, GL_FLOAT, nullptr);
+        }
+    }
+
+    //---------------------------------------------------------------------------------------
+    bool MultiLayerPeelingRenderer::updateTransparentRenderTargets()
+    //---------------------------------------------------------------------------------------
+    {
+        allocateTextures();
+        return true;
+    }
+
+    //---------------------------------------------------------------------------------------
+    bool MultiLayerPeelingRenderer::initTransparentRenderTargets()
+    //---------------------------------------------------------------------------------------
+    {
+        glGenTextures(1, &m_minMaxDepthTexId);
+        glGenTextures(2, m_bucketDepthTexId.data());
+        glGenTextures(MAX_LAYERS_PER_PASS, m_layerColorTexId.data());
+        glGenTextures(1, &m_missedDepthTexId);
+        glGenTextures(2, m_accumulationTexId.data());
+        glGenTextures(2, m_peeledDepthTexId.data());
+
+        std::vector<GLuint> texIds{ m_minMaxDepthTexId, m_missedDepthTexId };
+        texIds.insert(texIds.end(), m_bucketDepthTexId.cbegin(), m_bucketDepthTexId.cend());
+        texIds.insert(texIds.end(), m_layerColorTexId.cbegin(), m_layerColorTexId.cend());
+        texIds.insert(texIds.end(), m_accumulationTexId.cbegin(), m_accumulationTexId.cend());
+        texIds.insert(texIds.end(), m_peeledDepthTexId.cbegin(), m_peeledDepthTexId.cend());
+        for (const GLuint texId : texIds)
+        {
+            glBindTexture(USING_GL_TEXTURE, texId);
+            glTexParameteri(USING_GL_TEXTURE, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+            glTexParameteri(USING_GL_TEXTURE, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+            glTexParameteri(USING_GL_TEXTURE, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+            glTexParameteri(USING_GL_TEXTURE, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        }
+        allocateTextures();
+
+        // min max depth and bucket depths
+        glGenFramebuffers(1, &m_depthFboId);
+        glBindFramebuffer(GL_FRAMEBUFFER, m_depthFboId);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, USING_GL_TEXTURE, m_minMaxDepthTexId, 0);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, USING_GL_TEXTURE, m_bucketDepthTexId[0], 0);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT2, USING_GL_TEXTURE, m_bucketDepthTexId[1], 0);
+
+        // one color by bucket and the missed depth
+        glGenFramebuffers(1, &m_colorFboId);
+        glBindFramebuffer(GL_FRAMEBUFFER, m_colorFboId);
+        for (size_t i = 0; i < m_layerColorTexId.size(); i++)
+        {
+            glFramebufferTexture2D(GL_FRAMEBUFFER, DRAW_BUFFERS.at(i), USING_GL_TEXTURE, m_layerColorTexId.at(i), 0);
+        }
+        glFramebufferTexture2D(GL_FRAMEBUFFER, DRAW_BUFFERS.at(MAX_LAYERS_PER_PASS), USING_GL_TEXTURE, m_missedDepthTexId, 0);
+
+        // ping pong accumulation and peeled depth
+        glGenFramebuffers(1, &m_mergeFboId);
+        glBindFramebuffer(GL_FRAMEBUFFER, m_mergeFboId);
+        for (size_t i = 0; i < 2; i++)
+        {
+            glFramebufferTexture2D(GL_FRAMEBUFFER, DRAW_BUFFERS.at(2 * i + 0), USING_GL_TEXTURE, m_accumulationTexId[i], 0);
+            glFramebufferTexture2D(GL_FRAMEBUFFER, DRAW_BUFFERS.at(2 * i + 1), USING_GL_TEXTURE, m_peeledDepthTexId[i], 0);
+        }
+
+        return true;
+    }
+
+    //---------------------------------------------------------------------------------------
+    void MultiLayerPeelingRenderer::deleteRenderTargets(void)
+    //---------------------------------------------------------------------------------------
+    {
+        TransparencyRenderer::deleteRenderTargets();
+
+        glDeleteFramebuffers(1, &m_depthFboId);
+        glDeleteFramebuffers(1, &m_colorFboId);
+        glDeleteFramebuffers(1, &m_mergeFboId);
+
+        glDeleteTextures(1, &m_minMaxDepthTexId);
+        glDeleteTextures(2, m_bucketDepthTexId.data());
+        glDeleteTextures(MAX_LAYERS_PER_PASS, m_layerColorTexId.data());
+        glDeleteTextures(1, &m_missedDepthTexId);
+        glDeleteTextures(2, m_accumulationTexId.data());
+        glDeleteTextures(2, m_peeledDepthTexId.data());
+    }
+
+    //---------------------------------------------------------------------------------------
+    bool MultiLayerPeelingRenderer::initShaders(void)
+    //---------------------------------------------------------------------------------------
+    {
+        bool isOk{ loadShaders(m_shaderInit,
+            { "Shaders:UnorderedTransparency/init_vertex.glsl" },
+            { "Shaders:UnorderedTransparency/init_fragment.glsl" })
+        };
+
+        isOk &= loadShaders(m_shaderDepth,
+            { "Shaders:UnorderedTransparency/init_vertex.glsl" },
+            { "Shaders:UnorderedTransparency/multilayer_bucket.glsl", "Shaders:UnorderedTransparency/multilayer_depth_fragment.glsl" });
+
+        isOk &= loadShaders(m_shaderColor,
+            { MultipleLightsRenderer::shadeVertex(), "Shaders:UnorderedTransparency/peel_vertex.glsl" },
+            { MultipleLightsRenderer::shadeFragment(), "Shaders:UnorderedTransparency/multilayer_bucket.glsl", "Shaders:UnorderedTransparency/multilayer_color_fragment.glsl" });
+
+        isOk &= loadShaders(m_shaderMerge, { quadVertex() }, { "Shaders:UnorderedTransparency/multilayer_merge_fragment.glsl" });
+
+        isOk &= loadShaders(m_shaderFinal, { quadVertex() }, { "Shaders:UnorderedTransparency/multilayer_final_fragment.glsl" });
+
+        return isOk;
+    }
+
+    //---------------------------------------------------------------------------------------
+    void MultiLayerPeelingRenderer::deleteShaders(void)
+    //---------------------------------------------------------------------------------------
+    {
+        m_shaderInit.removeAllShaders();
+        m_shaderDepth.removeAllShaders();
+        m_shaderColor.removeAllShaders();
+        m_shaderMerge.removeAllShaders();
+        m_shaderFinal.removeAllShaders();
+    }
+
+    //---------------------------------------------------------------------------------------
+    void MultiLayerPeelingRenderer::bindBucketTextures(ShaderProgram& p_program, size_t p_currId)
+    //---------------------------------------------------------------------------------------
+    {
+        bindTexture(p_program, "MinMaxDepthTex", m_minMaxDepthTexId, 0);
+        bindTexture(p_program, "PeeledDepthTex", m_peeledDepthTexId.at(p_currId), 1);
+        bindTexture(p_program, "OpaqueDepthTex", m_opaqueDepthTexId, 2);
+        p_program.setUniformValue("LayerCount", m_layersPerPass);
+    }
+
+    //---------------------------------------------------------------------------------------
+    void MultiLayerPeelingRenderer::renderTransparentObjects(void)
+    //---------------------------------------------------------------------------------------
+    {
+        glDisable(GL_DEPTH_TEST);
+        glEnable(GL_BLEND);
+
+        // ---------------------------------------------------------------------
+        // 1. Initialize Min-Max Depth Buffer and the accumulation
+        // ---------------------------------------------------------------------
+        beginGpuStage("init");
+
+        glBindFramebuffer(GL_FRAMEBUFFER, m_depthFboId);
+        glDrawBuffer(DRAW_BUFFERS[0]);
+        glClearColor(-MAX_DEPTH, -MAX_DEPTH, 0, 0);
+        glClear(GL_COLOR_BUFFER_BIT);
+        glBlendEquation(GL_MAX);
+
+        for (MeshRenderer* const renderer : m_transparencyRendererMap)
+        {
+            renderer->renderMesh(m_shaderInit, false);
+        }
+        m_lastGeometryPassCount = 1;
+
+        glBindFramebuffer(GL_FRAMEBUFFER, m_mergeFboId);
+        glDrawBuffer(DRAW_BUFFERS[0]);
+        glClearColor(0, 0, 0, 1);
+        glClear(GL_COLOR_BUFFER_BIT);
+        glDrawBuffer(DRAW_BUFFERS[1]);
+        glClearColor(-MAX_DEPTH, -MAX_DEPTH, -MAX_DEPTH, -MAX_DEPTH);
+        glClear(GL_COLOR_BUFFER_BIT);
+
+        // ---------------------------------------------------------------------
+        // 2. Multi-Layer Peeling + Blending
+        // ---------------------------------------------------------------------
+
+        size_t currId{ 0 };
+        const size_t maxPass{ m_useOQ ? MAX_PASSES : std::min(m_numberOfPasses, MAX_PASSES) };
+        for (size_t pass = 0; pass < maxPass; pass++)
+        {
+            // Nearest depth of each bucket, MAX blending of -depth
+            beginGpuStage("peel depth", pass + 1);
+            glBindFramebuffer(GL_FRAMEBUFFER, m_depthFboId);
+            glDrawBuffers(2, &DRAW_BUFFERS[1]);
+            glClearColor(NO_DEPTH, NO_DEPTH, NO_DEPTH, NO_DEPTH);
+            glClear(GL_COLOR_BUFFER_BIT);
+
+            if (m_useOQ)
+            {
+                glBeginQuery(GL_SAMPLES_PASSED, m_queryId);
+            }
+
+            for (MeshRenderer* const renderer : m_transparencyRendererMap)
+            {
+                renderer->renderMesh(m_shaderDepth, false,
+                    [this, &currId]()
+                    {
+                        bindBucketTextures(m_shaderDepth, currId);
+                    },
+                    [this]()
+                    {
+                        unbindTexture(0);
+                        unbindTexture(1);
+                        unbindTexture(2);
+                    });
+            }
+            m_lastGeometryPassCount++;
+
+            if (m_useOQ)
+            {
+                glEndQuery(GL_SAMPLES_PASSED);
+                GLuint sampleCount{ 0 };
+                glGetQueryObjectuiv(m_queryId, GL_QUERY_RESULT, &sampleCount);
+                if (sampleCount == 0)
+                {
+                    break;
+                }
+            }
+
+            // Color of the captured fragments, nearest depth of the missed ones
+            beginGpuStage("peel color", pass + 1);
+            glBindFramebuffer(GL_FRAMEBUFFER, m_colorFboId);
+            glDrawBuffers(MAX_LAYERS_PER_PASS, DRAW_BUFFERS.data());
+            glClearColor(0, 0, 0, 0);
+            glClear(GL_COLOR_BUFFER_BIT);
+            glDrawBuffer(DRAW_BUFFERS[MAX_LAYERS_PER_PASS]);
+            glClearColor(NO_DEPTH, NO_DEPTH, NO_DEPTH, NO_DEPTH);
+            glClear(GL_COLOR_BUFFER_BIT);
+            glDrawBuffers(MAX_LAYERS_PER_PASS + 1, DRAW_BUFFERS.data());
+
+            for (MeshRenderer* const renderer : m_transparencyRendererMap)
+            {
+                renderer->renderMesh(m_shaderColor, true,
+                    [this, &currId]()
+                    {
+                        bindBucketTextures(m_shaderColor, currId);
+                        bindTexture(m_shaderColor, "BucketDepth0123Tex", m_bucketDepthTexId[0], 3);
+                        bindTexture(m_shaderColor, "BucketDepth456Tex", m_bucketDepthTexId[1], 4);
+                    },
+                    [this]()
+                    {
+                        unbindTexture(0);
+                        unbindTexture(1);
+                        unbindTexture(2);
+                        unbindTexture(3);
+                        unbindTexture(4);
+                    });
+            }
+            m_lastGeometryPassCount++;
+
+            // Blend the layers in front of the first missed fragment
+            beginGpuStage("blend", pass + 1);
+            const size_t nextId{ 1 - currId };
+            glBindFramebuffer(GL_FRAMEBUFFER, m_mergeFboId);
+            glDrawBuffers(2, &DRAW_BUFFERS.at(2 * nextId));
+            glDisable(GL_BLEND);
+
+            m_shaderMerge.bind();
+            m_shaderMerge.setUniformValue("LayerCount", m_layersPerPass);
+            bindTexture(m_shaderMerge, "BucketDepth0123Tex", m_bucketDepthTexId[0], 0);
+            bindTexture(m_shaderMerge, "BucketDepth456Tex", m_bucketDepthTexId[1], 1);
+            bindTexture(m_shaderMerge, "MissedDepthTex", m_missedDepthTexId, 2);
+            bindTexture(m_shaderMerge, "PrevAccumulationTex", m_accumulationTexId.at(currId), 3);
+            bindTexture(m_shaderMerge, "PrevPeeledDepthTex", m_peeledDepthTexId.at(currId), 4);
+            for (int i = 0; i < MAX_LAYERS_PER_PASS; i++)
+            {
+                bindTexture(m_shaderMerge, QString("LayerColorTex[%1]").arg(i), m_layerColorTexId.at(i), 5 + i);
+            }
+            drawFullScreenQuad();
+            for (int i = 0; i < 5 + MAX_LAYERS_PER_PASS; i++)
+            {
+                unbindTexture(i);
+            }
+            m_shaderMerge.release();
+
+            glEnable(GL_BLEND);
+            currId = nextId;
+        }
+
+        glDisable(GL_BLEND);
+
+        // ---------------------------------------------------------------------
+        // 3. Final Pass
+        // ---------------------------------------------------------------------
+        beginGpuStage("final");
+
+        bindOutputFramebuffer();
+
+        m_shaderFinal.bind();
+        m_shaderFinal.setUniformValue("BackgroundColor", m_backgroundColor);
+        bindTexture(m_shaderFinal, "OpaqueTex", m_opaqueTexId, 0);
+        bindTexture(m_shaderFinal, "AccumulationTex", m_accumulationTexId.at(currId), 1);
+        drawFullScreenQuad();
+        unbindTexture(0);
+        unbindTexture(1);
+        m_shaderFinal.release();
+
+        glEnable(GL_DEPTH_TEST);
+    }
+
+}
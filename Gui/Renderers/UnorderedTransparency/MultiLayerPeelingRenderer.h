@@ -0,0 +1,104 @@
+#pragma once
+
+#include "Renderers/UnorderedTransparency/TransparencyRenderer.h"
+
+#include <array>
+
+namespace gui::gl
+{
+
+    /*
+     * \class MultiLayerPeelingRenderer
+     * \brief Render a RMeshModel with transparency
+     *
+     * Class to make independent transparency with several layers peeled by pass (bucket depth peeling):
+     * the remaining depth range of each pixel is split in buckets, a depth pass captures the nearest fragment
+     * of each bucket with MAX blending, and a color pass writes the captured fragments in one render target by bucket.
+     * The layers are blended front to back until the first fragment lost by a bucket collision, which is peeled again
+     * at the next pass, so the result stays exact.
+     *
+    */
+    class MultiLayerPeelingRenderer final : public TransparencyRenderer
+    {
+    public:
+        explicit MultiLayerPeelingRenderer(const Scene& p_scene, const Camera& p_camera);
+        virtual ~MultiLayerPeelingRenderer(void);
+
+        static constexpr int MAX_LAYERS_PER_PASS = 7; //!< 8 draw buffers: one by layer and one for the collisions
+
+        //!< Number of buckets, at most one layer by bucket is peeled by pass (default and maximum MAX_LAYERS_PER_PASS)
+        void setLayersPerPass(int p_count);
+        inline int layersPerPass(void) const { return m_layersPerPass; }
+
+        //!< Automatically detect the number of needed passes to render a model (default true)
+        inline void setOpenGlQueryEnable(bool p_isEnabled) { m_useOQ = p_isEnabled; }
+        //!< Set a fixed number of peel passes, OpenGlQuery must be disabled
+        inline void setNumberOfPasses(size_t p_number) { m_numberOfPasses = p_number; }
+
+        //!< Geometry passes of the last frame, initialization pass included
+        //!< A peel pass is made of two geometry passes (depth and color)
+        inline size_t lastGeometryPassCount(void) const { return m_lastGeometryPassCount; }
+        //!< Peel passes of the last frame, the last depth pass without sample excluded
+        inline size_t lastPassCount(void) const { return m_lastGeometryPassCount > 0 ? (m_lastGeometryPassCount - 1) / 2 : 0; }
+
+    protected:
+        bool isOtherGlFunctionsInitialized(void) const override;
+        bool updateOtherGlFunctions(void) override;
+        bool initOtherGlFunctions(void) override;
+        void deleteOtherGlFunctions(void) override;
+
+        void renderTransparentObjects(void) override;
+
+        bool isRenderTargetsInitialized(void) const override;
+        bool updateTransparentRenderTargets() override;
+        bool initTransparentRenderTargets() override;
+        void deleteRenderTargets(void) override;
+
+        inline bool isShadersInitialized(void) const override { return (m_shaderInit.isLinked() && m_shaderDepth.isLinked() && m_shaderColor.isLinked() && m_shaderMerge.isLinked() && m_shaderFinal.isLinked()); }
+        bool initShaders(void) override;
+        void deleteShaders(void) override;
+
+    private:
+        void allocateTextures(void);
+        void bindBucketTextures(ShaderProgram& p_program, size_t p_currId); //!< texture units 0 to 2
+
+        ShaderProgram m_shaderInit;
+        ShaderProgram m_shaderDepth;
+        ShaderProgram m_shaderColor;
+        ShaderProgram m_shaderMerge;
+        ShaderProgram m_shaderFinal;
+
+        int m_layersPerPass;
+        bool m_useOQ;
+        GLuint m_queryId;
+        size_t m_numberOfPasses;
+        size_t m_lastGeometryPassCount;
+
+        GLuint m_depthFboId;
+        GLuint m_colorFboId;
+        GLuint m_mergeFboId;
+        GLuint m_minMaxDepthTexId; //!< (-nearest, farthest)
+        std::array<GLuint, 2> m_bucketDepthTexId; //!< -nearest depth of the buckets (4 + 3)
+        std::array<GLuint, MAX_LAYERS_PER_PASS> m_layerColorTexId;
+        GLuint m_missedDepthTexId; //!< -nearest depth of the fragments lost by bucket collisions
+        std::array<GLuint, 2> m_accumulationTexId; //!< front to back blending (color, transmittance), ping pong
+        std::array<GLuint, 2> m_peeledDepthTexId; //!< last blended depth, ping pong
+
+        static constexpr size_t MAX_PASSES = 64;
+        static constexpr GLfloat MAX_DEPTH = 1.f;
+        static constexpr GLfloat NO_DEPTH = -2.f;
+        static constexpr std::array<GLenum, 8> DRAW_BUFFERS{
+            GL_COLOR_ATTACHMENT0,
+            GL_COLOR_ATTACHMENT1,
+            GL_COLOR_ATTACHMENT2,
+            GL_COLOR_ATTACHMENT3,
+            GL_COLOR_ATTACHMENT4,
+            GL_COLOR_ATTACHMENT5,
+            GL_COLOR_ATTACHMENT6,
+            GL_COLOR_ATTACHMENT7
+        };
+
+        Q_DISABLE_COPY_MOVE(MultiLayerPeelingRenderer);
+    };
+
+}
@@ -0,0 +1,70 @@
+#include "Renderers/UnorderedTransparency/PassBudgetController.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace gui::gl
+{
+
+    //---------------------------------------------------------------------------------------
+    PassBudgetController::PassBudgetController(void)
+        : m_targetFrameTime(0.)
+        , m_fixedTime(0.)
+        , m_passTime(0.)
+        , m_hasTiming(false)
+        , m_passBudget(MAX_PASSES)
+    //---------------------------------------------------------------------------------------
+    {
+    }
+
+    //---------------------------------------------------------------------------------------
+    void PassBudgetController::reset(void)
+    //---------------------------------------------------------------------------------------
+    {
+        m_fixedTime = 0.;
+        m_passTime = 0.;
+        m_hasTiming = false;
+        m_passBudget = MAX_PASSES;
+    }
+
+    //---------------------------------------------------------------------------------------
+    void PassBudgetController::addFrameTiming(double p_fixedTime, double p_loopTime, size_t p_passCount)
+    //---------------------------------------------------------------------------------------
+    {
+        if (p_passCount == 0 || p_fixedTime < 0. || p_loopTime < 0.)
+        {
+            return;
+        }
+
+        const double passTime{ p_loopTime / static_cast<double>(p_passCount) };
+        if (m_hasTiming)
+        {
+            m_fixedTime += SMOOTHING * (p_fixedTime - m_fixedTime);
+            m_passTime += SMOOTHING * (passTime - m_passTime);
+        }
+        else
+        {
+            m_fixedTime = p_fixedTime;
+            m_passTime = passTime;
+            m_hasTiming = true;
+        }
+
+        updatePassBudget();
+    }
+
+    //---------------------------------------------------------------------------------------
+    void PassBudgetController::updatePassBudget(void)
+    //---------------------------------------------------------------------------------------
+    {
+        if (!m_hasTiming || m_passTime <= 0.)
+        {
+            m_passBudget = MAX_PASSES;
+            return;
+        }
+
+        // at least one pass is always done, the front layer must be rendered even if the budget is exceeded
+        const double passCount{ std::floor((m_targetFrameTime - m_fixedTime) / m_passTime) };
+        m_passBudget = static_cast<size_t>(std::clamp(passCount, 1., static_cast<double>(MAX_PASSES)));
+    }
+
+}
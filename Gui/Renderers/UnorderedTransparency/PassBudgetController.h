@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+
+namespace gui::gl
+{
+
+    /**
+     * \class PassBudgetController
+     * \brief Predict the number of peel passes that fit in a GPU frame time budget
+     *
+     * The controller is fed with the measured GPU time of past frames, split into a fixed part
+     * (initialization and final passes) and the peel loop. It keeps a smoothed estimation of both
+     * costs and deduces the pass cap of the next frame.
+     */
+    class PassBudgetController
+    {
+    public:
+        explicit PassBudgetController(void);
+
+        //!< Target GPU time in milliseconds, 0 disables the budget
+        inline void setTargetFrameTime(double p_milliseconds) { m_targetFrameTime = p_milliseconds; }
+        inline double targetFrameTime(void) const { return m_targetFrameTime; }
+        inline bool isEnabled(void) const { return m_targetFrameTime > 0.; }
+
+        //!< Add the timing of a frame (in milliseconds) which has run @a p_passCount peel passes
+        void addFrameTiming(double p_fixedTime, double p_loopTime, size_t p_passCount);
+        void reset(void);
+
+        //!< Number of passes allowed for the next frame, always at least 1
+        inline size_t passBudget(void) const { return m_passBudget; }
+
+        inline double fixedTime(void) const { return m_fixedTime; } //!< smoothed cost of the passes outside the peel loop
+        inline double passTime(void) const { return m_passTime; } //!< smoothed cost of one peel pass
+
+        static constexpr size_t MAX_PASSES = 64; //!< pass budget when nothing is known yet
+
+    private:
+        void updatePassBudget(void);
+
+        double m_targetFrameTime;
+        double m_fixedTime;
+        double m_passTime;
+        bool m_hasTiming;
+        size_t m_passBudget;
+
+        static constexpr double SMOOTHING = 0.25; //!< weight of the last frame in the estimations
+    };
+
+}
@@ -0,0 +1,250 @@
+#include "Renderers/UnorderedTransparency/SortedTransparencyRenderer.h"
+
+#include "GLWidgets/Camera.h"
+#include "GLWidgets/Scene.h"
+
+#include <Mesh/MeshModel.h>
+
+#include <QtCore/QDebug>
+#include <QtCore/QtMath>
+
+#include <algorithm>
+#include <cmath>
+
+namespace gui::gl
+{
+
+    //---------------------------------------------------------------------------------------
+    SortedTransparencyRenderer::SortedTransparencyRenderer(const Scene& p_scene, const Camera& p_camera) : TransparencyRenderer(p_scene, p_camera)
+        , m_incrementalSortAngle(5.f)
+        , m_lastSortedTriangleCount(0)
+        , m_lastIncrementalSortedTriangleCount(0)
+        , m_usePresortedMode(false)
+        , m_measurePresortedError(false)
+        , m_lastPresortedAngleError(0.f)
+        , m_lastPresortedInversionRate(0.f)
+    //---------------------------------------------------------------------------------------
+    {
+    }
+
+    //---------------------------------------------------------------------------------------
+    SortedTransparencyRenderer::~SortedTransparencyRenderer(void)
+    //---------------------------------------------------------------------------------------
+    {
+    }
+
+    //---------------------------------------------------------------------------------------
+    void SortedTransparencyRenderer::deleteOtherGlFunctions(void)
+    //---------------------------------------------------------------------------------------
+    {
+        TransparencyRenderer::deleteOtherGlFunctions();
+
+        for (SortedMesh& sortedMesh : m_sortedMeshes)
+        {
+            glDeleteBuffers(1, &sortedMesh.elementBufferId);
+        }
+        m_sortedMeshes.clear();
+    }
+
+    //---------------------------------------------------------------------------------------
+    bool SortedTransparencyRenderer::initShaders(void)
+    //---------------------------------------------------------------------------------------
+    {
+        bool isOk{ loadShaders(m_shaderBackground, { quadVertex() }, { "Shaders:UnorderedTransparency/sorted_background_fragment.glsl" }) };
+
+        isOk &= loadShaders(m_shaderSorted,
+            { MultipleLightsRenderer::shadeVertex(), "Shaders:UnorderedTransparency/peel_vertex.glsl" },
+            { MultipleLightsRenderer::shadeFragment(), "Shaders:UnorderedTransparency/sorted_fragment.glsl" });
+
+        return isOk;
+    }
+
+    //---------------------------------------------------------------------------------------
+    void SortedTransparencyRenderer::deleteShaders(void)
+    //---------------------------------------------------------------------------------------
+    {
+        m_shaderBackground.removeAllShaders();
+        m_shaderSorted.removeAllShaders();
+    }
+
+    //---------------------------------------------------------------------------------------
+    void SortedTransparencyRenderer::setMesh(const MeshRenderer& p_renderer, SortedMesh& p_sortedMesh)
+    //---------------------------------------------------------------------------------------
+    {
+        const MeshModel& mesh{ p_renderer.mesh() };
+        // the revision changes with the geometry, whatever its size, and differs between two meshes
+        if (p_sortedMesh.meshRevision != mesh.revision())
+        {
+            p_sortedMesh.sorter.setMesh(mesh);
+            p_sortedMesh.meshRevision = mesh.revision();
+            p_sortedMesh.isSorted = false;
+            p_sortedMesh.measuredViewDirection = QVector3D();
+        }
+    }
+
+    //---------------------------------------------------------------------------------------
+    void SortedTransparencyRenderer::sortMesh(SortedMesh& p_sortedMesh, const QVector4D& p_depthRow)
+    //---------------------------------------------------------------------------------------
+    {
+        if (p_sortedMesh.elementBufferId == 0u)
+        {
+            glGenBuffers(1, &p_sortedMesh.elementBufferId);
+        }
+
+        // the order only depends on the direction of the depth row, not on its scale or offset
+        const QVector3D viewDirection{ p_depthRow.toVector3D().normalized() };
+        if (p_sortedMesh.isSorted && qFuzzyCompare(viewDirection, p_sortedMesh.viewDirection))
+        {
+            return;
+        }
+
+        const bool isSmallRotation{ p_sortedMesh.isSorted && QVector3D::dotProduct(viewDirection, p_sortedMesh.viewDirection) >= std::cos(qDegreesToRadians(m_incrementalSortAngle)) };
+        p_sortedMesh.sorter.sort(p_depthRow, isSmallRotation);
+        p_sortedMesh.viewDirection = viewDirection;
+        p_sortedMesh.isSorted = true;
+
+        const size_t triangleCount{ static_cast<size_t>(p_sortedMesh.sorter.triangleCount()) };
+        m_lastSortedTriangleCount += triangleCount;
+        if (p_sortedMesh.sorter.isLastSortIncremental())
+        {
+            m_lastIncrementalSortedTriangleCount += triangleCount;
+        }
+
+        // the element buffer binding belongs to the vao of the mesh, upload through the array buffer target
+        p_sortedMesh.sorter.fillElementIndices(m_elementIndices);
+        glBindBuffer(GL_ARRAY_BUFFER, p_sortedMesh.elementBufferId);
+        glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(m_elementIndices.size() * sizeof(GLuint)), m_elementIndices.data(), GL_STREAM_DRAW);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    //---------------------------------------------------------------------------------------
+    GLuint SortedTransparencyRenderer::presortedElementBuffer(const MeshRenderer& p_renderer, SortedMesh& p_sortedMesh, const QVector4D& p_depthRow)
+    //---------------------------------------------------------------------------------------
+    {
+        const QVector3D viewDirection{ p_depthRow.toVector3D().normalized() };
+        QVector3D presortedDirection;
+        const GLuint elementBufferId{ p_renderer.presortedElementBuffer(viewDirection, &presortedDirection) };
+        if (elementBufferId == 0u)
+        {
+            return 0;
+        }
+
+        const float cosAngle{ std::clamp(QVector3D::dotProduct(viewDirection, presortedDirection), -1.f, 1.f) };
+        m_lastPresortedAngleError = std::max(m_lastPresortedAngleError, qRadiansToDegrees(std::acos(cosAngle)));
+
+        if (m_measurePresortedError)
+        {
+            // the sorter rebuilds the presorted order (same algorithm as MeshRenderer), then counts its errors for the view
+            if (!qFuzzyCompare(viewDirection, p_sortedMesh.measuredViewDirection))
+            {
+                p_sortedMesh.sorter.sort(QVector4D(presortedDirection, 0.f), false);
+                const size_t triangleCount{ static_cast<size_t>(p_sortedMesh.sorter.triangleCount()) };
+                const size_t inversionCount{ p_sortedMesh.sorter.countAdjacentInversions(p_depthRow) };
+                p_sortedMesh.presortedInversionRate = triangleCount > 1 ? static_cast<float>(inversionCount) / static_cast<float>(triangleCount - 1) : 0.f;
+
+                // the sorter order is not the one of the last sort anymore
+                p_sortedMesh.measuredViewDirection = viewDirection;
+                p_sortedMesh.isSorted = false;
+            }
+            m_lastPresortedInversionRate = std::max(m_lastPresortedInversionRate, p_sortedMesh.presortedInversionRate);
+        }
+
+        return elementBufferId;
+    }
+
+    //---------------------------------------------------------------------------------------
+    void SortedTransparencyRenderer::renderTransparentObjects(void)
+    //---------------------------------------------------------------------------------------
+    {
+        // ---------------------------------------------------------------------
+        // 1. Sort the triangles of each mesh, then the meshes
+        // ---------------------------------------------------------------------
+        beginGpuStage("sort");
+
+        // view space z of a model point, the camera looks toward -z
+        const QVector4D depthRow{ (m_camera.viewMatrix() * m_scene.modelMatrix()).row(2) };
+
+        for (auto it = m_sortedMeshes.begin(); it != m_sortedMeshes.end();)
+        {
+            if (std::find(m_transparencyRendererMap.cbegin(), m_transparencyRendererMap.cend(), it.key()) == m_transparencyRendererMap.cend())
+            {
+                glDeleteBuffers(1, &it->elementBufferId);
+                it = m_sortedMeshes.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+
+        m_lastSortedTriangleCount = 0;
+        m_lastIncrementalSortedTriangleCount = 0;
+        m_lastPresortedAngleError = 0.f;
+        m_lastPresortedInversionRate = 0.f;
+
+        struct MeshDraw
+        {
+            float averageDepth;
+            MeshRenderer* renderer;
+            GLuint elementBufferId;
+        };
+        std::vector<MeshDraw> drawOrder;
+        drawOrder.reserve(static_cast<size_t>(m_transparencyRendererMap.size()));
+        for (MeshRenderer* const renderer : m_transparencyRendererMap)
+        {
+            SortedMesh& sortedMesh{ m_sortedMeshes[renderer] };
+            setMesh(*renderer, sortedMesh);
+
+            GLuint elementBufferId{ m_usePresortedMode ? presortedElementBuffer(*renderer, sortedMesh, depthRow) : 0u };
+            if (elementBufferId == 0u)
+            {
+                sortMesh(sortedMesh, depthRow);
+                elementBufferId = sortedMesh.elementBufferId;
+            }
+            drawOrder.push_back({ sortedMesh.sorter.averageDepth(depthRow), renderer, elementBufferId });
+        }
+        std::sort(drawOrder.begin(), drawOrder.end(),
+            [](const MeshDraw& p_lhs, const MeshDraw& p_rhs) { return p_lhs.averageDepth < p_rhs.averageDepth; });
+
+        // ---------------------------------------------------------------------
+        // 2. Opaque color and depth in the default framebuffer
+        // ---------------------------------------------------------------------
+        beginGpuStage("background");
+
+        bindOutputFramebuffer();
+
+        glEnable(GL_DEPTH_TEST);
+        glDepthFunc(GL_ALWAYS);
+        glDepthMask(GL_TRUE);
+        glDisable(GL_BLEND);
+
+        m_shaderBackground.bind();
+        m_shaderBackground.setUniformValue("BackgroundColor", m_backgroundColor);
+        bindTexture(m_shaderBackground, "OpaqueTex", m_opaqueTexId, 0);
+        bindTexture(m_shaderBackground, "OpaqueDepthTex", m_opaqueDepthTexId, 1);
+        drawFullScreenQuad();
+        unbindTexture(0);
+        unbindTexture(1);
+        m_shaderBackground.release();
+
+        // ---------------------------------------------------------------------
+        // 3. Sorted triangles blended back to front
+        // ---------------------------------------------------------------------
+        beginGpuStage("blend");
+
+        glDepthFunc(GL_LESS);
+        glDepthMask(GL_FALSE);
+        glEnable(GL_BLEND);
+        glBlendEquation(GL_FUNC_ADD);
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+        for (const MeshDraw& mesh : drawOrder)
+        {
+            mesh.renderer->renderMeshElements(m_shaderSorted, true, mesh.elementBufferId);
+        }
+
+        glDisable(GL_BLEND);
+        glDepthMask(GL_TRUE);
+    }
+
+}
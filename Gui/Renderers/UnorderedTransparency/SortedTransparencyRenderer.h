@@ -0,0 +1,94 @@
+#pragma once
+
+#include "Renderers/UnorderedTransparency/TransparencyRenderer.h"
+#include "Renderers/UnorderedTransparency/TriangleSorter.h"
+
+#include <QtGui/QVector3D>
+
+#include <vector>
+
+namespace gui::gl
+{
+
+    /*
+     * \class SortedTransparencyRenderer
+     * \brief Render a RMeshModel with transparency
+     *
+     * Class to make transparency by sorting the triangles back to front on the CPU: each frame the triangles are
+     * sorted by the view depth of their centroid, the order is streamed in an element buffer and the meshes are
+     * drawn once with alpha blending over the opaque objects.
+     * Faster than peeling for moderate transparent sets, intersecting or cyclically overlapping triangles are not resolved.
+     *
+    */
+    class SortedTransparencyRenderer final : public TransparencyRenderer
+    {
+    public:
+        explicit SortedTransparencyRenderer(const Scene& p_scene, const Camera& p_camera);
+        virtual ~SortedTransparencyRenderer(void);
+
+        //!< Under this rotation of the view since the last sort, the previous order is updated by an insertion sort (default 5 degrees)
+        inline void setIncrementalSortAngle(float p_degrees) { m_incrementalSortAngle = p_degrees; }
+        //!< Triangles sorted at the last frame, 0 if the view direction did not change
+        inline size_t lastSortedTriangleCount(void) const { return m_lastSortedTriangleCount; }
+        //!< Triangles sorted incrementally at the last frame
+        inline size_t lastIncrementalSortedTriangleCount(void) const { return m_lastIncrementalSortedTriangleCount; }
+
+        //!< Draw the meshes in the order of their nearest presorted direction (MeshRenderer::setPresortedDirectionCount)
+        //!< instead of sorting them each frame, the meshes without presorted directions are still sorted (default false).
+        //!< Its image error against dual depth peeling is the mean error of the "Presorted" calibration candidate, or the
+        //!< headless renderer with --engine Presorted --reference --reference-engine DualDepthPeeling
+        inline void setPresortedModeEnable(bool p_isEnabled) { m_usePresortedMode = p_isEnabled; }
+        //!< Compare the presorted order with the exact order of the view, costs one sort by view change (default false)
+        inline void setPresortedErrorMeasureEnable(bool p_isEnabled) { m_measurePresortedError = p_isEnabled; }
+        //!< Degrees between the view direction and the nearest presorted direction, worst mesh of the last frame
+        inline float lastPresortedAngleError(void) const { return m_lastPresortedAngleError; }
+        //!< Ratio of consecutive triangles drawn in the wrong order, worst mesh of the last frame (needs the error measure)
+        inline float lastPresortedInversionRate(void) const { return m_lastPresortedInversionRate; }
+
+    protected:
+        void deleteOtherGlFunctions(void) override;
+
+        void renderTransparentObjects(void) override;
+
+        inline bool updateTransparentRenderTargets() override { return true; }
+        inline bool initTransparentRenderTargets() override { return true; }
+
+        inline bool isShadersInitialized(void) const override { return (m_shaderBackground.isLinked() && m_shaderSorted.isLinked()); }
+        bool initShaders(void) override;
+        void deleteShaders(void) override;
+
+    private:
+        struct SortedMesh
+        {
+            TriangleSorter sorter;
+            quint64 meshRevision = 0; //!< MeshModel::revision() of the sorted mesh
+            GLuint elementBufferId = 0;
+            QVector3D viewDirection; //!< of the last sort
+            bool isSorted = false;
+            QVector3D measuredViewDirection; //!< of the last presorted error measure
+            float presortedInversionRate = 0.f;
+        };
+
+        void setMesh(const MeshRenderer& p_renderer, SortedMesh& p_sortedMesh); //!< reset the sorter if the mesh changed
+        void sortMesh(SortedMesh& p_sortedMesh, const QVector4D& p_depthRow);
+        //!< presorted element buffer of the mesh, 0 if it has no presorted directions
+        GLuint presortedElementBuffer(const MeshRenderer& p_renderer, SortedMesh& p_sortedMesh, const QVector4D& p_depthRow);
+
+        ShaderProgram m_shaderBackground;
+        ShaderProgram m_shaderSorted;
+
+        float m_incrementalSortAngle;
+        size_t m_lastSortedTriangleCount;
+        size_t m_lastIncrementalSortedTriangleCount;
+        bool m_usePresortedMode;
+        bool m_measurePresortedError;
+        float m_lastPresortedAngleError;
+        float m_lastPresortedInversionRate;
+
+        QHash<const MeshRenderer*, SortedMesh> m_sortedMeshes;
+        std::vector<GLuint> m_elementIndices; //!< upload buffer, kept to avoid an allocation by frame
+
+        Q_DISABLE_COPY_MOVE(SortedTransparencyRenderer);
+    };
+
+}
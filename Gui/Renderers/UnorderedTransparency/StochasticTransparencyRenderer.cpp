@@ -0,0 +1,277 @@
+#include "Renderers/UnorderedTransparency/StochasticTransparencyRenderer.h"
+
+#include "GLWidgets/Camera.h"
+#include "GLWidgets/Scene.h"
+
+#include <QtGui/QOpenGLContext>
+#include <QtCore/QDebug>
+
+namespace gui::gl
+{
+
+    //---------------------------------------------------------------------------------------
+    StochasticTransparencyRenderer::StochasticTransparencyRenderer(const Scene& p_scene, const Camera& p_camera) : TransparencyRenderer(p_scene, p_camera)
+        , m_requestedSampleCount(8)
+        , m_sampleCount(0)
+        , m_useHashedCoverage(false)
+        , m_useTemporalAccumulation(true)
+        , m_maxAccumulatedFrames(64)
+        , m_accumulatedFrameCount(0)
+        , m_frameIndex(0)
+        , m_coverageFboId(0)
+        , m_coverageColorTexId(0)
+        , m_coverageDepthTexId(0)
+        , m_historyFboId(0)
+        , m_historyTexId(0)
+    //---------------------------------------------------------------------------------------
+    {
+    }
+
+    //---------------------------------------------------------------------------------------
+    StochasticTransparencyRenderer::~StochasticTransparencyRenderer(void)
+    //---------------------------------------------------------------------------------------
+    {
+    }
+
+    //---------------------------------------------------------------------------------------
+    void StochasticTransparencyRenderer::setSampleCount(int p_count)
+    //---------------------------------------------------------------------------------------
+    {
+        if (p_count < 1 || p_count > MAX_SAMPLE_COUNT)
+        {
+            qCritical() << "The number of samples must be in [1," << MAX_SAMPLE_COUNT << "], not" << p_count;
+            return;
+        }
+
+        if (m_requestedSampleCount != p_count)
+        {
+            m_requestedSampleCount = p_count;
+            requestUpdateRenderTargets();
+        }
+    }
+
+    //---------------------------------------------------------------------------------------
+    bool StochasticTransparencyRenderer::isRenderTargetsInitialized(void) const
+    //---------------------------------------------------------------------------------------
+    {
+        if (!TransparencyRenderer::isRenderTargetsInitialized())
+        {
+            return false;
+        }
+
+        return (m_coverageFboId != 0u && m_coverageColorTexId != 0u && m_coverageDepthTexId != 0u && m_historyFboId != 0u && m_historyTexId != 0u);
+    }
+
+    //---------------------------------------------------------------------------------------
+    void StochasticTransparencyRenderer::allocateTextures(void)
+    //---------------------------------------------------------------------------------------
+    {
+        GLint maxColorSamples{ 0 }, maxDepthSamples{ 0 };
+        glGetIntegerv(GL_MAX_COLOR_TEXTURE_SAMPLES, &maxColorSamples);
+        glGetIntegerv(GL_MAX_DEPTH_TEXTURE_SAMPLES, &maxDepthSamples);
+        const GLsizei samples{ std::clamp(m_requestedSampleCount, 1, std::min({ static_cast<int>(maxColorSamples), static_cast<int>(maxDepthSamples), MAX_SAMPLE_COUNT })) };
+
+        // both attachments need the same sample locations
+        glBindTexture(GL_TEXTURE_2D_MULTISAMPLE, m_coverageColorTexId);
+        glTexImage2DMultisample(GL_TEXTURE_2D_MULTISAMPLE, samples, GL_RGBA8, m_width, m_height, GL_TRUE);
+        glGetTexLevelParameteriv(GL_TEXTURE_2D_MULTISAMPLE, 0, GL_TEXTURE_SAMPLES, &m_sampleCount);
+
+        glBindTexture(GL_TEXTURE_2D_MULTISAMPLE, m_coverageDepthTexId);
+        glTexImage2DMultisample(GL_TEXTURE_2D_MULTISAMPLE, samples, GL_DEPTH_COMPONENT32F, m_width, m_height, GL_TRUE);
+        glBindTexture(GL_TEXTURE_2D_MULTISAMPLE, 0);
+
+        m_sampleCount = std::clamp(m_sampleCount, 1, MAX_SAMPLE_COUNT);
+        if (m_sampleCount != m_requestedSampleCount)
+        {
+            qDebug() << QString("Stochastic transparency: %0 samples instead of %1").arg(m_sampleCount).arg(m_requestedSampleCount);
+        }
+
+        glBindTexture(USING_GL_TEXTURE, m_historyTexId);
+        glTexImage2D(USING_GL_TEXTURE, 0, GL_RGBA16F, m_width, m_height, 0, GL_RGBA, GL_FLOAT, nullptr);
+
+        resetAccumulation();
+    }
+
+    //---------------------------------------------------------------------------------------
+    bool StochasticTransparencyRenderer::updateTransparentRenderTargets()
+    //---------------------------------------------------------------------------------------
+    {
+        allocateTextures();
+        return true;
+    }
+
+    //---------------------------------------------------------------------------------------
+    bool StochasticTransparencyRenderer::initTransparentRenderTargets()
+    //---------------------------------------------------------------------------------------
+    {
+        glGenTextures(1, &m_coverageColorTexId);
+        glGenTextures(1, &m_coverageDepthTexId);
+        glGenTextures(1, &m_historyTexId);
+
+        glBindTexture(USING_GL_TEXTURE, m_historyTexId);
+        glTexParameteri(USING_GL_TEXTURE, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+        glTexParameteri(USING_GL_TEXTURE, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+        glTexParameteri(USING_GL_TEXTURE, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(USING_GL_TEXTURE, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        allocateTextures();
+
+        glGenFramebuffers(1, &m_coverageFboId);
+        glBindFramebuffer(GL_FRAMEBUFFER, m_coverageFboId);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D_MULTISAMPLE, m_coverageColorTexId, 0);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D_MULTISAMPLE, m_coverageDepthTexId, 0);
+
+        glGenFramebuffers(1, &m_historyFboId);
+        glBindFramebuffer(GL_FRAMEBUFFER, m_historyFboId);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, USING_GL_TEXTURE, m_historyTexId, 0);
+
+        return true;
+    }
+
+    //---------------------------------------------------------------------------------------
+    void StochasticTransparencyRenderer::deleteRenderTargets(void)
+    //---------------------------------------------------------------------------------------
+    {
+        TransparencyRenderer::deleteRenderTargets();
+
+        glDeleteFramebuffers(1, &m_coverageFboId);
+        glDeleteFramebuffers(1, &m_historyFboId);
+        glDeleteTextures(1, &m_coverageColorTexId);
+        glDeleteTextures(1, &m_coverageDepthTexId);
+        glDeleteTextures(1, &m_historyTexId);
+    }
+
+    //---------------------------------------------------------------------------------------
+    bool StochasticTransparencyRenderer::initShaders(void)
+    //---------------------------------------------------------------------------------------
+    {
+        // gl_SampleMask needs GL_ARB_sample_shading (core in OpenGL 4.0)
+        const QOpenGLContext* const context{ QOpenGLContext::currentContext() };
+        m_useHashedCoverage = (context != nullptr && context->hasExtension("GL_ARB_sample_shading"));
+
+        bool isOk{ loadShaders(m_shaderCoverage,
+            { MultipleLightsRenderer::shadeVertex(), "Shaders:UnorderedTransparency/peel_vertex.glsl" },
+            { MultipleLightsRenderer::shadeFragment(), "Shaders:UnorderedTransparency/stochastic_hash.glsl",
+                m_useHashedCoverage ? "Shaders:UnorderedTransparency/stochastic_coverage_fragment.glsl" : "Shaders:UnorderedTransparency/stochastic_alpha_to_coverage_fragment.glsl" })
+        };
+
+        isOk &= loadShaders(m_shaderResolve, { quadVertex() }, { "Shaders:UnorderedTransparency/stochastic_resolve_fragment.glsl" });
+
+        isOk &= loadShaders(m_shaderPresent, { quadVertex() }, { "Shaders:UnorderedTransparency/stochastic_present_fragment.glsl" });
+
+        return isOk;
+    }
+
+    //---------------------------------------------------------------------------------------
+    void StochasticTransparencyRenderer::deleteShaders(void)
+    //---------------------------------------------------------------------------------------
+    {
+        m_shaderCoverage.removeAllShaders();
+        m_shaderResolve.removeAllShaders();
+        m_shaderPresent.removeAllShaders();
+    }
+
+    //---------------------------------------------------------------------------------------
+    void StochasticTransparencyRenderer::renderTransparentObjects(void)
+    //---------------------------------------------------------------------------------------
+    {
+        const QMatrix4x4 viewProjection{ m_camera.projMatrix() * m_camera.viewMatrix() * m_scene.modelMatrix() };
+        if (!m_useTemporalAccumulation || viewProjection != m_lastViewProjection)
+        {
+            m_lastViewProjection = viewProjection;
+            resetAccumulation();
+        }
+        m_frameIndex++;
+
+        // ---------------------------------------------------------------------
+        // 1. Nearest covering transparent fragment by sample
+        // ---------------------------------------------------------------------
+        beginGpuStage("coverage");
+
+        glBindFramebuffer(GL_FRAMEBUFFER, m_coverageFboId);
+        glDrawBuffer(GL_COLOR_ATTACHMENT0);
+        glClearColor(0, 0, 0, 0);
+        glDepthMask(GL_TRUE); // glClear respects the depth mask, an engine rendered before may have left it disabled
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+        const GLboolean isMultisampleEnabled{ glIsEnabled(GL_MULTISAMPLE) };
+        glEnable(GL_MULTISAMPLE);
+        glEnable(GL_DEPTH_TEST);
+        glDisable(GL_BLEND);
+        if (!m_useHashedCoverage)
+        {
+            glEnable(GL_SAMPLE_ALPHA_TO_COVERAGE);
+        }
+
+        for (MeshRenderer* const renderer : m_transparencyRendererMap)
+        {
+            renderer->renderMesh(m_shaderCoverage, true,
+                [this]()
+                {
+                    m_shaderCoverage.setUniformValue("SampleCount", m_sampleCount);
+                    m_shaderCoverage.setUniformValue("FrameIndex", m_frameIndex);
+                    bindTexture(m_shaderCoverage, "OpaqueDepthTex", m_opaqueDepthTexId, 0);
+                },
+                [this]()
+                {
+                    unbindTexture(0);
+                });
+        }
+
+        if (!m_useHashedCoverage)
+        {
+            glDisable(GL_SAMPLE_ALPHA_TO_COVERAGE);
+        }
+        if (isMultisampleEnabled == GL_FALSE)
+        {
+            glDisable(GL_MULTISAMPLE);
+        }
+        glDisable(GL_DEPTH_TEST);
+
+        // ---------------------------------------------------------------------
+        // 2. Resolve the samples and average with the previous frames
+        // ---------------------------------------------------------------------
+        beginGpuStage("resolve");
+
+        // the first frame overwrites the history, the next ones weight 1 / n
+        m_accumulatedFrameCount = std::min(m_accumulatedFrameCount + 1, m_maxAccumulatedFrames);
+        const GLfloat historyWeight{ 1.f / static_cast<GLfloat>(m_accumulatedFrameCount) };
+
+        glBindFramebuffer(GL_FRAMEBUFFER, m_historyFboId);
+        glDrawBuffer(GL_COLOR_ATTACHMENT0);
+        glEnable(GL_BLEND);
+        glBlendEquation(GL_FUNC_ADD);
+        glBlendColor(0.f, 0.f, 0.f, historyWeight);
+        glBlendFunc(GL_CONSTANT_ALPHA, GL_ONE_MINUS_CONSTANT_ALPHA);
+
+        m_shaderResolve.bind();
+        m_shaderResolve.setUniformValue("SampleCount", m_sampleCount);
+        m_shaderResolve.setUniformValue("BackgroundColor", m_backgroundColor);
+        m_shaderResolve.setUniformValue("ColorTex", 0);
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D_MULTISAMPLE, m_coverageColorTexId);
+        bindTexture(m_shaderResolve, "OpaqueTex", m_opaqueTexId, 1);
+        drawFullScreenQuad();
+        unbindTexture(1);
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D_MULTISAMPLE, 0);
+        m_shaderResolve.release();
+
+        glDisable(GL_BLEND);
+
+        // ---------------------------------------------------------------------
+        // 3. Final Pass
+        // ---------------------------------------------------------------------
+        beginGpuStage("final");
+
+        bindOutputFramebuffer();
+
+        m_shaderPresent.bind();
+        bindTexture(m_shaderPresent, "HistoryTex", m_historyTexId, 0);
+        drawFullScreenQuad();
+        unbindTexture(0);
+        m_shaderPresent.release();
+
+        glEnable(GL_DEPTH_TEST);
+    }
+
+}
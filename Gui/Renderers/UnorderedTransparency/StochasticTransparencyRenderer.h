@@ -0,0 +1,85 @@
+#pragma once
+
+#include "Renderers/UnorderedTransparency/TransparencyRenderer.h"
+
+#include <QtGui/QMatrix4x4>
+
+#include <algorithm>
+
+namespace gui::gl
+{
+
+    /*
+     * \class StochasticTransparencyRenderer
+     * \brief Render a RMeshModel with transparency
+     *
+     * Class to make approximated independent transparency with Stochastic Transparency (Enderton et al.):
+     * one depth tested geometry pass in a multisampled target where each fragment covers a random subset of the samples
+     * proportional to its opacity, then one full screen pass averages the samples. The cost is one geometry pass
+     * whatever the depth complexity, the noise decreases with the number of samples and with the accumulation of
+     * the frames while the camera does not move.
+     * Uses a hashed sample mask with GL_ARB_sample_shading, alpha-to-coverage otherwise.
+     *
+    */
+    class StochasticTransparencyRenderer final : public TransparencyRenderer
+    {
+    public:
+        explicit StochasticTransparencyRenderer(const Scene& p_scene, const Camera& p_camera);
+        virtual ~StochasticTransparencyRenderer(void);
+
+        //!< Requested samples by pixel, bounded by the graphic card (default 8)
+        void setSampleCount(int p_count);
+        inline int sampleCount(void) const { return m_sampleCount; } //!< samples of the render target, valid after initialize
+
+        //!< Average the frames while the camera does not move (default true)
+        inline void setTemporalAccumulationEnable(bool p_isEnabled) { m_useTemporalAccumulation = p_isEnabled; resetAccumulation(); }
+        //!< Over this number of frames, the older frames fade out instead of being averaged (default 64)
+        inline void setMaxAccumulatedFrames(int p_count) { m_maxAccumulatedFrames = std::max(p_count, 1); }
+        //!< Restart the accumulation, to call when the transparent objects change
+        inline void resetAccumulation(void) { m_accumulatedFrameCount = 0; }
+        inline int accumulatedFrameCount(void) const { return m_accumulatedFrameCount; }
+        //!< false while a new frame still reduces the noise, the view must be repainted until then
+        inline bool isAccumulationConverged(void) const { return (!m_useTemporalAccumulation || m_accumulatedFrameCount >= m_maxAccumulatedFrames); }
+
+        inline bool isHashedCoverage(void) const { return m_useHashedCoverage; } //!< false if alpha-to-coverage is used
+
+    protected:
+        void renderTransparentObjects(void) override;
+
+        bool isRenderTargetsInitialized(void) const override;
+        bool updateTransparentRenderTargets() override;
+        bool initTransparentRenderTargets() override;
+        void deleteRenderTargets(void) override;
+
+        inline bool isShadersInitialized(void) const override { return (m_shaderCoverage.isLinked() && m_shaderResolve.isLinked() && m_shaderPresent.isLinked()); }
+        bool initShaders(void) override;
+        void deleteShaders(void) override;
+
+    private:
+        void allocateTextures(void);
+
+        ShaderProgram m_shaderCoverage;
+        ShaderProgram m_shaderResolve;
+        ShaderProgram m_shaderPresent;
+
+        int m_requestedSampleCount;
+        int m_sampleCount;
+        bool m_useHashedCoverage;
+        bool m_useTemporalAccumulation;
+        int m_maxAccumulatedFrames;
+        int m_accumulatedFrameCount;
+        GLuint m_frameIndex; //!< seed of the coverage hash
+        QMatrix4x4 m_lastViewProjection; //!< the accumulation restarts when it changes
+
+        GLuint m_coverageFboId;
+        GLuint m_coverageColorTexId; //!< multisampled, alpha is 0 where no transparent fragment covers the sample
+        GLuint m_coverageDepthTexId; //!< multisampled, nearest transparent fragment by sample
+        GLuint m_historyFboId;
+        GLuint m_historyTexId; //!< average of the resolved frames
+
+        static constexpr int MAX_SAMPLE_COUNT = 32; //!< bits of the sample mask
+
+        Q_DISABLE_COPY_MOVE(StochasticTransparencyRenderer);
+    };
+
+}
@@ -0,0 +1,211 @@
+#include "Renderers/UnorderedTransparency/TransparencyEngineCalibrator.h"
+
+#include "Renderers/Common/ImageComparison.h"
+#include "Renderers/UnorderedTransparency/TransparencyRenderer.h"
+
+#include <QtGui/QImage>
+#include <QtGui/QOpenGLFramebufferObject>
+#include <QtCore/QDebug>
+#include <QtCore/QSettings>
+
+#include <cstddef>
+
+namespace
+{
+    //!< QSettings group of the selections, one key by graphic card and driver
+    constexpr const char* SETTINGS_GROUP = "TransparencyEngineCalibration";
+}
+
+namespace gui::gl
+{
+
+    //---------------------------------------------------------------------------------------
+    TransparencyEngineCalibrator::TransparencyEngineCalibrator(void)
+        : m_qualityTolerance(0.01)
+        , m_measuredFrameCount(5)
+    //---------------------------------------------------------------------------------------
+    {
+    }
+
+    //---------------------------------------------------------------------------------------
+    void TransparencyEngineCalibrator::addCandidate(const QString& p_name, TransparencyRenderer* p_renderer, const std::function<void()>& p_apply)
+    //---------------------------------------------------------------------------------------
+    {
+        if (p_renderer == nullptr)
+        {
+            qCritical() << "Invalid renderer for the calibration candidate" << p_name;
+            return;
+        }
+
+        m_candidates.push_back({ p_name, p_renderer, p_apply });
+    }
+
+    //---------------------------------------------------------------------------------------
+    QString TransparencyEngineCalibrator::deviceKey(void)
+    //---------------------------------------------------------------------------------------
+    {
+        initializeOpenGLFunctions();
+
+        QString key{ QString("%1 %2 %3").arg(reinterpret_cast<const char*>(glGetString(GL_VENDOR)),
+            reinterpret_cast<const char*>(glGetString(GL_RENDERER)),
+            reinterpret_cast<const char*>(glGetString(GL_VERSION))) };
+
+        // '/' and '\' split the QSettings groups
+        return key.replace('/', '_').replace('\\', '_');
+    }
+
+    //---------------------------------------------------------------------------------------
+    bool TransparencyEngineCalibrator::applyCandidate(const QString& p_name)
+    //---------------------------------------------------------------------------------------
+    {
+        const auto it = std::find_if(m_candidates.cbegin(), m_candidates.cend(), [&p_name](const Candidate& p_candidate) { return p_candidate.name == p_name; });
+        if (it == m_candidates.cend())
+        {
+            return false;
+        }
+
+        if (it->apply)
+        {
+            it->apply();
+        }
+        return true;
+    }
+
+    //---------------------------------------------------------------------------------------
+    bool TransparencyEngineCalibrator::applySavedSelection(void)
+    //---------------------------------------------------------------------------------------
+    {
+        QSettings settings;
+        settings.beginGroup(SETTINGS_GROUP);
+        const QString name{ settings.value(deviceKey()).toString() };
+        settings.endGroup();
+
+        if (name.isEmpty() || !applyCandidate(name))
+        {
+            return false;
+        }
+
+        qInfo() << "Transparency engine" << name << "selected by a previous calibration";
+        return true;
+    }
+
+    //---------------------------------------------------------------------------------------
+    void TransparencyEngineCalibrator::clearSavedSelection(void)
+    //---------------------------------------------------------------------------------------
+    {
+        QSettings settings;
+        settings.beginGroup(SETTINGS_GROUP);
+        settings.remove(deviceKey());
+        settings.endGroup();
+    }
+
+    //---------------------------------------------------------------------------------------
+    QString TransparencyEngineCalibrator::calibrate(int p_width, int p_height)
+    //---------------------------------------------------------------------------------------
+    {
+        m_results.clear();
+        if (m_candidates.empty() || p_width <= 0 || p_height <= 0)
+        {
+            return QString();
+        }
+
+        initializeOpenGLFunctions();
+
+        // the default framebuffer can be multisampled, it is resolved in this one to be read
+        QOpenGLFramebufferObject capture(p_width, p_height);
+        const QRect viewport(0, 0, p_width, p_height);
+
+        // time stamps rather than GL_TIME_ELAPSED, which cannot be nested with the stages of a GpuProfiler
+        std::vector<GLuint> queryIds(2 * static_cast<size_t>(m_measuredFrameCount));
+        glGenQueries(static_cast<GLsizei>(queryIds.size()), queryIds.data());
+
+        QImage reference;
+        for (const Candidate& candidate : m_candidates)
+        {
+            Result result;
+            result.name = candidate.name;
+
+            if (candidate.apply)
+            {
+                candidate.apply();
+            }
+
+            TransparencyRenderer& renderer{ *candidate.renderer };
+            if (renderer.isInitialized() || renderer.initialize(p_width, p_height))
+            {
+                for (int i = 0; i < WARM_UP_FRAME_COUNT; i++)
+                {
+                    renderer.render();
+                }
+
+                for (size_t i = 0; i < queryIds.size(); i += 2)
+                {
+                    glQueryCounter(queryIds.at(i), GL_TIMESTAMP);
+                    renderer.render();
+                    glQueryCounter(queryIds.at(i + 1), GL_TIMESTAMP);
+                }
+
+                // one stall by candidate, the calibration is not interactive
+                std::vector<double> frameTimes;
+                frameTimes.reserve(queryIds.size() / 2);
+                for (size_t i = 0; i < queryIds.size(); i += 2)
+                {
+                    GLuint64 startTime{ 0 }, endTime{ 0 };
+                    glGetQueryObjectui64v(queryIds.at(i), GL_QUERY_RESULT, &startTime);
+                    glGetQueryObjectui64v(queryIds.at(i + 1), GL_QUERY_RESULT, &endTime);
+                    frameTimes.push_back(static_cast<double>(endTime - startTime) * 1e-6);
+                }
+                std::nth_element(frameTimes.begin(), frameTimes.begin() + static_cast<std::ptrdiff_t>(frameTimes.size() / 2), frameTimes.end());
+                result.gpuTime = frameTimes.at(frameTimes.size() / 2);
+
+                QOpenGLFramebufferObject::blitFramebuffer(&capture, viewport, nullptr, viewport);
+                const QImage image{ capture.toImage().convertToFormat(QImage::Format_RGB32) };
+                if (reference.isNull())
+                {
+                    reference = image;
+                }
+                const ImageDifference difference{ compareImages(image, reference, DIFFERENT_PIXEL_THRESHOLD, false) };
+                result.meanError = difference.meanDifference / 255.;
+                result.differentPixelRate = difference.differentPixelRatio;
+                result.isValid = true;
+            }
+            else if (reference.isNull())
+            {
+                qCritical() << "The reference transparency engine" << candidate.name << "cannot be initialized, calibration aborted";
+                break;
+            }
+
+            qInfo().nospace() << "Transparency engine " << result.name << (result.isValid ? "" : " (not initialized)")
+                << ": " << result.gpuTime << " ms, mean error " << result.meanError << ", different pixels " << 100. * result.differentPixelRate << "%";
+            m_results.push_back(result);
+        }
+
+        glDeleteQueries(static_cast<GLsizei>(queryIds.size()), queryIds.data());
+        QOpenGLFramebufferObject::bindDefault();
+
+        // fastest within the tolerance, the reference is always within it
+        const Result* selection{ nullptr };
+        for (const Result& result : m_results)
+        {
+            if (result.isValid && result.meanError <= m_qualityTolerance && (selection == nullptr || result.gpuTime < selection->gpuTime))
+            {
+                selection = &result;
+            }
+        }
+        if (selection == nullptr)
+        {
+            return QString();
+        }
+
+        applyCandidate(selection->name);
+
+        QSettings settings;
+        settings.beginGroup(SETTINGS_GROUP);
+        settings.setValue(deviceKey(), selection->name);
+        settings.endGroup();
+
+        qInfo() << "Transparency engine" << selection->name << "selected";
+        return selection->name;
+    }
+
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <QtGui/QOpenGLFunctions_3_3_Core>
+#include <QtCore/QString>
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+namespace gui::gl
+{
+    class TransparencyRenderer;
+
+    /**
+     * \class TransparencyEngineCalibrator
+     * \brief Choose the fastest transparency engine of the graphic card within a quality tolerance
+     *
+     * Each candidate (an engine and its settings, ex. a render target format) renders a few frames of the current
+     * scene in the current context: the GPU time is measured with GL_TIMESTAMP queries and the last image is
+     * compared with the image of the reference candidate (an exact engine). The fastest candidate whose mean error
+     * is under the tolerance is selected.
+     * The selection is saved in the QSettings of the application by graphic card and driver, a later run reloads it
+     * without rendering anything.
+     */
+    class TransparencyEngineCalibrator : protected QOpenGLFunctions_3_3_Core
+    {
+    public:
+        struct Result
+        {
+            QString name;
+            bool isValid = false; //!< false if the candidate could not be initialized
+            double gpuTime = 0.; //!< median of the measured frames, in milliseconds
+            double meanError = 0.; //!< mean absolute difference with the reference, by channel in [0, 1]
+            double differentPixelRate = 0.; //!< ratio of pixels visibly different from the reference
+        };
+
+        explicit TransparencyEngineCalibrator(void);
+
+        //!< p_apply sets the engine and its settings before it is measured, or once it is selected
+        //!< The first candidate is the reference, its error is 0
+        void addCandidate(const QString& p_name, TransparencyRenderer* p_renderer, const std::function<void()>& p_apply);
+        inline void clearCandidates(void) { m_candidates.clear(); m_results.clear(); }
+
+        inline void setQualityTolerance(double p_meanError) { m_qualityTolerance = p_meanError; } //!< default 0.01, about 2.5 levels on 255
+        inline void setMeasuredFrameCount(int p_count) { m_measuredFrameCount = std::max(p_count, 1); } //!< default 5, after 2 warm up frames
+
+        //!< Need a current context: apply the selection saved for this graphic card and driver
+        //!< false if there is none or if it is not a candidate anymore
+        bool applySavedSelection(void);
+        //!< Need a current context: render every candidate at the size of the default framebuffer (the last rendering
+        //!< is left in it), apply the selected candidate and save it. Returns the selected name, empty if none is valid
+        QString calibrate(int p_width, int p_height);
+        void clearSavedSelection(void);
+
+        inline const std::vector<Result>& results(void) const { return m_results; } //!< of the last calibration
+
+    private:
+        struct Candidate
+        {
+            QString name;
+            TransparencyRenderer* renderer;
+            std::function<void()> apply;
+        };
+
+        QString deviceKey(void); //!< vendor, renderer and driver version
+        bool applyCandidate(const QString& p_name);
+
+        std::vector<Candidate> m_candidates;
+        std::vector<Result> m_results;
+
+        double m_qualityTolerance;
+        int m_measuredFrameCount;
+
+        static constexpr int WARM_UP_FRAME_COUNT = 2; //!< shader compilation and first allocations are not measured
+        static constexpr int DIFFERENT_PIXEL_THRESHOLD = 8; //!< on 255, difference of a channel visible on a smooth surface
+    };
+
+}
@@ -0,0 +1,181 @@
+#include "Renderers/UnorderedTransparency/TransparencyEngineFactory.h"
+
+#include "Renderers/UnorderedTransparency/ABufferRenderer.h"
+#include "Renderers/UnorderedTransparency/DualDepthPeelingRenderer.h"
+#include "Renderers/UnorderedTransparency/MomentTransparencyRenderer.h"
+#include "Renderers/UnorderedTransparency/MultiLayerPeelingRenderer.h"
+#include "Renderers/UnorderedTransparency/SortedTransparencyRenderer.h"
+#include "Renderers/UnorderedTransparency/StochasticTransparencyRenderer.h"
+#include "Renderers/UnorderedTransparency/WeightedBlendedRenderer.h"
+
+#include <QtCore/QDebug>
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+namespace
+{
+    using Factory = gui::gl::TransparencyEngineFactory;
+
+    //!< the names and their engine, the default settings of an engine first
+    const std::pair<const char*, Factory::Engine> NAMES[]{
+        { "DualDepthPeeling", Factory::DUAL_DEPTH_PEELING },
+        { "DualDepthPeelingNonStalling", Factory::DUAL_DEPTH_PEELING },
+        { "DualDepthPeelingStencilMask", Factory::DUAL_DEPTH_PEELING },
+        { "DualDepthPeelingFused", Factory::DUAL_DEPTH_PEELING },
+        { "WeightedBlended", Factory::WEIGHTED_BLENDED },
+        { "WeightedBlendedHalfFloat", Factory::WEIGHTED_BLENDED },
+        { "ABuffer", Factory::A_BUFFER },
+        { "Moments", Factory::MOMENTS },
+        { "MultiLayerPeeling4", Factory::MULTI_LAYER_PEELING },
+        { "MultiLayerPeeling7", Factory::MULTI_LAYER_PEELING },
+        { "Stochastic", Factory::STOCHASTIC },
+        { "Sorted", Factory::SORTED },
+        { "Presorted", Factory::PRESORTED }
+    };
+
+    //!< window depth range of the model scaled to 100 units in the [-1000, 1000] depth range of the camera
+    constexpr GLfloat MODEL_DEPTH_NEAR{ 0.45f };
+    constexpr GLfloat MODEL_DEPTH_FAR{ 0.55f };
+}
+
+namespace gui::gl
+{
+
+    //---------------------------------------------------------------------------------------
+    QStringList TransparencyEngineFactory::names(void)
+    //---------------------------------------------------------------------------------------
+    {
+        QStringList names;
+        for (const auto& [name, engine] : NAMES)
+        {
+            names.append(name);
+        }
+        return names;
+    }
+
+    //---------------------------------------------------------------------------------------
+    TransparencyEngineFactory::Engine TransparencyEngineFactory::engine(const QString& p_name)
+    //---------------------------------------------------------------------------------------
+    {
+        const auto it{ std::find_if(std::begin(NAMES), std::end(NAMES), [&p_name](const auto& p_entry) { return p_name == p_entry.first; }) };
+        return it != std::end(NAMES) ? it->second : ENGINE_COUNT;
+    }
+
+    //---------------------------------------------------------------------------------------
+    QString TransparencyEngineFactory::name(Engine p_engine)
+    //---------------------------------------------------------------------------------------
+    {
+        const auto it{ std::find_if(std::begin(NAMES), std::end(NAMES), [p_engine](const auto& p_entry) { return p_engine == p_entry.second; }) };
+        return it != std::end(NAMES) ? QString(it->first) : QString();
+    }
+
+    //---------------------------------------------------------------------------------------
+    bool TransparencyEngineFactory::isSupported(Engine p_engine, const QOpenGLContext* p_context)
+    //---------------------------------------------------------------------------------------
+    {
+        switch (p_engine)
+        {
+        case A_BUFFER:
+            return ABufferRenderer::isSupported(p_context);
+        case ENGINE_COUNT:
+            return false;
+        default:
+            return true;
+        }
+    }
+
+    //---------------------------------------------------------------------------------------
+    std::unique_ptr<TransparencyRenderer> TransparencyEngineFactory::create(const QString& p_name, const Scene& p_scene, const Camera& p_camera)
+    //---------------------------------------------------------------------------------------
+    {
+        std::unique_ptr<TransparencyRenderer> renderer;
+        switch (engine(p_name))
+        {
+        case DUAL_DEPTH_PEELING:
+            renderer = std::make_unique<DualDepthPeelingRenderer>(p_scene, p_camera);
+            break;
+        case WEIGHTED_BLENDED:
+            renderer = std::make_unique<WeightedBlendedRenderer>(p_scene, p_camera);
+            break;
+        case A_BUFFER:
+            renderer = std::make_unique<ABufferRenderer>(p_scene, p_camera);
+            break;
+        case MOMENTS:
+            renderer = std::make_unique<MomentTransparencyRenderer>(p_scene, p_camera);
+            break;
+        case MULTI_LAYER_PEELING:
+            renderer = std::make_unique<MultiLayerPeelingRenderer>(p_scene, p_camera);
+            break;
+        case STOCHASTIC:
+            renderer = std::make_unique<StochasticTransparencyRenderer>(p_scene, p_camera);
+            break;
+        case SORTED:
+        case PRESORTED:
+            renderer = std::make_unique<SortedTransparencyRenderer>(p_scene, p_camera);
+            break;
+        case ENGINE_COUNT:
+            return nullptr;
+        }
+
+        configure(p_name, *renderer);
+        return renderer;
+    }
+
+    //---------------------------------------------------------------------------------------
+    bool TransparencyEngineFactory::configure(const QString& p_name, TransparencyRenderer& p_renderer)
+    //---------------------------------------------------------------------------------------
+    {
+        switch (engine(p_name))
+        {
+        case DUAL_DEPTH_PEELING:
+            if (auto* const renderer{ dynamic_cast<DualDepthPeelingRenderer*>(&p_renderer) })
+            {
+                renderer->setNonStallingQueryEnable(p_name == "DualDepthPeelingNonStalling");
+                renderer->setStencilMaskEnable(p_name == "DualDepthPeelingStencilMask");
+                renderer->setFusedBackBlendEnable(p_name == "DualDepthPeelingFused");
+                return true;
+            }
+            break;
+        case WEIGHTED_BLENDED:
+            if (auto* const renderer{ dynamic_cast<WeightedBlendedRenderer*>(&p_renderer) })
+            {
+                renderer->setWeightDepthRange(MODEL_DEPTH_NEAR, MODEL_DEPTH_FAR);
+                renderer->setHalfFloatTargetsEnable(p_name == "WeightedBlendedHalfFloat");
+                return true;
+            }
+            break;
+        case MOMENTS:
+            if (auto* const renderer{ dynamic_cast<MomentTransparencyRenderer*>(&p_renderer) })
+            {
+                renderer->setMomentDepthRange(MODEL_DEPTH_NEAR, MODEL_DEPTH_FAR);
+                return true;
+            }
+            break;
+        case MULTI_LAYER_PEELING:
+            if (auto* const renderer{ dynamic_cast<MultiLayerPeelingRenderer*>(&p_renderer) })
+            {
+                renderer->setLayersPerPass(p_name == "MultiLayerPeeling7" ? 7 : 4);
+                return true;
+            }
+            break;
+        case SORTED:
+        case PRESORTED:
+            if (auto* const renderer{ dynamic_cast<SortedTransparencyRenderer*>(&p_renderer) })
+            {
+                renderer->setPresortedModeEnable(p_name == "Presorted");
+                return true;
+            }
+            break;
+        case ENGINE_COUNT:
+            break;
+        default:
+            return true; // no setting
+        }
+
+        qCritical() << "Transparency engine" << p_name << "is unknown or does not match the renderer";
+        return false;
+    }
+
+}
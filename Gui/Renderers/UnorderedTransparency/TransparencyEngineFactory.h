@@ -0,0 +1,57 @@
+#pragma once
+
+#include <QtCore/QStringList>
+
+#include <memory>
+
+class QOpenGLContext;
+
+namespace gui
+{
+    class Camera;
+    class Scene;
+}
+
+namespace gui::gl
+{
+    class TransparencyRenderer;
+
+    /**
+     * \class TransparencyEngineFactory
+     * \brief Names, construction and settings of the transparency engines, shared by MainWidget and OffscreenRenderer
+     *
+     * A name is an engine and its settings (ex. "MultiLayerPeeling4" and "MultiLayerPeeling7" are the same engine with
+     * 4 or 7 layers by pass). The dual depth peeling names after "DualDepthPeeling" each enable one option of the engine
+     * to compare it with the default one: the non stalling queries, the transmittance stencil mask, the back blend fused
+     * in the peel pass.
+     * The settings which depend on the scene convention of the application (a model scaled to 100 units in the
+     * [-1000, 1000] depth range of the camera) are applied with the settings of the name.
+     */
+    class TransparencyEngineFactory
+    {
+    public:
+        //!< Order independent transparency techniques, a renderer instance by engine
+        enum Engine { DUAL_DEPTH_PEELING, WEIGHTED_BLENDED, A_BUFFER, MOMENTS, MULTI_LAYER_PEELING, STOCHASTIC, SORTED, PRESORTED, ENGINE_COUNT };
+
+        //!< Directions of the orders sorted at initialization by the presorted engine (MeshRenderer::setPresortedDirectionCount)
+        static constexpr int PRESORTED_DIRECTION_COUNT{ 26 };
+
+        TransparencyEngineFactory(void) = delete;
+
+        //!< All the names, the exact reference (dual depth peeling) first: the candidates of the calibration
+        static QStringList names(void);
+        //!< Engine of p_name, ENGINE_COUNT if unknown
+        static Engine engine(const QString& p_name);
+        //!< Name of the default settings of p_engine
+        static QString name(Engine p_engine);
+
+        //!< false if p_context is too old for p_engine
+        static bool isSupported(Engine p_engine, const QOpenGLContext* p_context);
+
+        //!< New engine of p_name with its settings, nullptr if the name is unknown
+        static std::unique_ptr<TransparencyRenderer> create(const QString& p_name, const Scene& p_scene, const Camera& p_camera);
+        //!< Apply the settings of p_name to p_renderer, an engine of engine(p_name). false otherwise
+        static bool configure(const QString& p_name, TransparencyRenderer& p_renderer);
+    };
+
+}
@@ -1,6 +1,7 @@
 #include "Renderers/UnorderedTransparency/TransparencyRenderer.h"
 
 #include "GLWidgets/Scene.h"
+#include "Renderers/GpuProfiler.h"
 
 #include <QtCore/QDebug>
 
@@ -269,7 +270,7 @@ namespace gui::gl
     }
 
     //---------------------------------------------------------------------------------------
-    void TransparencyRenderer::bindTexture(QOpenGLShaderProgram& p_program, const QString& p_texname, GLuint p_texid, GLint p_texunit)
+    void TransparencyRenderer::bindTexture(ShaderProgram& p_program, const QString& p_texname, GLuint p_texid, GLint p_texunit)
     //---------------------------------------------------------------------------------------
     {
         p_program.setUniformValue(p_texname.toStdString().c_str(), p_texunit);
@@ -286,6 +287,28 @@ namespace gui::gl
         glBindTexture(USING_GL_TEXTURE, 0);
     }
 
+    //---------------------------------------------------------------------------------------
+    QList<MeshRenderer*> TransparencyRenderer::meshRenderers(void) const
+    //---------------------------------------------------------------------------------------
+    {
+        QList<MeshRenderer*> renderers;
+        for (MeshRenderer* const renderer : m_transparencyRendererMap)
+        {
+            if (renderer != nullptr)
+            {
+                renderers.append(renderer);
+            }
+        }
+        for (AbstractRenderer* const renderer : m_opaqueRendererMap)
+        {
+            if (auto* const meshRenderer{ dynamic_cast<MeshRenderer*>(renderer) })
+            {
+                renderers.append(meshRenderer);
+            }
+        }
+        return renderers;
+    }
+
     //---------------------------------------------------------------------------------------
     void TransparencyRenderer::render(void)
     //---------------------------------------------------------------------------------------
@@ -312,9 +335,28 @@ namespace gui::gl
             return;
         }
 
+        // the camera does not move during the frame: the meshes are tested once for all the passes of the engine
+        const QList<MeshRenderer*> frameRenderers{ meshRenderers() };
+        const geom::Frustum frustum{ viewFrustum() };
+        for (MeshRenderer* const renderer : frameRenderers)
+        {
+            renderer->setFrameFrustum(frustum);
+        }
+
+        GpuProfiler* const profiler{ gpuProfiler() };
+        if (profiler != nullptr)
+        {
+            profiler->beginFrame();
+        }
+#ifdef DEBUG_GL_CALL_COUNTERS
+        GlCallCounters::beginFrame();
+#endif
+
         // ---------------------------------------------------------------------
         // 0. Render Opaque Targets
         // ---------------------------------------------------------------------
+        beginGpuStage("opaque color");
+
         glDisable(GL_CULL_FACE);
         glEnable(GL_DEPTH_TEST);
         if (m_antiAliasing)
@@ -326,7 +368,13 @@ namespace gui::gl
         // Another work around is to delete and recreate the GL texture
         // https://community.intel.com/t5/Graphics/OpenGL-default-framebuffer-dimensions-not-updated-until-glClear/m-p/1195846
         // using glClear on the default framebuffer force the GPU buffer to an update
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        // bound explicitly: the final pass of the previous frame leaves the output framebuffer bound, which is not the
+        // default one offscreen (setOutputFramebuffer) and needs no work around
+        if (outputFramebuffer() == 0u)
+        {
+            bindOutputFramebuffer();
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        }
 
         glBindFramebuffer(GL_FRAMEBUFFER, m_opaqueFramebufferFboId);
 
@@ -338,6 +386,7 @@ namespace gui::gl
         }
 
         // render to depth texture
+        beginGpuStage("opaque depth");
         glBindFramebuffer(GL_FRAMEBUFFER, m_opaqueDepthFramebufferId);
 
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
@@ -348,10 +397,23 @@ namespace gui::gl
 
         renderTransparentObjects();
 
+        for (MeshRenderer* const renderer : frameRenderers)
+        {
+            renderer->resetFrameFrustum();
+        }
+
         if (m_antiAliasing)
         {
             glDisable(GL_MULTISAMPLE);
         }
+
+        if (profiler != nullptr)
+        {
+            profiler->endFrame();
+        }
+#ifdef DEBUG_GL_CALL_COUNTERS
+        GlCallCounters::endFrame();
+#endif
     }
 
 }
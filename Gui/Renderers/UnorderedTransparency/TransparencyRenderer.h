@@ -74,7 +74,7 @@ namespace gui::gl
 
         void drawFullScreenQuad(void); //!< bind texture in 2 screen triangles
 
-        void bindTexture(QOpenGLShaderProgram& p_program, const QString& p_texname, GLuint p_texid, GLint p_texunit);
+        void bindTexture(ShaderProgram& p_program, const QString& p_texname, GLuint p_texid, GLint p_texunit);
         void unbindTexture(GLint p_texunit);
 
         GLuint m_opaqueTexId;
@@ -88,6 +88,8 @@ namespace gui::gl
         QHash<QString, MeshRenderer*> m_transparencyRendererMap;
 
     private:
+        QList<MeshRenderer*> meshRenderers(void) const; //!< transparent and opaque renderers which draw a mesh
+
         GLuint m_quadVertexArrayId, m_quadPositionBufferId;
 
         QHash<QString, AbstractRenderer*> m_opaqueRendererMap;
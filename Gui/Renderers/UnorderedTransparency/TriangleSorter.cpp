@@ -0,0 +1,313 @@
+#include "Renderers/UnorderedTransparency/TriangleSorter.h"
+
+#include <Geom/Vec4Simd.h> // GEOM_SIMD_AVX, GEOM_SIMD_SSE2 and their intrinsics
+#include <Mesh/MeshModel.h>
+
+#include <QtConcurrent/QtConcurrentMap>
+#include <QtCore/QThread>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <functional>
+#include <numeric>
+
+namespace
+{
+    //!< unsigned integer with the same order as the float
+    inline uint32_t sortableKey(float p_value)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &p_value, sizeof bits);
+        return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+    }
+
+    //!< range of keys sorted by one thread
+    struct RadixChunk
+    {
+        size_t begin;
+        size_t end;
+        std::array<size_t, 256> offsets; //!< histogram of the digits, then first destination of each digit
+    };
+}
+
+namespace gui::gl
+{
+
+    //---------------------------------------------------------------------------------------
+    TriangleSorter::TriangleSorter(void)
+        : m_useParallelSort(true)
+        , m_isLastSortIncremental(false)
+    //---------------------------------------------------------------------------------------
+    {
+    }
+
+    //---------------------------------------------------------------------------------------
+    TriangleSorter::~TriangleSorter(void)
+    //---------------------------------------------------------------------------------------
+    {
+    }
+
+    //---------------------------------------------------------------------------------------
+    void TriangleSorter::setMesh(const MeshModel& p_mesh)
+    //---------------------------------------------------------------------------------------
+    {
+        const size_t count{ static_cast<size_t>(p_mesh.faceCount()) };
+        m_centroidX.resize(count);
+        m_centroidY.resize(count);
+        m_centroidZ.resize(count);
+        m_depths.resize(count);
+
+        double sumX{ 0. }, sumY{ 0. }, sumZ{ 0. };
+        for (size_t i = 0; i < count; i++)
+        {
+            double x{ 0. }, y{ 0. }, z{ 0. };
+            for (size_t j = 0; j < 3; j++)
+            {
+                const geom::Point& pt{ p_mesh.vertices()[p_mesh.vtxIndices()[static_cast<int>(3 * i + j)]] };
+                x += pt.x();
+                y += pt.y();
+                z += pt.z();
+            }
+            m_centroidX[i] = static_cast<float>(x / 3.);
+            m_centroidY[i] = static_cast<float>(y / 3.);
+            m_centroidZ[i] = static_cast<float>(z / 3.);
+            sumX += x / 3.;
+            sumY += y / 3.;
+            sumZ += z / 3.;
+        }
+        const double invCount{ count > 0 ? 1. / static_cast<double>(count) : 0. };
+        m_meanCentroid = QVector3D(static_cast<float>(sumX * invCount), static_cast<float>(sumY * invCount), static_cast<float>(sumZ * invCount));
+
+        m_order.resize(count);
+        std::iota(m_order.begin(), m_order.end(), 0u);
+    }
+
+    //---------------------------------------------------------------------------------------
+    void TriangleSorter::sort(const QVector4D& p_depthRow, bool p_incremental)
+    //---------------------------------------------------------------------------------------
+    {
+        computeDepths(p_depthRow, m_depths);
+
+        m_isLastSortIncremental = p_incremental && insertionSort(MAX_MOVES_BY_TRIANGLE * m_order.size());
+        if (!m_isLastSortIncremental)
+        {
+            radixSort(m_depths, m_order, m_radixBuffers, m_useParallelSort);
+        }
+    }
+
+    //---------------------------------------------------------------------------------------
+    void TriangleSorter::sortElementIndices(const QVector4D& p_depthRow, GLuint* p_indices) const
+    //---------------------------------------------------------------------------------------
+    {
+        // the buffers of the sort are local, the centroids are shared
+        std::vector<float> depths;
+        std::vector<GLuint> order;
+        RadixBuffers buffers;
+        computeDepths(p_depthRow, depths);
+        radixSort(depths, order, buffers, false);
+        fillElementIndices(order, p_indices);
+    }
+
+    //---------------------------------------------------------------------------------------
+    float TriangleSorter::averageDepth(const QVector4D& p_depthRow) const
+    //---------------------------------------------------------------------------------------
+    {
+        return QVector4D::dotProduct(p_depthRow, QVector4D(m_meanCentroid, 1.f));
+    }
+
+    //---------------------------------------------------------------------------------------
+    void TriangleSorter::fillElementIndices(std::vector<GLuint>& p_indices) const
+    //---------------------------------------------------------------------------------------
+    {
+        p_indices.resize(3 * m_order.size());
+        fillElementIndices(m_order, p_indices.data());
+    }
+
+    //---------------------------------------------------------------------------------------
+    void TriangleSorter::fillElementIndices(const std::vector<GLuint>& p_order, GLuint* p_indices)
+    //---------------------------------------------------------------------------------------
+    {
+        for (size_t i = 0; i < p_order.size(); i++)
+        {
+            const GLuint firstVertex{ 3 * p_order[i] };
+            p_indices[3 * i + 0] = firstVertex + 0;
+            p_indices[3 * i + 1] = firstVertex + 1;
+            p_indices[3 * i + 2] = firstVertex + 2;
+        }
+    }
+
+    //---------------------------------------------------------------------------------------
+    size_t TriangleSorter::countAdjacentInversions(const QVector4D& p_depthRow)
+    //---------------------------------------------------------------------------------------
+    {
+        computeDepths(p_depthRow, m_depths);
+
+        size_t inversionCount{ 0 };
+        for (size_t i = 1; i < m_order.size(); i++)
+        {
+            if (m_depths[m_order[i - 1]] > m_depths[m_order[i]])
+            {
+                inversionCount++;
+            }
+        }
+        return inversionCount;
+    }
+
+    //---------------------------------------------------------------------------------------
+    void TriangleSorter::computeDepths(const QVector4D& p_depthRow, std::vector<float>& p_depths) const
+    //---------------------------------------------------------------------------------------
+    {
+        const float a{ p_depthRow.x() }, b{ p_depthRow.y() }, c{ p_depthRow.z() }, d{ p_depthRow.w() };
+        const size_t count{ m_centroidX.size() };
+        p_depths.resize(count);
+        const float* const x{ m_centroidX.data() };
+        const float* const y{ m_centroidY.data() };
+        const float* const z{ m_centroidZ.data() };
+        float* const depths{ p_depths.data() };
+
+        // same instruction set as geom::simd, the operations are done in the order of the scalar loop
+        size_t i{ 0 };
+#if defined(GEOM_SIMD_AVX)
+        const __m256 a8{ _mm256_set1_ps(a) }, b8{ _mm256_set1_ps(b) }, c8{ _mm256_set1_ps(c) }, d8{ _mm256_set1_ps(d) };
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256 depth8{ _mm256_add_ps(_mm256_mul_ps(a8, _mm256_loadu_ps(x + i)), _mm256_mul_ps(b8, _mm256_loadu_ps(y + i))) };
+            depth8 = _mm256_add_ps(depth8, _mm256_mul_ps(c8, _mm256_loadu_ps(z + i)));
+            _mm256_storeu_ps(depths + i, _mm256_add_ps(depth8, d8));
+        }
+#elif defined(GEOM_SIMD_SSE2)
+        const __m128 a4{ _mm_set1_ps(a) }, b4{ _mm_set1_ps(b) }, c4{ _mm_set1_ps(c) }, d4{ _mm_set1_ps(d) };
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128 depth4{ _mm_add_ps(_mm_mul_ps(a4, _mm_loadu_ps(x + i)), _mm_mul_ps(b4, _mm_loadu_ps(y + i))) };
+            depth4 = _mm_add_ps(depth4, _mm_mul_ps(c4, _mm_loadu_ps(z + i)));
+            _mm_storeu_ps(depths + i, _mm_add_ps(depth4, d4));
+        }
+#endif
+        // last centroids, or all of them without SIMD
+        for (; i < count; i++)
+        {
+            depths[i] = a * x[i] + b * y[i] + c * z[i] + d;
+        }
+    }
+
+    //---------------------------------------------------------------------------------------
+    bool TriangleSorter::insertionSort(size_t p_maxMoves)
+    //---------------------------------------------------------------------------------------
+    {
+        size_t moveCount{ 0 };
+        for (size_t i = 1; i < m_order.size(); i++)
+        {
+            const GLuint triangleId{ m_order[i] };
+            const float depth{ m_depths[triangleId] };
+            size_t j{ i };
+            while (j > 0 && m_depths[m_order[j - 1]] > depth)
+            {
+                m_order[j] = m_order[j - 1];
+                j--;
+
+                if (++moveCount > p_maxMoves)
+                {
+                    m_order[j] = triangleId;
+                    return false;
+                }
+            }
+            m_order[j] = triangleId;
+        }
+
+        return true;
+    }
+
+    //---------------------------------------------------------------------------------------
+    void TriangleSorter::radixSort(const std::vector<float>& p_depths, std::vector<GLuint>& p_order, RadixBuffers& p_buffers, bool p_isParallel)
+    //---------------------------------------------------------------------------------------
+    {
+        const size_t count{ p_depths.size() };
+        p_order.resize(count);
+        p_buffers.keys.resize(count);
+        p_buffers.tmpKeys.resize(count);
+        p_buffers.tmpOrder.resize(count);
+        for (size_t i = 0; i < count; i++)
+        {
+            p_order[i] = static_cast<GLuint>(i);
+            p_buffers.keys[i] = sortableKey(p_depths[i]);
+        }
+
+        const size_t chunkCount{ (!p_isParallel || count < PARALLEL_SORT_MIN_SIZE) ? 1 : static_cast<size_t>(std::max(QThread::idealThreadCount(), 1)) };
+        std::vector<RadixChunk> chunks(chunkCount);
+        for (size_t i = 0; i < chunkCount; i++)
+        {
+            chunks[i].begin = (count * i) / chunkCount;
+            chunks[i].end = (count * (i + 1)) / chunkCount;
+        }
+        const auto forEachChunk = [&chunks](const std::function<void(RadixChunk&)>& p_function)
+        {
+            if (chunks.size() == 1)
+            {
+                p_function(chunks.front());
+            }
+            else
+            {
+                QtConcurrent::blockingMap(chunks, p_function);
+            }
+        };
+
+        uint32_t* srcKeys{ p_buffers.keys.data() };
+        uint32_t* dstKeys{ p_buffers.tmpKeys.data() };
+        GLuint* srcOrder{ p_order.data() };
+        GLuint* dstOrder{ p_buffers.tmpOrder.data() };
+
+        // least significant digit first, each pass is stable
+        for (uint32_t shift = 0; shift < 32; shift += 8)
+        {
+            forEachChunk([&srcKeys, shift](RadixChunk& p_chunk)
+                {
+                    p_chunk.offsets.fill(0);
+                    for (size_t i = p_chunk.begin; i < p_chunk.end; i++)
+                    {
+                        p_chunk.offsets[(srcKeys[i] >> shift) & 0xFFu]++;
+                    }
+                });
+
+            // the depths of a mesh often share their high digits
+            bool isPassNeeded{ true };
+            size_t offset{ 0 };
+            for (size_t digit = 0; digit < 256; digit++)
+            {
+                size_t digitCount{ 0 };
+                for (RadixChunk& chunk : chunks)
+                {
+                    const size_t chunkDigitCount{ chunk.offsets[digit] };
+                    chunk.offsets[digit] = offset + digitCount;
+                    digitCount += chunkDigitCount;
+                }
+                isPassNeeded = isPassNeeded && digitCount != count;
+                offset += digitCount;
+            }
+            if (!isPassNeeded)
+            {
+                continue;
+            }
+
+            forEachChunk([&srcKeys, &dstKeys, &srcOrder, &dstOrder, shift](RadixChunk& p_chunk)
+                {
+                    for (size_t i = p_chunk.begin; i < p_chunk.end; i++)
+                    {
+                        const size_t dst{ p_chunk.offsets[(srcKeys[i] >> shift) & 0xFFu]++ };
+                        dstKeys[dst] = srcKeys[i];
+                        dstOrder[dst] = srcOrder[i];
+                    }
+                });
+
+            std::swap(srcKeys, dstKeys);
+            std::swap(srcOrder, dstOrder);
+        }
+
+        if (srcOrder != p_order.data())
+        {
+            p_order.swap(p_buffers.tmpOrder);
+        }
+    }
+
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <QtGui/qopengl.h>
+#include <QtGui/QVector3D>
+#include <QtGui/QVector4D>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class MeshModel;
+
+namespace gui::gl
+{
+
+    /*
+     * \class TriangleSorter
+     * \brief Sort the triangles of a MeshModel back to front
+     *
+     * The triangles are sorted by the view depth of their centroid (z = depthRow . (centroid, 1), the camera looks
+     * toward -z) with a parallel radix sort. When the view changed a little, the previous order is nearly sorted and
+     * an insertion sort is cheaper, it falls back to the radix sort if too many triangles move.
+     * The mesh is not indexed (MeshRenderer draws the vertices 3i, 3i + 1 and 3i + 2 for the triangle i).
+     *
+    */
+    class TriangleSorter
+    {
+    public:
+        explicit TriangleSorter(void);
+        virtual ~TriangleSorter(void);
+
+        void setMesh(const MeshModel& p_mesh); //!< compute the centroids, the order is reset
+        inline int triangleCount(void) const { return static_cast<int>(m_order.size()); }
+        //!< Split the radix sort of large meshes on the threads of the pool (default true), disable it if the sorters already run in parallel
+        inline void setParallelSortEnable(bool p_isEnabled) { m_useParallelSort = p_isEnabled; }
+
+        //!< Sort along the view depth row (third row of the ModelView matrix)
+        //!< p_incremental: start from the previous order, to use when the view changed a little
+        void sort(const QVector4D& p_depthRow, bool p_incremental);
+        inline bool isLastSortIncremental(void) const { return m_isLastSortIncremental; } //!< false if the radix sort was used
+        float averageDepth(const QVector4D& p_depthRow) const; //!< depth of the mean centroid, to sort several meshes back to front
+
+        inline const std::vector<GLuint>& order(void) const { return m_order; } //!< triangle ids, farthest first
+        void fillElementIndices(std::vector<GLuint>& p_indices) const; //!< 3 vertex indices by triangle, in the sorted order
+        //!< Sort along p_depthRow into p_indices (3 * triangleCount() vertex indices) without changing the order of the sorter,
+        //!< several threads can sort the same mesh along different rows
+        void sortElementIndices(const QVector4D& p_depthRow, GLuint* p_indices) const;
+        //!< Error of the current order for another view: number of consecutive triangles in the wrong order
+        size_t countAdjacentInversions(const QVector4D& p_depthRow);
+
+    private:
+        struct RadixBuffers
+        {
+            std::vector<GLuint> tmpOrder;
+            std::vector<uint32_t> keys;
+            std::vector<uint32_t> tmpKeys;
+        };
+
+        void computeDepths(const QVector4D& p_depthRow, std::vector<float>& p_depths) const;
+        bool insertionSort(size_t p_maxMoves); //!< false if it stopped after p_maxMoves moves
+        //!< p_order: the triangle ids sorted by p_depths
+        static void radixSort(const std::vector<float>& p_depths, std::vector<GLuint>& p_order, RadixBuffers& p_buffers, bool p_isParallel);
+        static void fillElementIndices(const std::vector<GLuint>& p_order, GLuint* p_indices);
+
+        std::vector<float> m_centroidX; //!< structure of arrays for the SIMD depth computation (4 or 8 centroids by step)
+        std::vector<float> m_centroidY;
+        std::vector<float> m_centroidZ;
+        std::vector<float> m_depths; //!< by triangle id
+
+        std::vector<GLuint> m_order;
+        RadixBuffers m_radixBuffers;
+
+        bool m_useParallelSort;
+        bool m_isLastSortIncremental;
+        QVector3D m_meanCentroid;
+
+        static constexpr size_t MAX_MOVES_BY_TRIANGLE = 4; //!< budget of the insertion sort
+        static constexpr size_t PARALLEL_SORT_MIN_SIZE = 1 << 16; //!< under this count, the threads cost more than they save
+    };
+
+}
@@ -0,0 +1,180 @@
+#include "Renderers/UnorderedTransparency/WeightedBlendedRenderer.h"
+
+#include "GLWidgets/Camera.h"
+#include "GLWidgets/Scene.h"
+
+#include <QtCore/QDebug>
+
+namespace gui::gl
+{
+
+    //---------------------------------------------------------------------------------------
+    WeightedBlendedRenderer::WeightedBlendedRenderer(const Scene& p_scene, const Camera& p_camera) : TransparencyRenderer(p_scene, p_camera)
+        , m_weightDepthRange(0.f, 1.f)
+        , m_useHalfFloatTargets(false)
+        , m_accumulationFboId(0)
+        , m_accumulationTexId(0)
+        , m_weightTexId(0)
+    //---------------------------------------------------------------------------------------
+    {
+    }
+
+    //---------------------------------------------------------------------------------------
+    WeightedBlendedRenderer::~WeightedBlendedRenderer(void)
+    //---------------------------------------------------------------------------------------
+    {
+    }
+
+    //---------------------------------------------------------------------------------------
+    bool WeightedBlendedRenderer::isRenderTargetsInitialized(void) const
+    //---------------------------------------------------------------------------------------
+    {
+        if (!TransparencyRenderer::isRenderTargetsInitialized())
+        {
+            return false;
+        }
+
+        return (m_accumulationFboId != 0u && m_accumulationTexId != 0u && m_weightTexId != 0u);
+    }
+
+    //---------------------------------------------------------------------------------------
+    bool WeightedBlendedRenderer::updateTransparentRenderTargets()
+    //---------------------------------------------------------------------------------------
+    {
+        glBindTexture(USING_GL_TEXTURE, m_accumulationTexId);
+        glTexImage2D(USING_GL_TEXTURE, 0, m_useHalfFloatTargets ? GL_RGBA16F : GL_RGBA32F, m_width, m_height, 0, GL_RGBA, GL_FLOAT, nullptr);
+
+        glBindTexture(USING_GL_TEXTURE, m_weightTexId);
+        glTexImage2D(USING_GL_TEXTURE, 0, m_useHalfFloatTargets ? GL_R16F : GL_R32F, m_width, m_height, 0, GL_RED, GL_FLOAT, nullptr);
+
+        return true;
+    }
+
+    //---------------------------------------------------------------------------------------
+    bool WeightedBlendedRenderer::initTransparentRenderTargets()
+    //---------------------------------------------------------------------------------------
+    {
+        glGenTextures(1, &m_accumulationTexId);
+        glBindTexture(USING_GL_TEXTURE, m_accumulationTexId);
+        glTexParameteri(USING_GL_TEXTURE, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+        glTexParameteri(USING_GL_TEXTURE, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+        glTexParameteri(USING_GL_TEXTURE, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(USING_GL_TEXTURE, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexImage2D(USING_GL_TEXTURE, 0, m_useHalfFloatTargets ? GL_RGBA16F : GL_RGBA32F, m_width, m_height, 0, GL_RGBA, GL_FLOAT, nullptr);
+
+        glGenTextures(1, &m_weightTexId);
+        glBindTexture(USING_GL_TEXTURE, m_weightTexId);
+        glTexParameteri(USING_GL_TEXTURE, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+        glTexParameteri(USING_GL_TEXTURE, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+        glTexParameteri(USING_GL_TEXTURE, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(USING_GL_TEXTURE, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexImage2D(USING_GL_TEXTURE, 0, m_useHalfFloatTargets ? GL_R16F : GL_R32F, m_width, m_height, 0, GL_RED, GL_FLOAT, nullptr);
+
+        glGenFramebuffers(1, &m_accumulationFboId);
+        glBindFramebuffer(GL_FRAMEBUFFER, m_accumulationFboId);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, USING_GL_TEXTURE, m_accumulationTexId, 0);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, USING_GL_TEXTURE, m_weightTexId, 0);
+
+        // the depth test rejects the transparent fragments behind the opaque objects, without writing the depth
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, USING_GL_TEXTURE, m_opaqueDepthTexId, 0);
+
+        return true;
+    }
+
+    //---------------------------------------------------------------------------------------
+    void WeightedBlendedRenderer::deleteRenderTargets(void)
+    //---------------------------------------------------------------------------------------
+    {
+        TransparencyRenderer::deleteRenderTargets();
+
+        glDeleteFramebuffers(1, &m_accumulationFboId);
+        glDeleteTextures(1, &m_accumulationTexId);
+        glDeleteTextures(1, &m_weightTexId);
+    }
+
+    //---------------------------------------------------------------------------------------
+    bool WeightedBlendedRenderer::initShaders(void)
+    //---------------------------------------------------------------------------------------
+    {
+        bool isOk{ loadShaders(m_shaderAccumulation,
+            { MultipleLightsRenderer::shadeVertex(), "Shaders:UnorderedTransparency/peel_vertex.glsl" },
+            { MultipleLightsRenderer::shadeFragment(), "Shaders:UnorderedTransparency/wboit_accum_fragment.glsl" })
+        };
+
+        isOk &= loadShaders(m_shaderComposite, { quadVertex() }, { "Shaders:UnorderedTransparency/wboit_composite_fragment.glsl" });
+
+        return isOk;
+    }
+
+    //---------------------------------------------------------------------------------------
+    void WeightedBlendedRenderer::deleteShaders(void)
+    //---------------------------------------------------------------------------------------
+    {
+        m_shaderAccumulation.removeAllShaders();
+        m_shaderComposite.removeAllShaders();
+    }
+
+    //---------------------------------------------------------------------------------------
+    void WeightedBlendedRenderer::renderTransparentObjects(void)
+    //---------------------------------------------------------------------------------------
+    {
+        // ---------------------------------------------------------------------
+        // 1. Accumulate the transparent fragments
+        // ---------------------------------------------------------------------
+        beginGpuStage("accumulation");
+
+        glBindFramebuffer(GL_FRAMEBUFFER, m_accumulationFboId);
+
+        // revealage starts at 1 (nothing hides the background), the sums at 0
+        glDrawBuffer(DRAW_BUFFERS[0]);
+        glClearColor(0, 0, 0, 1);
+        glClear(GL_COLOR_BUFFER_BIT);
+        glDrawBuffer(DRAW_BUFFERS[1]);
+        glClearColor(0, 0, 0, 0);
+        glClear(GL_COLOR_BUFFER_BIT);
+
+        glDrawBuffers(2, DRAW_BUFFERS.data());
+
+        glEnable(GL_DEPTH_TEST);
+        glDepthMask(GL_FALSE);
+        glEnable(GL_BLEND);
+        glBlendEquation(GL_FUNC_ADD);
+        // GL 3.3 has no blend function by draw buffer: the colors are added on both targets
+        // and the alpha of the target 0 is multiplied by (1 - alpha)
+        glBlendFuncSeparate(GL_ONE, GL_ONE, GL_ZERO, GL_ONE_MINUS_SRC_ALPHA);
+
+        for (MeshRenderer* const renderer : m_transparencyRendererMap)
+        {
+            renderer->renderMesh(m_shaderAccumulation, true,
+                [this]()
+                {
+                    m_shaderAccumulation.setUniformValue("DepthRange", m_weightDepthRange);
+                });
+        }
+
+        glDepthMask(GL_TRUE);
+        glDisable(GL_DEPTH_TEST);
+
+        // ---------------------------------------------------------------------
+        // 2. Composite with the opaque objects
+        // ---------------------------------------------------------------------
+        beginGpuStage("final");
+
+        bindOutputFramebuffer();
+        glDisable(GL_BLEND);
+
+        m_shaderComposite.bind();
+        m_shaderComposite.setUniformValue("BackgroundColor", m_backgroundColor);
+        bindTexture(m_shaderComposite, "OpaqueTex", m_opaqueTexId, 0);
+        bindTexture(m_shaderComposite, "AccumulationTex", m_accumulationTexId, 1);
+        bindTexture(m_shaderComposite, "WeightTex", m_weightTexId, 2);
+        drawFullScreenQuad();
+        unbindTexture(0);
+        unbindTexture(1);
+        unbindTexture(2);
+        m_shaderComposite.release();
+
+        glEnable(GL_DEPTH_TEST);
+    }
+
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "Renderers/UnorderedTransparency/TransparencyRenderer.h"
+
+#include <QtGui/QVector2D>
+
+#include <array>
+
+namespace gui::gl
+{
+
+    /*
+     * \class WeightedBlendedRenderer
+     * \brief Render a RMeshModel with transparency
+     *
+     * Class to make approximated independent transparency with Weighted Blended technique (McGuire and Bavoil):
+     * one geometry pass accumulates the transparent fragments with a depth weight, then one full screen pass composites them.
+     * The cost does not depend on the depth complexity but the order of the layers is only approximated.
+     *
+    */
+    class WeightedBlendedRenderer final : public TransparencyRenderer
+    {
+    public:
+        explicit WeightedBlendedRenderer(const Scene& p_scene, const Camera& p_camera);
+        virtual ~WeightedBlendedRenderer(void);
+
+        //!< Window depth range where the weight of the fragments decreases (default [0, 1])
+        //!< Set it close to the depth range of the transparent objects to sort them better
+        inline void setWeightDepthRange(GLfloat p_near, GLfloat p_far) { m_weightDepthRange = QVector2D(p_near, p_far); }
+        //!< Accumulate in 16 bits float targets: half the bandwidth, but the sums overflow on deep scenes (default false)
+        inline void setHalfFloatTargetsEnable(bool p_isEnabled) { if (m_useHalfFloatTargets != p_isEnabled) { m_useHalfFloatTargets = p_isEnabled; requestUpdateRenderTargets(); } }
+        inline bool isHalfFloatTargets(void) const { return m_useHalfFloatTargets; }
+
+    protected:
+        void renderTransparentObjects(void) override;
+
+        bool isRenderTargetsInitialized(void) const override;
+        bool updateTransparentRenderTargets() override;
+        bool initTransparentRenderTargets() override;
+        void deleteRenderTargets(void) override;
+
+        inline bool isShadersInitialized(void) const override { return (m_shaderAccumulation.isLinked() && m_shaderComposite.isLinked()); }
+        bool initShaders(void) override;
+        void deleteShaders(void) override;
+
+    private:
+        ShaderProgram m_shaderAccumulation;
+        ShaderProgram m_shaderComposite;
+
+        QVector2D m_weightDepthRange;
+        bool m_useHalfFloatTargets;
+
+        GLuint m_accumulationFboId; //!< opaque depth texture is attached to reject hidden fragments
+        GLuint m_accumulationTexId; //!< (sum(color * alpha * weight), revealage)
+        GLuint m_weightTexId; //!< sum(alpha * weight)
+
+        static constexpr std::array<GLenum, 2> DRAW_BUFFERS{
+            GL_COLOR_ATTACHMENT0,
+            GL_COLOR_ATTACHMENT1
+        };
+
+        Q_DISABLE_COPY_MOVE(WeightedBlendedRenderer);
+    };
+
+}
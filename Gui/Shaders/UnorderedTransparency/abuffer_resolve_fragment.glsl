@@ -0,0 +1,91 @@
+//--------------------------------------------------------------------------------------
+// Order Independent Transparency with A-Buffer (per pixel linked lists)
+//--------------------------------------------------------------------------------------
+
+#version 430 core
+
+#define END_OF_LIST 0xFFFFFFFFu
+#define MAX_FRAGMENTS 32
+
+layout(binding = 0, r32ui) uniform readonly uimage2DRect HeadPointerImage;
+
+layout(std430, binding = 0) readonly buffer NodeBuffer
+{
+    uvec4 Nodes[];
+};
+
+uniform sampler2DRect OpaqueTex;
+uniform vec3 BackgroundColor;
+uniform int MaxFragments; // sorted fragments by pixel, at most MAX_FRAGMENTS
+uniform uint NodeCapacity;
+
+out vec4 fragColor;
+
+void main(void)
+{
+    vec2 texCoord = gl_FragCoord.xy;
+    vec3 opaqueColor = texture(OpaqueTex, texCoord).rgb;
+    int maxFragments = clamp(MaxFragments, 1, MAX_FRAGMENTS);
+
+    // (packed color, depth) of the nearest fragments of the list
+    uvec2 fragments[MAX_FRAGMENTS];
+    int count = 0;
+    int farthestId = 0;
+
+    uint nodeId = imageLoad(HeadPointerImage, ivec2(texCoord)).r;
+    uint visitCount = 0u;
+    while (nodeId != END_OF_LIST && visitCount < NodeCapacity)
+    {
+        uvec4 node = Nodes[nodeId];
+        if (count < maxFragments)
+        {
+            fragments[count] = node.xy;
+            if (count == 0 || uintBitsToFloat(node.y) > uintBitsToFloat(fragments[farthestId].y))
+            {
+                farthestId = count;
+            }
+            count++;
+        }
+        else if (uintBitsToFloat(node.y) < uintBitsToFloat(fragments[farthestId].y))
+        {
+            // too deep list: keep the nearest fragments, the hidden ones matter less
+            fragments[farthestId] = node.xy;
+            for (int i = 0; i < count; i++)
+            {
+                if (uintBitsToFloat(fragments[i].y) > uintBitsToFloat(fragments[farthestId].y))
+                {
+                    farthestId = i;
+                }
+            }
+        }
+        nodeId = node.z;
+        visitCount++;
+    }
+
+    // insertion sort, front to back
+    for (int i = 1; i < count; i++)
+    {
+        uvec2 fragment = fragments[i];
+        float depth = uintBitsToFloat(fragment.y);
+        int j = i - 1;
+        while (j >= 0 && uintBitsToFloat(fragments[j].y) > depth)
+        {
+            fragments[j + 1] = fragments[j];
+            j--;
+        }
+        fragments[j + 1] = fragment;
+    }
+
+    // front to back blending, same as the dual depth peeling front layers
+    vec3 color = vec3(0.);
+    float transmittance = 1.;
+    for (int i = 0; i < count; i++)
+    {
+        vec4 fragment = unpackUnorm4x8(fragments[i].x);
+        color += fragment.rgb * fragment.a * transmittance;
+        transmittance *= 1. - fragment.a;
+    }
+
+    fragColor.rgb = color + (BackgroundColor + opaqueColor) * transmittance;
+    fragColor.a = 1.;
+}
@@ -0,0 +1,37 @@
+//--------------------------------------------------------------------------------------
+// Order Independent Transparency with A-Buffer (per pixel linked lists)
+//--------------------------------------------------------------------------------------
+
+#version 430 core
+
+// the opaque depth test is done before the list writes
+layout(early_fragment_tests) in;
+
+#define END_OF_LIST 0xFFFFFFFFu
+
+layout(binding = 0, r32ui) uniform coherent uimage2DRect HeadPointerImage;
+layout(binding = 0, offset = 0) uniform atomic_uint NodeCounter;
+
+// node: (packed color, depth, next node, unused)
+layout(std430, binding = 0) writeonly buffer NodeBuffer
+{
+    uvec4 Nodes[];
+};
+
+uniform uint NodeCapacity;
+
+vec4 ShadeFragment();
+
+void main(void)
+{
+    // the counter keeps counting after an overflow to size the buffer of the next frames
+    uint nodeId = atomicCounterIncrement(NodeCounter);
+    if (nodeId >= NodeCapacity)
+    {
+        return;
+    }
+
+    vec4 color = ShadeFragment();
+    uint nextId = imageAtomicExchange(HeadPointerImage, ivec2(gl_FragCoord.xy), nodeId);
+    Nodes[nodeId] = uvec4(packUnorm4x8(color), floatBitsToUint(gl_FragCoord.z), nextId, 0u);
+}
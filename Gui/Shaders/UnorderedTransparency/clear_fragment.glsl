@@ -0,0 +1,23 @@
+//--------------------------------------------------------------------------------------
+// Order Independent Transparency with Dual Depth Peeling
+//
+// Author: Théo Devaucoup
+//--------------------------------------------------------------------------------------
+
+#version 330 core
+
+// Same as glClear but with the stencil test:
+// the pixels out of the transmittance mask keep their last peeled values
+
+layout(location = 0) out vec2 Depth;
+layout(location = 1) out vec4 FrontColor;
+layout(location = 2) out vec4 BackColor;
+
+#define MAX_DEPTH 1.0
+
+void main(void)
+{
+    Depth = vec2(-MAX_DEPTH);
+    FrontColor = vec4(0.);
+    BackColor = vec4(0.);
+}
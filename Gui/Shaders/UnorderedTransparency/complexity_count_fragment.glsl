@@ -0,0 +1,15 @@
+//--------------------------------------------------------------------------------------
+// Depth complexity of the transparent objects
+//--------------------------------------------------------------------------------------
+
+#version 330 core
+
+// One per transparent fragment, summed by an additive blending,
+// the opaque depth is rejected by the depth test of the framebuffer
+
+layout(location = 0) out float FragmentCount;
+
+void main(void)
+{
+    FragmentCount = 1.;
+}
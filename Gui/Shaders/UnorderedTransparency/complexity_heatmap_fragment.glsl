@@ -0,0 +1,34 @@
+//--------------------------------------------------------------------------------------
+// Depth complexity of the transparent objects
+//--------------------------------------------------------------------------------------
+
+#version 330 core
+
+// False colors of the number of transparent fragments by pixel, from blue (one) to red (MaxFragmentCount),
+// the pixels without transparent fragment show the opaque objects darkened
+
+uniform sampler2DRect FragmentCountTex;
+uniform sampler2DRect OpaqueTex;
+uniform vec3 BackgroundColor;
+uniform float MaxFragmentCount;
+
+out vec4 fragColor;
+
+vec3 HeatColor(float t)
+{
+    // blue, cyan, green, yellow, red
+    return clamp(vec3(4. * t - 2., t < 0.5 ? 4. * t : 4. - 4. * t, 2. - 4. * t), 0., 1.);
+}
+
+void main(void)
+{
+    float fragmentCount = texture(FragmentCountTex, gl_FragCoord.xy).r;
+    if (fragmentCount < 0.5)
+    {
+        fragColor = vec4(0.3 * (BackgroundColor + texture(OpaqueTex, gl_FragCoord.xy).rgb), 1.);
+        return;
+    }
+
+    float t = MaxFragmentCount > 1. ? (fragmentCount - 1.) / (MaxFragmentCount - 1.) : 0.;
+    fragColor = vec4(HeatColor(t), 1.);
+}
@@ -0,0 +1,14 @@
+//--------------------------------------------------------------------------------------
+// Depth complexity of the transparent objects
+//--------------------------------------------------------------------------------------
+
+#version 330 core
+
+flat in float Value;
+
+layout(location = 0) out float Bin;
+
+void main(void)
+{
+    Bin = Value;
+}
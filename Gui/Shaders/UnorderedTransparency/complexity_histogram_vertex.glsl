@@ -0,0 +1,27 @@
+//--------------------------------------------------------------------------------------
+// Depth complexity of the transparent objects
+//--------------------------------------------------------------------------------------
+
+#version 330 core
+
+// Histogram reduction without vertex buffer: one point by pixel of the fragment count texture,
+// sent to the texel of its bin in a (BinCount + 1) x 1 target and summed by an additive blending.
+// With ReduceMax, every point goes to the texel BinCount with its count and a GL_MAX blending.
+
+uniform sampler2DRect FragmentCountTex;
+uniform int BinCount; // the last bin counts the pixels with more fragments
+uniform bool ReduceMax;
+
+flat out float Value;
+
+void main(void)
+{
+    int width = textureSize(FragmentCountTex).x;
+    float fragmentCount = texelFetch(FragmentCountTex, ivec2(gl_VertexID % width, gl_VertexID / width)).r;
+
+    int texel = ReduceMax ? BinCount : min(int(fragmentCount), BinCount - 1);
+    Value = ReduceMax ? fragmentCount : 1.;
+
+    // center of the texel in normalized device coordinates
+    gl_Position = vec4(2. * (float(texel) + 0.5) / float(BinCount + 1) - 1., 0., 0., 1.);
+}
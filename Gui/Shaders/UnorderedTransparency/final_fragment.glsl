@@ -9,6 +9,11 @@
 uniform sampler2DRect OpaqueTex;
 uniform sampler2DRect FrontBlenderTex;
 uniform sampler2DRect BackBlenderTex;
+uniform sampler2DRect OtherFrontBlenderTex;
+uniform bool SelectFrontBlender;
+uniform sampler2DRect OtherBackBlenderTex;
+uniform bool FusedBackBlend;
+uniform vec3 BackgroundColor;
 
 //in vec2 texCoord;
 
@@ -19,7 +24,30 @@ void main(void)
     vec2 texCoord = gl_FragCoord.xy;
     vec3 opaqueColor = texture(OpaqueTex, texCoord).rgb;
     vec4 frontColor = texture(FrontBlenderTex, texCoord);
+    if (SelectFrontBlender)
+    {
+        // the last pass is unknown when passes are skipped on the GPU:
+        // front alpha always increases, so the last written front color is the most opaque
+        vec4 otherFrontColor = texture(OtherFrontBlenderTex, texCoord);
+        if (otherFrontColor.w > frontColor.w)
+        {
+            frontColor = otherFrontColor;
+        }
+    }
     vec3 backColor = texture(BackBlenderTex, texCoord).rgb;
+    if (FusedBackBlend)
+    {
+        // back layers are accumulated as (sum(color * alpha / T), 1 - T), see peel_fragment.glsl
+        // the back blenders are not cleared between passes, the last written one is the most opaque
+        vec4 backTemp = texture(BackBlenderTex, texCoord);
+        vec4 otherBackTemp = texture(OtherBackBlenderTex, texCoord);
+        if (otherBackTemp.w > backTemp.w)
+        {
+            backTemp = otherBackTemp;
+        }
+        float backTransmittance = 1. - backTemp.w;
+        backColor = (backTemp.rgb + BackgroundColor) * backTransmittance;
+    }
 
     // mix transparent and opaque objects
     float alphaMultiplier = 1. - frontColor.w;
@@ -0,0 +1,40 @@
+//--------------------------------------------------------------------------------------
+// Order Independent Transparency with Dual Depth Peeling
+//
+// Author: Théo Devaucoup
+//--------------------------------------------------------------------------------------
+
+#version 330 core
+
+// Keep the fragment to remove the pixel from the stencil mask,
+// discard it when the pixel needs another peel pass.
+// With CountRemaining, keep only the pixels with layers left to count them in an occlusion query
+
+uniform sampler2DRect DepthBlenderTex;
+uniform sampler2DRect FrontBlenderTex;
+uniform float TransmittanceEpsilon;
+uniform bool CountRemaining;
+
+void main(void)
+{
+    vec2 texCoord = gl_FragCoord.xy;
+    vec2 depthBlender = texture(DepthBlenderTex, texCoord).xy;
+    float frontAlpha = texture(FrontBlenderTex, texCoord).w;
+
+    // no layer to peel: the min-max depth buffer is still cleared
+    bool isPeeled = -depthBlender.x > depthBlender.y;
+    // the layers behind are hidden by the front layers
+    bool isOpaque = (1. - frontAlpha) < TransmittanceEpsilon;
+
+    if (CountRemaining)
+    {
+        if (isPeeled)
+        {
+            discard;
+        }
+    }
+    else if (!isPeeled && !isOpaque)
+    {
+        discard;
+    }
+}
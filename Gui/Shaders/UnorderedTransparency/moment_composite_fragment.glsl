@@ -0,0 +1,31 @@
+//--------------------------------------------------------------------------------------
+// Order Independent Transparency with Moments
+//--------------------------------------------------------------------------------------
+
+#version 330 core
+
+uniform sampler2DRect OpaqueTex;
+uniform sampler2DRect OpticalDepthTex;
+uniform sampler2DRect AccumulationTex;
+uniform vec3 BackgroundColor;
+
+out vec4 fragColor;
+
+void main(void)
+{
+    vec2 texCoord = gl_FragCoord.xy;
+    vec3 opaqueColor = texture(OpaqueTex, texCoord).rgb;
+    float totalTransmittance = exp(-texture(OpticalDepthTex, texCoord).r);
+    vec4 accumulation = texture(AccumulationTex, texCoord);
+
+    // the reconstructed transmittances are approximated, normalize the colors with the exact total one
+    vec3 color = vec3(0.);
+    if (accumulation.a > 0.)
+    {
+        color = accumulation.rgb / accumulation.a * (1. - totalTransmittance);
+    }
+
+    // same mix as the dual depth peeling: the background is under the opaque objects
+    fragColor.rgb = color + (BackgroundColor + opaqueColor) * totalTransmittance;
+    fragColor.a = 1.;
+}
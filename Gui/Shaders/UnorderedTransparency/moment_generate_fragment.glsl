@@ -0,0 +1,37 @@
+//--------------------------------------------------------------------------------------
+// Order Independent Transparency with Moments
+//--------------------------------------------------------------------------------------
+
+#version 330 core
+
+// First pass: additive sums of the optical depth and of its power moments,
+// the opaque depth is rejected by the depth test of the framebuffer
+
+uniform vec2 DepthRange; // window depth range mapped to [-1, 1]
+uniform int MomentCount; // 4 or 6
+
+layout(location = 0) out float OpticalDepth;
+layout(location = 1) out vec4 Moments1234;
+layout(location = 2) out vec2 Moments56;
+
+#define MAX_ALPHA 0.999
+
+vec4 ShadeFragment();
+
+float MomentDepth(void)
+{
+    float depth = (gl_FragCoord.z - DepthRange.x) / max(DepthRange.y - DepthRange.x, 1e-6);
+    return clamp(2. * depth - 1., -1., 1.);
+}
+
+void main(void)
+{
+    float alpha = ShadeFragment().a;
+    float opticalDepth = -log(1. - min(alpha, MAX_ALPHA));
+
+    float z = MomentDepth();
+    float z2 = z * z;
+    OpticalDepth = opticalDepth;
+    Moments1234 = opticalDepth * vec4(z, z2, z2 * z, z2 * z2);
+    Moments56 = (MomentCount > 4) ? opticalDepth * vec2(z2 * z2 * z, z2 * z2 * z2) : vec2(0.);
+}
@@ -0,0 +1,139 @@
+//--------------------------------------------------------------------------------------
+// Order Independent Transparency with Moments
+//
+// Transmittance reconstruction from power moments of the optical depth,
+// from "Moment-Based Order-Independent Transparency" (Münstermann, Krumpen, Klein and Peters 2018)
+//--------------------------------------------------------------------------------------
+
+#version 330 core
+
+// Real roots of c.x + c.y * z + c.z * z^2 + c.w * z^3, the three roots are assumed real
+vec3 SolveCubic(vec4 c)
+{
+    // normalize the polynomial and divide middle coefficients by three
+    c.xyz /= c.w;
+    c.yz /= 3.;
+
+    // Hessian and discriminant
+    vec3 delta = vec3(
+        -c.z * c.z + c.y,
+        -c.y * c.z + c.x,
+        dot(vec2(c.z, -c.y), c.xy));
+    float discriminant = dot(vec2(4. * delta.x, -delta.y), delta.zy);
+
+    // depressed cubic, take the cubic root of a normalized complex number
+    vec2 depressed = vec2(-2. * c.z * delta.x + delta.y, delta.x);
+    float theta = atan(sqrt(max(discriminant, 0.)), -depressed.x) / 3.;
+    vec2 cubicRoot = vec2(cos(theta), sin(theta));
+
+    vec3 root = vec3(
+        cubicRoot.x,
+        dot(vec2(-0.5, -0.5 * sqrt(3.)), cubicRoot),
+        dot(vec2(-0.5, 0.5 * sqrt(3.)), cubicRoot));
+    return 2. * sqrt(max(-depressed.y, 0.)) * root - c.z;
+}
+
+// b0: total optical depth, b: (b1, b2, b3, b4) / b0, depth in [-1, 1]
+float TransmittanceFrom4PowerMoments(float b0, vec4 b, float depth, float bias, float overestimation)
+{
+    // bias the moments to stay in the valid domain with the storage precision
+    b = mix(b, vec4(0., 0.375, 0., 0.375), bias);
+
+    // Cholesky factorization of the Hankel matrix
+    float L21D11 = -b.x * b.y + b.z;
+    float D11 = -b.x * b.x + b.y;
+    float invD11 = 1. / D11;
+    float L21 = L21D11 * invD11;
+    float D22 = -L21D11 * L21 + (-b.y * b.y + b.w);
+
+    // solve the system for (1, depth, depth^2)
+    vec3 c = vec3(1., depth, depth * depth);
+    c.y -= b.x;
+    c.z -= b.y + L21 * c.y;
+    c.y *= invD11;
+    c.z /= D22;
+    c.y -= L21 * c.z;
+    c.x -= dot(c.yz, b.xy);
+
+    // the roots of c.x + c.y * z + c.z * z^2 are the support of the canonical distribution
+    float p = c.y / c.z;
+    float q = c.x / c.z;
+    float r = sqrt(max(p * p * 0.25 - q, 0.));
+    vec3 z = vec3(depth, -p * 0.5 - r, -p * 0.5 + r);
+
+    // interpolation polynomial of the weights
+    vec3 weight = vec3(overestimation, (z.y < z.x) ? 1. : 0., (z.z < z.x) ? 1. : 0.);
+    float f01 = (weight.y - weight.x) / (z.y - z.x);
+    float f12 = (weight.z - weight.y) / (z.z - z.y);
+    float f012 = (f12 - f01) / (z.z - z.x);
+    vec3 polynomial;
+    polynomial.x = f01 - f012 * z.y;
+    polynomial.z = f012;
+    polynomial.y = polynomial.x - f012 * z.x;
+    polynomial.x = weight.x - polynomial.x * z.x;
+
+    float absorbance = polynomial.x + dot(b.xy, polynomial.yz);
+    return clamp(exp(-b0 * absorbance), 0., 1.);
+}
+
+// b0: total optical depth, b1234 and b56: (b1, ..., b6) / b0, depth in [-1, 1]
+float TransmittanceFrom6PowerMoments(float b0, vec4 b1234, vec2 b56, float depth, float bias, float overestimation)
+{
+    // bias the moments to stay in the valid domain with the storage precision
+    float b[6] = float[6](b1234.x, b1234.y, b1234.z, b1234.w, b56.x, b56.y);
+    const float biasVector[6] = float[6](0., 0.48, 0., 0.451, 0., 0.45);
+    for (int i = 0; i < 6; i++)
+    {
+        b[i] = mix(b[i], biasVector[i], bias);
+    }
+
+    // Cholesky factorization of the Hankel matrix
+    float invD11 = 1. / (-b[0] * b[0] + b[1]);
+    float L21D11 = -b[0] * b[1] + b[2];
+    float L21 = L21D11 * invD11;
+    float D22 = -L21D11 * L21 + (-b[1] * b[1] + b[3]);
+    float L31D11 = -b[0] * b[2] + b[3];
+    float L31 = L31D11 * invD11;
+    float invD22 = 1. / D22;
+    float L32D22 = -L21D11 * L31 + (-b[1] * b[2] + b[4]);
+    float L32 = L32D22 * invD22;
+    float D33 = (-b[2] * b[2] + b[5]) - dot(vec2(L31D11, L32D22), vec2(L31, L32));
+    float invD33 = 1. / D33;
+
+    // solve the system for (1, depth, depth^2, depth^3)
+    vec4 c = vec4(1., depth, depth * depth, depth * depth * depth);
+    c.y -= b[0];
+    c.z -= L21 * c.y + b[1];
+    c.w -= b[2] + dot(vec2(L31, L32), c.yz);
+    c.y *= invD11;
+    c.z *= invD22;
+    c.w *= invD33;
+    c.z -= L32 * c.w;
+    c.y -= dot(vec2(L21, L31), c.zw);
+    c.x -= dot(vec3(b[0], b[1], b[2]), c.yzw);
+
+    // the roots of the cubic are the support of the canonical distribution
+    vec4 z = vec4(depth, SolveCubic(c));
+
+    // interpolation polynomial of the weights
+    vec4 weight = vec4(overestimation, (z.y < z.x) ? 1. : 0., (z.z < z.x) ? 1. : 0., (z.w < z.x) ? 1. : 0.);
+    float f01 = (weight.y - weight.x) / (z.y - z.x);
+    float f12 = (weight.z - weight.y) / (z.z - z.y);
+    float f23 = (weight.w - weight.z) / (z.w - z.z);
+    float f012 = (f12 - f01) / (z.z - z.x);
+    float f123 = (f23 - f12) / (z.w - z.y);
+    float f0123 = (f123 - f012) / (z.w - z.x);
+    vec4 polynomial;
+    polynomial.x = -f0123 * z.z + f012;
+    polynomial.y = f0123;
+    polynomial.z = polynomial.y;
+    polynomial.y = -polynomial.y * z.y + polynomial.x;
+    polynomial.x = -polynomial.x * z.y + f01;
+    polynomial.w = polynomial.z;
+    polynomial.z = -polynomial.z * z.x + polynomial.y;
+    polynomial.y = -polynomial.y * z.x + polynomial.x;
+    polynomial.x = -polynomial.x * z.x + weight.x;
+
+    float absorbance = dot(polynomial, vec4(1., b[0], b[1], b[2]));
+    return clamp(exp(-b0 * absorbance), 0., 1.);
+}
@@ -0,0 +1,51 @@
+//--------------------------------------------------------------------------------------
+// Order Independent Transparency with Moments
+//--------------------------------------------------------------------------------------
+
+#version 330 core
+
+// Second pass: each fragment is weighted by the transmittance in front of it,
+// reconstructed from the moments of the first pass
+
+uniform sampler2DRect OpticalDepthTex;
+uniform sampler2DRect Moments1234Tex;
+uniform sampler2DRect Moments56Tex;
+uniform vec2 DepthRange;
+uniform int MomentCount;
+uniform float MomentBias;
+
+layout(location = 0) out vec4 Accumulation;
+
+#define OVERESTIMATION 0.25
+#define MIN_OPTICAL_DEPTH 1e-5
+
+vec4 ShadeFragment();
+float TransmittanceFrom4PowerMoments(float b0, vec4 b, float depth, float bias, float overestimation);
+float TransmittanceFrom6PowerMoments(float b0, vec4 b1234, vec2 b56, float depth, float bias, float overestimation);
+
+void main(void)
+{
+    vec4 color = ShadeFragment();
+
+    vec2 texCoord = gl_FragCoord.xy;
+    float b0 = texture(OpticalDepthTex, texCoord).r;
+    float transmittance = 1.;
+    if (b0 > MIN_OPTICAL_DEPTH)
+    {
+        float depth = (gl_FragCoord.z - DepthRange.x) / max(DepthRange.y - DepthRange.x, 1e-6);
+        depth = clamp(2. * depth - 1., -1., 1.);
+
+        vec4 b1234 = texture(Moments1234Tex, texCoord) / b0;
+        if (MomentCount > 4)
+        {
+            vec2 b56 = texture(Moments56Tex, texCoord).rg / b0;
+            transmittance = TransmittanceFrom6PowerMoments(b0, b1234, b56, depth, MomentBias, OVERESTIMATION);
+        }
+        else
+        {
+            transmittance = TransmittanceFrom4PowerMoments(b0, b1234, depth, MomentBias, OVERESTIMATION);
+        }
+    }
+
+    Accumulation = vec4(color.rgb * color.a, color.a) * transmittance;
+}
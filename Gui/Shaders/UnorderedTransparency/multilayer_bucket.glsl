@@ -0,0 +1,29 @@
+//--------------------------------------------------------------------------------------
+// Order Independent Transparency with Multi-Layer Peeling
+//--------------------------------------------------------------------------------------
+
+#version 330 core
+
+// The remaining depth range of each pixel, from the last peeled depth to the farthest one,
+// is split in LayerCount buckets. Each pass captures the nearest fragment of every bucket.
+
+uniform sampler2DRect MinMaxDepthTex; // (-nearest, farthest) of all the transparent fragments
+uniform sampler2DRect PeeledDepthTex; // last peeled depth, -1 before the first pass
+uniform sampler2DRect OpaqueDepthTex;
+uniform int LayerCount;
+
+// not peeled yet and not hidden by an opaque object
+bool IsRemaining(vec2 texCoord, float depth)
+{
+    float peeledDepth = texture(PeeledDepthTex, texCoord).r;
+    float opaqueDepth = texture(OpaqueDepthTex, texCoord).r;
+    return depth > peeledDepth && depth <= opaqueDepth;
+}
+
+int BucketIndex(vec2 texCoord, float depth)
+{
+    vec2 minMaxDepth = texture(MinMaxDepthTex, texCoord).xy;
+    float nearestDepth = max(texture(PeeledDepthTex, texCoord).r, -minMaxDepth.x);
+    float range = max(minMaxDepth.y - nearestDepth, 1e-7);
+    return clamp(int(float(LayerCount) * (depth - nearestDepth) / range), 0, LayerCount - 1);
+}
@@ -0,0 +1,42 @@
+//--------------------------------------------------------------------------------------
+// Order Independent Transparency with Multi-Layer Peeling
+//--------------------------------------------------------------------------------------
+
+#version 330 core
+
+// Write the color of the captured fragments in the target of their bucket,
+// and the nearest depth of the fragments not captured (bucket collisions) with MAX blending
+
+#define MAX_LAYERS 7
+#define NO_DEPTH -2.
+
+uniform sampler2DRect BucketDepth0123Tex;
+uniform sampler2DRect BucketDepth456Tex;
+
+layout(location = 0) out vec4 LayerColor[MAX_LAYERS];
+layout(location = 7) out float MissedDepth;
+
+vec4 ShadeFragment();
+bool IsRemaining(vec2 texCoord, float depth);
+int BucketIndex(vec2 texCoord, float depth);
+
+void main(void)
+{
+    vec2 texCoord = gl_FragCoord.xy;
+    float depth = gl_FragCoord.z;
+    if (!IsRemaining(texCoord, depth))
+    {
+        discard;
+    }
+
+    int bucket = BucketIndex(texCoord, depth);
+    float bucketDepth = (bucket < 4) ? -texture(BucketDepth0123Tex, texCoord)[bucket] : -texture(BucketDepth456Tex, texCoord)[bucket - 4];
+
+    bool isCaptured = (depth == bucketDepth);
+    vec4 color = isCaptured ? ShadeFragment() : vec4(0.);
+    for (int i = 0; i < MAX_LAYERS; i++)
+    {
+        LayerColor[i] = (i == bucket) ? color : vec4(0.);
+    }
+    MissedDepth = isCaptured ? NO_DEPTH : -depth;
+}
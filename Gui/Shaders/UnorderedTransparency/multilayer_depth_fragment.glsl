@@ -0,0 +1,37 @@
+//--------------------------------------------------------------------------------------
+// Order Independent Transparency with Multi-Layer Peeling
+//--------------------------------------------------------------------------------------
+
+#version 330 core
+
+// Capture the nearest depth of each bucket with MAX blending of -depth
+
+layout(location = 0) out vec4 BucketDepth0123;
+layout(location = 1) out vec4 BucketDepth456;
+
+#define NO_DEPTH -2.
+
+bool IsRemaining(vec2 texCoord, float depth);
+int BucketIndex(vec2 texCoord, float depth);
+
+void main(void)
+{
+    vec2 texCoord = gl_FragCoord.xy;
+    float depth = gl_FragCoord.z;
+    if (!IsRemaining(texCoord, depth))
+    {
+        discard;
+    }
+
+    int bucket = BucketIndex(texCoord, depth);
+    BucketDepth0123 = vec4(NO_DEPTH);
+    BucketDepth456 = vec4(NO_DEPTH);
+    if (bucket < 4)
+    {
+        BucketDepth0123[bucket] = -depth;
+    }
+    else
+    {
+        BucketDepth456[bucket - 4] = -depth;
+    }
+}
@@ -0,0 +1,22 @@
+//--------------------------------------------------------------------------------------
+// Order Independent Transparency with Multi-Layer Peeling
+//--------------------------------------------------------------------------------------
+
+#version 330 core
+
+uniform sampler2DRect OpaqueTex;
+uniform sampler2DRect AccumulationTex;
+uniform vec3 BackgroundColor;
+
+out vec4 fragColor;
+
+void main(void)
+{
+    vec2 texCoord = gl_FragCoord.xy;
+    vec3 opaqueColor = texture(OpaqueTex, texCoord).rgb;
+    vec4 accumulation = texture(AccumulationTex, texCoord);
+
+    // same mix as the dual depth peeling: the background is under the opaque objects
+    fragColor.rgb = accumulation.rgb + (BackgroundColor + opaqueColor) * accumulation.a;
+    fragColor.a = 1.;
+}
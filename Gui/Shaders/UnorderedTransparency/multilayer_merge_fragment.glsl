@@ -0,0 +1,67 @@
+//--------------------------------------------------------------------------------------
+// Order Independent Transparency with Multi-Layer Peeling
+//--------------------------------------------------------------------------------------
+
+#version 330 core
+
+// Blend the captured layers front to back until the first missed fragment:
+// all the layers in front of it have been captured in order, the next pass restarts from the last blended one
+
+#define MAX_LAYERS 7
+#define NO_DEPTH -2.
+
+uniform sampler2DRect BucketDepth0123Tex;
+uniform sampler2DRect BucketDepth456Tex;
+uniform sampler2DRect LayerColorTex[MAX_LAYERS];
+uniform sampler2DRect MissedDepthTex;
+uniform sampler2DRect PrevAccumulationTex; // (sum(color * alpha * transmittance), transmittance)
+uniform sampler2DRect PrevPeeledDepthTex;
+uniform int LayerCount;
+
+layout(location = 0) out vec4 Accumulation;
+layout(location = 1) out float PeeledDepth;
+
+void main(void)
+{
+    vec2 texCoord = gl_FragCoord.xy;
+    Accumulation = texture(PrevAccumulationTex, texCoord);
+    PeeledDepth = texture(PrevPeeledDepthTex, texCoord).r;
+
+    float missedDepth = -texture(MissedDepthTex, texCoord).r;
+    vec4 bucketDepth0123 = texture(BucketDepth0123Tex, texCoord);
+    vec4 bucketDepth456 = texture(BucketDepth456Tex, texCoord);
+    float bucketDepths[MAX_LAYERS] = float[MAX_LAYERS](
+        bucketDepth0123.x, bucketDepth0123.y, bucketDepth0123.z, bucketDepth0123.w,
+        bucketDepth456.x, bucketDepth456.y, bucketDepth456.z);
+
+    // the buckets are sorted by depth
+    for (int i = 0; i < LayerCount; i++)
+    {
+        if (bucketDepths[i] == NO_DEPTH)
+        {
+            continue; // empty bucket
+        }
+
+        float depth = -bucketDepths[i];
+        if (depth >= missedDepth)
+        {
+            break;
+        }
+
+        vec4 color;
+        // sampler arrays can only be indexed by constant expressions in GLSL 3.30
+        switch (i)
+        {
+            case 0: color = texture(LayerColorTex[0], texCoord); break;
+            case 1: color = texture(LayerColorTex[1], texCoord); break;
+            case 2: color = texture(LayerColorTex[2], texCoord); break;
+            case 3: color = texture(LayerColorTex[3], texCoord); break;
+            case 4: color = texture(LayerColorTex[4], texCoord); break;
+            case 5: color = texture(LayerColorTex[5], texCoord); break;
+            default: color = texture(LayerColorTex[6], texCoord); break;
+        }
+        Accumulation.rgb += color.rgb * color.a * Accumulation.a;
+        Accumulation.a *= 1. - color.a;
+        PeeledDepth = depth;
+    }
+}
@@ -10,6 +10,8 @@ uniform sampler2DRect DepthBlenderTex;
 uniform sampler2DRect FrontBlenderTex;
 uniform sampler2DRect OpaqueDepthTex;
 uniform sampler2DRect OpaqueColorTex;
+uniform sampler2DRect BackBlenderTex;
+uniform bool FusedBackBlend;
 //uniform float Width;
 //uniform float Height;
 
@@ -18,6 +20,9 @@ layout(location = 1) out vec4 FrontColor;
 layout(location = 2) out vec4 BackColor;
 
 #define MAX_DEPTH 1.0
+// fused back blending divides by the back transmittance, keep it far from 0
+#define MAX_BACK_ALPHA 0.999
+#define MIN_BACK_TRANSMITTANCE 1e-30
 
 vec4 ShadeFragment();
 
@@ -44,6 +49,16 @@ void main(void)
     // Each pass, only one fragment writes a color greater than 0
     BackColor = vec4(0.);
 
+    // With fused back blending, the back layers are accumulated as (sum(color * alpha / T), 1 - T)
+    // where T is the transmittance of the back layers already peeled. Both values always increase
+    // so we can pass-through by default with MAX blending, and the blended back color is sum * T.
+    vec4 backTemp = vec4(0.);
+    if (FusedBackBlend)
+    {
+        backTemp = texture(BackBlenderTex, texCoord);
+        BackColor = backTemp;
+    }
+
     float nearestDepth = -depthBlender.x;
     float farthestDepth = depthBlender.y;
     float alphaMultiplier = 1. - forwardTemp.w;
@@ -75,6 +90,13 @@ void main(void)
         FrontColor.xyz += color.rgb * color.a * alphaMultiplier;
         FrontColor.w = 1. - alphaMultiplier * (1. - color.a);
     }
+    else if (FusedBackBlend)
+    {
+        float alpha = min(color.a, MAX_BACK_ALPHA);
+        float transmittance = max((1. - backTemp.w) * (1. - alpha), MIN_BACK_TRANSMITTANCE);
+        BackColor.rgb += color.rgb * alpha / transmittance;
+        BackColor.w = 1. - transmittance;
+    }
     else 
     {
         BackColor += color;
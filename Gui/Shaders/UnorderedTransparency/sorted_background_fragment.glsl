@@ -0,0 +1,19 @@
+//--------------------------------------------------------------------------------------
+// Transparency with sorted triangles
+//--------------------------------------------------------------------------------------
+
+#version 330 core
+
+// Copy the opaque color and depth in the target, the sorted triangles are blended over them
+
+uniform sampler2DRect OpaqueTex;
+uniform sampler2DRect OpaqueDepthTex;
+uniform vec3 BackgroundColor;
+
+out vec4 fragColor;
+
+void main(void)
+{
+    fragColor = vec4(BackgroundColor + texture(OpaqueTex, gl_FragCoord.xy).rgb, 1.);
+    gl_FragDepth = texture(OpaqueDepthTex, gl_FragCoord.xy).r;
+}
@@ -0,0 +1,16 @@
+//--------------------------------------------------------------------------------------
+// Transparency with sorted triangles
+//--------------------------------------------------------------------------------------
+
+#version 330 core
+
+// the triangles are drawn back to front with (SRC_ALPHA, ONE_MINUS_SRC_ALPHA) blending
+
+out vec4 fragColor;
+
+vec4 ShadeFragment();
+
+void main(void)
+{
+    fragColor = ShadeFragment();
+}
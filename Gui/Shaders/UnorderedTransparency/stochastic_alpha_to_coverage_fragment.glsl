@@ -0,0 +1,30 @@
+//--------------------------------------------------------------------------------------
+// Order Independent Transparency with Stochastic Transparency
+//--------------------------------------------------------------------------------------
+
+#version 330 core
+
+// Fallback without GL_ARB_sample_shading: GL_SAMPLE_ALPHA_TO_COVERAGE converts the alpha to a sample mask.
+// The driver pattern is the same for a same alpha, a random dither of one sample decorrelates the layers a little.
+
+uniform sampler2DRect OpaqueDepthTex;
+uniform int SampleCount;
+
+layout(location = 0) out vec4 CoverageColor;
+
+vec4 ShadeFragment();
+uvec4 FragmentHash(void);
+float UnitRandom(uint h);
+
+void main(void)
+{
+    if (gl_FragCoord.z > texture(OpaqueDepthTex, gl_FragCoord.xy).r)
+    {
+        discard;
+    }
+
+    vec4 color = ShadeFragment();
+    float dither = (UnitRandom(FragmentHash().x) - 0.5) / float(SampleCount);
+
+    CoverageColor = vec4(color.rgb, clamp(color.a + dither, 0., 1.));
+}
@@ -0,0 +1,54 @@
+//--------------------------------------------------------------------------------------
+// Order Independent Transparency with Stochastic Transparency
+//--------------------------------------------------------------------------------------
+
+#version 330 core
+#extension GL_ARB_sample_shading : require
+
+// Stochastic transparency (Enderton et al. 2010): a fragment covers round(alpha * SampleCount) samples
+// at a random rotation of the pixel samples, the depth test of the multisampled target keeps the nearest one by sample
+
+#define MAX_SAMPLES 32
+
+uniform sampler2DRect OpaqueDepthTex;
+uniform int SampleCount;
+
+layout(location = 0) out vec4 CoverageColor;
+
+vec4 ShadeFragment();
+uvec4 FragmentHash(void);
+float UnitRandom(uint h);
+
+uint LowBitsMask(int count)
+{
+    return (count >= MAX_SAMPLES) ? 0xFFFFFFFFu : ((1u << uint(count)) - 1u);
+}
+
+void main(void)
+{
+    // the opaque depth is not multisampled, it cannot be attached to the target
+    if (gl_FragCoord.z > texture(OpaqueDepthTex, gl_FragCoord.xy).r)
+    {
+        discard;
+    }
+
+    vec4 color = ShadeFragment();
+    uvec4 h = FragmentHash();
+
+    // stratified coverage: the random threshold keeps the expected coverage equal to alpha
+    int coveredCount = clamp(int(color.a * float(SampleCount) + UnitRandom(h.x)), 0, SampleCount);
+    if (coveredCount == 0)
+    {
+        discard;
+    }
+
+    uint mask = LowBitsMask(coveredCount);
+    uint rotation = h.y % uint(SampleCount);
+    if (rotation != 0u)
+    {
+        mask = (mask << rotation) | (mask >> (uint(SampleCount) - rotation));
+    }
+    gl_SampleMask[0] = int(mask & LowBitsMask(SampleCount));
+
+    CoverageColor = vec4(color.rgb, 1.);
+}
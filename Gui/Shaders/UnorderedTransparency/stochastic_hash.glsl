@@ -0,0 +1,29 @@
+//--------------------------------------------------------------------------------------
+// Order Independent Transparency with Stochastic Transparency
+//--------------------------------------------------------------------------------------
+
+#version 330 core
+
+// pcg4d hash (Jarzynski and Olano 2020): 4 independent random values by fragment
+
+uniform uint FrameIndex; // new random values at every frame for the temporal accumulation
+
+uvec4 Hash(uvec4 v)
+{
+    v = v * 1664525u + 1013904223u;
+    v.x += v.y * v.w; v.y += v.z * v.x; v.z += v.x * v.y; v.w += v.y * v.z;
+    v ^= v >> 16u;
+    v.x += v.y * v.w; v.y += v.z * v.x; v.z += v.x * v.y; v.w += v.y * v.z;
+    return v;
+}
+
+// the depth and the primitive decorrelate the transparent surfaces of a same pixel
+uvec4 FragmentHash(void)
+{
+    return Hash(uvec4(uvec2(gl_FragCoord.xy), floatBitsToUint(gl_FragCoord.z) ^ uint(gl_PrimitiveID), FrameIndex));
+}
+
+float UnitRandom(uint h)
+{
+    return float(h >> 8u) * (1. / 16777216.);
+}
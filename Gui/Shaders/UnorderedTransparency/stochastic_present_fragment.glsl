@@ -0,0 +1,14 @@
+//--------------------------------------------------------------------------------------
+// Order Independent Transparency with Stochastic Transparency
+//--------------------------------------------------------------------------------------
+
+#version 330 core
+
+uniform sampler2DRect HistoryTex;
+
+out vec4 fragColor;
+
+void main(void)
+{
+    fragColor = vec4(texture(HistoryTex, gl_FragCoord.xy).rgb, 1.);
+}
@@ -0,0 +1,30 @@
+//--------------------------------------------------------------------------------------
+// Order Independent Transparency with Stochastic Transparency
+//--------------------------------------------------------------------------------------
+
+#version 330 core
+
+// Average of the samples: the nearest covering transparent color, the opaque color where no fragment covers the sample
+
+uniform sampler2DMS ColorTex;
+uniform int SampleCount;
+uniform sampler2DRect OpaqueTex;
+uniform vec3 BackgroundColor;
+
+out vec4 fragColor;
+
+void main(void)
+{
+    vec3 backColor = BackgroundColor + texture(OpaqueTex, gl_FragCoord.xy).rgb;
+
+    ivec2 texCoord = ivec2(gl_FragCoord.xy);
+    vec3 color = vec3(0.);
+    for (int i = 0; i < SampleCount; i++)
+    {
+        vec4 sampleColor = texelFetch(ColorTex, texCoord, i);
+        color += (sampleColor.a > 0.) ? sampleColor.rgb : backColor;
+    }
+
+    // blended with the previous frames by the constant blend factor
+    fragColor = vec4(color / float(SampleCount), 1.);
+}
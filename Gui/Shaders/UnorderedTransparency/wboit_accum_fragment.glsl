@@ -0,0 +1,32 @@
+//--------------------------------------------------------------------------------------
+// Order Independent Transparency with Weighted Blended
+//--------------------------------------------------------------------------------------
+
+#version 330 core
+
+// Weighted blended OIT (McGuire and Bavoil 2013):
+// the transparent fragments are summed with a weight decreasing with the depth,
+// the opaque depth is rejected by the depth test of the framebuffer
+
+// window depth range where the weight decreases, the scene depth range is a good value
+uniform vec2 DepthRange;
+
+// target 0: (sum(color * alpha * weight), prod(1 - alpha)) with one blend function for both targets
+// target 1: sum(alpha * weight) in the red channel, the alpha of 0 keeps the destination
+layout(location = 0) out vec4 Accumulation;
+layout(location = 1) out vec4 Weight;
+
+vec4 ShadeFragment();
+
+void main(void)
+{
+    vec4 color = ShadeFragment();
+
+    float depth = clamp((gl_FragCoord.z - DepthRange.x) / max(DepthRange.y - DepthRange.x, 1e-6), 0., 1.);
+    // w = alpha * clamp(3e3 * (1 - d)^3, 1e-2, 3e3) with d the window depth normalized to DepthRange: a cubic falloff on the
+    // depth buffer value, not one of the view depth weights of the paper. The bounds keep the sums in 16 bits float
+    float weight = color.a * clamp(3e3 * pow(1. - depth, 3.), 1e-2, 3e3);
+
+    Accumulation = vec4(color.rgb * weight, color.a);
+    Weight = vec4(weight, 0., 0., 0.);
+}
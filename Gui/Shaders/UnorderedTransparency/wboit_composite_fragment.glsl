@@ -0,0 +1,28 @@
+//--------------------------------------------------------------------------------------
+// Order Independent Transparency with Weighted Blended
+//--------------------------------------------------------------------------------------
+
+#version 330 core
+
+uniform sampler2DRect OpaqueTex;
+uniform sampler2DRect AccumulationTex;
+uniform sampler2DRect WeightTex;
+uniform vec3 BackgroundColor;
+
+out vec4 fragColor;
+
+void main(void)
+{
+    vec2 texCoord = gl_FragCoord.xy;
+    vec3 opaqueColor = texture(OpaqueTex, texCoord).rgb;
+    vec4 accumulation = texture(AccumulationTex, texCoord);
+    float weight = texture(WeightTex, texCoord).r;
+
+    // alpha channel is the product of (1 - alpha), the part of the background still visible
+    float revealage = accumulation.a;
+    vec3 averageColor = accumulation.rgb / max(weight, 1e-5);
+
+    // same mix as the dual depth peeling: the background is under the opaque objects
+    fragColor.rgb = averageColor * (1. - revealage) + (BackgroundColor + opaqueColor) * revealage;
+    fragColor.a = 1.;
+}